@@ -214,6 +214,8 @@ namespace DistributedInput {
 
     constexpr const char* CHECK_KEY_STATUS_THREAD_NAME = "checkKeyStatus";
 
+    constexpr const char* CREATE_NODE_THREAD_NAME = "createVirNode";
+
     constexpr int32_t LOG_MAX_LEN = 4096;
 
     constexpr uint32_t SCREEN_ID_DEFAULT = 0;
@@ -228,7 +230,10 @@ namespace DistributedInput {
 
     enum class EHandlerMsgType {
         DINPUT_SINK_EVENT_HANDLER_MSG = 1,
-        DINPUT_SOURCE_EVENT_HANDLER_MSG = 2
+        DINPUT_SOURCE_EVENT_HANDLER_MSG = 2,
+        DINPUT_SINK_EVENT_HANDLER_TRACE_MSG = 3,
+        // the batching window of the held sink events is over.
+        DINPUT_SINK_EVENT_HANDLER_FLUSH_MSG = 4
     };
 
     struct BusinessEvent {
@@ -302,6 +307,16 @@ namespace DistributedInput {
         std::string hdInfo;
     };
 
+    /*
+     * One hardware of a batch registration
+     */
+    struct RegisterHardwareItem {
+        std::string devId;
+        std::string dhId;
+        // the capability json of the hardware
+        std::string parameters;
+    };
+
     // Synthetic raw event type codes produced when devices are added or removed.
     enum class DeviceType {
         // Sent when a device is added.
@@ -351,6 +366,8 @@ namespace DistributedInput {
         OPENING = 0x01,
         OPENED = 0x02,
         CLOSING = 0x03,
+        // unprepared or pre-warmed, the socket is kept open for a later prepare.
+        IDLE = 0x04,
     };
 } // namespace DistributedInput
 } // namespace DistributedHardware
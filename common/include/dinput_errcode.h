@@ -113,6 +113,7 @@ namespace DistributedInput {
     constexpr int32_t ERR_DH_INPUT_SERVER_SOURCE_MANAGER_INJECT_EVENT_CB_IS_NULL = -65041;
     constexpr int32_t ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_PERMISSION_DENIED = -65042;
     constexpr int32_t ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_CONTEXT = -65043;
+    constexpr int32_t ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT = -65044;
 
     // handler error code
     constexpr int32_t ERR_DH_INPUT_SINK_HANDLER_INIT_SINK_SA_FAIL = -66000;
@@ -187,6 +188,13 @@ namespace DistributedInput {
     constexpr int32_t ERR_DH_INPUT_HIDUMP_DUMP_PROCESS_FAIL = -68001;
     constexpr int32_t ERR_DH_INPUT_HIDUMP_DPRINTF_FAIL = -68002;
 
+    // Event record and replay error code
+    constexpr int32_t ERR_DH_INPUT_RECORD_IS_BUSY = -68100;
+    constexpr int32_t ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL = -68101;
+    constexpr int32_t ERR_DH_INPUT_RECORD_WRITE_FAIL = -68102;
+    constexpr int32_t ERR_DH_INPUT_RECORD_FILE_INVALID = -68103;
+    constexpr int32_t ERR_DH_INPUT_REPLAY_IS_BUSY = -68104;
+
     // null pointer is not verified
     constexpr int32_t ERR_DH_INPUT_POINTER_NULL = -69000;
 } // namespace DistributedInput
@@ -45,6 +45,8 @@ enum class IDInputSourceInterfaceCode : uint32_t {
     SYNC_NODE_INFO_REMOTE_INPUT = 0xf019U,
     REGISTER_SESSION_STATE_CB = 0xf01aU,
     UNREGISTER_SESSION_STATE_CB = 0xf01bU,
+    REGISTER_BATCH_REMOTE_INPUT = 0xf01cU,
+    PREPARE_START_DHID_REMOTE_INPUT = 0xf01dU,
 };
 
 /* SAID: 4810 */
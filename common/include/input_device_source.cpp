@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_device_source.h"
+
+#include <cstring>
+#include <sys/ioctl.h>
+
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+void EvdevInputDeviceSource::ScanDevicePaths(const std::string &dirName, std::vector<std::string> &devicePaths)
+{
+    ScanInputDevicesPath(dirName, devicePaths);
+}
+
+int32_t EvdevInputDeviceSource::OpenDevice(const std::string &devicePath)
+{
+    return OpenInputDeviceFdByPath(devicePath);
+}
+
+int32_t EvdevInputDeviceSource::Ioctl(int32_t fd, unsigned long request, void *arg)
+{
+    return ioctl(fd, request, arg);
+}
+
+struct libevdev *EvdevInputDeviceSource::NewLibEvDev(int32_t fd)
+{
+    struct libevdev *dev = nullptr;
+    int rc = libevdev_new_from_fd(fd, &dev);
+    if (rc < 0) {
+        DHLOGE("Failed to init libevdev (%{public}s)", strerror(-rc));
+        return nullptr;
+    }
+    return dev;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUT_DEVICE_SOURCE_H
+#define INPUT_DEVICE_SOURCE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <libevdev/libevdev.h>
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Where InputHub finds and queries its input device nodes. The returned fds must be pollable
+ * and readable as a stream of struct input_event, InputHub registers them to epoll, reads
+ * and closes them itself.
+ */
+class InputDeviceSource {
+public:
+    virtual ~InputDeviceSource() = default;
+
+    virtual void ScanDevicePaths(const std::string &dirName, std::vector<std::string> &devicePaths) = 0;
+    /*
+     * Return the opened fd, or UN_INIT_FD_VALUE on failure.
+     */
+    virtual int32_t OpenDevice(const std::string &devicePath) = 0;
+    virtual int32_t Ioctl(int32_t fd, unsigned long request, void *arg) = 0;
+    /*
+     * Return a libevdev describing the device, the caller frees it with libevdev_free.
+     */
+    virtual struct libevdev *NewLibEvDev(int32_t fd) = 0;
+};
+
+/*
+ * The real device source, backed by the evdev nodes under /dev/input.
+ */
+class EvdevInputDeviceSource : public InputDeviceSource {
+public:
+    void ScanDevicePaths(const std::string &dirName, std::vector<std::string> &devicePaths) override;
+    int32_t OpenDevice(const std::string &devicePath) override;
+    int32_t Ioctl(int32_t fd, unsigned long request, void *arg) override;
+    struct libevdev *NewLibEvDev(int32_t fd) override;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // INPUT_DEVICE_SOURCE_H
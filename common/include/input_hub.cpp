@@ -20,6 +20,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <filesystem>
+#include <pthread.h>
 #include <regex>
 #include <securec.h>
 #include <sstream>
@@ -33,6 +34,7 @@
 #include "dinput_context.h"
 #include "dinput_errcode.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_sink_state.h"
 #include "dinput_utils_tool.h"
 
@@ -43,13 +45,21 @@ namespace {
 const uint32_t SLEEP_TIME_US = 100 * 1000;
 const std::string MOUSE_NODE_KEY = "mouse";
 const uint32_t SPACELENGTH = 1024;
+const size_t MAX_CAPABILITY_CACHE_SIZE = 64;
+const size_t MAX_PROBE_WORKER_NUM = 4;
+const char PROBE_DEVICE_THREAD_NAME[] = "probeDevice";
 }
 
-InputHub::InputHub(bool isPluginMonitor) : epollFd_(-1), iNotifyFd_(-1), inputWd_(-1),
-    isPluginMonitor_(isPluginMonitor), needToScanDevices_(true), mPendingEventItems{},
+InputHub::InputHub(bool isPluginMonitor, std::shared_ptr<InputDeviceSource> deviceSource) : epollFd_(-1),
+    iNotifyFd_(-1), inputWd_(-1), isPluginMonitor_(isPluginMonitor), deviceSource_(deviceSource),
+    needToScanDevices_(true), mPendingEventItems{},
     pendingEventCount_(0), pendingEventIndex_(0), pendingINotify_(false), deviceChanged_(false),
-    inputTypes_(0), isStartCollectEvent_(false), isStartCollectHandler_(false)
+    inputTypes_(0), isStartCollectEvent_(false), isStartCollectHandler_(false),
+    probeWorkerNum_(MAX_PROBE_WORKER_NUM)
 {
+    if (deviceSource_ == nullptr) {
+        deviceSource_ = std::make_shared<EvdevInputDeviceSource>();
+    }
     Initialize();
 }
 
@@ -110,7 +120,10 @@ int32_t InputHub::Release()
     }
 
     sharedDHIds_.clear();
-    logTimesMap_.clear();
+    {
+        std::lock_guard<std::mutex> logTimesLock(logTimesMutex_);
+        logTimesMap_.clear();
+    }
     return DH_SUCCESS;
 }
 
@@ -195,6 +208,7 @@ size_t InputHub::GetEvents(RawEvent *buffer, size_t bufferSize)
             continue;
         }
         size_t count = ReadInputEvent(readSize, *deviceByFd);
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_READ, count);
         Device* device = GetSupportDeviceByFd(eventItem.data.fd);
         if (!device) {
             DHLOGE("Can not find device by fd: %{public}d", eventItem.data.fd);
@@ -202,6 +216,7 @@ size_t InputHub::GetEvents(RawEvent *buffer, size_t bufferSize)
         }
         if (!sharedDHIds_[device->identifier.descriptor]) {
             RecordDeviceChangeStates(device, readBuffer, count);
+            DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_FILTERED, count);
             DHLOGD("Not in sharing stat, device descriptor: %{public}s",
                 GetAnonyString(device->identifier.descriptor).c_str());
             continue;
@@ -319,8 +334,10 @@ size_t InputHub::CollectEvent(RawEvent *buffer, size_t &capacity, Device *device
     }
 
     RawEvent* event = buffer;
+    size_t filteredNum = 0;
     for (size_t i = 0; i < count; i++) {
         if (needFilted[i]) {
+            filteredNum++;
             continue;
         }
         const struct input_event& iev = readBuffer[i];
@@ -337,6 +354,12 @@ size_t InputHub::CollectEvent(RawEvent *buffer, size_t &capacity, Device *device
             break;
         }
     }
+    if (filteredNum > 0) {
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_FILTERED, filteredNum);
+    }
+    if (event != buffer) {
+        DInputMetrics::GetInstance().AddDeviceEvents(device->identifier.descriptor, event - buffer);
+    }
     return event - buffer;
 }
 
@@ -521,12 +544,59 @@ std::vector<InputDevice> InputHub::GetAllInputDevices()
 void InputHub::ScanInputDevices(const std::string &dirName)
 {
     std::vector<std::string> inputDevPaths;
-    ScanInputDevicesPath(dirName, inputDevPaths);
+    deviceSource_->ScanDevicePaths(dirName, inputDevPaths);
+    std::vector<std::string> probePaths;
     for (const auto &tempPath: inputDevPaths) {
         if (IsInputNodeNoNeedScan(tempPath)) {
             continue;
         }
-        OpenInputDeviceLocked(tempPath);
+        probePaths.push_back(tempPath);
+    }
+    if (probePaths.empty()) {
+        return;
+    }
+    uint64_t startTime = GetCurrentTimeUs();
+    RunProbeTasks(probePaths.size(), [this, &probePaths](size_t index) {
+        OpenInputDeviceLocked(probePaths[index]);
+    });
+    DHLOGI("Scan input devices finish, node num: %{public}zu, cost: %{public}" PRIu64 " us", probePaths.size(),
+        GetCurrentTimeUs() - startTime);
+}
+
+void InputHub::SetProbeWorkerNum(size_t workerNum)
+{
+    probeWorkerNum_.store(std::max<size_t>(workerNum, 1));
+}
+
+void InputHub::RunProbeTasks(size_t taskNum, const std::function<void(size_t)> &task)
+{
+    size_t workerNum = std::min(taskNum, probeWorkerNum_.load());
+    if (workerNum <= 1) {
+        for (size_t i = 0; i < taskNum; i++) {
+            task(i);
+        }
+        return;
+    }
+    // the tasks are pulled one by one, so a node stuck in open or ioctl only holds back its own worker.
+    std::atomic<size_t> nextTask = 0;
+    auto runTasks = [&nextTask, taskNum, &task]() {
+        for (size_t i = nextTask.fetch_add(1); i < taskNum; i = nextTask.fetch_add(1)) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerNum; i++) {
+        workers.emplace_back([&runTasks]() {
+            int32_t ret = pthread_setname_np(pthread_self(), PROBE_DEVICE_THREAD_NAME);
+            if (ret != 0) {
+                DHLOGE("probeDevice setname failed.");
+            }
+            runTasks();
+        });
+    }
+    runTasks();
+    for (auto &worker : workers) {
+        worker.join();
     }
 }
 
@@ -539,6 +609,12 @@ bool InputHub::IsDeviceRegistered(const std::string &devicePath)
             return true; // device was already registered
         }
     }
+    for (const auto &device : openingDevices_) {
+        if (device->path == devicePath) {
+            DHLOGI("Device node already opened, node path: %{public}s", device->path.c_str());
+            return true;
+        }
+    }
     return false;
 }
 
@@ -548,21 +624,23 @@ int32_t InputHub::OpenInputDeviceLocked(const std::string &devicePath)
         return DH_SUCCESS;
     }
 
-    std::lock_guard<std::mutex> my_lock(operationMutex_);
-    DHLOGD("Opening device start: %{public}s", devicePath.c_str());
-    int fd = OpenInputDeviceFdByPath(devicePath);
-    if (fd == UN_INIT_FD_VALUE) {
-        DHLOGE("The fd open failed, devicePath %{public}s.", devicePath.c_str());
-        return ERR_DH_INPUT_HUB_OPEN_DEVICEPATH_FAIL;
+    uint64_t startTime = GetCurrentTimeUs();
+    std::unique_ptr<Device> device;
+    int32_t ret = ProbeInputDevice(devicePath, device);
+    uint64_t probeCost = GetCurrentTimeUs() - startTime;
+    DInputMetrics::GetInstance().RecordHistogram(MetricHistogram::DEVICE_PROBE_COST_US, probeCost);
+    DHLOGI("Probe device %{public}s cost: %{public}" PRIu64 " us, ret: %{public}d", devicePath.c_str(), probeCost,
+        ret);
+    if (ret != DH_SUCCESS) {
+        return ret;
     }
 
-    // Allocate device. (The device object takes ownership of the fd at this point.)
-    std::unique_ptr<Device> device = std::make_unique<Device>(fd, devicePath);
-
-    if (QueryInputDeviceInfo(fd, device) < 0) {
-        return ERR_DH_INPUT_HUB_QUERY_INPUT_DEVICE_INFO_FAIL;
+    std::lock_guard<std::mutex> my_lock(operationMutex_);
+    // the probe ran unlocked, a concurrent probe or scan of the same node may have added it meanwhile.
+    if (IsDeviceRegistered(devicePath)) {
+        return DH_SUCCESS;
     }
-    GenerateDescriptor(device->identifier);
+    int fd = device->fd;
     IncreaseLogTimes(device->identifier.descriptor);
     RecordDeviceLog(devicePath, device->identifier);
     std::string descriptor = device->identifier.descriptor;
@@ -577,6 +655,36 @@ int32_t InputHub::OpenInputDeviceLocked(const std::string &devicePath)
     return DH_SUCCESS;
 }
 
+int32_t InputHub::ProbeInputDevice(const std::string &devicePath, std::unique_ptr<Device> &device)
+{
+    DHLOGD("Opening device start: %{public}s", devicePath.c_str());
+    int fd = deviceSource_->OpenDevice(devicePath);
+    if (fd == UN_INIT_FD_VALUE) {
+        DHLOGE("The fd open failed, devicePath %{public}s.", devicePath.c_str());
+        return ERR_DH_INPUT_HUB_OPEN_DEVICEPATH_FAIL;
+    }
+
+    // Allocate device. (The device object takes ownership of the fd at this point.)
+    device = std::make_unique<Device>(fd, devicePath);
+    QueryEventMask(fd, device);
+
+    if (QueryInputDeviceInfo(fd, device) < 0) {
+        device.reset();
+        return ERR_DH_INPUT_HUB_QUERY_INPUT_DEVICE_INFO_FAIL;
+    }
+    return DH_SUCCESS;
+}
+
+void InputHub::QueryEventMask(int fd, std::unique_ptr<Device> &device)
+{
+    // Figure out the kinds of events the device reports.
+    DHLOGI("Query device event mask, fd: %{public}d, path: %{public}s", fd, device->path.c_str());
+    deviceSource_->Ioctl(fd, EVIOCGBIT(0, sizeof(device->evBitmask)), device->evBitmask);
+    deviceSource_->Ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(device->keyBitmask)), device->keyBitmask);
+    deviceSource_->Ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(device->absBitmask)), device->absBitmask);
+    deviceSource_->Ioctl(fd, EVIOCGBIT(EV_REL, sizeof(device->relBitmask)), device->relBitmask);
+}
+
 void InputHub::RecordSkipDevicePath(std::string path)
 {
     std::lock_guard<std::mutex> lock(skipDevicePathsMutex_);
@@ -591,6 +699,7 @@ bool InputHub::IsSkipDevicePath(const std::string &path)
 
 void InputHub::IncreaseLogTimes(const std::string& dhId)
 {
+    std::lock_guard<std::mutex> logTimesLock(logTimesMutex_);
     if (logTimesMap_.find(dhId) != logTimesMap_.end() && logTimesMap_[dhId] >= INT32_MAX - 1) {
         logTimesMap_[dhId] = 0;
     } else {
@@ -600,6 +709,7 @@ void InputHub::IncreaseLogTimes(const std::string& dhId)
 
 bool InputHub::IsNeedPrintLog(const std::string& dhId) const
 {
+    std::lock_guard<std::mutex> logTimesLock(logTimesMutex_);
     return logTimesMap_.find(dhId) == logTimesMap_.end() || logTimesMap_.at(dhId) <= MAX_LOG_TIMES;
 }
 
@@ -607,7 +717,7 @@ int32_t InputHub::QueryInputDeviceInfo(int fd, std::unique_ptr<Device> &device)
 {
     char buffer[INPUT_EVENT_BUFFER_SIZE] = {0};
     // Get device name.
-    if (ioctl(fd, EVIOCGNAME(sizeof(buffer) - 1), &buffer) < 1) {
+    if (deviceSource_->Ioctl(fd, EVIOCGNAME(sizeof(buffer) - 1), &buffer) < 1) {
         DHLOGE("Could not get device name for %{public}s", ConvertErrNo().c_str());
     } else {
         buffer[sizeof(buffer) - 1] = '\0';
@@ -622,14 +732,14 @@ int32_t InputHub::QueryInputDeviceInfo(int fd, std::unique_ptr<Device> &device)
     }
     // Get device driver version.
     int driverVersion;
-    if (ioctl(fd, EVIOCGVERSION, &driverVersion)) {
+    if (deviceSource_->Ioctl(fd, EVIOCGVERSION, &driverVersion)) {
         DHLOGE("could not get driver version for %{public}s\n", ConvertErrNo().c_str());
         RecordSkipDevicePath(device->path);
         return ERR_DH_INPUT_HUB_QUERY_INPUT_DEVICE_INFO_FAIL;
     }
     // Get device identifier.
     struct input_id inputId;
-    if (ioctl(fd, EVIOCGID, &inputId)) {
+    if (deviceSource_->Ioctl(fd, EVIOCGID, &inputId)) {
         DHLOGE("could not get device input id for %{public}s\n", ConvertErrNo().c_str());
         RecordSkipDevicePath(device->path);
         return ERR_DH_INPUT_HUB_QUERY_INPUT_DEVICE_INFO_FAIL;
@@ -639,24 +749,115 @@ int32_t InputHub::QueryInputDeviceInfo(int fd, std::unique_ptr<Device> &device)
     device->identifier.vendor = inputId.vendor;
     device->identifier.version = inputId.version;
     // Get device physical physicalPath.
-    if (ioctl(fd, EVIOCGPHYS(sizeof(buffer) - 1), &buffer) < 1) {
+    if (deviceSource_->Ioctl(fd, EVIOCGPHYS(sizeof(buffer) - 1), &buffer) < 1) {
         DHLOGE("could not get physicalPath for %{public}s\n", ConvertErrNo().c_str());
     } else {
         buffer[sizeof(buffer) - 1] = '\0';
         device->identifier.physicalPath = buffer;
     }
     // Get device unique id.
-    if (ioctl(fd, EVIOCGUNIQ(sizeof(buffer) - 1), &buffer) < 1) {
+    if (deviceSource_->Ioctl(fd, EVIOCGUNIQ(sizeof(buffer) - 1), &buffer) < 1) {
         DHLOGE("could not get idstring for %{public}s\n", ConvertErrNo().c_str());
     } else {
         buffer[sizeof(buffer) - 1] = '\0';
         device->identifier.uniqueId = buffer;
     }
 
+    std::vector<uint8_t> capabilityBits = QueryCapabilityBits(fd, *device);
+    if (LoadCachedCapability(fd, *device, capabilityBits)) {
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::CAPABILITY_CACHE_HITS);
+        return DH_SUCCESS;
+    }
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::CAPABILITY_CACHE_MISSES);
     QueryEventInfo(fd, device);
+    GenerateDescriptor(device->identifier);
+    SaveCapabilityCache(*device, std::move(capabilityBits));
     return DH_SUCCESS;
 }
 
+std::string InputHub::GetCapabilityCacheKey(const InputDevice &identifier) const
+{
+    return StringPrintf("%04x:%04x:%04x:%04x:", identifier.bus, identifier.vendor, identifier.product,
+        identifier.version) + identifier.physicalPath + "|" + identifier.uniqueId;
+}
+
+std::vector<uint8_t> InputHub::QueryCapabilityBits(int fd, Device &device)
+{
+    GetEventMask(fd, "msc", EV_MSC, sizeof(device.mscBitmask), device.mscBitmask);
+    GetEventMask(fd, "led", EV_LED, sizeof(device.ledBitmask), device.ledBitmask);
+    GetEventMask(fd, "switch", EV_SW, sizeof(device.switchBitmask), device.switchBitmask);
+    GetEventMask(fd, "repeat", EV_REP, sizeof(device.repBitmask), device.repBitmask);
+    if (deviceSource_->Ioctl(fd, EVIOCGPROP(sizeof(device.propBitmask)), device.propBitmask) < 0) {
+        DHLOGE("Could not get device properties: %{public}s", ConvertErrNo().c_str());
+    }
+
+    std::vector<uint8_t> capabilityBits;
+    auto append = [&capabilityBits](const uint8_t *bitmask, size_t size) {
+        capabilityBits.insert(capabilityBits.end(), bitmask, bitmask + size);
+    };
+    append(device.evBitmask, sizeof(device.evBitmask));
+    append(device.keyBitmask, sizeof(device.keyBitmask));
+    append(device.absBitmask, sizeof(device.absBitmask));
+    append(device.relBitmask, sizeof(device.relBitmask));
+    append(device.mscBitmask, sizeof(device.mscBitmask));
+    append(device.ledBitmask, sizeof(device.ledBitmask));
+    append(device.switchBitmask, sizeof(device.switchBitmask));
+    append(device.repBitmask, sizeof(device.repBitmask));
+    append(device.propBitmask, sizeof(device.propBitmask));
+    return capabilityBits;
+}
+
+bool InputHub::LoadCachedCapability(int fd, Device &device, const std::vector<uint8_t> &capabilityBits)
+{
+    std::string key = GetCapabilityCacheKey(device.identifier);
+    {
+        std::lock_guard<std::mutex> cacheLock(capabilityCacheMutex_);
+        auto iter = capabilityCache_.find(key);
+        if (iter == capabilityCache_.end()) {
+            return false;
+        }
+        CapabilityCacheEntry &entry = iter->second;
+        if (entry.name != device.identifier.name || entry.capabilityBits != capabilityBits) {
+            DHLOGI("Capability of %{public}s changed, drop the cached one.", device.path.c_str());
+            capabilityCache_.erase(iter);
+            return false;
+        }
+        entry.lastUsed = ++capabilityCacheClock_;
+        device.identifier = entry.identifier;
+    }
+    // the axis values and ranges are not covered by the bitmasks, read them again.
+    RefreshAbsInfos(fd, device.identifier);
+    DHLOGI("Reuse cached capability for %{public}s, dhId: %{public}s", device.path.c_str(),
+        GetAnonyString(device.identifier.descriptor).c_str());
+    return true;
+}
+
+void InputHub::SaveCapabilityCache(const Device &device, std::vector<uint8_t> capabilityBits)
+{
+    std::lock_guard<std::mutex> cacheLock(capabilityCacheMutex_);
+    if (capabilityCache_.size() >= MAX_CAPABILITY_CACHE_SIZE) {
+        auto oldest = std::min_element(capabilityCache_.begin(), capabilityCache_.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.second.lastUsed < rhs.second.lastUsed; });
+        capabilityCache_.erase(oldest);
+    }
+    CapabilityCacheEntry &entry = capabilityCache_[GetCapabilityCacheKey(device.identifier)];
+    entry.name = device.identifier.name;
+    entry.capabilityBits = std::move(capabilityBits);
+    entry.identifier = device.identifier;
+    entry.lastUsed = ++capabilityCacheClock_;
+}
+
+void InputHub::RefreshAbsInfos(int fd, InputDevice &identifier)
+{
+    for (auto &[absType, absInfo] : identifier.absInfos) {
+        struct input_absinfo abs {};
+        if (deviceSource_->Ioctl(fd, EVIOCGABS(absType), &abs) < 0) {
+            continue;
+        }
+        absInfo = { abs.value, abs.minimum, abs.maximum, abs.fuzz, abs.flat, abs.resolution };
+    }
+}
+
 void InputHub::QueryEventInfo(int fd, std::unique_ptr<Device> &device)
 {
     if (device == nullptr) {
@@ -680,10 +881,10 @@ void InputHub::QueryEventInfo(int fd, std::unique_ptr<Device> &device)
     GetRELTypes(dev, device->identifier);
     GetProperties(dev, device->identifier);
 
-    GetMSCBits(fd, device);
-    GetLEDBits(fd, device);
-    GetSwitchBits(fd, device);
-    GetRepeatBits(fd, device);
+    GetMSCBits(device);
+    GetLEDBits(device);
+    GetSwitchBits(device);
+    GetRepeatBits(device);
 
     libevdev_free(dev);
 }
@@ -691,57 +892,46 @@ void InputHub::QueryEventInfo(int fd, std::unique_ptr<Device> &device)
 void InputHub::GetEventMask(int fd, const std::string &eventName, uint32_t type,
     std::size_t arrayLength, uint8_t *whichBitMask) const
 {
-    int32_t rc = ioctl(fd, EVIOCGBIT(type, arrayLength), whichBitMask);
+    int32_t rc = deviceSource_->Ioctl(fd, EVIOCGBIT(type, arrayLength), whichBitMask);
     if (rc < 0) {
         DHLOGE("Could not get events %{public}s mask: %{public}s", eventName.c_str(), strerror(errno));
     }
 }
 
-void InputHub::GetMSCBits(int fd, std::unique_ptr<Device> &device)
+void InputHub::GetMSCBits(std::unique_ptr<Device> &device)
 {
-    uint8_t mscBitmask[NBYTES(MSC_MAX)] {};
-    GetEventMask(fd, "msc", EV_MSC, sizeof(mscBitmask), mscBitmask);
-
     for (uint32_t msc = MSC_SERIAL; msc < MSC_MAX; ++msc) {
-        if (TestBit(EV_MSC, device->evBitmask) && TestBit(msc, mscBitmask)) {
+        if (TestBit(EV_MSC, device->evBitmask) && TestBit(msc, device->mscBitmask)) {
             DHLOGI("Get MSC event: %{public}d", msc);
             device->identifier.miscellaneous.push_back(msc);
         }
     }
 }
 
-void InputHub::GetLEDBits(int fd, std::unique_ptr<Device> &device)
+void InputHub::GetLEDBits(std::unique_ptr<Device> &device)
 {
-    uint8_t ledBitmask[NBYTES(LED_MAX)] {};
-    GetEventMask(fd, "led", EV_LED, sizeof(ledBitmask), ledBitmask);
     for (uint32_t led = LED_NUML; led < LED_MAX; ++led) {
-        if (TestBit(EV_LED, device->evBitmask) && TestBit(led, ledBitmask)) {
+        if (TestBit(EV_LED, device->evBitmask) && TestBit(led, device->ledBitmask)) {
             DHLOGI("Get LED event: %{public}d", led);
             device->identifier.leds.push_back(led);
         }
     }
 }
 
-void InputHub::GetSwitchBits(int fd, std::unique_ptr<Device> &device)
+void InputHub::GetSwitchBits(std::unique_ptr<Device> &device)
 {
-    uint8_t switchBitmask[NBYTES(SW_MAX)] {};
-    GetEventMask(fd, "switch", EV_SW, sizeof(switchBitmask), switchBitmask);
-
     for (uint32_t sw = SW_LID; sw < SW_MAX; ++sw) {
-        if (TestBit(EV_SW, device->evBitmask) && TestBit(sw, switchBitmask)) {
+        if (TestBit(EV_SW, device->evBitmask) && TestBit(sw, device->switchBitmask)) {
             DHLOGI("Get Switch event: %{public}d", sw);
             device->identifier.switchs.push_back(sw);
         }
     }
 }
 
-void InputHub::GetRepeatBits(int fd, std::unique_ptr<Device> &device)
+void InputHub::GetRepeatBits(std::unique_ptr<Device> &device)
 {
-    uint8_t repBitmask[NBYTES(REP_MAX)] {};
-    GetEventMask(fd, "repeat", EV_REP, sizeof(repBitmask), repBitmask);
-
     for (uint32_t rep = REP_DELAY; rep < REP_MAX; ++rep) {
-        if (TestBit(EV_REP, device->evBitmask) && TestBit(rep, repBitmask)) {
+        if (TestBit(EV_REP, device->evBitmask) && TestBit(rep, device->repBitmask)) {
             DHLOGI("Get Repeat event: %{public}d", rep);
             device->identifier.repeats.push_back(rep);
         }
@@ -750,14 +940,7 @@ void InputHub::GetRepeatBits(int fd, std::unique_ptr<Device> &device)
 
 struct libevdev* InputHub::GetLibEvDev(int fd)
 {
-    struct libevdev *dev = nullptr;
-    int rc = 1;
-    rc = libevdev_new_from_fd(fd, &dev);
-    if (rc < 0) {
-        DHLOGE("Failed to init libevdev (%{public}s)", strerror(-rc));
-        return nullptr;
-    }
-    return dev;
+    return deviceSource_->NewLibEvDev(fd);
 }
 
 void InputHub::GetEventTypes(struct libevdev *dev, InputDevice &identifier)
@@ -909,43 +1092,43 @@ int32_t InputHub::QueryLocalTouchScreenInfo(int fd, std::unique_ptr<Device> &dev
     info.localAbsInfo.deviceInfo = device->identifier;
 
     struct input_absinfo absInfo;
-    ioctl(fd, EVIOCGABS(ABS_MT_POSITION_X), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_POSITION_X), &absInfo);
     info.localAbsInfo.absXMin = absInfo.minimum;
     info.localAbsInfo.absXMax = absInfo.maximum;
     info.localAbsInfo.absMtPositionXMin = absInfo.minimum;
     info.localAbsInfo.absMtPositionXMax = absInfo.maximum;
     info.sinkPhyWidth = static_cast<uint32_t>(absInfo.maximum + 1);
 
-    ioctl(fd, EVIOCGABS(ABS_MT_POSITION_Y), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_POSITION_Y), &absInfo);
     info.localAbsInfo.absYMin = absInfo.minimum;
     info.localAbsInfo.absYMax = absInfo.maximum;
     info.localAbsInfo.absMtPositionYMin = absInfo.minimum;
     info.localAbsInfo.absMtPositionYMax = absInfo.maximum;
     info.sinkPhyHeight = static_cast<uint32_t>(absInfo.maximum + 1);
 
-    ioctl(fd, EVIOCGABS(ABS_PRESSURE), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_PRESSURE), &absInfo);
     info.localAbsInfo.absPressureMin = absInfo.minimum;
     info.localAbsInfo.absPressureMax = absInfo.maximum;
     info.localAbsInfo.absMtPressureMin = absInfo.minimum;
     info.localAbsInfo.absMtPressureMax = absInfo.maximum;
 
-    ioctl(fd, EVIOCGABS(ABS_MT_TOUCH_MAJOR), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_TOUCH_MAJOR), &absInfo);
     info.localAbsInfo.absMtTouchMajorMin = absInfo.minimum;
     info.localAbsInfo.absMtTouchMajorMax = absInfo.maximum;
 
-    ioctl(fd, EVIOCGABS(ABS_MT_TOUCH_MINOR), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_TOUCH_MINOR), &absInfo);
     info.localAbsInfo.absMtTouchMinorMin = absInfo.minimum;
     info.localAbsInfo.absMtTouchMinorMax = absInfo.maximum;
 
-    ioctl(fd, EVIOCGABS(ABS_MT_ORIENTATION), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_ORIENTATION), &absInfo);
     info.localAbsInfo.absMtOrientationMin = absInfo.minimum;
     info.localAbsInfo.absMtOrientationMax = absInfo.maximum;
 
-    ioctl(fd, EVIOCGABS(ABS_MT_BLOB_ID), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_BLOB_ID), &absInfo);
     info.localAbsInfo.absMtBlobIdMin = absInfo.minimum;
     info.localAbsInfo.absMtBlobIdMax = absInfo.maximum;
 
-    ioctl(fd, EVIOCGABS(ABS_MT_TRACKING_ID), &absInfo);
+    deviceSource_->Ioctl(fd, EVIOCGABS(ABS_MT_TRACKING_ID), &absInfo);
     info.localAbsInfo.absMtTrackingIdMin = absInfo.minimum;
     info.localAbsInfo.absMtTrackingIdMax = absInfo.maximum;
 
@@ -1593,24 +1776,25 @@ void InputHub::CheckTargetKeyState(const InputHub::Device *dev, const unsigned l
 
 void InputHub::CheckTargetDevicesState(std::vector<InputHub::Device*> targetDevices)
 {
-    uint32_t count = 0;
+    RunProbeTasks(targetDevices.size(), [this, &targetDevices](size_t index) {
+        CheckTargetDeviceState(targetDevices[index]);
+    });
+}
+
+void InputHub::CheckTargetDeviceState(const InputHub::Device *dev)
+{
+    // every device retries on its own, a node that keeps failing does not use up the others' retries.
     unsigned long keyState[NLONGS(KEY_CNT)] = { 0 };
-    for (const auto *dev : targetDevices) {
-        while (true) {
-            if (count > READ_RETRY_MAX) {
-                break;
-            }
-            // Query all key state
-            int rc = ioctl(dev->fd, EVIOCGKEY(sizeof(keyState)), keyState);
-            if (rc < 0) {
-                DHLOGE("read all key state failed, rc=%{public}d", rc);
-                count += 1;
-                std::this_thread::sleep_for(std::chrono::milliseconds(READ_SLEEP_TIME_MS));
-                continue;
-            }
-            CheckTargetKeyState(dev, keyState, NLONGS(KEY_CNT));
-            break;
+    for (uint32_t count = 0; count <= READ_RETRY_MAX; count++) {
+        // Query all key state
+        int rc = deviceSource_->Ioctl(dev->fd, EVIOCGKEY(sizeof(keyState)), keyState);
+        if (rc < 0) {
+            DHLOGE("read all key state failed, rc=%{public}d", rc);
+            std::this_thread::sleep_for(std::chrono::milliseconds(READ_SLEEP_TIME_MS));
+            continue;
         }
+        CheckTargetKeyState(dev, keyState, NLONGS(KEY_CNT));
+        return;
     }
 }
 
@@ -1640,12 +1824,6 @@ void InputHub::ClearSkipDevicePaths()
 InputHub::Device::Device(int fd, const std::string &path)
     : next(nullptr), fd(fd), path(path), identifier({}), classes(0), enabled(false),
       isShare(false), isVirtual(fd < 0) {
-    // Figure out the kinds of events the device reports.
-    DHLOGI("Ctor Device for get event mask, fd: %{public}d, path: %{public}s", fd, path.c_str());
-    ioctl(fd, EVIOCGBIT(0, sizeof(evBitmask)), evBitmask);
-    ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBitmask)), keyBitmask);
-    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBitmask)), absBitmask);
-    ioctl(fd, EVIOCGBIT(EV_REL, sizeof(relBitmask)), relBitmask);
 }
 
 InputHub::Device::~Device()
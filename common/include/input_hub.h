@@ -17,11 +17,13 @@
 #define INPUT_HUB_H
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <map>
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <libevdev/libevdev.h>
 #include <linux/input.h>
@@ -29,6 +31,7 @@
 #include <sys/inotify.h>
 
 #include "constants_dinput.h"
+#include "input_device_source.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -56,6 +59,11 @@ public:
         uint8_t keyBitmask[NBYTES(KEY_MAX)] {};
         uint8_t absBitmask[NBYTES(ABS_MAX)] {};
         uint8_t relBitmask[NBYTES(REL_MAX)] {};
+        uint8_t mscBitmask[NBYTES(MSC_MAX)] {};
+        uint8_t ledBitmask[NBYTES(LED_MAX)] {};
+        uint8_t switchBitmask[NBYTES(SW_MAX)] {};
+        uint8_t repBitmask[NBYTES(REP_MAX)] {};
+        uint8_t propBitmask[NBYTES(INPUT_PROP_MAX)] {};
 
         Device(int fd, const std::string &path);
         ~Device();
@@ -75,7 +83,10 @@ public:
         int32_t absYIndex;
     };
 
-    explicit InputHub(bool isPluginMonitor);
+    /*
+     * deviceSource: where the input device nodes come from, nullptr for the evdev nodes under /dev/input.
+     */
+    explicit InputHub(bool isPluginMonitor, std::shared_ptr<InputDeviceSource> deviceSource = nullptr);
     ~InputHub();
     size_t StartCollectInputEvents(RawEvent *buffer, size_t bufferSize);
     size_t StartCollectInputHandler(InputDeviceEvent *buffer, size_t bufferSize);
@@ -96,6 +107,11 @@ public:
         std::vector<std::string> &sharedKeyboardPaths, std::vector<std::string> &sharedKeyboardDhIds);
     bool IsAllDevicesStoped();
     void ScanInputDevices(const std::string &dirName);
+    /*
+     * The number of workers probing the input nodes and reading their key states in parallel, 1 probes
+     * the nodes one after another on the calling thread.
+     */
+    void SetProbeWorkerNum(size_t workerNum);
 
     void RecordDeviceStates();
     void CheckTargetDevicesState(std::vector<Device*> targetDevices);
@@ -119,6 +135,16 @@ private:
     int32_t RefreshEpollItem(bool isSleep);
 
     int32_t OpenInputDeviceLocked(const std::string &devicePath);
+    /*
+     * Open the node and query its capability. Only touches the new device, so nodes are probed in parallel.
+     */
+    int32_t ProbeInputDevice(const std::string &devicePath, std::unique_ptr<Device> &device);
+    /*
+     * Run task(0) .. task(taskNum - 1) on up to probeWorkerNum_ threads, the calling thread included.
+     */
+    void RunProbeTasks(size_t taskNum, const std::function<void(size_t)> &task);
+    void CheckTargetDeviceState(const Device *dev);
+    void QueryEventMask(int fd, std::unique_ptr<Device> &device);
     int32_t QueryInputDeviceInfo(int fd, std::unique_ptr<Device> &device);
     void QueryEventInfo(int fd, std::unique_ptr<Device> &device);
     struct libevdev* GetLibEvDev(int fd);
@@ -128,10 +154,22 @@ private:
     int32_t GetRELTypes(struct libevdev *dev, InputDevice &identifier);
     void GetProperties(struct libevdev *dev, InputDevice &identifier);
 
-    void GetMSCBits(int fd, std::unique_ptr<Device> &device);
-    void GetLEDBits(int fd, std::unique_ptr<Device> &device);
-    void GetSwitchBits(int fd, std::unique_ptr<Device> &device);
-    void GetRepeatBits(int fd, std::unique_ptr<Device> &device);
+    /*
+     * The capability cache lets a reopened node of a known peripheral skip the libevdev walk and the
+     * descriptor hash. An entry is only reused while the name and every EVIOCGBIT/EVIOCGPROP result
+     * the capability was probed from are unchanged.
+     */
+    std::string GetCapabilityCacheKey(const InputDevice &identifier) const;
+    std::vector<uint8_t> QueryCapabilityBits(int fd, Device &device);
+    bool LoadCachedCapability(int fd, Device &device, const std::vector<uint8_t> &capabilityBits);
+    void SaveCapabilityCache(const Device &device, std::vector<uint8_t> capabilityBits);
+    void RefreshAbsInfos(int fd, InputDevice &identifier);
+
+    // read from the bitmasks QueryCapabilityBits fetched, the ioctls are not issued again.
+    void GetMSCBits(std::unique_ptr<Device> &device);
+    void GetLEDBits(std::unique_ptr<Device> &device);
+    void GetSwitchBits(std::unique_ptr<Device> &device);
+    void GetRepeatBits(std::unique_ptr<Device> &device);
 
     void GetEventMask(int fd, const std::string &eventName, uint32_t type,
         std::size_t arrayLength, uint8_t *whichBitMask) const;
@@ -218,6 +256,7 @@ private:
      * false: for read device events.
      */
     bool isPluginMonitor_;
+    std::shared_ptr<InputDeviceSource> deviceSource_;
 
     std::vector<std::unique_ptr<Device>> openingDevices_;
     std::vector<std::unique_ptr<Device>> closingDevices_;
@@ -242,7 +281,21 @@ private:
     std::atomic<bool> isStartCollectEvent_;
     std::atomic<bool> isStartCollectHandler_;
     std::unordered_map<std::string, bool> sharedDHIds_;
+    mutable std::mutex logTimesMutex_;
     std::unordered_map<std::string, int32_t> logTimesMap_;
+    std::atomic<size_t> probeWorkerNum_;
+
+    struct CapabilityCacheEntry {
+        std::string name;
+        std::vector<uint8_t> capabilityBits;
+        // the probed capability and descriptor, the per-open fields are overwritten on reuse.
+        InputDevice identifier;
+        uint64_t lastUsed = 0;
+    };
+    // the key is made of bus, vendor, product, version, phys and uniq.
+    std::mutex capabilityCacheMutex_;
+    std::unordered_map<std::string, CapabilityCacheEntry> capabilityCache_;
+    uint64_t capabilityCacheClock_ = 0;
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
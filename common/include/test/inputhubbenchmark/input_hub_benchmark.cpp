@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <linux/input.h>
+
+#include "dinput_context.h"
+#include "fake_input_device_source.h"
+#include "input_hub.h"
+
+using namespace OHOS::DistributedHardware::DistributedInput;
+
+namespace {
+enum class Workload {
+    KEYBOARD = 0,
+    MOUSE,
+    TOUCHPAD,
+    TOUCHSCREEN,
+};
+
+constexpr uint32_t FINGER_NUM = 10;
+constexpr int32_t ABS_POSITION_MAX = 4095;
+constexpr int32_t FINGER_STEP = 300;
+constexpr int32_t PROJECTION_SIZE = 4096;
+const std::string DEVICE_PATH_PREFIX = "/dev/input/event";
+const std::string SCREEN_INFO_KEY = "benchmark_screen";
+
+input_event MakeEvent(uint16_t type, uint16_t code, int32_t value)
+{
+    input_event event {};
+    event.type = type;
+    event.code = code;
+    event.value = value;
+    return event;
+}
+
+FakeInputDeviceConfig MakeKeyboardConfig()
+{
+    FakeInputDeviceConfig config;
+    config.name = "fake keyboard";
+    config.id = { BUS_USB, 0x1, 0x1, 0x1 };
+    for (uint32_t key = KEY_ESC; key <= KEY_KPDOT; key++) {
+        config.codes[EV_KEY].push_back(key);
+    }
+    config.codes[EV_MSC] = { MSC_SCAN };
+    return config;
+}
+
+std::vector<input_event> MakeKeyboardFrame()
+{
+    return {
+        MakeEvent(EV_MSC, MSC_SCAN, KEY_A), MakeEvent(EV_KEY, KEY_A, 1), MakeEvent(EV_SYN, SYN_REPORT, 0),
+        MakeEvent(EV_MSC, MSC_SCAN, KEY_A), MakeEvent(EV_KEY, KEY_A, 0), MakeEvent(EV_SYN, SYN_REPORT, 0),
+    };
+}
+
+FakeInputDeviceConfig MakeMouseConfig()
+{
+    FakeInputDeviceConfig config;
+    config.name = "fake pointer";
+    config.id = { BUS_USB, 0x2, 0x2, 0x1 };
+    config.codes[EV_KEY] = { BTN_MOUSE, BTN_RIGHT, BTN_MIDDLE };
+    config.codes[EV_REL] = { REL_X, REL_Y, REL_WHEEL };
+    return config;
+}
+
+std::vector<input_event> MakeMouseFrame()
+{
+    return { MakeEvent(EV_REL, REL_X, 1), MakeEvent(EV_REL, REL_Y, -1), MakeEvent(EV_SYN, SYN_REPORT, 0) };
+}
+
+FakeInputDeviceConfig MakeTouchConfig(const std::string &name, uint16_t product)
+{
+    FakeInputDeviceConfig config;
+    config.name = name;
+    config.id = { BUS_I2C, 0x3, product, 0x1 };
+    config.codes[EV_KEY] = { BTN_TOUCH, BTN_TOOL_FINGER };
+    config.codes[EV_ABS] = { ABS_X, ABS_Y, ABS_MT_SLOT, ABS_MT_TRACKING_ID, ABS_MT_POSITION_X, ABS_MT_POSITION_Y };
+    for (uint32_t code : config.codes[EV_ABS]) {
+        config.absInfos[code] = { 0, 0, ABS_POSITION_MAX, 0, 0, 0 };
+    }
+    config.absInfos[ABS_MT_SLOT].maximum = FINGER_NUM - 1;
+    config.properties = { INPUT_PROP_DIRECT };
+    return config;
+}
+
+std::vector<input_event> MakeTouchPadFrame()
+{
+    return {
+        MakeEvent(EV_ABS, ABS_MT_SLOT, 0), MakeEvent(EV_ABS, ABS_MT_POSITION_X, 100),
+        MakeEvent(EV_ABS, ABS_MT_POSITION_Y, 200), MakeEvent(EV_ABS, ABS_X, 100),
+        MakeEvent(EV_ABS, ABS_Y, 200), MakeEvent(EV_SYN, SYN_REPORT, 0),
+    };
+}
+
+std::vector<input_event> MakeTouchScreenFrame()
+{
+    std::vector<input_event> frame;
+    for (uint32_t finger = 0; finger < FINGER_NUM; finger++) {
+        int32_t position = static_cast<int32_t>(finger) * FINGER_STEP;
+        frame.push_back(MakeEvent(EV_ABS, ABS_MT_SLOT, static_cast<int32_t>(finger)));
+        frame.push_back(MakeEvent(EV_ABS, ABS_MT_TRACKING_ID, static_cast<int32_t>(finger)));
+        frame.push_back(MakeEvent(EV_ABS, ABS_MT_POSITION_X, position));
+        frame.push_back(MakeEvent(EV_ABS, ABS_MT_POSITION_Y, position));
+    }
+    frame.push_back(MakeEvent(EV_KEY, BTN_TOUCH, 1));
+    frame.push_back(MakeEvent(EV_SYN, SYN_REPORT, 0));
+    return frame;
+}
+
+/*
+ * One InputHub per workload, reading a single shared fake device.
+ */
+class InputHubBench {
+public:
+    explicit InputHubBench(Workload workload)
+    {
+        FakeInputDeviceConfig config;
+        switch (workload) {
+            case Workload::KEYBOARD:
+                config = MakeKeyboardConfig();
+                frame_ = MakeKeyboardFrame();
+                break;
+            case Workload::MOUSE:
+                config = MakeMouseConfig();
+                frame_ = MakeMouseFrame();
+                break;
+            case Workload::TOUCHPAD:
+                config = MakeTouchConfig("fake touchpad", 0x3);
+                frame_ = MakeTouchPadFrame();
+                break;
+            case Workload::TOUCHSCREEN:
+                config = MakeTouchConfig("fake touchscreen", 0x4);
+                frame_ = MakeTouchScreenFrame();
+                AddProjectionScreen();
+                break;
+        }
+        config.path = DEVICE_PATH_PREFIX + std::to_string(static_cast<int32_t>(workload));
+        path_ = config.path;
+        source_ = std::make_shared<FakeInputDeviceSource>();
+        source_->AddDevice(config);
+        hub_ = std::make_unique<InputHub>(false, source_);
+        hub_->ScanAndRecordInputDevices();
+        device_ = hub_->GetDeviceByPathLocked(path_);
+        if (device_ != nullptr) {
+            hub_->SetSharingDevices(true, { device_->identifier.descriptor });
+        }
+    }
+
+    static InputHubBench &Get(Workload workload)
+    {
+        static InputHubBench benches[] = {
+            InputHubBench(Workload::KEYBOARD), InputHubBench(Workload::MOUSE),
+            InputHubBench(Workload::TOUCHPAD), InputHubBench(Workload::TOUCHSCREEN),
+        };
+        return benches[static_cast<size_t>(workload)];
+    }
+
+    static void AddProjectionScreen()
+    {
+        SinkScreenInfo sinkScreenInfo;
+        sinkScreenInfo.transformInfo.sinkProjPhyWidth = PROJECTION_SIZE;
+        sinkScreenInfo.transformInfo.sinkProjPhyHeight = PROJECTION_SIZE;
+        sinkScreenInfo.transformInfo.coeffWidth = 1.0;
+        sinkScreenInfo.transformInfo.coeffHeight = 1.0;
+        sinkScreenInfo.srcScreenInfo.sourcePhyId = "benchmark_phy_id";
+        DInputContext::GetInstance().sinkScreenInfoMap_[SCREEN_INFO_KEY] = sinkScreenInfo;
+    }
+
+    std::shared_ptr<FakeInputDeviceSource> source_;
+    std::unique_ptr<InputHub> hub_;
+    InputHub::Device *device_ = nullptr;
+    std::string path_;
+    std::vector<input_event> frame_;
+};
+
+void SetEventCounters(benchmark::State &state, size_t frameSize)
+{
+    int64_t events = state.iterations() * static_cast<int64_t>(frameSize);
+    state.SetItemsProcessed(events);
+    state.counters["time_per_event"] = benchmark::Counter(static_cast<double>(events),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+void BM_CollectEvent(benchmark::State &state, Workload workload)
+{
+    InputHubBench &bench = InputHubBench::Get(workload);
+    if (bench.device_ == nullptr) {
+        state.SkipWithError("fake device is not recognized");
+        return;
+    }
+    std::vector<input_event> readBuffer(bench.frame_.size());
+    RawEvent buffer[INPUT_EVENT_BUFFER_SIZE];
+    for (auto _ : state) {
+        // HandleTouchScreenEvent rewrites the positions in place, start every round from the raw frame.
+        std::copy(bench.frame_.begin(), bench.frame_.end(), readBuffer.begin());
+        size_t capacity = INPUT_EVENT_BUFFER_SIZE;
+        benchmark::DoNotOptimize(bench.hub_->CollectEvent(buffer, capacity, bench.device_, readBuffer.data(),
+            readBuffer.size()));
+    }
+    SetEventCounters(state, bench.frame_.size());
+}
+
+void BM_RecordDeviceChangeStates(benchmark::State &state, Workload workload)
+{
+    InputHubBench &bench = InputHubBench::Get(workload);
+    if (bench.device_ == nullptr) {
+        state.SkipWithError("fake device is not recognized");
+        return;
+    }
+    std::vector<input_event> readBuffer = bench.frame_;
+    for (auto _ : state) {
+        bench.hub_->RecordDeviceChangeStates(bench.device_, readBuffer.data(), readBuffer.size());
+    }
+    SetEventCounters(state, bench.frame_.size());
+}
+
+void BM_StartCollectInputEvents(benchmark::State &state, Workload workload)
+{
+    InputHubBench &bench = InputHubBench::Get(workload);
+    if (bench.device_ == nullptr) {
+        state.SkipWithError("fake device is not recognized");
+        return;
+    }
+    RawEvent buffer[INPUT_EVENT_BUFFER_SIZE];
+    for (auto _ : state) {
+        size_t pending = bench.source_->WriteEvents(bench.path_, bench.frame_);
+        while (pending > 0) {
+            size_t count = bench.hub_->StartCollectInputEvents(buffer, INPUT_EVENT_BUFFER_SIZE);
+            if (count == 0) {
+                state.SkipWithError("events lost in the fake device");
+                return;
+            }
+            pending -= std::min(pending, count);
+        }
+    }
+    SetEventCounters(state, bench.frame_.size());
+}
+}
+
+BENCHMARK_CAPTURE(BM_CollectEvent, keyboard, Workload::KEYBOARD);
+BENCHMARK_CAPTURE(BM_CollectEvent, mouse, Workload::MOUSE);
+BENCHMARK_CAPTURE(BM_CollectEvent, touchpad, Workload::TOUCHPAD);
+BENCHMARK_CAPTURE(BM_CollectEvent, touchscreen_ten_finger, Workload::TOUCHSCREEN);
+
+BENCHMARK_CAPTURE(BM_RecordDeviceChangeStates, keyboard, Workload::KEYBOARD);
+BENCHMARK_CAPTURE(BM_RecordDeviceChangeStates, mouse, Workload::MOUSE);
+BENCHMARK_CAPTURE(BM_RecordDeviceChangeStates, touchpad, Workload::TOUCHPAD);
+BENCHMARK_CAPTURE(BM_RecordDeviceChangeStates, touchscreen_ten_finger, Workload::TOUCHSCREEN);
+
+BENCHMARK_CAPTURE(BM_StartCollectInputEvents, keyboard, Workload::KEYBOARD);
+BENCHMARK_CAPTURE(BM_StartCollectInputEvents, mouse, Workload::MOUSE);
+BENCHMARK_CAPTURE(BM_StartCollectInputEvents, touchpad, Workload::TOUCHPAD);
+BENCHMARK_CAPTURE(BM_StartCollectInputEvents, touchscreen_ten_finger, Workload::TOUCHSCREEN);
+
+BENCHMARK_MAIN();
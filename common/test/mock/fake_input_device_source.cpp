@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fake_input_device_source.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "constants_dinput.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint32_t BITS_PER_BYTE = 8;
+    constexpr uint32_t EVIOC_NR_VERSION = _IOC_NR(EVIOCGVERSION);
+    constexpr uint32_t EVIOC_NR_ID = _IOC_NR(EVIOCGID);
+    constexpr uint32_t EVIOC_NR_NAME = _IOC_NR(EVIOCGNAME(0));
+    constexpr uint32_t EVIOC_NR_PHYS = _IOC_NR(EVIOCGPHYS(0));
+    constexpr uint32_t EVIOC_NR_UNIQ = _IOC_NR(EVIOCGUNIQ(0));
+    constexpr uint32_t EVIOC_NR_PROP = _IOC_NR(EVIOCGPROP(0));
+    constexpr uint32_t EVIOC_NR_KEY = _IOC_NR(EVIOCGKEY(0));
+    constexpr uint32_t EVIOC_NR_BIT_BASE = _IOC_NR(EVIOCGBIT(0, 0));
+    constexpr uint32_t EVIOC_NR_ABS_BASE = _IOC_NR(EVIOCGABS(0));
+}
+
+FakeInputDeviceSource::~FakeInputDeviceSource()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[path, device] : devices_) {
+        CloseDeviceLocked(device);
+    }
+    devices_.clear();
+}
+
+void FakeInputDeviceSource::AddDevice(const FakeInputDeviceConfig &config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FakeDevice &device = devices_[config.path];
+    CloseDeviceLocked(device);
+    device.config = config;
+}
+
+void FakeInputDeviceSource::RemoveDevice(const std::string &devicePath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(devicePath);
+    if (iter == devices_.end()) {
+        return;
+    }
+    CloseDeviceLocked(iter->second);
+    devices_.erase(iter);
+}
+
+size_t FakeInputDeviceSource::WriteEvents(const std::string &devicePath,
+    const std::vector<struct input_event> &events)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(devicePath);
+    if (iter == devices_.end() || iter->second.writeFd < 0 || events.empty()) {
+        return 0;
+    }
+    ssize_t ret = send(iter->second.writeFd, events.data(), events.size() * sizeof(struct input_event),
+        MSG_NOSIGNAL);
+    if (ret < 0) {
+        return 0;
+    }
+    return static_cast<size_t>(ret) / sizeof(struct input_event);
+}
+
+void FakeInputDeviceSource::ScanDevicePaths(const std::string &dirName, std::vector<std::string> &devicePaths)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &[path, device] : devices_) {
+        if (path.compare(0, dirName.size(), dirName) == 0) {
+            devicePaths.push_back(path);
+        }
+    }
+}
+
+int32_t FakeInputDeviceSource::OpenDevice(const std::string &devicePath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(devicePath);
+    if (iter == devices_.end()) {
+        return UN_INIT_FD_VALUE;
+    }
+    CloseDeviceLocked(iter->second);
+    int fds[2] = { -1, -1 };
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) {
+        return UN_INIT_FD_VALUE;
+    }
+    iter->second.readFd = fds[0];
+    iter->second.writeFd = fds[1];
+    return fds[0];
+}
+
+int32_t FakeInputDeviceSource::Ioctl(int32_t fd, unsigned long request, void *arg)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FakeDevice *device = GetDeviceByFdLocked(fd);
+    if (device == nullptr || arg == nullptr || _IOC_TYPE(request) != 'E') {
+        errno = ENOTTY;
+        return -1;
+    }
+    const FakeInputDeviceConfig &config = device->config;
+    uint32_t nr = _IOC_NR(request);
+    size_t size = _IOC_SIZE(request);
+    if (nr == EVIOC_NR_VERSION) {
+        *static_cast<int *>(arg) = EV_VERSION;
+        return 0;
+    }
+    if (nr == EVIOC_NR_ID) {
+        *static_cast<struct input_id *>(arg) = config.id;
+        return 0;
+    }
+    if (nr == EVIOC_NR_NAME) {
+        return CopyString(config.name, size, arg);
+    }
+    if (nr == EVIOC_NR_PHYS) {
+        return CopyString(config.phys, size, arg);
+    }
+    if (nr == EVIOC_NR_UNIQ) {
+        return CopyString(config.uniq, size, arg);
+    }
+    if (nr == EVIOC_NR_PROP) {
+        return CopyBits(config.properties, size, arg);
+    }
+    if (nr == EVIOC_NR_KEY) {
+        return CopyBits(config.pressedKeys, size, arg);
+    }
+    if (nr == EVIOC_NR_BIT_BASE) {
+        std::vector<uint32_t> types = { EV_SYN };
+        for (const auto &[type, codes] : config.codes) {
+            types.push_back(type);
+        }
+        return CopyBits(types, size, arg);
+    }
+    if (nr > EVIOC_NR_BIT_BASE && nr < EVIOC_NR_BIT_BASE + EV_CNT) {
+        auto iter = config.codes.find(nr - EVIOC_NR_BIT_BASE);
+        return CopyBits(iter == config.codes.end() ? std::vector<uint32_t>() : iter->second, size, arg);
+    }
+    if (nr >= EVIOC_NR_ABS_BASE && nr < EVIOC_NR_ABS_BASE + ABS_CNT) {
+        auto iter = config.absInfos.find(nr - EVIOC_NR_ABS_BASE);
+        *static_cast<struct input_absinfo *>(arg) =
+            (iter == config.absInfos.end()) ? input_absinfo {} : iter->second;
+        return 0;
+    }
+    errno = ENOTTY;
+    return -1;
+}
+
+struct libevdev *FakeInputDeviceSource::NewLibEvDev(int32_t fd)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FakeDevice *device = GetDeviceByFdLocked(fd);
+    if (device == nullptr) {
+        return nullptr;
+    }
+    const FakeInputDeviceConfig &config = device->config;
+    struct libevdev *dev = libevdev_new();
+    if (dev == nullptr) {
+        return nullptr;
+    }
+    libevdev_set_name(dev, config.name.c_str());
+    libevdev_set_phys(dev, config.phys.c_str());
+    libevdev_set_uniq(dev, config.uniq.c_str());
+    libevdev_set_id_bustype(dev, config.id.bustype);
+    libevdev_set_id_vendor(dev, config.id.vendor);
+    libevdev_set_id_product(dev, config.id.product);
+    libevdev_set_id_version(dev, config.id.version);
+    for (const auto &[type, codes] : config.codes) {
+        // EV_REP codes carry the repeat settings as data, they are not scripted.
+        if (type == EV_REP) {
+            libevdev_enable_event_type(dev, type);
+            continue;
+        }
+        for (uint32_t code : codes) {
+            auto absIter = config.absInfos.find(code);
+            const void *data = (type == EV_ABS && absIter != config.absInfos.end()) ? &absIter->second : nullptr;
+            struct input_absinfo emptyAbsInfo {};
+            if (type == EV_ABS && data == nullptr) {
+                data = &emptyAbsInfo;
+            }
+            libevdev_enable_event_code(dev, type, code, data);
+        }
+    }
+    for (uint32_t prop : config.properties) {
+        libevdev_enable_property(dev, prop);
+    }
+    return dev;
+}
+
+FakeInputDeviceSource::FakeDevice *FakeInputDeviceSource::GetDeviceByFdLocked(int32_t fd)
+{
+    for (auto &[path, device] : devices_) {
+        if (device.readFd == fd) {
+            return &device;
+        }
+    }
+    return nullptr;
+}
+
+void FakeInputDeviceSource::CloseDeviceLocked(FakeDevice &device)
+{
+    if (device.writeFd >= 0) {
+        close(device.writeFd);
+    }
+    device.writeFd = -1;
+    device.readFd = -1;
+}
+
+int32_t FakeInputDeviceSource::CopyString(const std::string &str, size_t size, void *arg)
+{
+    if (str.empty()) {
+        errno = ENOENT;
+        return -1;
+    }
+    size_t len = std::min(str.size() + 1, size);
+    if (len == 0) {
+        return 0;
+    }
+    char *buffer = static_cast<char *>(arg);
+    std::copy_n(str.c_str(), len - 1, buffer);
+    buffer[len - 1] = '\0';
+    return static_cast<int32_t>(len);
+}
+
+int32_t FakeInputDeviceSource::CopyBits(const std::vector<uint32_t> &bits, size_t size, void *arg)
+{
+    uint8_t *bitmask = static_cast<uint8_t *>(arg);
+    std::fill_n(bitmask, size, 0);
+    for (uint32_t bit : bits) {
+        if (bit / BITS_PER_BYTE < size) {
+            bitmask[bit / BITS_PER_BYTE] |= static_cast<uint8_t>(1 << (bit % BITS_PER_BYTE));
+        }
+    }
+    return static_cast<int32_t>(size);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
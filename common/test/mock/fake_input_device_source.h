@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FAKE_INPUT_DEVICE_SOURCE_H
+#define FAKE_INPUT_DEVICE_SOURCE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <linux/input.h>
+
+#include "input_device_source.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * The scripted capabilities of one fake input device node.
+ */
+struct FakeInputDeviceConfig {
+    std::string path;
+    std::string name;
+    struct input_id id {};
+    std::string phys;
+    std::string uniq;
+    // the map's key is the event type, the value is the supported codes of the type.
+    std::map<uint32_t, std::vector<uint32_t>> codes;
+    // the map's key is the abs code.
+    std::map<uint32_t, struct input_absinfo> absInfos;
+    std::vector<uint32_t> properties;
+    std::vector<uint32_t> pressedKeys;
+};
+
+/*
+ * In-memory device source for tests and benchmarks. Every opened node is one end of a non-blocking
+ * unix socket pair, so InputHub polls and reads it exactly like an evdev node, while the events
+ * are scripted through WriteEvents. Ioctl and NewLibEvDev answer from the config.
+ */
+class FakeInputDeviceSource : public InputDeviceSource {
+public:
+    ~FakeInputDeviceSource() override;
+
+    void AddDevice(const FakeInputDeviceConfig &config);
+    void RemoveDevice(const std::string &devicePath);
+    /*
+     * Write the events to the opened node of devicePath, return the number of events written.
+     */
+    size_t WriteEvents(const std::string &devicePath, const std::vector<struct input_event> &events);
+
+    void ScanDevicePaths(const std::string &dirName, std::vector<std::string> &devicePaths) override;
+    int32_t OpenDevice(const std::string &devicePath) override;
+    int32_t Ioctl(int32_t fd, unsigned long request, void *arg) override;
+    struct libevdev *NewLibEvDev(int32_t fd) override;
+
+private:
+    struct FakeDevice {
+        FakeInputDeviceConfig config;
+        // owned by InputHub once opened.
+        int32_t readFd = -1;
+        int32_t writeFd = -1;
+    };
+    FakeDevice *GetDeviceByFdLocked(int32_t fd);
+    void CloseDeviceLocked(FakeDevice &device);
+    static int32_t CopyString(const std::string &str, size_t size, void *arg);
+    static int32_t CopyBits(const std::vector<uint32_t> &bits, size_t size, void *arg);
+
+    std::mutex mutex_;
+    // the map's key is the device path.
+    std::map<std::string, FakeDevice> devices_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // FAKE_INPUT_DEVICE_SOURCE_H
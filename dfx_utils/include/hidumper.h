@@ -26,6 +26,7 @@
 #include <sys/inotify.h>
 
 #include "constants_dinput.h"
+#include "dinput_latency_histogram.h"
 #include "single_instance.h"
 
 namespace OHOS {
@@ -35,6 +36,17 @@ enum class HiDumperFlag {
     GET_HELP = 0,
     GET_NODE_INFO,
     GET_SESSION_INFO,
+    GET_LATENCY_INFO,
+    START_LATENCY_TRACE,
+    STOP_LATENCY_TRACE,
+    GET_LATENCY_TRACE_INFO,
+    GET_METRICS_INFO,
+    GET_METRICS_JSON,
+    START_EVENT_RECORD,
+    STOP_EVENT_RECORD,
+    START_EVENT_REPLAY,
+    STOP_EVENT_REPLAY,
+    GET_POOL_INFO,
 };
 
 struct NodeInfo {
@@ -43,6 +55,13 @@ struct NodeInfo {
     std::string inputDhId = "";
 };
 
+struct PooledNodeInfo {
+    std::string devId = "";
+    std::string virNodeName = "";
+    std::string inputDhId = "";
+    uint64_t parkTime = 0;
+};
+
 struct SessionInfo {
     int32_t sesId = 0;
     std::string mySesName = "";
@@ -50,6 +69,16 @@ struct SessionInfo {
     SessionStatus sessionState = SessionStatus::CLOSED;
 };
 
+struct LatencyInfo {
+    uint32_t sendNum = 0;
+    uint32_t recvNum = 0;
+    LatencySummary rtt;
+    // the clock of the sink relative to the local one, estimated from the probes.
+    bool hasClockEstimate = false;
+    int64_t clockOffsetUs = 0;
+    double clockDriftPpm = 0;
+};
+
 class HiDumper {
 DECLARE_SINGLE_INSTANCE_BASE(HiDumper);
 
@@ -57,24 +86,48 @@ public:
     bool HiDump(const std::vector<std::string> &args, std::string &result);
     void SaveNodeInfo(const std::string &deviceId, const std::string &nodeName, const std::string &dhId);
     void DeleteNodeInfo(const std::string &deviceId, const std::string &dhId);
+    void SavePooledNodeInfo(const std::string &deviceId, const std::string &nodeName, const std::string &dhId,
+        uint64_t parkTime);
+    void DeletePooledNodeInfo(const std::string &deviceId, const std::string &dhId);
     void CreateSessionInfo(const std::string &remoteDevId, const int32_t &sessionId, const std::string &mySessionName,
         const std::string &peerSessionName, const SessionStatus &sessionStatus);
     void SetSessionStatus(const std::string &remoteDevId, const SessionStatus &sessionStatus);
     void DeleteSessionInfo(const std::string &remoteDevId);
+    void SaveLatencyInfo(const std::string &remoteDevId, const LatencyInfo &latencyInfo);
+    void DeleteLatencyInfo(const std::string &remoteDevId);
 private:
     explicit HiDumper() = default;
     ~HiDumper() = default;
-    int32_t ProcessDump(const std::string &args, std::string &result);
+    int32_t ProcessDump(const std::vector<std::string> &args, std::string &result);
     int32_t GetAllNodeInfos(std::string &result);
+    int32_t GetPooledNodeInfos(std::string &result);
     int32_t GetSessionInfo(std::string &result);
+    int32_t GetLatencyInfo(std::string &result);
+    int32_t SetLatencyTraceEnabled(bool enabled, std::string &result);
+    int32_t GetLatencyTraceInfo(std::string &result);
+    int32_t GetMetricsInfo(std::string &result);
+    int32_t GetMetricsJson(std::string &result);
+#ifdef DINPUT_EVENT_RECORD
+    int32_t StartEventRecord(const std::vector<std::string> &args, std::string &result);
+    int32_t StopEventRecord(std::string &result);
+    int32_t StartEventReplay(const std::vector<std::string> &args, std::string &result);
+    int32_t StopEventReplay(std::string &result);
+#endif
     int32_t ShowHelp(std::string &result);
 private:
     std::vector<NodeInfo> nodeInfos_;
     std::mutex nodeMutex_;
 
+    // the virtual nodes parked in the source's pool, guarded by nodeMutex_.
+    std::vector<PooledNodeInfo> pooledNodeInfos_;
+
     // the unordered_map's key is remoteDevId.
     std::unordered_map<std::string, SessionInfo> sessionInfos_;
     std::mutex sessionMutex_;
+
+    // the unordered_map's key is remoteDevId.
+    std::unordered_map<std::string, LatencyInfo> latencyInfos_;
+    std::mutex latencyMutex_;
     std::mutex operationMutex_;
 };
 } // namespace DistributedInput
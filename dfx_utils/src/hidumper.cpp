@@ -15,8 +15,18 @@
 
 #include "hidumper.h"
 
+#include <algorithm>
+#include <cstdlib>
+
+#include "nlohmann/json.hpp"
+
 #include "dinput_errcode.h"
+#ifdef DINPUT_EVENT_RECORD
+#include "dinput_event_record.h"
+#endif
+#include "dinput_latency_trace.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_softbus_define.h"
 #include "dinput_utils_tool.h"
 
@@ -28,11 +38,44 @@ namespace {
     const std::string ARGS_HELP = "-h";
     const std::string ARGS_NODE_INFO = "-nodeinfo";
     const std::string ARGS_SESSION_INFO = "-sessioninfo";
+    const std::string ARGS_LATENCY_INFO = "-latencyinfo";
+    const std::string ARGS_TRACE_START = "-tracestart";
+    const std::string ARGS_TRACE_STOP = "-tracestop";
+    const std::string ARGS_TRACE_INFO = "-traceinfo";
+    const std::string ARGS_METRICS = "-metrics";
+    const std::string ARGS_METRICS_JSON = "-metricsjson";
+    const std::string ARGS_POOL_INFO = "-poolinfo";
+#ifdef DINPUT_EVENT_RECORD
+    const std::string ARGS_RECORD_START = "-recordstart";
+    const std::string ARGS_RECORD_STOP = "-recordstop";
+    const std::string ARGS_REPLAY = "-replay";
+    const std::string ARGS_REPLAY_STOP = "-replaystop";
+    const std::string REPLAY_SPEED_MAX = "max";
+    constexpr size_t ARGS_FILE_NAME_INDEX = 1;
+    constexpr size_t ARGS_REPLAY_SPEED_INDEX = 2;
+#endif
+    constexpr uint64_t US_PER_MS = 1000;
+    // every dump command keeps its own rate window.
+    const std::string METRICS_READER_TEXT = "hidumper_text";
+    const std::string METRICS_READER_JSON = "hidumper_json";
 
     const std::map<std::string, HiDumperFlag> ARGS_MAP = {
         {ARGS_HELP, HiDumperFlag::GET_HELP},
         {ARGS_NODE_INFO, HiDumperFlag::GET_NODE_INFO},
         {ARGS_SESSION_INFO, HiDumperFlag::GET_SESSION_INFO},
+        {ARGS_LATENCY_INFO, HiDumperFlag::GET_LATENCY_INFO},
+        {ARGS_TRACE_START, HiDumperFlag::START_LATENCY_TRACE},
+        {ARGS_TRACE_STOP, HiDumperFlag::STOP_LATENCY_TRACE},
+        {ARGS_TRACE_INFO, HiDumperFlag::GET_LATENCY_TRACE_INFO},
+        {ARGS_METRICS, HiDumperFlag::GET_METRICS_INFO},
+        {ARGS_METRICS_JSON, HiDumperFlag::GET_METRICS_JSON},
+        {ARGS_POOL_INFO, HiDumperFlag::GET_POOL_INFO},
+#ifdef DINPUT_EVENT_RECORD
+        {ARGS_RECORD_START, HiDumperFlag::START_EVENT_RECORD},
+        {ARGS_RECORD_STOP, HiDumperFlag::STOP_EVENT_RECORD},
+        {ARGS_REPLAY, HiDumperFlag::START_EVENT_REPLAY},
+        {ARGS_REPLAY_STOP, HiDumperFlag::STOP_EVENT_REPLAY},
+#endif
     };
 
     const std::map<SessionStatus, std::string> SESSION_STATUS = {
@@ -40,6 +83,7 @@ namespace {
         {SessionStatus::OPENING, "opening"},
         {SessionStatus::OPENED, "opened"},
         {SessionStatus::CLOSING, "closing"},
+        {SessionStatus::IDLE, "idle"},
     };
 }
 
@@ -55,13 +99,13 @@ bool HiDumper::HiDump(const std::vector<std::string> &args, std::string &result)
     for (int32_t i = 0; i < argsSize; i++) {
         DHLOGI("HiDumper Dump args[%{public}d]: %{public}s.", i, args.at(i).c_str());
     }
-    if (ProcessDump(args[0], result) != DH_SUCCESS) {
+    if (ProcessDump(args, result) != DH_SUCCESS) {
         return false;
     }
     return true;
 }
 
-int32_t HiDumper::ProcessDump(const std::string &args, std::string &result)
+int32_t HiDumper::ProcessDump(const std::vector<std::string> &args, std::string &result)
 {
     DHLOGI("ProcessDump Dump.");
     int32_t ret = ERR_DH_INPUT_HIDUMP_INVALID_ARGS;
@@ -70,7 +114,7 @@ int32_t HiDumper::ProcessDump(const std::string &args, std::string &result)
     std::map<std::string, HiDumperFlag>::const_iterator operatorIter;
     {
         std::lock_guard<std::mutex> lock(operationMutex_);
-        operatorIter = ARGS_MAP.find(args);
+        operatorIter = ARGS_MAP.find(args[0]);
         if (operatorIter == ARGS_MAP.end()) {
             result.append("unknown command");
             DHLOGI("ProcessDump");
@@ -92,6 +136,52 @@ int32_t HiDumper::ProcessDump(const std::string &args, std::string &result)
             ret = GetSessionInfo(result);
             break;
         }
+        case HiDumperFlag::GET_LATENCY_INFO: {
+            ret = GetLatencyInfo(result);
+            break;
+        }
+        case HiDumperFlag::START_LATENCY_TRACE: {
+            ret = SetLatencyTraceEnabled(true, result);
+            break;
+        }
+        case HiDumperFlag::STOP_LATENCY_TRACE: {
+            ret = SetLatencyTraceEnabled(false, result);
+            break;
+        }
+        case HiDumperFlag::GET_LATENCY_TRACE_INFO: {
+            ret = GetLatencyTraceInfo(result);
+            break;
+        }
+        case HiDumperFlag::GET_METRICS_INFO: {
+            ret = GetMetricsInfo(result);
+            break;
+        }
+        case HiDumperFlag::GET_METRICS_JSON: {
+            ret = GetMetricsJson(result);
+            break;
+        }
+#ifdef DINPUT_EVENT_RECORD
+        case HiDumperFlag::START_EVENT_RECORD: {
+            ret = StartEventRecord(args, result);
+            break;
+        }
+        case HiDumperFlag::STOP_EVENT_RECORD: {
+            ret = StopEventRecord(result);
+            break;
+        }
+        case HiDumperFlag::START_EVENT_REPLAY: {
+            ret = StartEventReplay(args, result);
+            break;
+        }
+        case HiDumperFlag::STOP_EVENT_REPLAY: {
+            ret = StopEventReplay(result);
+            break;
+        }
+#endif
+        case HiDumperFlag::GET_POOL_INFO: {
+            ret = GetPooledNodeInfos(result);
+            break;
+        }
         default:
             break;
     }
@@ -128,6 +218,48 @@ void HiDumper::DeleteNodeInfo(const std::string &deviceId, const std::string &dh
     }
 }
 
+int32_t HiDumper::GetPooledNodeInfos(std::string &result)
+{
+    DHLOGI("GetPooledNodeInfos Dump.");
+    uint64_t now = GetCurrentTimeUs();
+    std::lock_guard<std::mutex> node_lock(nodeMutex_);
+    for (const auto &info : pooledNodeInfos_) {
+        result.append("\n{");
+        result.append("\n   deviceid :   ");
+        result.append(GetAnonyString(info.devId));
+        result.append("\n   nodename :   ");
+        result.append(info.virNodeName);
+        result.append("\n   dhId :   ");
+        result.append(GetAnonyString(info.inputDhId));
+        result.append("\n   idle(ms) :   ");
+        result.append(std::to_string(now > info.parkTime ? (now - info.parkTime) / US_PER_MS : 0));
+        result.append("\n},");
+    }
+    return DH_SUCCESS;
+}
+
+void HiDumper::SavePooledNodeInfo(const std::string &deviceId, const std::string &nodeName, const std::string &dhId,
+    uint64_t parkTime)
+{
+    std::lock_guard<std::mutex> node_lock(nodeMutex_);
+    PooledNodeInfo info = {
+        .devId = deviceId,
+        .virNodeName = nodeName,
+        .inputDhId = dhId,
+        .parkTime = parkTime,
+    };
+    pooledNodeInfos_.push_back(info);
+}
+
+void HiDumper::DeletePooledNodeInfo(const std::string &deviceId, const std::string &dhId)
+{
+    std::lock_guard<std::mutex> node_lock(nodeMutex_);
+    pooledNodeInfos_.erase(std::remove_if(pooledNodeInfos_.begin(), pooledNodeInfos_.end(),
+        [&deviceId, &dhId](const PooledNodeInfo &info) {
+            return info.devId == deviceId && info.inputDhId == dhId;
+        }), pooledNodeInfos_.end());
+}
+
 int32_t HiDumper::GetSessionInfo(std::string &result)
 {
     DHLOGI("GetSessionInfo Dump.");
@@ -170,6 +302,209 @@ void HiDumper::DeleteSessionInfo(const std::string &remoteDevId)
     }
 }
 
+int32_t HiDumper::GetLatencyInfo(std::string &result)
+{
+    DHLOGI("GetLatencyInfo Dump.");
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    for (auto iter = latencyInfos_.begin(); iter != latencyInfos_.end(); iter++) {
+        const LatencySummary &rtt = iter->second.rtt;
+        result.append("\n{");
+        result.append("\n   remotedevid :   ");
+        result.append(GetAnonyString(iter->first));
+        result.append("\n   sendnum :   ");
+        result.append(std::to_string(iter->second.sendNum));
+        result.append("\n   recvnum :   ");
+        result.append(std::to_string(iter->second.recvNum));
+        result.append("\n   rtt p50(us) :   ");
+        result.append(std::to_string(rtt.p50));
+        result.append("\n   rtt p90(us) :   ");
+        result.append(std::to_string(rtt.p90));
+        result.append("\n   rtt p99(us) :   ");
+        result.append(std::to_string(rtt.p99));
+        result.append("\n   rtt max(us) :   ");
+        result.append(std::to_string(rtt.max));
+        if (iter->second.hasClockEstimate) {
+            result.append("\n   clock offset(us) :   ");
+            result.append(std::to_string(iter->second.clockOffsetUs));
+            result.append("\n   clock drift(ppm) :   ");
+            result.append(std::to_string(iter->second.clockDriftPpm));
+        }
+        result.append("\n},");
+    }
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::SetLatencyTraceEnabled(bool enabled, std::string &result)
+{
+    DHLOGI("SetLatencyTraceEnabled Dump, enabled: %{public}d.", enabled);
+    if (enabled) {
+        DInputLatencyTrace::GetInstance().Reset();
+    }
+    DInputLatencyTrace::GetInstance().SetEnabled(enabled);
+    result.append(enabled ? "latency trace started\n" : "latency trace stopped\n");
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::GetLatencyTraceInfo(std::string &result)
+{
+    DHLOGI("GetLatencyTraceInfo Dump.");
+    std::vector<TraceStageSummary> summaries = DInputLatencyTrace::GetInstance().GetStageSummaries();
+    for (const auto &stage : summaries) {
+        result.append("\n{");
+        result.append("\n   stage :   ");
+        result.append(stage.name);
+        result.append("\n   count :   ");
+        result.append(std::to_string(stage.summary.count));
+        result.append("\n   p50(us) :   ");
+        result.append(std::to_string(stage.summary.p50));
+        result.append("\n   p90(us) :   ");
+        result.append(std::to_string(stage.summary.p90));
+        result.append("\n   p99(us) :   ");
+        result.append(std::to_string(stage.summary.p99));
+        result.append("\n   max(us) :   ");
+        result.append(std::to_string(stage.summary.max));
+        result.append("\n},");
+    }
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::GetMetricsInfo(std::string &result)
+{
+    DHLOGI("GetMetricsInfo Dump.");
+    MetricsSnapshot snapshot = DInputMetrics::GetInstance().GetSnapshot(METRICS_READER_TEXT);
+    result.append("\n{");
+    for (size_t i = 0; i < METRIC_COUNTER_NUM; i++) {
+        result.append("\n   ");
+        result.append(DInputMetrics::GetCounterName(static_cast<MetricCounter>(i)));
+        result.append(" :   ");
+        result.append(std::to_string(snapshot.counters[i]));
+    }
+    for (size_t i = 0; i < METRIC_GAUGE_NUM; i++) {
+        result.append("\n   ");
+        result.append(DInputMetrics::GetGaugeName(static_cast<MetricGauge>(i)));
+        result.append(" :   ");
+        result.append(std::to_string(snapshot.gauges[i]));
+    }
+    for (size_t i = 0; i < METRIC_HISTOGRAM_NUM; i++) {
+        const LatencySummary &summary = snapshot.histograms[i];
+        result.append("\n   ");
+        result.append(DInputMetrics::GetHistogramName(static_cast<MetricHistogram>(i)));
+        result.append(" :   count ").append(std::to_string(summary.count));
+        result.append(", p50 ").append(std::to_string(summary.p50));
+        result.append(", p99 ").append(std::to_string(summary.p99));
+        result.append(", max ").append(std::to_string(summary.max));
+    }
+    result.append("\n},");
+    for (const auto &device : snapshot.devices) {
+        result.append("\n{");
+        result.append("\n   dhId :   ");
+        result.append(GetAnonyString(device.first));
+        result.append("\n   events :   ");
+        result.append(std::to_string(device.second.events));
+        result.append("\n   rate(events/s) :   ");
+        result.append(std::to_string(device.second.rate));
+        result.append("\n},");
+    }
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::GetMetricsJson(std::string &result)
+{
+    DHLOGI("GetMetricsJson Dump.");
+    MetricsSnapshot snapshot = DInputMetrics::GetInstance().GetSnapshot(METRICS_READER_JSON);
+    nlohmann::json metricsJson;
+    for (size_t i = 0; i < METRIC_COUNTER_NUM; i++) {
+        metricsJson["counters"][DInputMetrics::GetCounterName(static_cast<MetricCounter>(i))] =
+            snapshot.counters[i];
+    }
+    for (size_t i = 0; i < METRIC_GAUGE_NUM; i++) {
+        metricsJson["gauges"][DInputMetrics::GetGaugeName(static_cast<MetricGauge>(i))] = snapshot.gauges[i];
+    }
+    for (size_t i = 0; i < METRIC_HISTOGRAM_NUM; i++) {
+        const LatencySummary &summary = snapshot.histograms[i];
+        nlohmann::json histogramJson;
+        histogramJson["count"] = summary.count;
+        histogramJson["min"] = summary.min;
+        histogramJson["mean"] = summary.mean;
+        histogramJson["p50"] = summary.p50;
+        histogramJson["p90"] = summary.p90;
+        histogramJson["p99"] = summary.p99;
+        histogramJson["max"] = summary.max;
+        metricsJson["histograms"][DInputMetrics::GetHistogramName(static_cast<MetricHistogram>(i))] = histogramJson;
+    }
+    metricsJson["devices"] = nlohmann::json::array();
+    for (const auto &device : snapshot.devices) {
+        nlohmann::json deviceJson;
+        deviceJson["dhId"] = GetAnonyString(device.first);
+        deviceJson["events"] = device.second.events;
+        deviceJson["rate"] = device.second.rate;
+        metricsJson["devices"].push_back(deviceJson);
+    }
+    result.append(metricsJson.dump());
+    return DH_SUCCESS;
+}
+
+#ifdef DINPUT_EVENT_RECORD
+int32_t HiDumper::StartEventRecord(const std::vector<std::string> &args, std::string &result)
+{
+    DHLOGI("StartEventRecord Dump.");
+    std::string fileName = args.size() > ARGS_FILE_NAME_INDEX ? args[ARGS_FILE_NAME_INDEX] :
+        EVENT_RECORD_DEFAULT_FILE;
+    int32_t ret = DInputEventRecorder::GetInstance().Start(fileName);
+    if (ret != DH_SUCCESS) {
+        result.append("start event record failed, ret: ").append(std::to_string(ret));
+        return ret;
+    }
+    result.append("event record started, file: ").append(EVENT_RECORD_DIR + fileName);
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::StopEventRecord(std::string &result)
+{
+    DHLOGI("StopEventRecord Dump.");
+    DInputEventRecorder::GetInstance().Stop();
+    result.append("event record stopped, events: ")
+        .append(std::to_string(DInputEventRecorder::GetInstance().GetRecordedEventNum()));
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::StartEventReplay(const std::vector<std::string> &args, std::string &result)
+{
+    DHLOGI("StartEventReplay Dump.");
+    std::string fileName = args.size() > ARGS_FILE_NAME_INDEX ? args[ARGS_FILE_NAME_INDEX] :
+        EVENT_RECORD_DEFAULT_FILE;
+    double speed = 1.0;
+    if (args.size() > ARGS_REPLAY_SPEED_INDEX) {
+        const std::string &speedArg = args[ARGS_REPLAY_SPEED_INDEX];
+        char *end = nullptr;
+        speed = (speedArg == REPLAY_SPEED_MAX) ? 0 : strtod(speedArg.c_str(), &end);
+        if (speedArg != REPLAY_SPEED_MAX && (end == speedArg.c_str() || *end != '\0' || speed <= 0)) {
+            result.append("invalid replay speed: ").append(speedArg);
+            return ERR_DH_INPUT_HIDUMP_INVALID_ARGS;
+        }
+    }
+    EventRecording recording;
+    int32_t ret = DInputEventReplayer::GetInstance().StartReplay(fileName, speed, recording);
+    if (ret != DH_SUCCESS) {
+        result.append("start event replay failed, ret: ").append(std::to_string(ret));
+        return ret;
+    }
+    result.append("event replay started");
+    result.append("\n   devices :   ").append(std::to_string(recording.devices.size()));
+    result.append("\n   batches :   ").append(std::to_string(recording.batches.size()));
+    result.append("\n   events :   ").append(std::to_string(recording.eventNum));
+    return DH_SUCCESS;
+}
+
+int32_t HiDumper::StopEventReplay(std::string &result)
+{
+    DHLOGI("StopEventReplay Dump.");
+    DInputEventReplayer::GetInstance().StopReplay();
+    result.append("event replay stopped");
+    return DH_SUCCESS;
+}
+#endif
+
 int32_t HiDumper::ShowHelp(std::string &result)
 {
     DHLOGI("ShowHelp Dump.");
@@ -178,7 +513,35 @@ int32_t HiDumper::ShowHelp(std::string &result)
         .append("-nodeinfo        ")
         .append("dump all input node information in the system\n")
         .append("-sessioninfo     ")
-        .append("dump all input session information in the system\n");
+        .append("dump all input session information in the system\n")
+        .append("-latencyinfo     ")
+        .append("dump the rtt latency percentiles of all input sessions in the system\n")
+        .append("-tracestart      ")
+        .append("clear and start the per stage event latency trace, run it on the source device\n")
+        .append("-tracestop       ")
+        .append("stop the per stage event latency trace\n")
+        .append("-traceinfo       ")
+        .append("dump the per stage event latency percentiles of the trace\n")
+        .append("-metrics         ")
+        .append("dump the input event counters, queue depths and per device event rates\n")
+        .append("-metricsjson     ")
+        .append("dump the same metrics as -metrics in json format\n")
+        .append("-poolinfo        ")
+        .append("dump the virtual input nodes kept for reuse on the source device\n");
+#ifdef DINPUT_EVENT_RECORD
+    result.append("-recordstart     ")
+        .append("[file] record the collected input events, except keys, and the device capabilities,\n")
+        .append("                 ")
+        .append("run it on the sink device, the file name is taken in ").append(EVENT_RECORD_DIR).append("\n")
+        .append("-recordstop      ")
+        .append("stop the input event record\n")
+        .append("-replay          ")
+        .append("[file] [speed|max] replay a record through the sink transport at 1x, Nx or max speed,\n")
+        .append("                 ")
+        .append("the recorded devices must be prepared and started on the source\n")
+        .append("-replaystop      ")
+        .append("stop the running replay\n");
+#endif
     return DH_SUCCESS;
 }
 
@@ -219,7 +582,18 @@ void HiDumper::SetSessionStatus(const std::string &remoteDevId, const SessionSta
     }
     sessionInfos_[remoteDevId].sessionState = sessionStatus;
 }
+
+void HiDumper::SaveLatencyInfo(const std::string &remoteDevId, const LatencyInfo &latencyInfo)
+{
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    latencyInfos_[remoteDevId] = latencyInfo;
+}
+
+void HiDumper::DeleteLatencyInfo(const std::string &remoteDevId)
+{
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    latencyInfos_.erase(remoteDevId);
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
-
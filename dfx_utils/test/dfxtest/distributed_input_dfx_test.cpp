@@ -17,7 +17,9 @@
 
 #include "system_ability_definition.h"
 
+#include "nlohmann/json.hpp"
 #include "dinput_errcode.h"
+#include "dinput_metrics.h"
 #include "hidumper.h"
 #include "hisysevent_util.h"
 
@@ -66,12 +68,113 @@ HWTEST_F(DInputDfxUtilsTest, HiDump_002, testing::ext::TestSize.Level1)
     ret = HiDumper::GetInstance().HiDump(args, result);
     EXPECT_EQ(true, ret);
 
+    args.clear();
+    args.push_back("-latencyinfo");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-tracestart");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-traceinfo");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-tracestop");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-metrics");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-metricsjson");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+#ifdef DINPUT_EVENT_RECORD
+    args.clear();
+    args.push_back("-recordstop");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-replaystop");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(true, ret);
+
+    args.clear();
+    args.push_back("-replay");
+    args.push_back("dinput_not_exist_record.bin");
+    args.push_back("fast");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(false, ret);
+
+    args.clear();
+    args.push_back("-recordstart");
+    args.push_back("/data/test/dinput_event_record.bin");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(false, ret);
+
+    args.clear();
+    args.push_back("-replay");
+    args.push_back("../dinput_event_record.bin");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(false, ret);
+#else
+    args.clear();
+    args.push_back("-recordstart");
+    ret = HiDumper::GetInstance().HiDump(args, result);
+    EXPECT_EQ(false, ret);
+#endif
+
     args.clear();
     args.push_back("args_test");
     ret = HiDumper::GetInstance().HiDump(args, result);
     EXPECT_EQ(false, ret);
 }
 
+HWTEST_F(DInputDfxUtilsTest, GetLatencyInfo_001, testing::ext::TestSize.Level1)
+{
+    std::string remoteDevId = "umkyu1b165e1be98151891erbe8r91ev";
+    LatencyInfo latencyInfo;
+    latencyInfo.sendNum = 60;
+    latencyInfo.recvNum = 59;
+    latencyInfo.rtt.p50 = 1000;
+    HiDumper::GetInstance().SaveLatencyInfo(remoteDevId, latencyInfo);
+    EXPECT_EQ(1, HiDumper::GetInstance().latencyInfos_.size());
+
+    std::string result = "";
+    int32_t ret = HiDumper::GetInstance().GetLatencyInfo(result);
+    EXPECT_EQ(DH_SUCCESS, ret);
+    EXPECT_NE(std::string::npos, result.find("1000"));
+
+    HiDumper::GetInstance().DeleteLatencyInfo(remoteDevId);
+    EXPECT_EQ(0, HiDumper::GetInstance().latencyInfos_.size());
+}
+
+HWTEST_F(DInputDfxUtilsTest, GetMetricsJson_001, testing::ext::TestSize.Level1)
+{
+    DInputMetrics::GetInstance().Reset();
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::BATCHES_SENT, 3);
+    DInputMetrics::GetInstance().AddDeviceEvents("1ds56v18e1v21v8v1erv15r1v8r1j1ty8", 10);
+
+    std::string result = "";
+    int32_t ret = HiDumper::GetInstance().GetMetricsJson(result);
+    EXPECT_EQ(DH_SUCCESS, ret);
+    nlohmann::json metricsJson = nlohmann::json::parse(result, nullptr, false);
+    ASSERT_FALSE(metricsJson.is_discarded());
+    EXPECT_EQ(3, metricsJson["counters"]["batches_sent"].get<uint64_t>());
+    EXPECT_EQ(1, metricsJson["devices"].size());
+    DInputMetrics::GetInstance().Reset();
+}
+
 HWTEST_F(DInputDfxUtilsTest, GetAllNodeInfos_001, testing::ext::TestSize.Level1)
 {
     std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
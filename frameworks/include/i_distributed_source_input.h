@@ -52,6 +52,13 @@ public:
         const std::string &devId, const std::string &dhId, const std::string &parameters,
         sptr<IRegisterDInputCallback> callback) = 0;
 
+    /*
+     * Register a batch of hardware in one call, at most IPC_VECTOR_MAX_SIZE items.
+     * results holds the result of every item in order, and the callback is called once for every item.
+     */
+    virtual int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+        sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results) = 0;
+
     virtual int32_t UnregisterDistributedHardware(
         const std::string &devId, const std::string &dhId,
         sptr<IUnregisterDInputCallback> callback) = 0;
@@ -84,6 +91,13 @@ public:
     virtual int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
         sptr<IStartStopDInputsCallback> callback) = 0;
 
+    /*
+     * Prepare the sink and start the dhIds in one round trip, the sink answers both in one response.
+     * prepareCallback and startCallback get the same results as PrepareRemoteInput and StartRemoteInput.
+     */
+    virtual int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback) = 0;
+
     virtual int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId,
         const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback) = 0;
 
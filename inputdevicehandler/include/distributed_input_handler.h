@@ -16,10 +16,12 @@
 #ifndef DISTRIBUTED_INPUT_HANDLER_H
 #define DISTRIBUTED_INPUT_HANDLER_H
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <sys/epoll.h>
 #include <linux/input.h>
@@ -50,16 +52,37 @@ public:
 
     API_EXPORT void FindDevicesInfoByType(const uint32_t inputTypes, std::map<int32_t, std::string> &datas);
     API_EXPORT void FindDevicesInfoByDhId(std::vector<std::string> dhidsVec, std::map<int32_t, std::string> &datas);
+    /*
+     * Bumped whenever a device is plugged, unplugged or reports a different capability.
+     */
+    API_EXPORT uint64_t GetCapabilityGeneration();
+    /*
+     * The devices added or changed and the dhIds removed after the given generation. Returns the current
+     * generation to pass in the next call. isFull is set when the generation is too old to answer
+     * incrementally, changed holds every device then and removed is empty.
+     */
+    API_EXPORT uint64_t QueryChangedSince(uint64_t generation, std::vector<DHItem> &changed,
+        std::vector<std::string> &removed, bool &isFull);
 private:
+    struct CapabilityEntry {
+        // the serialized capability reported in DHItem::attrs.
+        std::string attrs;
+        // the generation of the last change.
+        uint64_t generation = 0;
+    };
+
     DistributedInputHandler();
     ~DistributedInputHandler();
     void StructTransJson(const InputDevice &pBuf, std::string &strDescriptor);
+    void SyncCapabilityCache();
+    const std::string &UpdateCapabilityLocked(const InputDevice &device);
+    void RemoveCapabilityLocked(const std::string &dhId);
     std::shared_ptr<PluginListener> m_listener;
     bool InitCollectEventsThread();
     void NotifyHardWare(int iCnt);
 
     pthread_t collectThreadID_;
-    bool isCollectingEvents_;
+    std::atomic<bool> isCollectingEvents_;
     bool isStartCollectEventThread_;
     static void *CollectEventsThread(void *param);
     void StartInputMonitorDeviceThread();
@@ -70,6 +93,16 @@ private:
     InputDeviceEvent mEventBuffer_[inputDeviceBufferSize_] = {};
     std::mutex operationMutex_;
     std::unique_ptr<InputHub> inputHub_;
+
+    std::mutex capabilityMutex_;
+    // the key is dhId, kept up to date by the hotplug events while the collect thread runs.
+    std::map<std::string, CapabilityEntry> capabilities_;
+    // the key is dhId and the value is the generation it was removed at.
+    std::map<std::string, uint64_t> removedDhIds_;
+    uint64_t capabilityGeneration_ = 0;
+    // the removals up to this generation are forgotten, older callers get the full list.
+    uint64_t trimmedGeneration_ = 0;
+    bool isCapabilitySynced_ = false;
 };
 
 #ifdef __cplusplus
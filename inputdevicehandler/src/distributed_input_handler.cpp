@@ -15,10 +15,12 @@
 
 #include "distributed_input_handler.h"
 
+#include <algorithm>
 #include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <set>
 #include <sstream>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -31,6 +33,7 @@
 #include "nlohmann/json.hpp"
 
 #include "constants_dinput.h"
+#include "dinput_capability_codec.h"
 #include "dinput_errcode.h"
 #include "dinput_log.h"
 #include "dinput_softbus_define.h"
@@ -40,12 +43,30 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    constexpr size_t MAX_REMOVED_DHID_NUM = 64;
+    // the high bits of a generation hold the epoch of the run, the low bits count the changes in it.
+    constexpr uint32_t GENERATION_EPOCH_SHIFT = 32;
+    const std::string INPUT_SUBTYPE = "input";
+
+    DHItem MakeDHItem(const std::string &dhId, const std::string &attrs)
+    {
+        DHItem item;
+        item.dhId = dhId;
+        item.subtype = INPUT_SUBTYPE;
+        item.attrs = attrs;
+        return item;
+    }
+}
 IMPLEMENT_SINGLE_INSTANCE(DistributedInputHandler);
 DistributedInputHandler::DistributedInputHandler()
     : collectThreadID_(-1), isCollectingEvents_(false), isStartCollectEventThread_(false)
 {
     inputHub_ = std::make_unique<InputHub>(true);
     this->m_listener = nullptr;
+    uint64_t epoch = static_cast<uint64_t>(GetRandomInt32(1, INT32_MAX));
+    capabilityGeneration_ = epoch << GENERATION_EPOCH_SHIFT;
+    trimmedGeneration_ = capabilityGeneration_;
 }
 
 DistributedInputHandler::~DistributedInputHandler()
@@ -57,32 +78,13 @@ void DistributedInputHandler::StructTransJson(const InputDevice &pBuf, std::stri
 {
     DHLOGI("[%{public}s] %{public}d, %{public}d, %{public}d, %{public}d, %{public}s.\n", (pBuf.name).c_str(),
         pBuf.bus, pBuf.vendor, pBuf.product, pBuf.version, GetAnonyString(pBuf.descriptor).c_str());
-    nlohmann::json tmpJson;
-    tmpJson[DEVICE_NAME] = pBuf.name;
-    tmpJson[PHYSICAL_PATH] = pBuf.physicalPath;
-    tmpJson[UNIQUE_ID] = pBuf.uniqueId;
-    tmpJson[BUS] = pBuf.bus;
-    tmpJson[VENDOR] = pBuf.vendor;
-    tmpJson[PRODUCT] = pBuf.product;
-    tmpJson[VERSION] = pBuf.version;
-    tmpJson[DESCRIPTOR] = pBuf.descriptor;
-    tmpJson[CLASSES] = pBuf.classes;
-    tmpJson[EVENT_TYPES] = pBuf.eventTypes;
-    tmpJson[EVENT_KEYS] = pBuf.eventKeys;
-    tmpJson[ABS_TYPES] = pBuf.absTypes;
-    tmpJson[ABS_INFOS] = pBuf.absInfos;
-    tmpJson[REL_TYPES] = pBuf.relTypes;
-    tmpJson[PROPERTIES] = pBuf.properties;
-
-    tmpJson[MISCELLANEOUS] = pBuf.miscellaneous;
-    tmpJson[LEDS] = pBuf.leds;
-    tmpJson[REPEATS] = pBuf.repeats;
-    tmpJson[SWITCHS] = pBuf.switchs;
-
-    std::ostringstream stream;
-    stream << tmpJson.dump();
-    strDescriptor = stream.str();
+#ifdef DINPUT_COMPACT_CAPABILITY
+    strDescriptor = InputDeviceToDescriptor(pBuf);
+    DHLOGI("Record InputDevice descriptor, size: %{public}zu", strDescriptor.size());
+#else
+    strDescriptor = InputDeviceToJson(pBuf);
     DHLOGI("Record InputDevice json info: %{public}s", strDescriptor.c_str());
+#endif
     return;
 }
 
@@ -117,28 +119,120 @@ std::vector<DHItem> DistributedInputHandler::QueryMeta()
 
 std::vector<DHItem> DistributedInputHandler::Query()
 {
+    SyncCapabilityCache();
     std::vector<DHItem> retInfos;
-
-    if (inputHub_ != nullptr) {
-        std::vector<InputDevice> vecInput = inputHub_->GetAllInputDevices();
-        for (auto iter : vecInput) {
-            DHItem item;
-            item.dhId = iter.descriptor;
-            item.subtype = "input";
-            StructTransJson(iter, item.attrs);
-            retInfos.push_back(item);
-        }
+    std::lock_guard<std::mutex> lock(capabilityMutex_);
+    for (const auto &[dhId, entry] : capabilities_) {
+        retInfos.push_back(MakeDHItem(dhId, entry.attrs));
     }
-
     return retInfos;
 }
 
 std::map<std::string, std::string> DistributedInputHandler::QueryExtraInfo()
 {
+    // the input devices carry everything in the attrs of Query, there is no extra info to cache.
     std::map<std::string, std::string> ret;
     return ret;
 }
 
+uint64_t DistributedInputHandler::GetCapabilityGeneration()
+{
+    SyncCapabilityCache();
+    std::lock_guard<std::mutex> lock(capabilityMutex_);
+    return capabilityGeneration_;
+}
+
+uint64_t DistributedInputHandler::QueryChangedSince(uint64_t generation, std::vector<DHItem> &changed,
+    std::vector<std::string> &removed, bool &isFull)
+{
+    SyncCapabilityCache();
+    changed.clear();
+    removed.clear();
+    std::lock_guard<std::mutex> lock(capabilityMutex_);
+    // a generation of another epoch belongs to a previous run of the service, whether it is lower or higher.
+    isFull = (generation >> GENERATION_EPOCH_SHIFT) != (capabilityGeneration_ >> GENERATION_EPOCH_SHIFT) ||
+        generation < trimmedGeneration_ || generation > capabilityGeneration_;
+    for (const auto &[dhId, entry] : capabilities_) {
+        if (isFull || entry.generation > generation) {
+            changed.push_back(MakeDHItem(dhId, entry.attrs));
+        }
+    }
+    if (!isFull) {
+        for (const auto &[dhId, removedGeneration] : removedDhIds_) {
+            if (removedGeneration > generation) {
+                removed.push_back(dhId);
+            }
+        }
+    }
+    return capabilityGeneration_;
+}
+
+void DistributedInputHandler::SyncCapabilityCache()
+{
+    if (inputHub_ == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(capabilityMutex_);
+        if (isCapabilitySynced_ && isCollectingEvents_) {
+            return;
+        }
+    }
+    // the snapshot is taken under the lock, so no hotplug handled by NotifyHardWare falls between the two.
+    std::lock_guard<std::mutex> lock(capabilityMutex_);
+    std::vector<InputDevice> devices = inputHub_->GetAllInputDevices();
+    std::set<std::string> presentDhIds;
+    for (const auto &device : devices) {
+        presentDhIds.insert(device.descriptor);
+        if (capabilities_.count(device.descriptor) == 0) {
+            UpdateCapabilityLocked(device);
+        }
+    }
+    std::vector<std::string> staleDhIds;
+    for (const auto &[dhId, entry] : capabilities_) {
+        if (presentDhIds.count(dhId) == 0) {
+            staleDhIds.push_back(dhId);
+        }
+    }
+    for (const auto &dhId : staleDhIds) {
+        RemoveCapabilityLocked(dhId);
+    }
+    // without the collect thread no hotplug is seen, so sync again on the next query.
+    isCapabilitySynced_ = isCollectingEvents_;
+}
+
+const std::string &DistributedInputHandler::UpdateCapabilityLocked(const InputDevice &device)
+{
+    std::string attrs;
+    StructTransJson(device, attrs);
+    removedDhIds_.erase(device.descriptor);
+    CapabilityEntry &entry = capabilities_[device.descriptor];
+    if (entry.generation == 0 || entry.attrs != attrs) {
+        entry.attrs = std::move(attrs);
+        entry.generation = ++capabilityGeneration_;
+    }
+    return entry.attrs;
+}
+
+void DistributedInputHandler::RemoveCapabilityLocked(const std::string &dhId)
+{
+    if (capabilities_.erase(dhId) == 0) {
+        return;
+    }
+    removedDhIds_[dhId] = ++capabilityGeneration_;
+    if (removedDhIds_.size() <= MAX_REMOVED_DHID_NUM) {
+        return;
+    }
+    auto oldest = removedDhIds_.begin();
+    for (auto iter = removedDhIds_.begin(); iter != removedDhIds_.end(); ++iter) {
+        if (iter->second < oldest->second) {
+            oldest = iter;
+        }
+    }
+    trimmedGeneration_ = std::max(trimmedGeneration_, oldest->second);
+    removedDhIds_.erase(oldest);
+}
+
 bool DistributedInputHandler::IsSupportPlugin()
 {
     return true;
@@ -213,15 +307,23 @@ void DistributedInputHandler::StartInputMonitorDeviceThread()
 void DistributedInputHandler::NotifyHardWare(int iCnt)
 {
     switch (mEventBuffer_[iCnt].type) {
-        case DeviceType::DEVICE_ADDED:
+        case DeviceType::DEVICE_ADDED: {
+            std::string hdInfo;
+            {
+                std::lock_guard<std::mutex> lock(capabilityMutex_);
+                hdInfo = UpdateCapabilityLocked(mEventBuffer_[iCnt].deviceInfo);
+            }
             if (this->m_listener != nullptr) {
-                std::string hdInfo;
-                StructTransJson(mEventBuffer_[iCnt].deviceInfo, hdInfo);
-                std::string subtype = "input";
+                std::string subtype = INPUT_SUBTYPE;
                 this->m_listener->PluginHardware(mEventBuffer_[iCnt].deviceInfo.descriptor, hdInfo, subtype);
             }
             break;
+        }
         case DeviceType::DEVICE_REMOVED:
+            {
+                std::lock_guard<std::mutex> lock(capabilityMutex_);
+                RemoveCapabilityLocked(mEventBuffer_[iCnt].deviceInfo.descriptor);
+            }
             if (this->m_listener != nullptr) {
                 this->m_listener->UnPluginHardware(mEventBuffer_[iCnt].deviceInfo.descriptor);
             }
@@ -239,6 +341,10 @@ void DistributedInputHandler::StopInputMonitorDeviceThread()
     }
     isCollectingEvents_ = false;
     isStartCollectEventThread_ = false;
+    {
+        std::lock_guard<std::mutex> lock(capabilityMutex_);
+        isCapabilitySynced_ = false;
+    }
     inputHub_->StopCollectInputHandler();
     if (collectThreadID_ != (pthread_t)(-1)) {
         DHLOGI("DistributedInputHandler::Wait collect thread exit");
@@ -15,14 +15,76 @@
 
 #include "distributed_input_handler_test.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "system_ability_definition.h"
 
 #include "dinput_errcode.h"
 #include "distributed_input_handler.h"
+#include "fake_input_device_source.h"
 
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    const std::string FAKE_KEYBOARD_PATH = "/dev/input/event100";
+    const std::string FAKE_INPUT_DIR = "/dev/input";
+    constexpr int32_t FAKE_NODE_NUM = 4;
+    constexpr int32_t SLOW_OPEN_TIME_MS = 50;
+
+    class CountingInputDeviceSource : public FakeInputDeviceSource {
+    public:
+        struct libevdev *NewLibEvDev(int32_t fd) override
+        {
+            newLibEvDevNum_++;
+            return FakeInputDeviceSource::NewLibEvDev(fd);
+        }
+        int32_t Ioctl(int32_t fd, unsigned long request, void *arg) override
+        {
+            if (_IOC_NR(request) == _IOC_NR(EVIOCGBIT(EV_LED, 0))) {
+                ledMaskNum_++;
+            }
+            return FakeInputDeviceSource::Ioctl(fd, request, arg);
+        }
+        std::atomic<int32_t> newLibEvDevNum_ = 0;
+        std::atomic<int32_t> ledMaskNum_ = 0;
+    };
+
+    // every open takes a while, like a node whose driver is still binding.
+    class SlowInputDeviceSource : public FakeInputDeviceSource {
+    public:
+        int32_t OpenDevice(const std::string &devicePath) override
+        {
+            int32_t opening = ++openingNum_;
+            int32_t peak = peakOpeningNum_.load();
+            while (opening > peak && !peakOpeningNum_.compare_exchange_weak(peak, opening)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_OPEN_TIME_MS));
+            openingNum_--;
+            return FakeInputDeviceSource::OpenDevice(devicePath);
+        }
+        std::atomic<int32_t> openingNum_ = 0;
+        std::atomic<int32_t> peakOpeningNum_ = 0;
+    };
+
+    FakeInputDeviceConfig MakeFakeKeyboardConfig()
+    {
+        FakeInputDeviceConfig config;
+        config.path = FAKE_KEYBOARD_PATH;
+        config.name = "fake keyboard";
+        config.id = { BUS_USB, 0x1, 0x2, 0x3 };
+        config.phys = "usb-0000:00:14.0-1/input0";
+        config.uniq = "fake01";
+        config.codes[EV_KEY] = { KEY_ESC, KEY_A, KEY_CAPSLOCK };
+        config.codes[EV_MSC] = { MSC_SCAN };
+        config.codes[EV_LED] = { LED_CAPSL };
+        return config;
+    }
+}
+
 void DInputHandlerTest::SetUp()
 {
 }
@@ -78,6 +140,144 @@ HWTEST_F(DInputHandlerTest, FindDevicesInfoByType_001, testing::ext::TestSize.Le
     dInputHandler.inputHub_ = std::make_unique<InputHub>(true);
     dInputHandler.StartInputMonitorDeviceThread();
 }
+
+HWTEST_F(DInputHandlerTest, CapabilityCache_001, testing::ext::TestSize.Level1)
+{
+    auto source = std::make_shared<CountingInputDeviceSource>();
+    FakeInputDeviceConfig config = MakeFakeKeyboardConfig();
+    source->AddDevice(config);
+    InputHub inputHub(false, source);
+    EXPECT_EQ(DH_SUCCESS, inputHub.OpenInputDeviceLocked(FAKE_KEYBOARD_PATH));
+    ASSERT_EQ(1, inputHub.openingDevices_.size());
+    InputDevice probed = inputHub.openingDevices_[0]->identifier;
+    EXPECT_EQ(1, source->newLibEvDevNum_);
+    // the full probe reads the led bits from the mask fetched for the cache check.
+    EXPECT_EQ(1, source->ledMaskNum_);
+    EXPECT_EQ(std::vector<uint32_t>{ LED_CAPSL }, probed.leds);
+
+    // a reconnect of the same peripheral reuses the probed capability.
+    inputHub.openingDevices_.clear();
+    EXPECT_EQ(DH_SUCCESS, inputHub.OpenInputDeviceLocked(FAKE_KEYBOARD_PATH));
+    ASSERT_EQ(1, inputHub.openingDevices_.size());
+    InputDevice reopened = inputHub.openingDevices_[0]->identifier;
+    EXPECT_EQ(1, source->newLibEvDevNum_);
+    EXPECT_EQ(probed.descriptor, reopened.descriptor);
+    EXPECT_EQ(probed.eventKeys, reopened.eventKeys);
+    EXPECT_EQ(probed.leds, reopened.leds);
+    EXPECT_EQ(probed.classes, reopened.classes);
+
+    // the same identity with a different EVIOCGBIT result is probed again.
+    config.codes[EV_KEY].push_back(KEY_B);
+    source->AddDevice(config);
+    inputHub.openingDevices_.clear();
+    EXPECT_EQ(DH_SUCCESS, inputHub.OpenInputDeviceLocked(FAKE_KEYBOARD_PATH));
+    ASSERT_EQ(1, inputHub.openingDevices_.size());
+    EXPECT_EQ(2, source->newLibEvDevNum_);
+    EXPECT_NE(probed.eventKeys, inputHub.openingDevices_[0]->identifier.eventKeys);
+    EXPECT_EQ(1, inputHub.capabilityCache_.size());
+}
+
+HWTEST_F(DInputHandlerTest, ParallelProbe_001, testing::ext::TestSize.Level1)
+{
+    auto source = std::make_shared<SlowInputDeviceSource>();
+    std::vector<std::string> paths;
+    for (int32_t i = 0; i < FAKE_NODE_NUM; i++) {
+        FakeInputDeviceConfig config = MakeFakeKeyboardConfig();
+        config.path = FAKE_KEYBOARD_PATH + std::to_string(i);
+        config.uniq = "fake0" + std::to_string(i);
+        source->AddDevice(config);
+        paths.push_back(config.path);
+    }
+    InputHub inputHub(false, source);
+    inputHub.ScanInputDevices(FAKE_INPUT_DIR);
+    EXPECT_GT(source->peakOpeningNum_.load(), 1);
+    ASSERT_EQ(FAKE_NODE_NUM, inputHub.openingDevices_.size());
+    std::vector<std::string> probedPaths;
+    for (const auto &device : inputHub.openingDevices_) {
+        probedPaths.push_back(device->path);
+    }
+    std::sort(probedPaths.begin(), probedPaths.end());
+    EXPECT_EQ(paths, probedPaths);
+
+    // one worker probes the nodes one after another.
+    InputHub serialHub(false, source);
+    serialHub.SetProbeWorkerNum(1);
+    source->peakOpeningNum_ = 0;
+    serialHub.ScanInputDevices(FAKE_INPUT_DIR);
+    EXPECT_EQ(1, source->peakOpeningNum_.load());
+    EXPECT_EQ(FAKE_NODE_NUM, serialHub.openingDevices_.size());
+}
+
+HWTEST_F(DInputHandlerTest, ParallelProbe_002, testing::ext::TestSize.Level1)
+{
+    // both probes of the same node run unlocked, only the first one to finish is added.
+    auto source = std::make_shared<SlowInputDeviceSource>();
+    source->AddDevice(MakeFakeKeyboardConfig());
+    InputHub inputHub(false, source);
+    std::thread otherProbe([&inputHub]() {
+        EXPECT_EQ(DH_SUCCESS, inputHub.OpenInputDeviceLocked(FAKE_KEYBOARD_PATH));
+    });
+    EXPECT_EQ(DH_SUCCESS, inputHub.OpenInputDeviceLocked(FAKE_KEYBOARD_PATH));
+    otherProbe.join();
+    EXPECT_EQ(2, source->peakOpeningNum_.load());
+    EXPECT_EQ(1, inputHub.openingDevices_.size());
+}
+
+HWTEST_F(DInputHandlerTest, QueryChangedSince_001, testing::ext::TestSize.Level1)
+{
+    auto source = std::make_shared<CountingInputDeviceSource>();
+    FakeInputDeviceConfig config = MakeFakeKeyboardConfig();
+    source->AddDevice(config);
+    DistributedInputHandler dInputHandler;
+    dInputHandler.inputHub_ = std::make_unique<InputHub>(false, source);
+    dInputHandler.inputHub_->ScanAndRecordInputDevices();
+    std::vector<DHItem> items = dInputHandler.Query();
+    ASSERT_EQ(1, items.size());
+    std::string keyboardDhId = items[0].dhId;
+    uint64_t generation = dInputHandler.GetCapabilityGeneration();
+    EXPECT_EQ(dInputHandler.trimmedGeneration_ + 1, generation);
+
+    // the collect thread keeps the cache up to date, a query does not serialize again.
+    dInputHandler.isCollectingEvents_ = true;
+    EXPECT_EQ(1, dInputHandler.Query().size());
+    std::vector<DHItem> changed;
+    std::vector<std::string> removed;
+    bool isFull = true;
+    EXPECT_EQ(generation, dInputHandler.QueryChangedSince(generation, changed, removed, isFull));
+    EXPECT_FALSE(isFull);
+    EXPECT_TRUE(changed.empty());
+    EXPECT_TRUE(removed.empty());
+
+    InputDevice mouse;
+    mouse.descriptor = "fake mouse";
+    dInputHandler.mEventBuffer_[0].type = DeviceType::DEVICE_ADDED;
+    dInputHandler.mEventBuffer_[0].deviceInfo = mouse;
+    dInputHandler.NotifyHardWare(0);
+    InputDevice keyboard;
+    keyboard.descriptor = keyboardDhId;
+    dInputHandler.mEventBuffer_[1].type = DeviceType::DEVICE_REMOVED;
+    dInputHandler.mEventBuffer_[1].deviceInfo = keyboard;
+    dInputHandler.NotifyHardWare(1);
+    uint64_t current = dInputHandler.QueryChangedSince(generation, changed, removed, isFull);
+    EXPECT_EQ(generation + 2, current);
+    EXPECT_FALSE(isFull);
+    ASSERT_EQ(1, changed.size());
+    EXPECT_EQ(mouse.descriptor, changed[0].dhId);
+    ASSERT_EQ(1, removed.size());
+    EXPECT_EQ(keyboardDhId, removed[0]);
+
+    // a generation of an earlier run gets the full list, whichever side of the current one it falls on.
+    dInputHandler.QueryChangedSince(current + 1, changed, removed, isFull);
+    EXPECT_TRUE(isFull);
+    EXPECT_EQ(1, changed.size());
+    EXPECT_TRUE(removed.empty());
+    uint64_t otherEpoch = (current >> 32) == 1 ? 2 : 1;
+    dInputHandler.QueryChangedSince((otherEpoch << 32) + 1, changed, removed, isFull);
+    EXPECT_TRUE(isFull);
+    EXPECT_EQ(1, changed.size());
+    EXPECT_TRUE(removed.empty());
+    dInputHandler.isCollectingEvents_ = false;
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -37,6 +37,11 @@ namespace DistributedHardware {
 namespace DistributedInput {
 class DistributedInputKit {
 public:
+    /*
+     * Register a batch of hardware in one call, the callback reports the result of every item.
+     */
+    static int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+        const std::shared_ptr<RegisterCallback> &callback, std::vector<int32_t> &results);
 
     static int32_t PrepareRemoteInput(const std::string &sinkId, sptr<IPrepareDInputCallback> callback);
     static int32_t UnprepareRemoteInput(const std::string &sinkId, sptr<IUnprepareDInputCallback> callback);
@@ -55,6 +60,11 @@ public:
         sptr<IStartStopDInputsCallback> callback);
     static int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
         sptr<IStartStopDInputsCallback> callback);
+    /*
+     * PrepareRemoteInput and StartRemoteInput by dhIds in one round trip to the sink.
+     */
+    static int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback);
 
     static int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId, const uint32_t &inputTypes,
         sptr<IStartDInputCallback> callback);
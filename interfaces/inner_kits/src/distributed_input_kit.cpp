@@ -18,6 +18,13 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+int32_t DistributedInputKit::RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+    const std::shared_ptr<RegisterCallback> &callback, std::vector<int32_t> &results)
+{
+    DHLOGI("RegisterDistributedHardwareBatch entrance");
+    return DistributedInputClient::GetInstance().RegisterDistributedHardwareBatch(items, callback, results);
+}
+
 int32_t DistributedInputKit::PrepareRemoteInput(
     const std::string &sinkId, sptr<IPrepareDInputCallback> callback)
 {
@@ -101,6 +108,15 @@ int32_t DistributedInputKit::StartRemoteInput(const std::string &sinkId, const s
     return DistributedInputClient::GetInstance().StartRemoteInput(sinkId, dhIds, callback);
 }
 
+int32_t DistributedInputKit::PrepareAndStartRemoteInput(const std::string &sinkId,
+    const std::vector<std::string> &dhIds, sptr<IPrepareDInputCallback> prepareCallback,
+    sptr<IStartStopDInputsCallback> startCallback)
+{
+    DHLOGI("PrepareAndStartRemoteInput entrance by sinkId and dhIds");
+    return DistributedInputClient::GetInstance().PrepareAndStartRemoteInput(sinkId, dhIds, prepareCallback,
+        startCallback);
+}
+
 int32_t DistributedInputKit::StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
     sptr<IStartStopDInputsCallback> callback)
 {
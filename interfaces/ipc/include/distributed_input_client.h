@@ -59,11 +59,17 @@ public:
     int32_t RegisterDistributedHardware(const std::string &devId, const std::string &dhId,
         const std::string &parameters, const std::shared_ptr<RegisterCallback> &callback);
 
+    int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+        const std::shared_ptr<RegisterCallback> &callback, std::vector<int32_t> &results);
+
     int32_t UnregisterDistributedHardware(const std::string &devId, const std::string &dhId,
         const std::shared_ptr<UnregisterCallback> &callback);
 
     int32_t PrepareRemoteInput(const std::string &deviceId, sptr<IPrepareDInputCallback> callback);
 
+    int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback);
+
     int32_t UnprepareRemoteInput(const std::string &deviceId, sptr<IUnprepareDInputCallback> callback);
 
     int32_t StartRemoteInput(
@@ -174,6 +180,8 @@ private:
     void DelWhiteListInfos(const std::string &deviceId) const;
     void UpdateSinkScreenInfos(const std::string &strJson);
     sptr<IDistributedSinkInput> GetRemoteDInput(const std::string &networkId) const;
+    void RemoveRegisterInfos(const std::vector<RegisterHardwareItem> &items,
+        const std::shared_ptr<RegisterCallback> &callback);
 
 private:
     static std::shared_ptr<DistributedInputClient> instance;
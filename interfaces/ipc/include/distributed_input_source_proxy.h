@@ -37,6 +37,9 @@ public:
     int32_t RegisterDistributedHardware(const std::string &devId, const std::string &dhId,
         const std::string &parameters, sptr<IRegisterDInputCallback> callback) override;
 
+    int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+        sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results) override;
+
     int32_t UnregisterDistributedHardware(const std::string &devId, const std::string &dhId,
         sptr<IUnregisterDInputCallback> callback) override;
 
@@ -68,6 +71,9 @@ public:
     int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
         sptr<IStartStopDInputsCallback> callback) override;
 
+    int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback) override;
+
     int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId,
         const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback) override;
 
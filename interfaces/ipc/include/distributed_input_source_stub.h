@@ -38,6 +38,7 @@ private:
     int32_t HandleInitDistributedHardware(MessageParcel &reply);
     int32_t HandleReleaseDistributedHardware(MessageParcel &reply);
     int32_t HandleRegisterDistributedHardware(MessageParcel &data, MessageParcel &reply);
+    int32_t HandleRegisterDistributedHardwareBatch(MessageParcel &data, MessageParcel &reply);
     int32_t HandleUnregisterDistributedHardware(MessageParcel &data, MessageParcel &reply);
     int32_t HandlePrepareRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleUnprepareRemoteInput(MessageParcel &data, MessageParcel &reply);
@@ -49,6 +50,7 @@ private:
     int32_t HandleUnprepareRelayRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleStartDhidRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleStopDhidRemoteInput(MessageParcel &data, MessageParcel &reply);
+    int32_t HandlePrepareStartDhidRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleStartRelayDhidRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleStopRelayDhidRemoteInput(MessageParcel &data, MessageParcel &reply);
     int32_t HandleRegisterAddWhiteListCallback(MessageParcel &data, MessageParcel &reply);
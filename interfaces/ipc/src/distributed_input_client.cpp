@@ -15,6 +15,8 @@
 
 #include "distributed_input_client.h"
 
+#include <algorithm>
+
 #include "iservice_registry.h"
 #include "nlohmann/json.hpp"
 #include "system_ability_definition.h"
@@ -352,6 +354,70 @@ int32_t DistributedInputClient::RegisterDistributedHardware(const std::string &d
         new(std::nothrow) RegisterDInputCb());
 }
 
+int32_t DistributedInputClient::RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+    const std::shared_ptr<RegisterCallback> &callback, std::vector<int32_t> &results)
+{
+    DHLOGI("DinputRegisterBatch called, item size: %{public}zu.", items.size());
+    if (!DInputSAManager::GetInstance().GetDInputSourceProxy()) {
+        DHLOGE("DinputRegisterBatch client fail.");
+        return ERR_DH_INPUT_CLIENT_GET_SOURCE_PROXY_FAIL;
+    }
+    if (items.empty() || items.size() > IPC_VECTOR_MAX_SIZE) {
+        DHLOGE("DinputRegisterBatch item size is invalid.");
+        return ERR_DH_INPUT_CLIENT_REGISTER_FAIL;
+    }
+    for (const auto &item : items) {
+        if (!DInputCheckParam::GetInstance().CheckRegisterParam(item.devId, item.dhId, item.parameters, callback)) {
+            return ERR_DH_INPUT_CLIENT_REGISTER_FAIL;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(DistributedInputClient::GetInstance().operationMutex_);
+        std::set<std::pair<std::string, std::string>> itemKeys;
+        for (const auto &item : items) {
+            if (!itemKeys.insert({item.devId, item.dhId}).second) {
+                DHLOGE("DinputRegisterBatch item is duplicate.");
+                return ERR_DH_INPUT_CLIENT_REGISTER_FAIL;
+            }
+            for (auto iter : dHardWareFwkRstInfos_) {
+                if (iter.devId == item.devId && iter.dhId == item.dhId) {
+                    return ERR_DH_INPUT_CLIENT_REGISTER_FAIL;
+                }
+            }
+        }
+        for (const auto &item : items) {
+            DHardWareFwkRegistInfo info {item.devId, item.dhId, callback};
+            dHardWareFwkRstInfos_.push_back(info);
+        }
+    }
+    int32_t ret = ERR_DH_INPUT_CLIENT_REGISTER_FAIL;
+    {
+        std::lock_guard<std::mutex> lock(DInputSAManager::GetInstance().sourceMutex_);
+        ret = DInputSAManager::GetInstance().dInputSourceProxy_->RegisterDistributedHardwareBatch(items,
+            new(std::nothrow) RegisterDInputCb(), results);
+    }
+    if (ret != DH_SUCCESS) {
+        RemoveRegisterInfos(items, callback);
+    }
+    return ret;
+}
+
+void DistributedInputClient::RemoveRegisterInfos(const std::vector<RegisterHardwareItem> &items,
+    const std::shared_ptr<RegisterCallback> &callback)
+{
+    // the items answered through RegisterDInputCb are gone already, the rest never get a result.
+    std::lock_guard<std::mutex> lock(operationMutex_);
+    for (const auto &item : items) {
+        auto iter = std::find_if(dHardWareFwkRstInfos_.begin(), dHardWareFwkRstInfos_.end(),
+            [&item, &callback](const DHardWareFwkRegistInfo &info) {
+                return info.devId == item.devId && info.dhId == item.dhId && info.callback == callback;
+            });
+        if (iter != dHardWareFwkRstInfos_.end()) {
+            dHardWareFwkRstInfos_.erase(iter);
+        }
+    }
+}
+
 int32_t DistributedInputClient::UnregisterDistributedHardware(const std::string &devId, const std::string &dhId,
     const std::shared_ptr<UnregisterCallback> &callback)
 {
@@ -393,6 +459,24 @@ int32_t DistributedInputClient::PrepareRemoteInput(const std::string &deviceId,
     return DInputSAManager::GetInstance().dInputSourceProxy_->PrepareRemoteInput(deviceId, callback);
 }
 
+int32_t DistributedInputClient::PrepareAndStartRemoteInput(const std::string &sinkId,
+    const std::vector<std::string> &dhIds, sptr<IPrepareDInputCallback> prepareCallback,
+    sptr<IStartStopDInputsCallback> startCallback)
+{
+    DHLOGI("DinputPrepareAndStart called, sinkId: %{public}s.", GetAnonyString(sinkId).c_str());
+    if (!DInputSAManager::GetInstance().GetDInputSourceProxy()) {
+        DHLOGE("DinputPrepareAndStart client fail.");
+        return ERR_DH_INPUT_CLIENT_GET_SOURCE_PROXY_FAIL;
+    }
+    if (!DInputCheckParam::GetInstance().CheckParam(sinkId, prepareCallback) ||
+        !DInputCheckParam::GetInstance().CheckParam(sinkId, dhIds, startCallback)) {
+        return ERR_DH_INPUT_CLIENT_PREPARE_FAIL;
+    }
+    std::lock_guard<std::mutex> lock(DInputSAManager::GetInstance().sourceMutex_);
+    return DInputSAManager::GetInstance().dInputSourceProxy_->PrepareAndStartRemoteInput(sinkId, dhIds,
+        prepareCallback, startCallback);
+}
+
 int32_t DistributedInputClient::UnprepareRemoteInput(const std::string &deviceId,
     sptr<IUnprepareDInputCallback> callback)
 {
@@ -94,6 +94,52 @@ int32_t DistributedInputSourceProxy::RegisterDistributedHardware(const std::stri
     return result;
 }
 
+int32_t DistributedInputSourceProxy::RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+    sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results)
+{
+    if (callback == nullptr) {
+        DHLOGE("callback is nullptr");
+        return ERR_DH_INPUT_SRC_PROXY_CALLBACK_IS_NULL;
+    }
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        DHLOGE("DistributedInputSourceProxy write token valid failed");
+        return ERR_DH_INPUT_IPC_WRITE_TOKEN_VALID_FAIL;
+    }
+    if (!data.WriteUint32(items.size())) {
+        DHLOGE("Write RegisterDistributedHardwareBatch item size to parcel failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    for (const auto &item : items) {
+        if (!data.WriteString(item.devId) || !data.WriteString(item.dhId) || !data.WriteString(item.parameters)) {
+            DHLOGE("Write RegisterDistributedHardwareBatch item to parcel failed");
+            return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+        }
+    }
+    if (!data.WriteRemoteObject(callback->AsObject())) {
+        DHLOGE("Write RegisterDistributedHardwareBatch callback to parcel failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    MessageParcel reply;
+    int32_t result = ERR_DH_INPUT_SOURCE_PROXY_REGISTER_FAIL;
+    bool ret = SendRequest(static_cast<uint32_t>(IDInputSourceInterfaceCode::REGISTER_BATCH_REMOTE_INPUT), data,
+        reply);
+    if (!ret) {
+        return result;
+    }
+    result = reply.ReadInt32();
+    uint32_t resultSize = reply.ReadUint32();
+    if (resultSize != items.size()) {
+        DHLOGE("RegisterDistributedHardwareBatch result size %{public}u mismatch", resultSize);
+        return ERR_DH_INPUT_IPC_READ_VALID_FAIL;
+    }
+    results.clear();
+    for (uint32_t i = 0; i < resultSize; i++) {
+        results.push_back(reply.ReadInt32());
+    }
+    return result;
+}
+
 int32_t DistributedInputSourceProxy::UnregisterDistributedHardware(const std::string &devId, const std::string &dhId,
     sptr<IUnregisterDInputCallback> callback)
 {
@@ -446,6 +492,48 @@ int32_t DistributedInputSourceProxy::StartRemoteInput(const std::string &sinkId,
     return result;
 }
 
+int32_t DistributedInputSourceProxy::PrepareAndStartRemoteInput(const std::string &sinkId,
+    const std::vector<std::string> &dhIds, sptr<IPrepareDInputCallback> prepareCallback,
+    sptr<IStartStopDInputsCallback> startCallback)
+{
+    if (prepareCallback == nullptr || startCallback == nullptr) {
+        DHLOGE("callback is nullptr");
+        return ERR_DH_INPUT_SRC_PROXY_CALLBACK_IS_NULL;
+    }
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        DHLOGE("DistributedInputSourceProxy write token valid failed");
+        return ERR_DH_INPUT_IPC_WRITE_TOKEN_VALID_FAIL;
+    }
+    if (!data.WriteString(sinkId)) {
+        DHLOGE("Write PrepareAndStartRemoteInput sinkId to parcel failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    if (!data.WriteUint32(dhIds.size())) {
+        DHLOGE("Write PrepareAndStartRemoteInput dhid size to parcel failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    for (auto it = dhIds.begin(); it != dhIds.end(); ++it) {
+        if (!data.WriteString(*it)) {
+            DHLOGE("Write PrepareAndStartRemoteInput dhid to parcel failed");
+            return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+        }
+    }
+    if (!data.WriteRemoteObject(prepareCallback->AsObject()) || !data.WriteRemoteObject(startCallback->AsObject())) {
+        DHLOGE("Write PrepareAndStartRemoteInput callback to parcel failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    MessageParcel reply;
+    int32_t result = ERR_DH_INPUT_SOURCE_PROXY_PREPARE_FAIL;
+    bool ret = SendRequest(static_cast<uint32_t>(IDInputSourceInterfaceCode::PREPARE_START_DHID_REMOTE_INPUT), data,
+        reply);
+    if (ret) {
+        result = reply.ReadInt32();
+    }
+    DHLOGI("Source proxy PrepareAndStartRemoteInput end, result:%{public}d.", result);
+    return result;
+}
+
 int32_t DistributedInputSourceProxy::StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
     sptr<IStartStopDInputsCallback> callback)
 {
@@ -113,6 +113,82 @@ int32_t DistributedInputSourceStub::HandleRegisterDistributedHardware(MessagePar
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputSourceStub::HandlePrepareStartDhidRemoteInput(MessageParcel &data, MessageParcel &reply)
+{
+    if (!HasAccessDHPermission()) {
+        DHLOGE("The caller has no ACCESS_DISTRIBUTED_HARDWARE permission.");
+        return ERR_DH_INPUT_SRC_ACCESS_PERMISSION_CHECK_FAIL;
+    }
+    std::string sinkId = data.ReadString();
+    std::vector<std::string> tempVector;
+    uint32_t vecSize = data.ReadUint32();
+    if (vecSize > IPC_VECTOR_MAX_SIZE) {
+        DHLOGE("HandlePrepareStartDhidRemoteInput vecSize too large");
+        return ERR_DH_INPUT_IPC_READ_VALID_FAIL;
+    }
+    for (uint32_t i = 0; i < vecSize; i++) {
+        std::string dhid = data.ReadString();
+        if (dhid.empty()) {
+            DHLOGE("HandlePrepareStartDhidRemoteInput dhid is empty");
+            continue;
+        }
+        tempVector.push_back(dhid);
+    }
+    sptr<IPrepareDInputCallback> prepareCallback = iface_cast<IPrepareDInputCallback>(data.ReadRemoteObject());
+    sptr<IStartStopDInputsCallback> startCallback = iface_cast<IStartStopDInputsCallback>(data.ReadRemoteObject());
+    if (prepareCallback == nullptr || startCallback == nullptr) {
+        DHLOGE("HandlePrepareStartDhidRemoteInput failed, callback is nullptr.");
+        return ERR_DH_INPUT_POINTER_NULL;
+    }
+    int32_t ret = PrepareAndStartRemoteInput(sinkId, tempVector, prepareCallback, startCallback);
+    if (!reply.WriteInt32(ret)) {
+        DHLOGE("HandlePrepareStartDhidRemoteInput write ret failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    return DH_SUCCESS;
+}
+
+int32_t DistributedInputSourceStub::HandleRegisterDistributedHardwareBatch(MessageParcel &data, MessageParcel &reply)
+{
+    if (!HasEnableDHPermission()) {
+        DHLOGE("The caller has no ENABLE_DISTRIBUTED_HARDWARE permission.");
+        return ERR_DH_INPUT_SRC_ENABLE_PERMISSION_CHECK_FAIL;
+    }
+    uint32_t itemSize = data.ReadUint32();
+    if (itemSize > IPC_VECTOR_MAX_SIZE) {
+        DHLOGE("HandleRegisterDistributedHardwareBatch itemSize too large");
+        return ERR_DH_INPUT_IPC_READ_VALID_FAIL;
+    }
+    std::vector<RegisterHardwareItem> items;
+    for (uint32_t i = 0; i < itemSize; i++) {
+        RegisterHardwareItem item;
+        item.devId = data.ReadString();
+        item.dhId = data.ReadString();
+        item.parameters = data.ReadString();
+        items.push_back(item);
+    }
+    sptr<IRegisterDInputCallback> callback = iface_cast<IRegisterDInputCallback>(data.ReadRemoteObject());
+    if (callback == nullptr) {
+        DHLOGE("HandleRegisterDistributedHardwareBatch failed, callback is nullptr.");
+        return ERR_DH_INPUT_POINTER_NULL;
+    }
+    std::vector<int32_t> results;
+    int32_t ret = RegisterDistributedHardwareBatch(items, callback, results);
+    // every item gets a result, even if the implementation gave up early.
+    results.resize(items.size(), ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL);
+    if (!reply.WriteInt32(ret) || !reply.WriteUint32(results.size())) {
+        DHLOGE("HandleRegisterDistributedHardwareBatch write ret failed");
+        return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+    }
+    for (int32_t result : results) {
+        if (!reply.WriteInt32(result)) {
+            DHLOGE("HandleRegisterDistributedHardwareBatch write result failed");
+            return ERR_DH_INPUT_IPC_WRITE_VALID_FAIL;
+        }
+    }
+    return DH_SUCCESS;
+}
+
 int32_t DistributedInputSourceStub::HandleUnregisterDistributedHardware(MessageParcel &data, MessageParcel &reply)
 {
     if (!HasEnableDHPermission()) {
@@ -569,6 +645,10 @@ int32_t DistributedInputSourceStub::HandleRemoteRequest(uint32_t code, MessagePa
             return HandleRegisterSessionStateCb(data, reply);
         case static_cast<uint32_t>(IDInputSourceInterfaceCode::UNREGISTER_SESSION_STATE_CB):
             return HandleUnregisterSessionStateCb(data, reply);
+        case static_cast<uint32_t>(IDInputSourceInterfaceCode::REGISTER_BATCH_REMOTE_INPUT):
+            return HandleRegisterDistributedHardwareBatch(data, reply);
+        case static_cast<uint32_t>(IDInputSourceInterfaceCode::PREPARE_START_DHID_REMOTE_INPUT):
+            return HandlePrepareStartDhidRemoteInput(data, reply);
         default:
             DHLOGE("invalid request code is %{public}u.", code);
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -88,6 +88,15 @@ int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::RegisterDistribu
     return DH_SUCCESS;
 }
 
+int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::RegisterDistributedHardwareBatch(
+    const std::vector<RegisterHardwareItem> &items, sptr<IRegisterDInputCallback> callback,
+    std::vector<int32_t> &results)
+{
+    (void)callback;
+    results.assign(items.size(), DH_SUCCESS);
+    return DH_SUCCESS;
+}
+
 int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::UnregisterDistributedHardware(
     const std::string &devId, const std::string &dhId,
     sptr<IUnregisterDInputCallback> callback)
@@ -194,6 +203,17 @@ int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::StopRemoteInput(
     return DH_SUCCESS;
 }
 
+int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::PrepareAndStartRemoteInput(
+    const std::string &sinkId, const std::vector<std::string> &dhIds,
+    sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback)
+{
+    (void)sinkId;
+    (void)dhIds;
+    (void)prepareCallback;
+    (void)startCallback;
+    return DH_SUCCESS;
+}
+
 int32_t DInputSourceCallBackTest::TestDInputSourceCallBackStub::StartRemoteInput(
     const std::string &srcId, const std::string &sinkId,
     const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback)
@@ -405,6 +425,24 @@ HWTEST_F(DInputSourceCallBackTest, RegisterDistributedHardware01, testing::ext::
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
+HWTEST_F(DInputSourceCallBackTest, RegisterDistributedHardwareBatch01, testing::ext::TestSize.Level1)
+{
+    sptr<IRemoteObject> callBackStubPtr(new TestDInputSourceCallBackStub());
+    DistributedInputSourceProxy callBackProxy(callBackStubPtr);
+    std::vector<RegisterHardwareItem> items = {
+        {"d6f4s6d4f6", "Input_sd4f4s5d4f5s4", "d4a6s5d46asd"},
+        {"d6f4s6d4f6", "Input_as5d4as5d4a5s", "d4a6s5d46asd"},
+    };
+    sptr<IRegisterDInputCallback> callback(new TestDInputRegisterCallBack());
+    std::vector<int32_t> results;
+    int32_t ret = callBackProxy.RegisterDistributedHardwareBatch(items, callback, results);
+    EXPECT_EQ(DH_SUCCESS, ret);
+    EXPECT_EQ(items.size(), results.size());
+
+    ret = callBackProxy.RegisterDistributedHardwareBatch(items, nullptr, results);
+    EXPECT_EQ(ERR_DH_INPUT_SRC_PROXY_CALLBACK_IS_NULL, ret);
+}
+
 HWTEST_F(DInputSourceCallBackTest, UnregisterDistributedHardware01, testing::ext::TestSize.Level1)
 {
     sptr<IRemoteObject> callBackStubPtr(new TestDInputSourceCallBackStub());
@@ -493,6 +531,22 @@ HWTEST_F(DInputSourceCallBackTest, StartRemoteInput03, testing::ext::TestSize.Le
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
+HWTEST_F(DInputSourceCallBackTest, PrepareAndStartRemoteInput01, testing::ext::TestSize.Level1)
+{
+    sptr<IRemoteObject> callBackStubPtr(new TestDInputSourceCallBackStub());
+    DistributedInputSourceProxy callBackProxy(callBackStubPtr);
+    const std::string sinkId = "d6f4s6d4f6";
+    std::vector<std::string> dhIds;
+    dhIds.push_back("Input_6ds54f6sd4f65sd4fsdf4s");
+    sptr<TestDInputPrepareCallBack> prepareCallback(new TestDInputPrepareCallBack());
+    sptr<TestVectorStartStopCallBackStub> startCallback(new TestVectorStartStopCallBackStub());
+    int32_t ret = callBackProxy.PrepareAndStartRemoteInput(sinkId, dhIds, prepareCallback, startCallback);
+    EXPECT_EQ(DH_SUCCESS, ret);
+
+    ret = callBackProxy.PrepareAndStartRemoteInput(sinkId, dhIds, prepareCallback, nullptr);
+    EXPECT_EQ(ERR_DH_INPUT_SRC_PROXY_CALLBACK_IS_NULL, ret);
+}
+
 HWTEST_F(DInputSourceCallBackTest, StartRemoteInput04, testing::ext::TestSize.Level1)
 {
     sptr<IRemoteObject> callBackStubPtr(new TestDInputSourceCallBackStub());
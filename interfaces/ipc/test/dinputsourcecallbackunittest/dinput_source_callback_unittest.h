@@ -58,6 +58,9 @@ public:
             const std::string &devId, const std::string &dhId, const std::string &parameters,
             sptr<IRegisterDInputCallback> callback);
 
+        int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+            sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results);
+
         int32_t UnregisterDistributedHardware(
             const std::string &devId, const std::string &dhId,
             sptr<IUnregisterDInputCallback> callback);
@@ -90,6 +93,9 @@ public:
         int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
             sptr<IStartStopDInputsCallback> callback);
 
+        int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+            sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback);
+
         int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId,
             const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback);
 
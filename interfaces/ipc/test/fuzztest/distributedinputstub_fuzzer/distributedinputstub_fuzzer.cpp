@@ -209,6 +209,15 @@ int32_t DInputSourceCallBackStubFuzz::RegisterDistributedHardware(
     return DistributedInput::DH_SUCCESS;
 }
 
+int32_t DInputSourceCallBackStubFuzz::RegisterDistributedHardwareBatch(
+    const std::vector<DistributedInput::RegisterHardwareItem> &items,
+    sptr<DistributedInput::IRegisterDInputCallback> callback, std::vector<int32_t> &results)
+{
+    (void)callback;
+    results.assign(items.size(), DistributedInput::DH_SUCCESS);
+    return DistributedInput::DH_SUCCESS;
+}
+
 int32_t DInputSourceCallBackStubFuzz::UnregisterDistributedHardware(
     const std::string &devId, const std::string &dhId,
     sptr<DistributedInput::IUnregisterDInputCallback> callback)
@@ -315,6 +324,18 @@ int32_t DInputSourceCallBackStubFuzz::StopRemoteInput(
     return DistributedInput::DH_SUCCESS;
 }
 
+int32_t DInputSourceCallBackStubFuzz::PrepareAndStartRemoteInput(
+    const std::string &sinkId, const std::vector<std::string> &dhIds,
+    sptr<DistributedInput::IPrepareDInputCallback> prepareCallback,
+    sptr<DistributedInput::IStartStopDInputsCallback> startCallback)
+{
+    (void)sinkId;
+    (void)dhIds;
+    (void)prepareCallback;
+    (void)startCallback;
+    return DistributedInput::DH_SUCCESS;
+}
+
 int32_t DInputSourceCallBackStubFuzz::StartRemoteInput(
     const std::string &srcId, const std::string &sinkId,
     const std::vector<std::string> &dhIds, sptr<DistributedInput::IStartStopDInputsCallback> callback)
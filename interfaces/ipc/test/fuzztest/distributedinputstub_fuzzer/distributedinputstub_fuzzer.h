@@ -49,6 +49,8 @@ public:
     int32_t RegisterDistributedHardware(
         const std::string &devId, const std::string &dhId, const std::string &parameters,
         sptr<DistributedInput::IRegisterDInputCallback> callback);
+    int32_t RegisterDistributedHardwareBatch(const std::vector<DistributedInput::RegisterHardwareItem> &items,
+        sptr<DistributedInput::IRegisterDInputCallback> callback, std::vector<int32_t> &results);
     int32_t UnregisterDistributedHardware(
         const std::string &devId, const std::string &dhId, sptr<DistributedInput::IUnregisterDInputCallback> callback);
     int32_t PrepareRemoteInput(const std::string &deviceId, sptr<DistributedInput::IPrepareDInputCallback> callback);
@@ -72,6 +74,9 @@ public:
         sptr<DistributedInput::IStartStopDInputsCallback> callback);
     int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
         sptr<DistributedInput::IStartStopDInputsCallback> callback);
+    int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<DistributedInput::IPrepareDInputCallback> prepareCallback,
+        sptr<DistributedInput::IStartStopDInputsCallback> startCallback);
     int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId,
         const std::vector<std::string> &dhIds, sptr<DistributedInput::IStartStopDInputsCallback> callback);
     int32_t StopRemoteInput(const std::string &srcId, const std::string &sinkId,
@@ -29,6 +29,8 @@ public:
     virtual void OnStopRemoteInput(const int32_t &sessionId, const uint32_t &inputTypes) = 0;
     virtual void OnStartRemoteInputDhid(const int32_t &sessionId, const std::string &strDhids) = 0;
     virtual void OnStopRemoteInputDhid(const int32_t &sessionId, const std::string &strDhids) = 0;
+    virtual void OnPrepareStartRemoteInputDhid(const int32_t &sessionId, const std::string &deviceId,
+        const std::string &strDhids) = 0;
 
     virtual void OnRelayPrepareRemoteInput(const int32_t &toSrcSessionId, const int32_t &toSinkSessionId,
         const std::string &deviceId) = 0;
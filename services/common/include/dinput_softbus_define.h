@@ -43,6 +43,8 @@ namespace DistributedInput {
 
     const std::string DINPUT_PKG_NAME = "ohos.dhardware.dinput";
     const std::string SESSION_NAME = "ohos.dhardware.dinput.session";
+    // the server and client sockets carrying only the event batches are named with this prefix.
+    const std::string DATA_SESSION_NAME = SESSION_NAME + ".data";
     const std::string GROUP_ID = "input_softbus_group_id";
 
     #define DINPUT_SOFTBUS_KEY_CMD_TYPE "dinput_softbus_key_cmd_type"
@@ -59,6 +61,21 @@ namespace DistributedInput {
     #define DINPUT_SOFTBUS_KEY_KEYSTATE_VALUE "dinput_softbus_key_keystate_value"
     #define DINPUT_SOFTBUS_KEY_SRC_DEV_ID "dinput_softbus_key_src_dev_id"
     #define DINPUT_SOFTBUS_KEY_SINK_DEV_ID "dinput_softbus_key_sink_dev_id"
+    #define DINPUT_SOFTBUS_KEY_TRACE_ENABLE "dinput_softbus_key_trace_enable"
+    #define DINPUT_SOFTBUS_KEY_TRACE_STAMPS "dinput_softbus_key_trace_stamps"
+    #define DINPUT_SOFTBUS_KEY_START_RESP_VALUE "dinput_softbus_key_start_resp_value"
+    // set by the source on start and stop requests, the sink echoes it in the response.
+    #define DINPUT_SOFTBUS_KEY_REQUEST_ID "dinput_softbus_key_request_id"
+    // set in the prepare response of a sink that handles TRANS_SOURCE_MSG_PREPARE_START_DHID.
+    #define DINPUT_SOFTBUS_KEY_PREPARE_START "dinput_softbus_key_prepare_start"
+    // the request carries no correlation id, such as a response from a sink that does not echo it.
+    const uint64_t INVALID_REQUEST_ID = 0;
+    // the wall clock stamps of a latency probe: sent by the source, received and answered by the sink.
+    #define DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME "dinput_softbus_key_latency_origin_time"
+    #define DINPUT_SOFTBUS_KEY_LATENCY_RECEIVE_TIME "dinput_softbus_key_latency_receive_time"
+    #define DINPUT_SOFTBUS_KEY_LATENCY_TRANSMIT_TIME "dinput_softbus_key_latency_transmit_time"
+    // the last RTT measured by the source, the sink adapts its send rate to it.
+    #define DINPUT_SOFTBUS_KEY_LATENCY_RTT "dinput_softbus_key_latency_rtt"
 
     // src will receive
     const uint32_t TRANS_SINK_MSG_ONPREPARE    = 1;
@@ -89,6 +106,7 @@ namespace DistributedInput {
     const uint32_t TRANS_SINK_MSG_ON_RELAY_STARTTYPE  = 26;
     const uint32_t TRANS_SINK_MSG_ON_RELAY_STOPTYPE   = 27;
     const uint32_t TRANS_SINK_MSG_KEY_STATE_BATCH     = 28;
+    const uint32_t TRANS_SINK_MSG_ON_PREPARE_START    = 29;
 
     // src or sink
     const uint32_t TRANS_MSG_SRC_SINK_SPLIT    = 30;
@@ -107,6 +125,7 @@ namespace DistributedInput {
     const uint32_t TRANS_SOURCE_MSG_STOP_TYPE_FOR_REL    = 41;
     const uint32_t TRANS_SOURCE_MSG_PREPARE_FOR_REL      = 42;
     const uint32_t TRANS_SOURCE_MSG_UNPREPARE_FOR_REL    = 43;
+    const uint32_t TRANS_SOURCE_MSG_PREPARE_START_DHID   = 44;
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -18,6 +18,8 @@
 
 #include <string>
 
+#include "dinput_latency_trace.h"
+
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
@@ -31,10 +33,51 @@ public:
     virtual void OnResponseStopRemoteInput(const std::string deviceId, const uint32_t inputTypes, bool result) = 0;
     virtual void OnResponseStartRemoteInputDhid(const std::string deviceId, const std::string &dhids, bool result) = 0;
     virtual void OnResponseStopRemoteInputDhid(const std::string deviceId, const std::string &dhids, bool result) = 0;
+    virtual void OnResponsePrepareStartRemoteInput(const std::string deviceId, bool prepareResult, bool startResult,
+        const std::string &dhids, const std::string &object) = 0;
+    /*
+     * The responses carrying the correlation id of the request, the id is 0 when the sink does not echo it.
+     */
+    virtual void OnResponseStartRemoteInputById(const std::string deviceId, const uint32_t inputTypes, bool result,
+        uint64_t requestId)
+    {
+        (void)requestId;
+        OnResponseStartRemoteInput(deviceId, inputTypes, result);
+    }
+    virtual void OnResponseStopRemoteInputById(const std::string deviceId, const uint32_t inputTypes, bool result,
+        uint64_t requestId)
+    {
+        (void)requestId;
+        OnResponseStopRemoteInput(deviceId, inputTypes, result);
+    }
+    virtual void OnResponseStartRemoteInputDhidById(const std::string deviceId, const std::string &dhids,
+        bool result, uint64_t requestId)
+    {
+        (void)requestId;
+        OnResponseStartRemoteInputDhid(deviceId, dhids, result);
+    }
+    virtual void OnResponseStopRemoteInputDhidById(const std::string deviceId, const std::string &dhids,
+        bool result, uint64_t requestId)
+    {
+        (void)requestId;
+        OnResponseStopRemoteInputDhid(deviceId, dhids, result);
+    }
+    virtual void OnResponsePrepareStartRemoteInputById(const std::string deviceId, bool prepareResult,
+        bool startResult, const std::string &dhids, const std::string &object, uint64_t requestId)
+    {
+        (void)requestId;
+        OnResponsePrepareStartRemoteInput(deviceId, prepareResult, startResult, dhids, object);
+    }
     virtual void OnResponseKeyState(const std::string deviceId, const std::string &dhid, const uint32_t type,
         const uint32_t code, const uint32_t value) = 0;
     virtual void OnResponseKeyStateBatch(const std::string deviceId, const std::string &object) = 0;
     virtual void OnReceivedEventRemoteInput(const std::string deviceId, const std::string &object) = 0;
+    virtual void OnReceivedTracedEventRemoteInput(const std::string deviceId, const std::string &object,
+        const TraceStamps &stamps)
+    {
+        (void)stamps;
+        OnReceivedEventRemoteInput(deviceId, object);
+    }
 
     virtual void OnResponseRelayPrepareRemoteInput(int32_t sessionId, const std::string &deviceId, bool result,
         const std::string &object) = 0;
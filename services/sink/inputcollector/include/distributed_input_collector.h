@@ -65,6 +65,10 @@ private:
     static void *CollectEventsThread(void *param);
     void StartCollectEventsThread();
     void StopCollectEventsThread();
+#ifdef DINPUT_EVENT_RECORD
+    void RecordCollectedEvents(const RawEvent *events, size_t count);
+#endif
+    void SendEventBatch(const RawEvent *events, size_t count);
 
     RawEvent mEventBuffer[INPUT_EVENT_BUFFER_SIZE];
     pthread_t collectThreadID_;
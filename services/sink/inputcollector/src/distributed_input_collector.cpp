@@ -30,16 +30,29 @@
 #include "nlohmann/json.hpp"
 
 #include "dinput_errcode.h"
+#ifdef DINPUT_EVENT_RECORD
+#include "dinput_event_record.h"
+#endif
+#include "dinput_latency_trace.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_utils_tool.h"
 
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    constexpr int64_t NS_PER_US = 1000;
+}
 DistributedInputCollector::DistributedInputCollector() : mEventBuffer{}, collectThreadID_(-1),
     isCollectingEvents_(false), isStartGetDeviceHandlerThread(false), inputTypes_(0)
 {
     inputHub_ = std::make_unique<InputHub>(false);
+#ifdef DINPUT_EVENT_RECORD
+    DInputEventReplayer::GetInstance().RegisterBatchCallback([this](std::vector<RawEvent> &events) {
+        SendEventBatch(events.data(), events.size());
+    });
+#endif
 }
 
 DistributedInputCollector::~DistributedInputCollector()
@@ -128,27 +141,83 @@ void DistributedInputCollector::StartCollectEventsThread()
             continue;
         }
 
-        // The RawEvent obtained by the controlled end calls transport and is
-        // sent to the main control end.
-        std::shared_ptr<nlohmann::json> jsonArrayMsg = std::make_shared<nlohmann::json>();
-        for (size_t ind = 0; ind < count; ind++) {
-            nlohmann::json tmpJson;
-            tmpJson[INPUT_KEY_WHEN] = mEventBuffer[ind].when;
-            tmpJson[INPUT_KEY_TYPE] = mEventBuffer[ind].type;
-            tmpJson[INPUT_KEY_CODE] = mEventBuffer[ind].code;
-            tmpJson[INPUT_KEY_VALUE] = mEventBuffer[ind].value;
-            tmpJson[INPUT_KEY_PATH] = mEventBuffer[ind].path;
-            tmpJson[INPUT_KEY_DESCRIPTOR] = mEventBuffer[ind].descriptor;
-            jsonArrayMsg->push_back(tmpJson);
+#ifdef DINPUT_EVENT_RECORD
+        if (DInputEventRecorder::GetInstance().IsRecording()) {
+            RecordCollectedEvents(mEventBuffer, count);
         }
+#endif
+        SendEventBatch(mEventBuffer, count);
+    }
+    DHLOGW("DistributedInputCollector::StartCollectEventsThread exit!");
+}
 
-        AppExecFwk::InnerEvent::Pointer msgEvent = AppExecFwk::InnerEvent::Get(
-            static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_MSG), jsonArrayMsg, 0);
-        if (sinkHandler_ != nullptr) {
-            sinkHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+#ifdef DINPUT_EVENT_RECORD
+void DistributedInputCollector::RecordCollectedEvents(const RawEvent *events, size_t count)
+{
+    DInputEventRecorder &recorder = DInputEventRecorder::GetInstance();
+    std::vector<InputDevice> devices;
+    for (size_t ind = 0; ind < count; ind++) {
+        if (recorder.HasDevice(events[ind].descriptor)) {
+            continue;
+        }
+        if (devices.empty()) {
+            devices = inputHub_->GetAllInputDevices();
+        }
+        for (const auto &device : devices) {
+            if (device.descriptor == events[ind].descriptor) {
+                recorder.RecordDevice(device.descriptor, events[ind].path, InputDeviceToJson(device));
+                break;
+            }
         }
     }
-    DHLOGW("DistributedInputCollector::StartCollectEventsThread exit!");
+    recorder.RecordEvents(events, count);
+}
+#endif
+
+void DistributedInputCollector::SendEventBatch(const RawEvent *events, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    bool isTraceEnabled = DInputLatencyTrace::GetInstance().IsEnabled();
+    TraceStamps stamps {};
+    if (isTraceEnabled) {
+        DInputLatencyTrace::Stamp(stamps, TraceStage::HUB_READ);
+        stamps[static_cast<size_t>(TraceStage::KERNEL_EVENT)] =
+            static_cast<uint64_t>(events[0].when / NS_PER_US);
+    }
+
+    // The RawEvent obtained by the controlled end calls transport and is
+    // sent to the main control end.
+    std::shared_ptr<nlohmann::json> jsonArrayMsg = std::make_shared<nlohmann::json>();
+    for (size_t ind = 0; ind < count; ind++) {
+        nlohmann::json tmpJson;
+        tmpJson[INPUT_KEY_WHEN] = events[ind].when;
+        tmpJson[INPUT_KEY_TYPE] = events[ind].type;
+        tmpJson[INPUT_KEY_CODE] = events[ind].code;
+        tmpJson[INPUT_KEY_VALUE] = events[ind].value;
+        tmpJson[INPUT_KEY_PATH] = events[ind].path;
+        tmpJson[INPUT_KEY_DESCRIPTOR] = events[ind].descriptor;
+        jsonArrayMsg->push_back(tmpJson);
+    }
+
+    std::shared_ptr<TracedEventBatch> tracedBatch = nullptr;
+    if (isTraceEnabled) {
+        tracedBatch = std::make_shared<TracedEventBatch>();
+        tracedBatch->events = jsonArrayMsg;
+        tracedBatch->stamps = stamps;
+        DInputLatencyTrace::Stamp(tracedBatch->stamps, TraceStage::COLLECTOR_ENCODE);
+    }
+    AppExecFwk::InnerEvent::Pointer msgEvent = (tracedBatch != nullptr) ?
+        AppExecFwk::InnerEvent::Get(
+            static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_TRACE_MSG), tracedBatch, 0) :
+        AppExecFwk::InnerEvent::Get(
+            static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_MSG), jsonArrayMsg, 0);
+    DInputMetrics::GetInstance().RecordHistogram(MetricHistogram::EVENTS_PER_BATCH, count);
+    if (sinkHandler_ != nullptr &&
+        sinkHandler_->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE)) {
+        DInputMetrics::GetInstance().AddGauge(MetricGauge::SINK_SEND_QUEUE_DEPTH, 1);
+    }
 }
 
 void DistributedInputCollector::StopCollectEventsThread()
@@ -73,6 +73,8 @@ public:
         void OnStopRemoteInput(const int32_t &sessionId, const uint32_t &inputTypes) override;
         void OnStartRemoteInputDhid(const int32_t &sessionId, const std::string &strDhids) override;
         void OnStopRemoteInputDhid(const int32_t &sessionId, const std::string &strDhids) override;
+        void OnPrepareStartRemoteInputDhid(const int32_t &sessionId, const std::string &deviceId,
+            const std::string &strDhids) override;
 
         void OnRelayPrepareRemoteInput(const int32_t &toSrcSessionId, const int32_t &toSinkSessionId,
             const std::string &deviceId) override;
@@ -88,6 +90,8 @@ public:
             const std::string &deviceId, uint32_t inputTypes) override;
 
     private:
+        void ShareStartedDhIds(const int32_t &sessionId, const std::string &strDhids);
+
         DistributedInputSinkManager *sinkManagerObj_;
     };
 
@@ -144,6 +144,7 @@ void DistributedInputSinkManager::DInputSinkListener::OnPrepareRemoteInput(
     DistributedInputSinkSwitch::GetInstance().AddSession(sessionId);
     sinkManagerObj_->QueryLocalWhiteList(jsonStr);
     jsonStr[DINPUT_SOFTBUS_KEY_RESP_VALUE] = true;
+    jsonStr[DINPUT_SOFTBUS_KEY_PREPARE_START] = true;
     smsg = jsonStr.dump();
     DistributedInputSinkTransport::GetInstance().RespPrepareRemoteInput(sessionId, smsg);
 }
@@ -304,6 +305,42 @@ void DistributedInputSinkManager::DInputSinkListener::OnStartRemoteInputDhid(con
         DHLOGE("StartSwitch error.");
         return;
     }
+    ShareStartedDhIds(sessionId, strDhids);
+}
+
+void DistributedInputSinkManager::DInputSinkListener::OnPrepareStartRemoteInputDhid(const int32_t &sessionId,
+    const std::string &deviceId, const std::string &strDhids)
+{
+    if (sinkManagerObj_ == nullptr) {
+        DHLOGE("sinkManagerObj is null.");
+        return;
+    }
+    DHLOGI("OnPrepareStartRemoteInputDhid called, sessionId: %{public}d, devId: %{public}s", sessionId,
+        GetAnonyString(deviceId).c_str());
+    // the prepare part, same as OnPrepareRemoteInput
+    DistributedInputSinkSwitch::GetInstance().AddSession(sessionId);
+    nlohmann::json jsonStr;
+    jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_ON_PREPARE_START;
+    sinkManagerObj_->QueryLocalWhiteList(jsonStr);
+    jsonStr[DINPUT_SOFTBUS_KEY_RESP_VALUE] = true;
+
+    // the start part, same as OnStartRemoteInputDhid
+    int32_t startRes = DistributedInputSinkSwitch::GetInstance().StartSwitch(sessionId);
+    jsonStr[DINPUT_SOFTBUS_KEY_START_RESP_VALUE] = (startRes == DH_SUCCESS);
+    jsonStr[DINPUT_SOFTBUS_KEY_VECTOR_DHID] = strDhids;
+    std::string smsg = jsonStr.dump();
+    DistributedInputSinkTransport::GetInstance().RespPrepareRemoteInput(sessionId, smsg);
+
+    if (startRes != DH_SUCCESS) {
+        DHLOGE("StartSwitch error.");
+        return;
+    }
+    ShareStartedDhIds(sessionId, strDhids);
+}
+
+void DistributedInputSinkManager::DInputSinkListener::ShareStartedDhIds(const int32_t &sessionId,
+    const std::string &strDhids)
+{
     if (sinkManagerObj_ == nullptr) {
         DHLOGE("sinkManagerObj is null.");
         return;
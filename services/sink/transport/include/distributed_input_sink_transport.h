@@ -16,6 +16,7 @@
 #ifndef DISTRIBUTED_INPUT_SINK_TRANSPORT_H
 #define DISTRIBUTED_INPUT_SINK_TRANSPORT_H
 
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <string>
@@ -25,10 +26,12 @@
 #include "event_handler.h"
 #include "nlohmann/json.hpp"
 
+#include "dinput_latency_trace.h"
 #include "dinput_sink_trans_callback.h"
 #include "dinput_transbase_sink_callback.h"
 #include "dinput_softbus_define.h"
 #include "distributed_input_sink_switch.h"
+#include "sink_congestion_control.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -69,6 +72,24 @@ public:
 
         void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event) override;
         void RecordEventLog(const std::shared_ptr<nlohmann::json> &events);
+        /*
+         * Drop the batches still queued or held, they have no session to go to.
+         */
+        void PurgeInputData();
+
+    private:
+        /*
+         * Send the batch at once on a clear link, or hold it for the batching window of the congestion mode.
+         */
+        void QueueInputData(const std::shared_ptr<nlohmann::json> &events, TraceStamps *stamps);
+        void FlushInputData();
+        void SendInputData(const std::shared_ptr<nlohmann::json> &events, TraceStamps *stamps);
+
+        SinkEventCoalescer coalescer_;
+        // the stamps of the first traced batch held, the trace measures its oldest event.
+        TraceStamps heldStamps_ {};
+        bool hasHeldStamps_ = false;
+        bool isFlushScheduled_ = false;
     };
 
     std::shared_ptr<DistributedInputSinkTransport::DInputSinkEventHandler> GetEventHandler();
@@ -85,6 +106,7 @@ private:
     void NotifyLatency(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyStartRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyStopRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg);
+    void NotifyPrepareStartRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg);
 
     void NotifyRelayPrepareRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyRelayUnprepareRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
@@ -97,11 +119,19 @@ private:
     void RecordEventLog(const std::vector<struct RawEvent> &events);
 
     void DoSendMsgBatch(const int32_t sessionId, const std::vector<struct RawEvent> &events);
+    /*
+     * Point the congestion controller at the session the events are switched to, its signals are dropped when
+     * that session changes.
+     */
+    void UpdateCongestionSession(int32_t sessionId);
 private:
     std::string mySessionName_;
     std::shared_ptr<DistributedInputSinkTransport::DInputSinkEventHandler> eventHandler_;
     std::shared_ptr<DistributedInputSinkTransport::DInputTransbaseSinkListener> statuslistener_;
     std::shared_ptr<DInputSinkTransCallback> callback_;
+    SinkCongestionController congestionController_;
+    // the session whose link the controller measures, 0 if none.
+    std::atomic<int32_t> congestionSessionId_ = 0;
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SINK_CONGESTION_CONTROL_H
+#define SINK_CONGESTION_CONTROL_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+enum class CongestionMode : int32_t {
+    // every batch is sent as soon as it is read.
+    NORMAL = 0,
+    // batches are held for a short window, motion is coalesced.
+    CONGESTED = 1,
+    // as CONGESTED with a wider window.
+    SEVERE = 2,
+};
+
+/*
+ * Picks the send mode of the sink from the cost of the blocking softbus send, the send failures and the RTT
+ * reported by the latency probe of the source. A worse mode is entered on the first signal, a better one
+ * only after the link stayed clear for RECOVER_HOLD_US, one step at a time.
+ */
+class SinkCongestionController {
+public:
+    static constexpr uint64_t RECOVER_HOLD_US = 1000 * 1000;
+
+    void OnSendResult(uint64_t costUs, bool isSuccess, uint64_t now);
+    void OnRtt(uint64_t rttUs, uint64_t now);
+    /*
+     * The mode at the given time, a clear link is noticed here even when nothing is sent.
+     */
+    CongestionMode GetMode(uint64_t now);
+    void Reset();
+    /*
+     * How long a batch may wait to be merged with the next ones, 0 in the NORMAL mode.
+     */
+    static int64_t GetBatchWindowMs(CongestionMode mode);
+
+private:
+    CongestionMode GetSignaledMode(uint64_t now) const;
+    void Update(uint64_t now);
+
+    std::mutex mutex_;
+    CongestionMode mode_ = CongestionMode::NORMAL;
+    // the last time the signals asked for the current mode or a worse one.
+    uint64_t lastSignalTime_ = 0;
+    double sendCostUs_ = 0;
+    uint32_t sendFailNum_ = 0;
+    uint64_t lastSendTime_ = 0;
+    // the recent RTT samples, the lowest one is the RTT of the idle link.
+    std::deque<uint64_t> rtts_;
+    uint64_t lastRttTime_ = 0;
+};
+
+/*
+ * Merges the event batches held during a batching window. A pointer frame, up to its SYN_REPORT, is merged
+ * into the previous frame of the same device when both only move it: relative axes are summed and absolute
+ * axes keep their latest value. Frames with keys, multi touch slots or tracking ids are never merged, so
+ * the source sees the same final state with fewer frames. Not thread safe, it is owned by the send thread.
+ */
+class SinkEventCoalescer {
+public:
+    void Append(const nlohmann::json &events);
+    /*
+     * Move the held events out in their order, the coalescer is empty after.
+     */
+    void Take(nlohmann::json &events);
+    bool IsEmpty() const;
+    bool HasKeyEvent() const;
+    size_t GetEventNum() const;
+    // the events merged away since the last Take.
+    size_t GetCoalescedNum() const;
+
+private:
+    enum class FrameKind {
+        OTHER = 0,
+        REL,
+        ABS,
+    };
+    struct Frame {
+        std::string path;
+        std::vector<nlohmann::json> events;
+        FrameKind kind = FrameKind::OTHER;
+        bool isClosed = false;
+    };
+    static FrameKind GetFrameKind(const Frame &frame);
+    void CloseFrame(size_t index);
+    void MergeFrame(Frame &prev, Frame &frame);
+
+    std::vector<Frame> frames_;
+    size_t eventNum_ = 0;
+    size_t coalescedNum_ = 0;
+    bool hasKeyEvent_ = false;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // SINK_CONGESTION_CONTROL_H
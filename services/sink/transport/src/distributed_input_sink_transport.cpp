@@ -15,6 +15,7 @@
 
 #include "distributed_input_sink_transport.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "linux/input.h"
@@ -25,7 +26,9 @@
 #include "constants_dinput.h"
 #include "dinput_context.h"
 #include "dinput_errcode.h"
+#include "dinput_latency_trace.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_softbus_define.h"
 #include "dinput_utils_tool.h"
 #include "hidumper.h"
@@ -40,6 +43,24 @@ namespace DistributedInput {
 namespace {
     // each time, we send msg batch with MAX 20 events.
     constexpr int32_t MSG_BTACH_MAX_SIZE = 20;
+    /*
+     * The correlation id of the request HandleData is dispatching, the sink manager answers on the same thread
+     * before HandleData returns, so the response picks the id up here without threading it through the callbacks.
+     */
+    thread_local uint64_t g_handlingRequestId = INVALID_REQUEST_ID;
+
+    void AttachRequestId(std::string &smsg)
+    {
+        if (g_handlingRequestId == INVALID_REQUEST_ID) {
+            return;
+        }
+        nlohmann::json jsonStr = nlohmann::json::parse(smsg, nullptr, false);
+        if (jsonStr.is_discarded() || !jsonStr.is_object()) {
+            return;
+        }
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = g_handlingRequestId;
+        smsg = jsonStr.dump();
+    }
 }
 DistributedInputSinkTransport::DistributedInputSinkTransport() : mySessionName_("")
 {
@@ -78,22 +99,29 @@ void DistributedInputSinkTransport::DInputSinkEventHandler::ProcessEvent(const A
     EHandlerMsgType eventId = static_cast<EHandlerMsgType>(event->GetInnerEventId());
     switch (eventId) {
         case EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_MSG: {
+            DInputMetrics::GetInstance().AddGauge(MetricGauge::SINK_SEND_QUEUE_DEPTH, -1);
             std::shared_ptr<nlohmann::json> innerMsg = event->GetSharedObject<nlohmann::json>();
             if (innerMsg == nullptr) {
                 DHLOGE("innerMsg is null.");
                 break;
             }
-            nlohmann::json jsonStr;
-            jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_BODY_DATA;
-            jsonStr[DINPUT_SOFTBUS_KEY_INPUT_DATA] = innerMsg->dump();
-            std::string smsg = jsonStr.dump();
-            RecordEventLog(innerMsg);
-            int32_t sessionId = DistributedInputSinkSwitch::GetInstance().GetSwitchOpenedSession();
-            if (sessionId > 0) {
-                DistributedInputSinkTransport::GetInstance().SendMessage(sessionId, smsg);
-            } else {
-                DHLOGE("ProcessEvent can't send input data, because no session switch on.");
+            QueueInputData(innerMsg, nullptr);
+            break;
+        }
+        case EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_TRACE_MSG: {
+            DInputMetrics::GetInstance().AddGauge(MetricGauge::SINK_SEND_QUEUE_DEPTH, -1);
+            std::shared_ptr<TracedEventBatch> tracedBatch = event->GetSharedObject<TracedEventBatch>();
+            if (tracedBatch == nullptr || tracedBatch->events == nullptr) {
+                DHLOGE("tracedBatch is null.");
+                break;
             }
+            DInputLatencyTrace::Stamp(tracedBatch->stamps, TraceStage::RUNNER_DEQUEUE);
+            QueueInputData(tracedBatch->events, &tracedBatch->stamps);
+            break;
+        }
+        case EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_FLUSH_MSG: {
+            isFlushScheduled_ = false;
+            FlushInputData();
             break;
         }
         default:
@@ -102,6 +130,109 @@ void DistributedInputSinkTransport::DInputSinkEventHandler::ProcessEvent(const A
     }
 }
 
+void DistributedInputSinkTransport::DInputSinkEventHandler::QueueInputData(
+    const std::shared_ptr<nlohmann::json> &events, TraceStamps *stamps)
+{
+    DistributedInputSinkTransport::GetInstance().UpdateCongestionSession(
+        DistributedInputSinkSwitch::GetInstance().GetSwitchOpenedSession());
+    CongestionMode mode = DistributedInputSinkTransport::GetInstance().congestionController_.GetMode(
+        GetCurrentTimeUs());
+    if (mode == CongestionMode::NORMAL && coalescer_.IsEmpty()) {
+        SendInputData(events, stamps);
+        return;
+    }
+    if (stamps != nullptr && !hasHeldStamps_) {
+        heldStamps_ = *stamps;
+        hasHeldStamps_ = true;
+    }
+    coalescer_.Append(*events);
+    // keys are never held, they go out together with the motion held before them.
+    if (mode == CongestionMode::NORMAL || coalescer_.HasKeyEvent() ||
+        coalescer_.GetEventNum() >= INPUT_EVENT_BUFFER_SIZE) {
+        FlushInputData();
+        return;
+    }
+    if (isFlushScheduled_) {
+        return;
+    }
+    AppExecFwk::InnerEvent::Pointer flushEvent = AppExecFwk::InnerEvent::Get(
+        static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_FLUSH_MSG), 0);
+    isFlushScheduled_ = SendEvent(flushEvent, SinkCongestionController::GetBatchWindowMs(mode),
+        AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    if (!isFlushScheduled_) {
+        DHLOGE("Schedule the flush of the held events failed.");
+        FlushInputData();
+    }
+}
+
+void DistributedInputSinkTransport::DInputSinkEventHandler::PurgeInputData()
+{
+    RemoveEvent(static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_MSG));
+    RemoveEvent(static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_TRACE_MSG));
+    // the batches removed never reach ProcessEvent, so they are taken off the queue depth here.
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::SINK_SEND_QUEUE_DEPTH, 0);
+    PostTask([this]() {
+        RemoveEvent(static_cast<uint32_t>(EHandlerMsgType::DINPUT_SINK_EVENT_HANDLER_FLUSH_MSG));
+        isFlushScheduled_ = false;
+        nlohmann::json events;
+        coalescer_.Take(events);
+        hasHeldStamps_ = false;
+    }, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
+void DistributedInputSinkTransport::DInputSinkEventHandler::FlushInputData()
+{
+    if (coalescer_.IsEmpty()) {
+        return;
+    }
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::SINK_EVENTS_COALESCED, coalescer_.GetCoalescedNum());
+    std::shared_ptr<nlohmann::json> events = std::make_shared<nlohmann::json>();
+    coalescer_.Take(*events);
+    SendInputData(events, hasHeldStamps_ ? &heldStamps_ : nullptr);
+    hasHeldStamps_ = false;
+}
+
+void DistributedInputSinkTransport::DInputSinkEventHandler::SendInputData(
+    const std::shared_ptr<nlohmann::json> &events, TraceStamps *stamps)
+{
+    nlohmann::json jsonStr;
+    jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_BODY_DATA;
+    jsonStr[DINPUT_SOFTBUS_KEY_INPUT_DATA] = events->dump();
+    if (stamps != nullptr) {
+        DInputLatencyTrace::Stamp(*stamps, TraceStage::SEND_BYTES);
+        jsonStr[DINPUT_SOFTBUS_KEY_TRACE_STAMPS] = DInputLatencyTrace::StampsToJson(*stamps);
+    }
+    std::string smsg = jsonStr.dump();
+    RecordEventLog(events);
+    int32_t sessionId = DistributedInputSinkSwitch::GetInstance().GetSwitchOpenedSession();
+    if (sessionId <= 0) {
+        DHLOGE("ProcessEvent can't send input data, because no session switch on.");
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::SEND_FAILURES);
+        return;
+    }
+    // the batches go on the data session of the peer if it opened one.
+    sessionId = DistributedInputTransportBase::GetInstance().GetDataSessionId(sessionId);
+    uint64_t sendTime = GetCurrentTimeUs();
+    int32_t ret = DistributedInputSinkTransport::GetInstance().SendMessage(sessionId, smsg);
+    uint64_t curTime = GetCurrentTimeUs();
+    DistributedInputSinkTransport::GetInstance().congestionController_.OnSendResult(
+        curTime > sendTime ? curTime - sendTime : 0, ret == DH_SUCCESS, curTime);
+    if (ret != DH_SUCCESS) {
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::SEND_FAILURES);
+        return;
+    }
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::BATCHES_SENT);
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::BYTES_SENT, smsg.size());
+}
+
+void DistributedInputSinkTransport::UpdateCongestionSession(int32_t sessionId)
+{
+    sessionId = std::max(sessionId, 0);
+    if (congestionSessionId_.exchange(sessionId) != sessionId) {
+        congestionController_.Reset();
+    }
+}
+
 int32_t DistributedInputSinkTransport::Init()
 {
     DHLOGI("Init");
@@ -133,6 +264,7 @@ int32_t DistributedInputSinkTransport::RespPrepareRemoteInput(
     const int32_t sessionId, std::string &smsg)
 {
     if (sessionId > 0) {
+        AttachRequestId(smsg);
         DHLOGI("RespPrepareRemoteInput sessionId: %{public}d, smsg:%{public}s.", sessionId, SetAnonyId(smsg).c_str());
         int32_t ret = SendMessage(sessionId, smsg);
         if (ret != DH_SUCCESS) {
@@ -165,6 +297,7 @@ int32_t DistributedInputSinkTransport::RespUnprepareRemoteInput(const int32_t se
 int32_t DistributedInputSinkTransport::RespStartRemoteInput(const int32_t sessionId, std::string &smsg)
 {
     if (sessionId > 0) {
+        AttachRequestId(smsg);
         DHLOGI("RespStartRemoteInput sessionId: %{public}d, smsg:%{public}s.", sessionId, SetAnonyId(smsg).c_str());
         int32_t ret = SendMessage(sessionId, smsg);
         if (ret != DH_SUCCESS) {
@@ -181,6 +314,7 @@ int32_t DistributedInputSinkTransport::RespStartRemoteInput(const int32_t sessio
 int32_t DistributedInputSinkTransport::RespStopRemoteInput(const int32_t sessionId, std::string &smsg)
 {
     if (sessionId > 0) {
+        AttachRequestId(smsg);
         DHLOGI("RespStopRemoteInput sessionId: %{public}d, smsg:%{public}s.", sessionId, SetAnonyId(smsg).c_str());
         int32_t ret = SendMessage(sessionId, smsg);
         if (ret != DH_SUCCESS) {
@@ -402,14 +536,31 @@ void DistributedInputSinkTransport::NotifyStopRemoteInput(int32_t sessionId, con
 
 void DistributedInputSinkTransport::NotifyLatency(int32_t sessionId, const nlohmann::json &recMsg)
 {
+    uint64_t receiveTime = GetCurrentTimeUs();
     if (!IsString(recMsg, DINPUT_SOFTBUS_KEY_DEVICE_ID)) {
         DHLOGE("The key is invaild.");
         return;
     }
 
+    if (IsBoolean(recMsg, DINPUT_SOFTBUS_KEY_TRACE_ENABLE)) {
+        DInputLatencyTrace::GetInstance().SetEnabled(recMsg[DINPUT_SOFTBUS_KEY_TRACE_ENABLE].get<bool>());
+    }
+    // the probes of the other sources measure links the events do not take.
+    if (IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_LATENCY_RTT) &&
+        sessionId == DistributedInputSinkSwitch::GetInstance().GetSwitchOpenedSession()) {
+        UpdateCongestionSession(sessionId);
+        congestionController_.OnRtt(recMsg[DINPUT_SOFTBUS_KEY_LATENCY_RTT].get<uint64_t>(), receiveTime);
+    }
+
     nlohmann::json jsonStr;
     jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_LATENCY;
     jsonStr[DINPUT_SOFTBUS_KEY_RESP_VALUE] = true;
+    // an older source sends no origin time, it only measures the RTT.
+    if (IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME)) {
+        jsonStr[DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME] = recMsg[DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME];
+        jsonStr[DINPUT_SOFTBUS_KEY_LATENCY_RECEIVE_TIME] = receiveTime;
+        jsonStr[DINPUT_SOFTBUS_KEY_LATENCY_TRANSMIT_TIME] = GetCurrentTimeUs();
+    }
     std::string smsg = jsonStr.dump();
     RespLatency(sessionId, smsg);
 }
@@ -432,6 +583,25 @@ void DistributedInputSinkTransport::NotifyStartRemoteInputDhid(int32_t sessionId
     callback_->OnStartRemoteInputDhid(sessionId, strTmp);
 }
 
+void DistributedInputSinkTransport::NotifyPrepareStartRemoteInputDhid(int32_t sessionId,
+    const nlohmann::json &recMsg)
+{
+    if (!IsString(recMsg, DINPUT_SOFTBUS_KEY_DEVICE_ID) ||
+        !IsString(recMsg, DINPUT_SOFTBUS_KEY_VECTOR_DHID)) {
+        DHLOGE("The key is invaild.");
+        return;
+    }
+    std::string deviceId = recMsg[DINPUT_SOFTBUS_KEY_DEVICE_ID];
+    std::string strTmp = recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID];
+    DHLOGI("OnBytesReceived cmdType is TRANS_SOURCE_MSG_PREPARE_START_DHID deviceId:%{public}s .",
+        GetAnonyString(deviceId).c_str());
+    if (callback_ == nullptr) {
+        DHLOGE("callback_ is nullptr.");
+        return;
+    }
+    callback_->OnPrepareStartRemoteInputDhid(sessionId, deviceId, strTmp);
+}
+
 void DistributedInputSinkTransport::NotifyStopRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg)
 {
     if (!IsString(recMsg, DINPUT_SOFTBUS_KEY_DEVICE_ID) ||
@@ -569,6 +739,15 @@ void DistributedInputSinkTransport::NotifyRelayStopTypeRemoteInput(int32_t sessi
 void DistributedInputSinkTransport::DInputTransbaseSinkListener::NotifySessionClosed(int32_t sessionId)
 {
     DistributedInputSinkSwitch::GetInstance().RemoveSession(sessionId);
+    int32_t congestionSessionId = sessionId;
+    if (DistributedInputSinkTransport::GetInstance().congestionSessionId_.compare_exchange_strong(
+        congestionSessionId, 0)) {
+        DistributedInputSinkTransport::GetInstance().congestionController_.Reset();
+    }
+    if (DistributedInputSinkSwitch::GetInstance().GetSwitchOpenedSession() <= 0 &&
+        DistributedInputSinkTransport::GetInstance().eventHandler_ != nullptr) {
+        DistributedInputSinkTransport::GetInstance().eventHandler_->PurgeInputData();
+    }
 }
 
 void DistributedInputSinkTransport::DInputTransbaseSinkListener::HandleSessionData(int32_t sessionId,
@@ -621,6 +800,8 @@ void DistributedInputSinkTransport::HandleData(int32_t sessionId, const std::str
         return;
     }
     uint32_t cmdType = recMsg[DINPUT_SOFTBUS_KEY_CMD_TYPE];
+    g_handlingRequestId = IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_REQUEST_ID) ?
+        recMsg[DINPUT_SOFTBUS_KEY_REQUEST_ID].get<uint64_t>() : INVALID_REQUEST_ID;
     switch (cmdType) {
         case TRANS_SOURCE_MSG_PREPARE:
             NotifyPrepareRemoteInput(sessionId, recMsg);
@@ -643,9 +824,13 @@ void DistributedInputSinkTransport::HandleData(int32_t sessionId, const std::str
         case TRANS_SOURCE_MSG_STOP_DHID:
             NotifyStopRemoteInputDhid(sessionId, recMsg);
             break;
+        case TRANS_SOURCE_MSG_PREPARE_START_DHID:
+            NotifyPrepareStartRemoteInputDhid(sessionId, recMsg);
+            break;
         default:
             HandleEventInner(sessionId, recMsg);
     }
+    g_handlingRequestId = INVALID_REQUEST_ID;
 }
 
 void DistributedInputSinkTransport::CloseAllSession()
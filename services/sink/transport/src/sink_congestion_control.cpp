@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sink_congestion_control.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <linux/input.h>
+
+#include "constants_dinput.h"
+#include "dinput_log.h"
+#include "dinput_metrics.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr double SEND_COST_GAIN = 8.0;
+    // SendBytes returns in well under a millisecond while softbus keeps up.
+    constexpr double CONGESTED_SEND_COST_US = 4000;
+    constexpr double SEVERE_SEND_COST_US = 16000;
+    constexpr uint32_t SEVERE_SEND_FAIL_NUM = 3;
+    // the RTT above the one of the idle link, which is the queueing on the way.
+    constexpr uint64_t CONGESTED_RTT_EXCESS_US = 20 * 1000;
+    constexpr uint64_t SEVERE_RTT_EXCESS_US = 80 * 1000;
+    // about three seconds of probes.
+    constexpr size_t RTT_WINDOW = 64;
+    // a signal not refreshed for this long no longer tells anything about the link.
+    constexpr uint64_t SIGNAL_STALE_US = 1000 * 1000;
+    constexpr int64_t CONGESTED_BATCH_WINDOW_MS = 8;
+    constexpr int64_t SEVERE_BATCH_WINDOW_MS = 16;
+
+    bool IsStale(uint64_t signalTime, uint64_t now)
+    {
+        return signalTime == 0 || (now > signalTime && now - signalTime > SIGNAL_STALE_US);
+    }
+
+    const char *GetModeName(CongestionMode mode)
+    {
+        switch (mode) {
+            case CongestionMode::CONGESTED:
+                return "congested";
+            case CongestionMode::SEVERE:
+                return "severe";
+            default:
+                return "normal";
+        }
+    }
+}
+
+void SinkCongestionController::OnSendResult(uint64_t costUs, bool isSuccess, uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (IsStale(lastSendTime_, now)) {
+        sendCostUs_ = 0;
+    }
+    sendCostUs_ += (static_cast<double>(costUs) - sendCostUs_) / SEND_COST_GAIN;
+    sendFailNum_ = isSuccess ? 0 : sendFailNum_ + 1;
+    lastSendTime_ = now;
+    Update(now);
+}
+
+void SinkCongestionController::OnRtt(uint64_t rttUs, uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rtts_.push_back(rttUs);
+    if (rtts_.size() > RTT_WINDOW) {
+        rtts_.pop_front();
+    }
+    lastRttTime_ = now;
+    Update(now);
+}
+
+CongestionMode SinkCongestionController::GetMode(uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Update(now);
+    return mode_;
+}
+
+void SinkCongestionController::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mode_ != CongestionMode::NORMAL) {
+        DHLOGI("Congestion mode reset to normal.");
+    }
+    mode_ = CongestionMode::NORMAL;
+    lastSignalTime_ = 0;
+    sendCostUs_ = 0;
+    sendFailNum_ = 0;
+    lastSendTime_ = 0;
+    rtts_.clear();
+    lastRttTime_ = 0;
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::SINK_CONGESTION_MODE,
+        static_cast<int64_t>(CongestionMode::NORMAL));
+}
+
+int64_t SinkCongestionController::GetBatchWindowMs(CongestionMode mode)
+{
+    switch (mode) {
+        case CongestionMode::CONGESTED:
+            return CONGESTED_BATCH_WINDOW_MS;
+        case CongestionMode::SEVERE:
+            return SEVERE_BATCH_WINDOW_MS;
+        default:
+            return 0;
+    }
+}
+
+CongestionMode SinkCongestionController::GetSignaledMode(uint64_t now) const
+{
+    double sendCostUs = 0;
+    uint32_t sendFailNum = 0;
+    if (!IsStale(lastSendTime_, now)) {
+        sendCostUs = sendCostUs_;
+        sendFailNum = sendFailNum_;
+    }
+    uint64_t rttExcessUs = 0;
+    if (!rtts_.empty() && !IsStale(lastRttTime_, now)) {
+        rttExcessUs = rtts_.back() - *std::min_element(rtts_.begin(), rtts_.end());
+    }
+    if (sendFailNum >= SEVERE_SEND_FAIL_NUM || sendCostUs >= SEVERE_SEND_COST_US ||
+        rttExcessUs >= SEVERE_RTT_EXCESS_US) {
+        return CongestionMode::SEVERE;
+    }
+    if (sendFailNum > 0 || sendCostUs >= CONGESTED_SEND_COST_US || rttExcessUs >= CONGESTED_RTT_EXCESS_US) {
+        return CongestionMode::CONGESTED;
+    }
+    return CongestionMode::NORMAL;
+}
+
+void SinkCongestionController::Update(uint64_t now)
+{
+    CongestionMode signaledMode = GetSignaledMode(now);
+    CongestionMode lastMode = mode_;
+    if (signaledMode >= mode_) {
+        mode_ = signaledMode;
+        lastSignalTime_ = now;
+    } else if (now < lastSignalTime_ || now - lastSignalTime_ >= RECOVER_HOLD_US) {
+        mode_ = static_cast<CongestionMode>(static_cast<int32_t>(mode_) - 1);
+        lastSignalTime_ = now;
+    }
+    if (mode_ == lastMode) {
+        return;
+    }
+    DHLOGI("Congestion mode changed from %{public}s to %{public}s, send cost: %{public}.0f us, "
+        "send fail num: %{public}u.", GetModeName(lastMode), GetModeName(mode_), sendCostUs_, sendFailNum_);
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::SINK_CONGESTION_MODE, static_cast<int64_t>(mode_));
+}
+
+void SinkEventCoalescer::Append(const nlohmann::json &events)
+{
+    if (!events.is_array()) {
+        return;
+    }
+    for (const auto &event : events) {
+        std::string path;
+        uint32_t type = 0;
+        uint32_t code = 0;
+        if (event.is_object()) {
+            path = event.value(INPUT_KEY_PATH, "");
+            type = event.value(INPUT_KEY_TYPE, 0u);
+            code = event.value(INPUT_KEY_CODE, 0u);
+        }
+        hasKeyEvent_ = hasKeyEvent_ || type == EV_KEY;
+
+        auto iter = std::find_if(frames_.rbegin(), frames_.rend(),
+            [&path](const Frame &frame) { return frame.path == path; });
+        if (iter == frames_.rend() || iter->isClosed) {
+            Frame frame;
+            frame.path = path;
+            frames_.push_back(std::move(frame));
+            iter = frames_.rbegin();
+        }
+        iter->events.push_back(event);
+        eventNum_++;
+        if (type == EV_SYN && code == SYN_REPORT) {
+            CloseFrame(static_cast<size_t>(std::distance(iter, frames_.rend())) - 1);
+        }
+    }
+}
+
+void SinkEventCoalescer::Take(nlohmann::json &events)
+{
+    events = nlohmann::json::array();
+    for (auto &frame : frames_) {
+        for (auto &event : frame.events) {
+            events.push_back(std::move(event));
+        }
+    }
+    frames_.clear();
+    eventNum_ = 0;
+    coalescedNum_ = 0;
+    hasKeyEvent_ = false;
+}
+
+bool SinkEventCoalescer::IsEmpty() const
+{
+    return frames_.empty();
+}
+
+bool SinkEventCoalescer::HasKeyEvent() const
+{
+    return hasKeyEvent_;
+}
+
+size_t SinkEventCoalescer::GetEventNum() const
+{
+    return eventNum_;
+}
+
+size_t SinkEventCoalescer::GetCoalescedNum() const
+{
+    return coalescedNum_;
+}
+
+SinkEventCoalescer::FrameKind SinkEventCoalescer::GetFrameKind(const Frame &frame)
+{
+    bool hasRel = false;
+    bool hasAbs = false;
+    for (const auto &event : frame.events) {
+        uint32_t type = event.value(INPUT_KEY_TYPE, 0u);
+        uint32_t code = event.value(INPUT_KEY_CODE, 0u);
+        if (type == EV_REL) {
+            hasRel = true;
+        } else if (type == EV_ABS && code != ABS_MT_SLOT && code != ABS_MT_TRACKING_ID) {
+            hasAbs = true;
+        } else if (type != EV_MSC && !(type == EV_SYN && code == SYN_REPORT)) {
+            return FrameKind::OTHER;
+        }
+    }
+    if (hasRel == hasAbs) {
+        return FrameKind::OTHER;
+    }
+    return hasRel ? FrameKind::REL : FrameKind::ABS;
+}
+
+void SinkEventCoalescer::CloseFrame(size_t index)
+{
+    Frame &frame = frames_[index];
+    frame.isClosed = true;
+    frame.kind = GetFrameKind(frame);
+    if (frame.kind == FrameKind::OTHER) {
+        return;
+    }
+    for (size_t prevIndex = index; prevIndex > 0; prevIndex--) {
+        Frame &prev = frames_[prevIndex - 1];
+        if (prev.path != frame.path) {
+            continue;
+        }
+        if (prev.isClosed && prev.kind == frame.kind) {
+            MergeFrame(prev, frame);
+            frames_.erase(frames_.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+        return;
+    }
+}
+
+void SinkEventCoalescer::MergeFrame(Frame &prev, Frame &frame)
+{
+    // a closed frame ends with its SYN_REPORT, the axes of the newer frame go before it.
+    auto prevEnd = prev.events.end() - 1;
+    for (auto &event : frame.events) {
+        uint32_t type = event.value(INPUT_KEY_TYPE, 0u);
+        uint32_t code = event.value(INPUT_KEY_CODE, 0u);
+        if (type == EV_SYN) {
+            (*prevEnd)[INPUT_KEY_WHEN] = event[INPUT_KEY_WHEN];
+            coalescedNum_++;
+            eventNum_--;
+            continue;
+        }
+        auto iter = std::find_if(prev.events.begin(), prevEnd, [type, code](const nlohmann::json &prevEvent) {
+            return prevEvent.value(INPUT_KEY_TYPE, 0u) == type && prevEvent.value(INPUT_KEY_CODE, 0u) == code;
+        });
+        if (iter == prevEnd) {
+            prevEnd = prev.events.insert(prevEnd, std::move(event)) + 1;
+            continue;
+        }
+        int64_t value = event.value(INPUT_KEY_VALUE, 0);
+        if (type == EV_REL) {
+            value = std::clamp<int64_t>(value + iter->value(INPUT_KEY_VALUE, 0),
+                std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+        }
+        (*iter)[INPUT_KEY_VALUE] = static_cast<int32_t>(value);
+        (*iter)[INPUT_KEY_WHEN] = event[INPUT_KEY_WHEN];
+        coalescedNum_++;
+        eventNum_--;
+    }
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
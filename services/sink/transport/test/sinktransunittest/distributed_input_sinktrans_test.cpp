@@ -15,6 +15,8 @@
 
 #include "distributed_input_sinktrans_test.h"
 
+#include <linux/input.h>
+
 #include "nlohmann/json.hpp"
 #include "dinput_errcode.h"
 #include "distributed_input_sink_manager.h"
@@ -39,6 +41,29 @@ namespace {
     const std::string STR_SESSIONID = "100";
     const std::string STR_INPUTTYPE = "111";
     const std::string SOFTBUSCMDTYPE = "softbus_cmd_type";
+    const std::string MOUSE_PATH = "/dev/input/event1";
+    const std::string TOUCH_PATH = "/dev/input/event2";
+    constexpr uint64_t CONGESTION_BASE_US = 1000 * 1000 * 1000;
+
+    nlohmann::json MakeEvent(const std::string &path, uint32_t type, uint32_t code, int32_t value, int64_t when)
+    {
+        nlohmann::json event;
+        event[INPUT_KEY_WHEN] = when;
+        event[INPUT_KEY_TYPE] = type;
+        event[INPUT_KEY_CODE] = code;
+        event[INPUT_KEY_VALUE] = value;
+        event[INPUT_KEY_PATH] = path;
+        event[INPUT_KEY_DESCRIPTOR] = DHID;
+        return event;
+    }
+
+    nlohmann::json MakeFrame(const std::string &path, uint32_t type, uint32_t code, int32_t value, int64_t when)
+    {
+        nlohmann::json frame = nlohmann::json::array();
+        frame.push_back(MakeEvent(path, type, code, value, when));
+        frame.push_back(MakeEvent(path, EV_SYN, SYN_REPORT, 0, when));
+        return frame;
+    }
 }
 
 bool SoftBusPermissionCheck::CheckSrcPermission(const std::string &sinkNetworkId)
@@ -66,6 +91,20 @@ bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
     return true;
 }
 
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    return true;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    (void)networkId;
+}
+
 void DistributedInputSinkTransTest::SetUp()
 {
 }
@@ -508,6 +547,136 @@ HWTEST_F(DistributedInputSinkTransTest, SendMessage_001, testing::ext::TestSize.
     int32_t ret = DistributedInputSinkTransport::GetInstance().SendMessage(sessionId, smsg);
     EXPECT_EQ(DH_SUCCESS, ret);
 }
+
+HWTEST_F(DistributedInputSinkTransTest, CongestionController_001, testing::ext::TestSize.Level1)
+{
+    SinkCongestionController controller;
+    uint64_t now = CONGESTION_BASE_US;
+    EXPECT_EQ(CongestionMode::NORMAL, controller.GetMode(now));
+    controller.OnSendResult(100, false, now);
+    EXPECT_EQ(CongestionMode::CONGESTED, controller.GetMode(now));
+    controller.OnSendResult(100, false, ++now);
+    controller.OnSendResult(100, false, ++now);
+    EXPECT_EQ(CongestionMode::SEVERE, controller.GetMode(now));
+
+    // the link clears, the mode recovers one step per hold time.
+    controller.OnSendResult(100, true, now);
+    EXPECT_EQ(CongestionMode::SEVERE, controller.GetMode(now + SinkCongestionController::RECOVER_HOLD_US - 1));
+    now += SinkCongestionController::RECOVER_HOLD_US;
+    EXPECT_EQ(CongestionMode::CONGESTED, controller.GetMode(now));
+    now += SinkCongestionController::RECOVER_HOLD_US;
+    EXPECT_EQ(CongestionMode::NORMAL, controller.GetMode(now));
+
+    EXPECT_EQ(0, SinkCongestionController::GetBatchWindowMs(CongestionMode::NORMAL));
+    EXPECT_GT(SinkCongestionController::GetBatchWindowMs(CongestionMode::CONGESTED), 0);
+    EXPECT_GT(SinkCongestionController::GetBatchWindowMs(CongestionMode::SEVERE),
+        SinkCongestionController::GetBatchWindowMs(CongestionMode::CONGESTED));
+}
+
+HWTEST_F(DistributedInputSinkTransTest, CongestionController_002, testing::ext::TestSize.Level1)
+{
+    SinkCongestionController controller;
+    uint64_t now = CONGESTION_BASE_US;
+    controller.OnRtt(5000, now);
+    controller.OnRtt(6000, now + 50000);
+    EXPECT_EQ(CongestionMode::NORMAL, controller.GetMode(now + 50000));
+    controller.OnRtt(40000, now + 100000);
+    EXPECT_EQ(CongestionMode::CONGESTED, controller.GetMode(now + 100000));
+    controller.OnRtt(120000, now + 150000);
+    EXPECT_EQ(CongestionMode::SEVERE, controller.GetMode(now + 150000));
+    controller.Reset();
+    EXPECT_EQ(CongestionMode::NORMAL, controller.GetMode(now + 150000));
+
+    // a send slowed down by softbus is a signal on its own.
+    controller.OnSendResult(50000, true, now);
+    EXPECT_EQ(CongestionMode::CONGESTED, controller.GetMode(now));
+}
+
+HWTEST_F(DistributedInputSinkTransTest, CongestionController_Session_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputSinkTransport &transport = DistributedInputSinkTransport::GetInstance();
+    int32_t switchedSessionId = 1000;
+    int32_t otherSessionId = 1001;
+    DistributedInputSinkSwitch::GetInstance().switchVector_.clear();
+    DistributedInputSinkSwitch::GetInstance().switchVector_.push_back({switchedSessionId, true});
+    DistributedInputSinkSwitch::GetInstance().switchVector_.push_back({otherSessionId, false});
+    transport.congestionSessionId_ = 0;
+    transport.congestionController_.Reset();
+
+    // only the probe of the session the events go to feeds the controller.
+    nlohmann::json recMsg;
+    recMsg[DINPUT_SOFTBUS_KEY_DEVICE_ID] = "devId_congestion";
+    recMsg[DINPUT_SOFTBUS_KEY_LATENCY_RTT] = static_cast<uint64_t>(5000);
+    transport.NotifyLatency(otherSessionId, recMsg);
+    EXPECT_TRUE(transport.congestionController_.rtts_.empty());
+    transport.NotifyLatency(switchedSessionId, recMsg);
+    EXPECT_EQ(1u, transport.congestionController_.rtts_.size());
+    EXPECT_EQ(switchedSessionId, transport.congestionSessionId_.load());
+
+    // closing another session keeps the state of the one still sending.
+    DistributedInputSinkTransport::DInputTransbaseSinkListener listener(&transport);
+    listener.NotifySessionClosed(otherSessionId);
+    EXPECT_EQ(1u, transport.congestionController_.rtts_.size());
+    listener.NotifySessionClosed(switchedSessionId);
+    EXPECT_TRUE(transport.congestionController_.rtts_.empty());
+    EXPECT_EQ(0, transport.congestionSessionId_.load());
+    DistributedInputSinkSwitch::GetInstance().switchVector_.clear();
+}
+
+HWTEST_F(DistributedInputSinkTransTest, EventCoalescer_001, testing::ext::TestSize.Level1)
+{
+    SinkEventCoalescer coalescer;
+    EXPECT_TRUE(coalescer.IsEmpty());
+    coalescer.Append(MakeFrame(MOUSE_PATH, EV_REL, REL_X, 3, 1000));
+    coalescer.Append(MakeFrame(MOUSE_PATH, EV_REL, REL_X, 4, 2000));
+    nlohmann::json batch = MakeFrame(MOUSE_PATH, EV_REL, REL_Y, -2, 3000);
+    batch.insert(batch.begin(), MakeEvent(MOUSE_PATH, EV_REL, REL_X, 1, 3000));
+    coalescer.Append(batch);
+    EXPECT_EQ(3u, coalescer.GetEventNum());
+    EXPECT_EQ(4u, coalescer.GetCoalescedNum());
+    EXPECT_FALSE(coalescer.HasKeyEvent());
+
+    // a button frame is a barrier, the motion after it is not moved before it.
+    coalescer.Append(MakeFrame(MOUSE_PATH, EV_KEY, BTN_LEFT, 1, 4000));
+    coalescer.Append(MakeFrame(MOUSE_PATH, EV_REL, REL_X, 5, 5000));
+    EXPECT_TRUE(coalescer.HasKeyEvent());
+
+    nlohmann::json events;
+    coalescer.Take(events);
+    EXPECT_TRUE(coalescer.IsEmpty());
+    ASSERT_EQ(7u, events.size());
+    EXPECT_EQ(REL_X, events[0][INPUT_KEY_CODE].get<uint32_t>());
+    EXPECT_EQ(8, events[0][INPUT_KEY_VALUE].get<int32_t>());
+    EXPECT_EQ(3000, events[0][INPUT_KEY_WHEN].get<int64_t>());
+    EXPECT_EQ(REL_Y, events[1][INPUT_KEY_CODE].get<uint32_t>());
+    EXPECT_EQ(-2, events[1][INPUT_KEY_VALUE].get<int32_t>());
+    EXPECT_EQ(SYN_REPORT, events[2][INPUT_KEY_CODE].get<uint32_t>());
+    EXPECT_EQ(EV_KEY, events[3][INPUT_KEY_TYPE].get<uint32_t>());
+    EXPECT_EQ(5, events[5][INPUT_KEY_VALUE].get<int32_t>());
+}
+
+HWTEST_F(DistributedInputSinkTransTest, EventCoalescer_002, testing::ext::TestSize.Level1)
+{
+    SinkEventCoalescer coalescer;
+    coalescer.Append(MakeFrame(TOUCH_PATH, EV_ABS, ABS_X, 100, 1000));
+    coalescer.Append(MakeFrame(MOUSE_PATH, EV_REL, REL_X, 1, 1500));
+    coalescer.Append(MakeFrame(TOUCH_PATH, EV_ABS, ABS_X, 120, 2000));
+    // only the latest absolute position of a device is kept.
+    EXPECT_EQ(4u, coalescer.GetEventNum());
+
+    // a slot change can not be merged, the frames around it keep their slot.
+    coalescer.Append(MakeFrame(TOUCH_PATH, EV_ABS, ABS_MT_SLOT, 1, 3000));
+    coalescer.Append(MakeFrame(TOUCH_PATH, EV_ABS, ABS_X, 130, 4000));
+    EXPECT_EQ(8u, coalescer.GetEventNum());
+
+    nlohmann::json events;
+    coalescer.Take(events);
+    ASSERT_EQ(8u, events.size());
+    EXPECT_EQ(120, events[0][INPUT_KEY_VALUE].get<int32_t>());
+    EXPECT_EQ(MOUSE_PATH, events[2][INPUT_KEY_PATH].get<std::string>());
+    EXPECT_EQ(ABS_MT_SLOT, events[4][INPUT_KEY_CODE].get<uint32_t>());
+    EXPECT_EQ(130, events[6][INPUT_KEY_VALUE].get<int32_t>());
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
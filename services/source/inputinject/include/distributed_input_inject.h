@@ -21,6 +21,7 @@
 #include <string>
 
 #include "constants_dinput.h"
+#include "dinput_latency_trace.h"
 #include "distributed_input_handler.h"
 #include "distributed_input_node_manager.h"
 #include "i_input_node_listener.h"
@@ -33,8 +34,15 @@ public:
     static DistributedInputInject &GetInstance();
     int32_t RegisterDistributedHardware(const std::string &devId, const std::string &dhId,
         const std::string &parameters);
+    /*
+     * Create the virtual node in the background, callback reports the result unless an error is returned.
+     */
+    int32_t RegisterDistributedHardwareAsync(const std::string &devId, const std::string &dhId,
+        const std::string &parameters, CreateNodeCallback callback);
     int32_t UnregisterDistributedHardware(const std::string &devId, const std::string &dhId);
     int32_t RegisterDistributedEvent(const std::string &devId, const std::vector<RawEvent> &events);
+    int32_t RegisterDistributedEvent(const std::string &devId, const std::vector<RawEvent> &events,
+        const TraceStamps &stamps);
     int32_t StructTransJson(const InputDevice &pBuf, std::string &strDescriptor);
     void StartInjectThread();
     void StopInjectThread();
@@ -48,8 +56,7 @@ public:
     int32_t UnregisterInjectEventCb();
 
     void NotifyNodeMgrScanVirNode(const std::string &devId, const std::string &dhId);
-    void GetVirtualKeyboardPaths(const std::string &devId, const std::vector<std::string> &dhIds,
-        std::vector<std::string> &virKeyboardPaths);
+    void ResetPressedKeys(const std::string &devId, const std::vector<std::string> &dhIds);
 private:
     DistributedInputInject();
     ~DistributedInputInject();
@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -28,15 +29,20 @@
 #include "nlohmann/json.hpp"
 
 #include "constants_dinput.h"
+#include "dinput_capability_codec.h"
+#include "dinput_latency_trace.h"
+#include "inject_jitter_buffer.h"
 #include "input_hub.h"
 #include "i_session_state_callback.h"
 #include "virtual_device.h"
+#include "virtual_device_pool.h"
 
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
 constexpr uint32_t DINPUT_NODE_MANAGER_SCAN_ALL_NODE = 1;
 constexpr uint32_t DINPUT_INJECT_EVENT_FAIL = 2;
+constexpr uint32_t DINPUT_NODE_MANAGER_EVICT_POOL = 3;
 const std::string INPUT_NODE_DEVID = "devId";
 const std::string INPUT_NODE_DHID = "dhId";
 /**
@@ -45,20 +51,26 @@ const std::string INPUT_NODE_DHID = "dhId";
  */
 using DhUniqueID = std::pair<std::string, std::string>;
 /**
- * @brief a batch events form one device
- * left: device networid where these events from
- * right: the event batch
+ * @brief called once the virtual node of {devId, dhId} is created or failed to be created,
+ * result is DH_SUCCESS or the error code. It runs on the node creating thread.
  */
-using EventBatch = std::pair<std::string, std::vector<RawEvent>>;
+using CreateNodeCallback = std::function<void(const std::string &devId, const std::string &dhId, int32_t result)>;
 class DistributedInputNodeManager {
 public:
     DistributedInputNodeManager();
     ~DistributedInputNodeManager();
 
     int32_t OpenDevicesNode(const std::string &devId, const std::string &dhId, const std::string &parameters);
+    /**
+     * @brief Create the virtual node on a background thread, nodes of different requests come up in parallel.
+     * The callback is called only if DH_SUCCESS is returned.
+     */
+    int32_t OpenDevicesNodeAsync(const std::string &devId, const std::string &dhId, const std::string &parameters,
+        CreateNodeCallback callback);
 
     int32_t GetDevice(const std::string &devId, const std::string &dhId, VirtualDevice *&device);
-    void ReportEvent(const std::string &devId, const std::vector<RawEvent> &events);
+    void ReportEvent(const std::string &devId, const std::vector<RawEvent> &events,
+        std::shared_ptr<TraceStamps> stamps = nullptr);
     int32_t CloseDeviceLocked(const std::string &devId, const std::string &dhId);
     void StartInjectThread();
     void StopInjectThread();
@@ -68,16 +80,15 @@ public:
     int32_t GetVirtualTouchScreenFd();
 
     void ProcessInjectEvent(const EventBatch &events);
+    void FlushInjectedEvents(const std::string &dhId, uint64_t &eventNum);
+    void RecordOneWayLatency(const EventBatch &events, uint64_t writtenTime);
 
     /**
-     * @brief Get the Virtual Keyboard Paths By Dh Ids object
+     * @brief Release the keys and buttons left pressed on the virtual devices.
      *
-     * @param dhKeys list for device identify({networkId, dhId})
-     * @param virKeyboardPaths the matched keyboard device
-     * @param virKeyboardDhIds matched keyboard device identify
+     * @param dhUniqueIds list for device identify({networkId, dhId})
      */
-    void GetVirtualKeyboardPaths(const std::vector<DhUniqueID> &dhUniqueIds,
-        std::vector<std::string> &virKeyboardPaths);
+    void ResetPressedKeys(const std::vector<DhUniqueID> &dhUniqueIds);
     void NotifyNodeMgrScanVirNode(const std::string &devId, const std::string &dhId);
     void RegisterInjectEventCb(sptr<ISessionStateCallback> callback);
     void UnregisterInjectEventCb();
@@ -91,6 +102,7 @@ public:
         void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event) override;
     private:
         void ScanAllNode(const AppExecFwk::InnerEvent::Pointer &event);
+        void EvictPool(const AppExecFwk::InnerEvent::Pointer &event);
 
         using nodeMgrFunc = void (DInputNodeManagerEventHandler::*)(
             const AppExecFwk::InnerEvent::Pointer &event);
@@ -99,13 +111,21 @@ public:
     };
 
 private:
+    struct CreateNodeTask {
+        InputDevice inputDevice;
+        std::string devId;
+        std::string dhId;
+        CreateNodeCallback callback;
+    };
+
     void AddDeviceLocked(const std::string &networkId, const std::string &dhId, std::unique_ptr<VirtualDevice> device);
+    bool CheckOpenNodeParam(const std::string &devId, const std::string &dhId, const std::string &parameters);
+    void CreateNodeLoop();
+    void StopCreateNodeThreads();
     int32_t CreateHandle(const InputDevice &inputDevice, const std::string &devId, const std::string &dhId);
-    void ParseInputDeviceJson(const std::string &str, InputDevice &pBuf);
-    void ParseInputDevice(const nlohmann::json &inputDeviceJson, InputDevice &pBuf);
-    void ParseInputDeviceBasicInfo(const nlohmann::json &inputDeviceJson, InputDevice &pBuf);
-    void ParseInputDeviceEvents(const nlohmann::json &inputDeviceJson, InputDevice &pBuf);
+    void ParseCapability(const std::string &str, InputDevice &pBuf);
     void InjectEvent();
+    void InjectBatch(InjectEventBatch &batch);
 
     void ScanSinkInputDevices(const std::string &devId, const std::string &dhId);
     bool MatchAndSavePhysicalPath(const std::string &devicePath, const std::string &devId, const std::string &dhId);
@@ -113,6 +133,7 @@ private:
     bool GetDevDhUniqueIdByFd(int fd, DhUniqueID &dhUnqueId, std::string &physicalPath);
     void SetPathForVirDev(const DhUniqueID &dhUniqueId, const std::string &devicePath);
     void RunInjectEventCallback(const std::string &dhId, const uint32_t injectEvent);
+    void ScheduleEvictPool(int64_t delayMs);
 
     /* the key is {networkId, dhId}, and the value is virtualDevice */
     std::map<DhUniqueID, std::unique_ptr<VirtualDevice>> virtualDeviceMap_;
@@ -123,11 +144,26 @@ private:
     std::thread eventInjectThread_;
     std::mutex injectThreadMutex_;
     std::condition_variable conditionVariable_;
-    std::queue<EventBatch> injectQueue_;
+    std::queue<InjectEventBatch> injectQueue_;
+    // set by the dinput_inject_jitter_buffer gn arg.
+    bool isJitterBufferEnabled_ = false;
+    // only touched by the inject thread.
+    InjectJitterBuffer jitterBuffer_;
     int32_t virtualTouchScreenFd_;
     std::once_flag callOnceFlag_;
     std::shared_ptr<DInputNodeManagerEventHandler> callBackHandler_;
     sptr<ISessionStateCallback> SessionStateCallback_;
+
+    std::mutex createNodeMutex_;
+    std::condition_variable createNodeCv_;
+    std::queue<CreateNodeTask> createNodeQueue_;
+    std::vector<std::thread> createNodeThreads_;
+    size_t idleCreateNodeThreadNum_ = 0;
+    bool isCreateNodeRunning_ = true;
+
+    // the nodes of the closed devices, kept for a while to be reused when the devices come back.
+    VirtualDevicePool devicePool_;
+    CapabilityParseCache capabilityCache_;
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INJECT_JITTER_BUFFER_H
+#define INJECT_JITTER_BUFFER_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constants_dinput.h"
+#include "dinput_latency_trace.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/**
+ * @brief a batch events form one device
+ * left: device networid where these events from
+ * right: the event batch
+ */
+using EventBatch = std::pair<std::string, std::vector<RawEvent>>;
+/**
+ * @brief a event batch waiting in the inject queue
+ * stamps is not null only when latency trace is enabled.
+ */
+struct InjectEventBatch {
+    EventBatch events;
+    std::shared_ptr<TraceStamps> stamps;
+};
+
+/*
+ * Paces the injection of the pointer and scroll frames by their sink kernel time, so the frames of batches
+ * arriving in clumps keep the spacing they were read with. A frame is released at its kernel time translated
+ * into the local clock plus the target delay of its device, which is the lowest recent transit time plus a
+ * multiple of the smoothed transit jitter. Batches holding key events, or of a device without a clock
+ * estimate, are released at once together with the frames of the device still held, so nothing is reordered.
+ * Not thread safe, it is owned by the inject thread.
+ */
+class InjectJitterBuffer {
+public:
+    /*
+     * arrivalTime is on the monotonic clock all the release times are on, localTime is the wall clock at the
+     * same instant. The kernel times are translated into the wall clock and moved onto the monotonic one
+     * through this pair, so a step of the wall clock never holds the frames.
+     */
+    void Push(InjectEventBatch &&batch, uint64_t arrivalTime, uint64_t localTime);
+    /*
+     * Take the frames released by now in their release order.
+     */
+    void PopDue(uint64_t now, std::vector<InjectEventBatch> &due);
+    void PopAll(std::vector<InjectEventBatch> &due);
+    /*
+     * Return false if no frame is held.
+     */
+    bool GetNextReleaseTime(uint64_t &releaseTime) const;
+    uint64_t GetTargetDelayUs(const std::string &devId) const;
+    size_t GetSize() const;
+    void Clear();
+
+private:
+    struct DeviceState {
+        // the recent transit times, the lowest one is the base of the target delay.
+        std::deque<int64_t> transits;
+        int64_t lastTransit = 0;
+        double jitterUs = 0;
+        uint64_t lastRelease = 0;
+        size_t heldNum = 0;
+    };
+    static bool HasKeyEvent(const std::vector<RawEvent> &events);
+    static void SplitFrames(InjectEventBatch &&batch, std::vector<InjectEventBatch> &frames);
+    uint64_t ScheduleFrame(DeviceState &state, uint64_t frameTime, uint64_t arrivalTime);
+    void ReleaseDevice(const std::string &devId, uint64_t releaseTime);
+    void Hold(DeviceState &state, uint64_t releaseTime, InjectEventBatch &&frame);
+
+    // ordered by the release time, the frames of one device are released in their arrival order.
+    std::multimap<uint64_t, InjectEventBatch> held_;
+    std::map<std::string, DeviceState> devices_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // INJECT_JITTER_BUFFER_H
@@ -16,7 +16,9 @@
 #ifndef OHOS_VIRTUAL_DEVICE_H
 #define OHOS_VIRTUAL_DEVICE_H
 
+#include <bitset>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,11 +44,21 @@ public:
     bool SetPhys(const std::string &deviceName, const std::string &dhId);
     bool SetUp(const InputDevice &inputDevice, const std::string &devId, const std::string &dhId);
     bool InjectInputEvent(const input_event &event);
+    /*
+     * Release the keys left pressed by the injected events with one write, return the released key number.
+     */
+    size_t ReleasePressedKeys();
     void SetNetWorkId(const std::string &netWorkId);
     void SetPath(const std::string &path);
     std::string GetNetWorkId();
     std::string GetPath();
     uint16_t GetClasses();
+    std::string GetDeviceName();
+    /*
+     * The capability signature the node was created from, empty for a node that is never pooled.
+     */
+    void SetSignature(const std::string &signature);
+    std::string GetSignature();
 
     int32_t GetDeviceFd();
     uint16_t GetDeviceType();
@@ -56,6 +68,7 @@ private:
     std::string deviceName_;
     std::string netWorkId_;
     std::string path_;
+    std::string signature_;
     const uint16_t busType_;
     const uint16_t vendorId_;
     const uint16_t productId_;
@@ -63,9 +76,22 @@ private:
     const uint16_t classes_;
     struct uinput_user_dev dev_ {};
     const std::string pid_ = std::to_string(getpid());
+    // the shadow key state kept from the injected events, so a reset needs no EVIOCGKEY on the node.
+    std::mutex keyStateMutex_;
+    std::bitset<KEY_CNT> pressedKeyBits_;
+    std::vector<uint16_t> pressedKeys_;
 
 private:
     void RecordEventLog(const input_event &event);
+    void UpdatePressedKeysLocked(const input_event &event);
+    /*
+     * Get the /dev/input/eventN path of the created uinput device from its sysfs entry, empty if not found.
+     */
+    std::string GetEventNodePath(const std::string &sysName);
+    /*
+     * Wait until the event node of the created uinput device can be opened.
+     */
+    bool WaitNodeReady(const std::string &nodePath);
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
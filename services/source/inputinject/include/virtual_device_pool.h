@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIRTUAL_DEVICE_POOL_H
+#define VIRTUAL_DEVICE_POOL_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "constants_dinput.h"
+#include "virtual_device.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Keeps the uinput nodes of unregistered remote devices alive for a while, so registering the same device
+ * again reuses its node instead of creating a new one and making the compositor rescan the input devices.
+ * The PHYS of a node carries the networkId and dhId and can not change once created, so a node is only
+ * reused by the same {networkId, dhId}, and only while the capability signature is unchanged.
+ */
+class VirtualDevicePool {
+public:
+    VirtualDevicePool() = default;
+    ~VirtualDevicePool();
+
+    /*
+     * The signature covers everything the node is created from: identity, event types, codes and axis ranges,
+     * but not the current axis values.
+     */
+    static std::string GetSignature(const InputDevice &inputDevice);
+
+    /*
+     * Park the node of an unregistered device, the least recently parked node is destroyed if the pool is full.
+     */
+    void Park(const std::string &devId, const std::string &dhId, std::unique_ptr<VirtualDevice> device);
+    /*
+     * Take the parked node of the device out of the pool, nullptr if there is none with the same signature.
+     */
+    std::unique_ptr<VirtualDevice> Take(const std::string &devId, const std::string &dhId,
+        const std::string &signature);
+    /*
+     * Destroy the nodes parked for longer than the idle timeout.
+     * Return the time in ms until the next node expires, 0 if the pool is empty.
+     */
+    int64_t EvictIdle();
+    void Clear();
+    size_t GetSize();
+
+private:
+    struct PooledDevice {
+        std::unique_ptr<VirtualDevice> device;
+        uint64_t parkTime = 0;
+    };
+    using PoolKey = std::pair<std::string, std::string>;
+    void EvictLocked(std::map<PoolKey, PooledDevice>::iterator iter, const char *reason);
+
+    std::mutex poolMutex_;
+    // the key is {networkId, dhId}.
+    std::map<PoolKey, PooledDevice> pool_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // VIRTUAL_DEVICE_POOL_H
@@ -65,6 +65,23 @@ int32_t DistributedInputInject::RegisterDistributedHardware(const std::string &d
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputInject::RegisterDistributedHardwareAsync(const std::string &devId, const std::string &dhId,
+    const std::string &parameters, CreateNodeCallback callback)
+{
+    DHLOGI("RegisterDistributedHardwareAsync called, deviceId: %{public}s,  dhId: %{public}s",
+        GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
+    std::lock_guard<std::mutex> lock(inputNodeManagerMutex_);
+    if (inputNodeManager_ == nullptr) {
+        DHLOGE("the DistributedInputNodeManager is null\n");
+        return ERR_DH_INPUT_SERVER_SOURCE_INJECT_NODE_MANAGER_IS_NULL;
+    }
+    if (inputNodeManager_->OpenDevicesNodeAsync(devId, dhId, parameters, std::move(callback)) < 0) {
+        DHLOGE("create virtual device error\n");
+        return ERR_DH_INPUT_SERVER_SOURCE_INJECT_REGISTER_FAIL;
+    }
+    return DH_SUCCESS;
+}
+
 int32_t DistributedInputInject::UnregisterDistributedHardware(const std::string &devId, const std::string &dhId)
 {
     DHLOGI("UnregisterDistributedHardware called, deviceId: %{public}s,  dhId: %{public}s",
@@ -123,6 +140,19 @@ int32_t DistributedInputInject::RegisterDistributedEvent(const std::string &devI
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputInject::RegisterDistributedEvent(const std::string &devId,
+    const std::vector<RawEvent> &events, const TraceStamps &stamps)
+{
+    std::lock_guard<std::mutex> lock(inputNodeManagerMutex_);
+    if (inputNodeManager_ == nullptr) {
+        DHLOGE("the DistributedInputNodeManager is null");
+        return ERR_DH_INPUT_SERVER_SOURCE_INJECT_NODE_MANAGER_IS_NULL;
+    }
+
+    inputNodeManager_->ReportEvent(devId, events, std::make_shared<TraceStamps>(stamps));
+    return DH_SUCCESS;
+}
+
 void DistributedInputInject::StartInjectThread()
 {
     std::lock_guard<std::mutex> lock(inputNodeManagerMutex_);
@@ -194,8 +224,7 @@ int32_t DistributedInputInject::UnregisterInjectEventCb()
     return DH_SUCCESS;
 }
 
-void DistributedInputInject::GetVirtualKeyboardPaths(const std::string &devId,
-    const std::vector<std::string> &dhIds, std::vector<std::string> &virKeyboardPaths)
+void DistributedInputInject::ResetPressedKeys(const std::string &devId, const std::vector<std::string> &dhIds)
 {
     std::lock_guard<std::mutex> lock(inputNodeManagerMutex_);
     if (inputNodeManager_ == nullptr) {
@@ -203,12 +232,10 @@ void DistributedInputInject::GetVirtualKeyboardPaths(const std::string &devId,
         return;
     }
     std::vector<DhUniqueID> dhUniqIds;
-    std::for_each(dhIds.begin(), dhIds.end(),
-        [&devId, &dhUniqIds](std::string dhId) {
-            DhUniqueID id = {devId, dhId};
-            dhUniqIds.push_back(id);
-        });
-    inputNodeManager_->GetVirtualKeyboardPaths(dhUniqIds, virKeyboardPaths);
+    for (const auto &dhId : dhIds) {
+        dhUniqIds.push_back({devId, dhId});
+    }
+    inputNodeManager_->ResetPressedKeys(dhUniqIds);
 }
 
 void DistributedInputInject::NotifyNodeMgrScanVirNode(const std::string &devId, const std::string &dhId)
@@ -15,6 +15,7 @@
 
 #include "distributed_input_node_manager.h"
 
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
 
@@ -22,11 +23,14 @@
 
 #include "softbus_bus_center.h"
 
+#include "dinput_clock_sync.h"
 #include "dinput_context.h"
 #include "dinput_errcode.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_softbus_define.h"
 #include "dinput_utils_tool.h"
+#include "hidumper.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -34,11 +38,25 @@ namespace DistributedInput {
 namespace {
     constexpr int32_t RETRY_MAX_TIMES = 3;
     constexpr uint32_t SLEEP_TIME_US = 10 * 1000;
+    constexpr size_t MAX_CREATE_NODE_THREAD_NUM = 4;
+    constexpr size_t MAX_CAPABILITY_CACHE_NUM = 32;
+    constexpr int64_t NS_PER_US = 1000;
+
+    // the held frames are released on this clock, a step of the wall clock must not stall them.
+    uint64_t GetSteadyTimeUs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
 }
 DistributedInputNodeManager::DistributedInputNodeManager() : isInjectThreadCreated_(false),
-    isInjectThreadRunning_(false), virtualTouchScreenFd_(UN_INIT_FD_VALUE)
+    isInjectThreadRunning_(false), virtualTouchScreenFd_(UN_INIT_FD_VALUE),
+    capabilityCache_(MAX_CAPABILITY_CACHE_NUM)
 {
     DHLOGI("DistributedInputNodeManager ctor");
+#ifdef DINPUT_INJECT_JITTER_BUFFER
+    isJitterBufferEnabled_ = true;
+#endif
     std::shared_ptr<AppExecFwk::EventRunner> runner = AppExecFwk::EventRunner::Create(true);
     callBackHandler_ = std::make_shared<DistributedInputNodeManager::DInputNodeManagerEventHandler>(runner, this);
 }
@@ -46,6 +64,8 @@ DistributedInputNodeManager::DistributedInputNodeManager() : isInjectThreadCreat
 DistributedInputNodeManager::~DistributedInputNodeManager()
 {
     DHLOGI("DistributedInputNodeManager dtor");
+    StopCreateNodeThreads();
+    devicePool_.Clear();
     isInjectThreadCreated_.store(false);
     isInjectThreadRunning_.store(false);
     if (eventInjectThread_.joinable()) {
@@ -58,16 +78,25 @@ DistributedInputNodeManager::~DistributedInputNodeManager()
     DHLOGI("destructor end");
 }
 
-int32_t DistributedInputNodeManager::OpenDevicesNode(const std::string &devId, const std::string &dhId,
+bool DistributedInputNodeManager::CheckOpenNodeParam(const std::string &devId, const std::string &dhId,
     const std::string &parameters)
 {
     if (devId.size() > DEV_ID_LENGTH_MAX || devId.empty() || dhId.size() > DH_ID_LENGTH_MAX || dhId.empty() ||
         parameters.size() > STRING_MAX_SIZE || parameters.empty()) {
         DHLOGE("Params is invalid!");
+        return false;
+    }
+    return true;
+}
+
+int32_t DistributedInputNodeManager::OpenDevicesNode(const std::string &devId, const std::string &dhId,
+    const std::string &parameters)
+{
+    if (!CheckOpenNodeParam(devId, dhId, parameters)) {
         return ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL;
     }
     InputDevice event;
-    ParseInputDeviceJson(parameters, event);
+    ParseCapability(parameters, event);
     if (CreateHandle(event, devId, dhId) < 0) {
         DHLOGE("Can not create virtual node!");
         return ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL;
@@ -75,84 +104,81 @@ int32_t DistributedInputNodeManager::OpenDevicesNode(const std::string &devId, c
     return DH_SUCCESS;
 }
 
-void DistributedInputNodeManager::ParseInputDeviceJson(const std::string &str, InputDevice &pBuf)
+int32_t DistributedInputNodeManager::OpenDevicesNodeAsync(const std::string &devId, const std::string &dhId,
+    const std::string &parameters, CreateNodeCallback callback)
 {
-    nlohmann::json inputDeviceJson = nlohmann::json::parse(str, nullptr, false);
-    if (inputDeviceJson.is_discarded()) {
-        DHLOGE("recMsg parse failed!");
-        return;
+    if (!CheckOpenNodeParam(devId, dhId, parameters) || callback == nullptr) {
+        return ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL;
+    }
+    CreateNodeTask task;
+    ParseCapability(parameters, task.inputDevice);
+    task.devId = devId;
+    task.dhId = dhId;
+    task.callback = std::move(callback);
+
+    std::lock_guard<std::mutex> lock(createNodeMutex_);
+    if (!isCreateNodeRunning_) {
+        DHLOGE("Node manager is stopping, reject the node of dhId: %{public}s", GetAnonyString(dhId).c_str());
+        return ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL;
     }
-    ParseInputDevice(inputDeviceJson, pBuf);
+    createNodeQueue_.push(std::move(task));
+    if (idleCreateNodeThreadNum_ < createNodeQueue_.size() &&
+        createNodeThreads_.size() < MAX_CREATE_NODE_THREAD_NUM) {
+        createNodeThreads_.emplace_back([this]() { this->CreateNodeLoop(); });
+    }
+    createNodeCv_.notify_one();
+    return DH_SUCCESS;
 }
 
-void DistributedInputNodeManager::ParseInputDevice(const nlohmann::json &inputDeviceJson, InputDevice &pBuf)
+void DistributedInputNodeManager::CreateNodeLoop()
 {
-    ParseInputDeviceBasicInfo(inputDeviceJson, pBuf);
-    ParseInputDeviceEvents(inputDeviceJson, pBuf);
+    int32_t ret = pthread_setname_np(pthread_self(), CREATE_NODE_THREAD_NAME);
+    if (ret != 0) {
+        DHLOGE("CreateNodeLoop setname failed.");
+    }
+    std::unique_lock<std::mutex> lock(createNodeMutex_);
+    while (true) {
+        idleCreateNodeThreadNum_++;
+        createNodeCv_.wait(lock, [this]() { return !isCreateNodeRunning_ || !createNodeQueue_.empty(); });
+        idleCreateNodeThreadNum_--;
+        if (createNodeQueue_.empty()) {
+            return;
+        }
+        CreateNodeTask task = std::move(createNodeQueue_.front());
+        createNodeQueue_.pop();
+        lock.unlock();
+        int32_t result = DH_SUCCESS;
+        if (CreateHandle(task.inputDevice, task.devId, task.dhId) < 0) {
+            DHLOGE("Can not create virtual node!");
+            result = ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL;
+        }
+        task.callback(task.devId, task.dhId, result);
+        lock.lock();
+    }
 }
 
-void DistributedInputNodeManager::ParseInputDeviceBasicInfo(const nlohmann::json &inputDeviceJson, InputDevice &pBuf)
+void DistributedInputNodeManager::StopCreateNodeThreads()
 {
-    if (IsString(inputDeviceJson, DEVICE_NAME)) {
-        pBuf.name = inputDeviceJson[DEVICE_NAME].get<std::string>();
-    }
-    if (IsString(inputDeviceJson, PHYSICAL_PATH)) {
-        pBuf.physicalPath = inputDeviceJson[PHYSICAL_PATH].get<std::string>();
-    }
-    if (IsString(inputDeviceJson, UNIQUE_ID)) {
-        pBuf.uniqueId = inputDeviceJson[UNIQUE_ID].get<std::string>();
-    }
-    if (IsUInt16(inputDeviceJson, BUS)) {
-        pBuf.bus = inputDeviceJson[BUS].get<uint16_t>();
-    }
-    if (IsUInt16(inputDeviceJson, VENDOR)) {
-        pBuf.vendor = inputDeviceJson[VENDOR].get<uint16_t>();
-    }
-    if (IsUInt16(inputDeviceJson, PRODUCT)) {
-        pBuf.product = inputDeviceJson[PRODUCT].get<uint16_t>();
-    }
-    if (IsUInt16(inputDeviceJson, VERSION)) {
-        pBuf.version = inputDeviceJson[VERSION].get<uint16_t>();
-    }
-    if (IsString(inputDeviceJson, DESCRIPTOR)) {
-        pBuf.descriptor = inputDeviceJson[DESCRIPTOR].get<std::string>();
-    }
-    if (IsUInt32(inputDeviceJson, CLASSES)) {
-        pBuf.classes = inputDeviceJson[CLASSES].get<uint32_t>();
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(createNodeMutex_);
+        isCreateNodeRunning_ = false;
+        threads.swap(createNodeThreads_);
+    }
+    // the queued requests are still created and answered before the threads exit.
+    createNodeCv_.notify_all();
+    for (auto &thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
     }
 }
 
-void DistributedInputNodeManager::ParseInputDeviceEvents(const nlohmann::json &inputDeviceJson, InputDevice &pBuf)
+void DistributedInputNodeManager::ParseCapability(const std::string &str, InputDevice &pBuf)
 {
-    if (IsArray(inputDeviceJson, EVENT_TYPES)) {
-        pBuf.eventTypes = inputDeviceJson[EVENT_TYPES].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, EVENT_KEYS)) {
-        pBuf.eventKeys = inputDeviceJson[EVENT_KEYS].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, ABS_TYPES)) {
-        pBuf.absTypes = inputDeviceJson[ABS_TYPES].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, ABS_INFOS)) {
-        pBuf.absInfos = inputDeviceJson[ABS_INFOS].get<std::map<uint32_t, std::vector<int32_t>>>();
-    }
-    if (IsArray(inputDeviceJson, REL_TYPES)) {
-        pBuf.relTypes = inputDeviceJson[REL_TYPES].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, PROPERTIES)) {
-        pBuf.properties = inputDeviceJson[PROPERTIES].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, MISCELLANEOUS)) {
-        pBuf.miscellaneous = inputDeviceJson[MISCELLANEOUS].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, LEDS)) {
-        pBuf.leds = inputDeviceJson[LEDS].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, REPEATS)) {
-        pBuf.repeats = inputDeviceJson[REPEATS].get<std::vector<uint32_t>>();
-    }
-    if (IsArray(inputDeviceJson, SWITCHS)) {
-        pBuf.switchs = inputDeviceJson[SWITCHS].get<std::vector<uint32_t>>();
+    // the sink reports either the capability json or the compact descriptor.
+    if (!capabilityCache_.Parse(str, pBuf)) {
+        DHLOGE("Parse the capability failed!");
     }
 }
 
@@ -188,6 +214,7 @@ DistributedInputNodeManager::DInputNodeManagerEventHandler::DInputNodeManagerEve
     : AppExecFwk::EventHandler(runner)
 {
     eventFuncMap_[DINPUT_NODE_MANAGER_SCAN_ALL_NODE] = &DInputNodeManagerEventHandler::ScanAllNode;
+    eventFuncMap_[DINPUT_NODE_MANAGER_EVICT_POOL] = &DInputNodeManagerEventHandler::EvictPool;
 
     nodeManagerObj_ = manager;
 }
@@ -218,9 +245,35 @@ void DistributedInputNodeManager::DInputNodeManagerEventHandler::ScanAllNode(
     nodeManagerObj_->ScanSinkInputDevices(devId, devicedhId);
 }
 
+void DistributedInputNodeManager::DInputNodeManagerEventHandler::EvictPool(
+    const AppExecFwk::InnerEvent::Pointer &event)
+{
+    (void)event;
+    int64_t nextDelayMs = nodeManagerObj_->devicePool_.EvictIdle();
+    if (nextDelayMs > 0) {
+        nodeManagerObj_->ScheduleEvictPool(nextDelayMs);
+    }
+}
+
+void DistributedInputNodeManager::ScheduleEvictPool(int64_t delayMs)
+{
+    // only one pending check is needed, it reschedules itself for the next node to expire.
+    callBackHandler_->RemoveEvent(DINPUT_NODE_MANAGER_EVICT_POOL);
+    callBackHandler_->SendEvent(DINPUT_NODE_MANAGER_EVICT_POOL, 0, delayMs);
+}
+
 void DistributedInputNodeManager::NotifyNodeMgrScanVirNode(const std::string &devId, const std::string &dhId)
 {
     DHLOGI("NotifyNodeMgrScanVirNode enter.");
+    {
+        // the nodes created here know their path from sysfs, scanning is only the fallback.
+        std::lock_guard<std::mutex> lock(virtualDeviceMapMutex_);
+        auto iter = virtualDeviceMap_.find({devId, dhId});
+        if (iter != virtualDeviceMap_.end() && iter->second != nullptr && !iter->second->GetPath().empty()) {
+            DHLOGI("The virtual node path is known, skip scan, path: %{public}s", iter->second->GetPath().c_str());
+            return;
+        }
+    }
     std::shared_ptr<nlohmann::json> jsonArrayMsg = std::make_shared<nlohmann::json>();
     nlohmann::json tmpJson;
     tmpJson[INPUT_NODE_DEVID] = devId;
@@ -333,25 +386,18 @@ bool DistributedInputNodeManager::MatchAndSavePhysicalPath(const std::string &de
     return true;
 }
 
-void DistributedInputNodeManager::GetVirtualKeyboardPaths(const std::vector<DhUniqueID> &dhUniqueIds,
-    std::vector<std::string> &virKeyboardPaths)
+void DistributedInputNodeManager::ResetPressedKeys(const std::vector<DhUniqueID> &dhUniqueIds)
 {
     std::lock_guard<std::mutex> lock(virtualDeviceMapMutex_);
     for (const auto &dhUniqueId : dhUniqueIds) {
-        auto iter = virtualDeviceMap_.begin();
-        while (iter != virtualDeviceMap_.end()) {
-            if (iter->second == nullptr) {
-                DHLOGE("device is nullptr");
-                continue;
-            }
-            if ((iter->first == dhUniqueId) &&
-                ((iter->second->GetClasses() & INPUT_DEVICE_CLASS_KEYBOARD) != 0)) {
-                DHLOGI("Found vir keyboard path %{public}s, deviceId %{public}s, dhid %{public}s",
-                    iter->second->GetPath().c_str(), GetAnonyString(dhUniqueId.first).c_str(),
-                    GetAnonyString(dhUniqueId.second).c_str());
-                virKeyboardPaths.push_back(iter->second->GetPath());
-            }
-            iter++;
+        auto iter = virtualDeviceMap_.find(dhUniqueId);
+        if (iter == virtualDeviceMap_.end() || iter->second == nullptr) {
+            continue;
+        }
+        size_t releasedNum = iter->second->ReleasePressedKeys();
+        if (releasedNum > 0) {
+            DHLOGI("Released %{public}zu pressed keys, deviceId %{public}s, dhid %{public}s", releasedNum,
+                GetAnonyString(dhUniqueId.first).c_str(), GetAnonyString(dhUniqueId.second).c_str());
         }
     }
 }
@@ -359,25 +405,31 @@ void DistributedInputNodeManager::GetVirtualKeyboardPaths(const std::vector<DhUn
 int32_t DistributedInputNodeManager::CreateHandle(const InputDevice &inputDevice, const std::string &devId,
     const std::string &dhId)
 {
-    std::unique_lock<std::mutex> my_lock(operationMutex_);
-    std::unique_ptr<VirtualDevice> virtualDevice = std::make_unique<VirtualDevice>(inputDevice);
-
-    virtualDevice->SetNetWorkId(devId);
-
-    if (!virtualDevice->SetUp(inputDevice, devId, dhId)) {
-        DHLOGE("could not create new virtual device\n");
-        for (int32_t i = 0; i < RETRY_MAX_TIMES; ++i) {
-            if (virtualDevice->SetUp(inputDevice, devId, dhId)) {
-                DHLOGI("Create new virtual success");
-                AddDeviceLocked(devId, inputDevice.descriptor, std::move(virtualDevice));
-                return DH_SUCCESS;
-            }
+    std::string signature = VirtualDevicePool::GetSignature(inputDevice);
+    std::unique_ptr<VirtualDevice> pooledDevice = devicePool_.Take(devId, inputDevice.descriptor, signature);
+    if (pooledDevice != nullptr) {
+        pooledDevice->SetNetWorkId(devId);
+        HiDumper::GetInstance().SaveNodeInfo(devId, pooledDevice->GetDeviceName(), dhId);
+        AddDeviceLocked(devId, inputDevice.descriptor, std::move(pooledDevice));
+        return DH_SUCCESS;
+    }
+    // no lock is held while the node comes up, only the map insertion is serialized.
+    for (int32_t i = 0; i <= RETRY_MAX_TIMES; ++i) {
+        if (i > 0) {
             usleep(SLEEP_TIME_US);
         }
-        return ERR_DH_INPUT_SERVER_SOURCE_CREATE_HANDLE_FAIL;
+        // a failed SetUp leaves the device half configured, every attempt starts from a fresh one.
+        std::unique_ptr<VirtualDevice> virtualDevice = std::make_unique<VirtualDevice>(inputDevice);
+        virtualDevice->SetNetWorkId(devId);
+        virtualDevice->SetSignature(signature);
+        if (virtualDevice->SetUp(inputDevice, devId, dhId)) {
+            DHLOGI("Create new virtual success, retry: %{public}d", i);
+            AddDeviceLocked(devId, inputDevice.descriptor, std::move(virtualDevice));
+            return DH_SUCCESS;
+        }
+        DHLOGE("could not create new virtual device, retry: %{public}d", i);
     }
-    AddDeviceLocked(devId, inputDevice.descriptor, std::move(virtualDevice));
-    return DH_SUCCESS;
+    return ERR_DH_INPUT_SERVER_SOURCE_CREATE_HANDLE_FAIL;
 }
 
 int32_t DistributedInputNodeManager::CreateVirtualTouchScreenNode(const std::string &devId, const std::string &dhId,
@@ -428,13 +480,24 @@ int32_t DistributedInputNodeManager::CloseDeviceLocked(const std::string &devId,
 {
     DHLOGI("CloseDeviceLocked called, deviceId=%{public}s, dhId=%{public}s",
         GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
-    std::lock_guard<std::mutex> lock(virtualDeviceMapMutex_);
-    DhUniqueID dhUniqueId = {devId, dhId};
-    std::map<DhUniqueID, std::unique_ptr<VirtualDevice>>::iterator iter = virtualDeviceMap_.find(dhUniqueId);
-    if (iter != virtualDeviceMap_.end()) {
+    std::unique_ptr<VirtualDevice> device;
+    {
+        std::lock_guard<std::mutex> lock(virtualDeviceMapMutex_);
+        DhUniqueID dhUniqueId = {devId, dhId};
+        std::map<DhUniqueID, std::unique_ptr<VirtualDevice>>::iterator iter = virtualDeviceMap_.find(dhUniqueId);
+        if (iter != virtualDeviceMap_.end()) {
+            device = std::move(iter->second);
+            virtualDeviceMap_.erase(iter);
+        }
+    }
+    if (device != nullptr) {
         DHLOGI("CloseDeviceLocked called success, deviceId=%{public}s, dhId=%{public}s",
             GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
-        virtualDeviceMap_.erase(iter);
+        // the nodes without signature, such as the touch screen node, are destroyed right away.
+        if (!device->GetSignature().empty()) {
+            devicePool_.Park(devId, dhId, std::move(device));
+            ScheduleEvictPool(devicePool_.EvictIdle());
+        }
         return DH_SUCCESS;
     }
     DHLOGE("CloseDeviceLocked called failure, deviceId=%{public}s, dhId=%{public}s",
@@ -480,10 +543,12 @@ void DistributedInputNodeManager::StopInjectThread()
     }
 }
 
-void DistributedInputNodeManager::ReportEvent(const std::string &devId, const std::vector<RawEvent> &events)
+void DistributedInputNodeManager::ReportEvent(const std::string &devId, const std::vector<RawEvent> &events,
+    std::shared_ptr<TraceStamps> stamps)
 {
     std::lock_guard<std::mutex> lockGuard(injectThreadMutex_);
-    injectQueue_.push({devId, events});
+    injectQueue_.push({{devId, events}, stamps});
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::INJECT_QUEUE_DEPTH, static_cast<int64_t>(injectQueue_.size()));
     conditionVariable_.notify_all();
 }
 
@@ -494,20 +559,65 @@ void DistributedInputNodeManager::InjectEvent()
         DHLOGE("InjectEvent setname failed.");
     }
     DHLOGD("start");
+    std::vector<InjectEventBatch> dueBatches;
     while (isInjectThreadRunning_.load()) {
-        EventBatch events;
+        InjectEventBatch batch;
+        bool hasBatch = false;
         {
             std::unique_lock<std::mutex> waitEventLock(injectThreadMutex_);
-            conditionVariable_.wait(waitEventLock,
-                [this]() { return !isInjectThreadRunning_.load() || !injectQueue_.empty(); });
-            if (injectQueue_.empty()) {
-                continue;
+            auto isWakeUp = [this]() { return !isInjectThreadRunning_.load() || !injectQueue_.empty(); };
+            uint64_t releaseTime = 0;
+            if (jitterBuffer_.GetNextReleaseTime(releaseTime)) {
+                uint64_t now = GetSteadyTimeUs();
+                if (releaseTime > now) {
+                    conditionVariable_.wait_for(waitEventLock, std::chrono::microseconds(releaseTime - now),
+                        isWakeUp);
+                }
+            } else {
+                conditionVariable_.wait(waitEventLock, isWakeUp);
+            }
+            if (!injectQueue_.empty()) {
+                batch = std::move(injectQueue_.front());
+                injectQueue_.pop();
+                hasBatch = true;
+                DInputMetrics::GetInstance().SetGauge(MetricGauge::INJECT_QUEUE_DEPTH,
+                    static_cast<int64_t>(injectQueue_.size()));
             }
-            events = injectQueue_.front();
-            injectQueue_.pop();
         }
 
-        ProcessInjectEvent(events);
+        if (hasBatch && batch.stamps != nullptr) {
+            DInputLatencyTrace::Stamp(*batch.stamps, TraceStage::INJECT_DEQUEUE);
+        }
+        if (isJitterBufferEnabled_) {
+            if (hasBatch) {
+                jitterBuffer_.Push(std::move(batch), GetSteadyTimeUs(), GetCurrentTimeUs());
+            }
+            jitterBuffer_.PopDue(GetSteadyTimeUs(), dueBatches);
+        } else {
+            jitterBuffer_.PopAll(dueBatches);
+            if (hasBatch) {
+                dueBatches.push_back(std::move(batch));
+            }
+        }
+        for (auto &dueBatch : dueBatches) {
+            InjectBatch(dueBatch);
+        }
+        dueBatches.clear();
+    }
+    jitterBuffer_.Clear();
+}
+
+void DistributedInputNodeManager::InjectBatch(InjectEventBatch &batch)
+{
+    uint64_t startTime = GetCurrentTimeUs();
+    ProcessInjectEvent(batch.events);
+    uint64_t endTime = GetCurrentTimeUs();
+    DInputMetrics::GetInstance().RecordHistogram(MetricHistogram::INJECT_BATCH_COST_US,
+        endTime > startTime ? endTime - startTime : 0);
+    RecordOneWayLatency(batch.events, endTime);
+    if (batch.stamps != nullptr) {
+        DInputLatencyTrace::Stamp(*batch.stamps, TraceStage::UINPUT_WRITTEN);
+        DInputLatencyTrace::GetInstance().RecordBatch(batch.events.first, *batch.stamps);
     }
 }
 
@@ -536,6 +646,9 @@ void DistributedInputNodeManager::RunInjectEventCallback(const std::string &dhId
 void DistributedInputNodeManager::ProcessInjectEvent(const EventBatch &events)
 {
     std::string deviceId = events.first;
+    // consecutive events mostly come from the same device, count them per run instead of per event.
+    std::string countingDhId;
+    uint64_t countingNum = 0;
     for (const auto &rawEvent : events.second) {
         std::string dhId = rawEvent.descriptor;
         struct input_event event = {
@@ -549,12 +662,47 @@ void DistributedInputNodeManager::ProcessInjectEvent(const EventBatch &events)
         VirtualDevice* device = nullptr;
         if (GetDevice(deviceId, dhId, device) < 0) {
             DHLOGE("could not find the device");
-            return;
+            break;
+        }
+        if (device == nullptr) {
+            continue;
+        }
+        if (!device->InjectInputEvent(event)) {
+            DInputMetrics::GetInstance().AddCounter(MetricCounter::INJECT_WRITE_ERRORS);
+            continue;
         }
-        if (device != nullptr) {
-            device->InjectInputEvent(event);
+        if (dhId != countingDhId) {
+            FlushInjectedEvents(countingDhId, countingNum);
+            countingDhId = dhId;
         }
+        countingNum++;
+    }
+    FlushInjectedEvents(countingDhId, countingNum);
+}
+
+void DistributedInputNodeManager::FlushInjectedEvents(const std::string &dhId, uint64_t &eventNum)
+{
+    if (eventNum == 0) {
+        return;
+    }
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_INJECTED, eventNum);
+    DInputMetrics::GetInstance().AddDeviceEvents(dhId, eventNum);
+    eventNum = 0;
+}
+
+void DistributedInputNodeManager::RecordOneWayLatency(const EventBatch &events, uint64_t writtenTime)
+{
+    if (events.second.empty() || events.second.front().when <= 0) {
+        return;
+    }
+    // the first event of the batch waited the longest, its kernel time is on the sink clock.
+    uint64_t kernelTime = static_cast<uint64_t>(events.second.front().when / NS_PER_US);
+    uint64_t localKernelTime = 0;
+    if (!DInputClockSync::GetInstance().RemoteToLocalUs(events.first, kernelTime, localKernelTime)) {
+        return;
     }
+    DInputMetrics::GetInstance().RecordHistogram(MetricHistogram::SINK_KERNEL_TO_INJECT_US,
+        writtenTime > localKernelTime ? writtenTime - localKernelTime : 0);
 }
 } // namespace DistributedInput
 } // namespace DistributedHardware
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inject_jitter_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <linux/input.h>
+
+#include "dinput_clock_sync.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr int64_t NS_PER_US = 1000;
+    // about a second of frames at the usual pointer report rates.
+    constexpr size_t TRANSIT_WINDOW = 128;
+    // the smoothing of the jitter, as for the interarrival jitter of RTP.
+    constexpr double JITTER_GAIN = 16.0;
+    constexpr double JITTER_FACTOR = 3.0;
+    // pacing never holds a frame longer than this, a larger jitter is better passed through than buffered.
+    constexpr uint64_t MAX_EXTRA_DELAY_US = 30 * 1000;
+    constexpr uint64_t MAX_HOLD_US = 50 * 1000;
+    constexpr size_t MAX_HELD_FRAMES = 256;
+}
+
+void InjectJitterBuffer::Push(InjectEventBatch &&batch, uint64_t arrivalTime, uint64_t localTime)
+{
+    if (batch.events.second.empty()) {
+        return;
+    }
+    std::string devId = batch.events.first;
+    DeviceState &state = devices_[devId];
+    uint64_t kernelTime = 0;
+    bool isPaced = !HasKeyEvent(batch.events.second) && batch.events.second.front().when > 0 &&
+        DInputClockSync::GetInstance().RemoteToLocalUs(devId,
+            static_cast<uint64_t>(batch.events.second.front().when / NS_PER_US), kernelTime);
+    if (!isPaced || state.heldNum >= MAX_HELD_FRAMES) {
+        ReleaseDevice(devId, arrivalTime);
+    }
+    if (!isPaced) {
+        Hold(state, arrivalTime, std::move(batch));
+        return;
+    }
+
+    std::vector<InjectEventBatch> frames;
+    SplitFrames(std::move(batch), frames);
+    for (auto &frame : frames) {
+        const RawEvent &first = frame.events.second.front();
+        // the frames of a batch are read in order, a frame without a time goes with the previous one.
+        uint64_t frameTime = kernelTime;
+        if (first.when > 0 && DInputClockSync::GetInstance().RemoteToLocalUs(devId,
+            static_cast<uint64_t>(first.when / NS_PER_US), frameTime)) {
+            kernelTime = frameTime;
+        }
+        frameTime = frameTime + arrivalTime - localTime;
+        Hold(state, ScheduleFrame(state, frameTime, arrivalTime), std::move(frame));
+    }
+}
+
+uint64_t InjectJitterBuffer::ScheduleFrame(DeviceState &state, uint64_t frameTime, uint64_t arrivalTime)
+{
+    int64_t transit = static_cast<int64_t>(arrivalTime) - static_cast<int64_t>(frameTime);
+    if (!state.transits.empty()) {
+        double deviation = std::fabs(static_cast<double>(transit - state.lastTransit));
+        state.jitterUs += (deviation - state.jitterUs) / JITTER_GAIN;
+    }
+    state.lastTransit = transit;
+    state.transits.push_back(transit);
+    if (state.transits.size() > TRANSIT_WINDOW) {
+        state.transits.pop_front();
+    }
+    int64_t baseTransit = *std::min_element(state.transits.begin(), state.transits.end());
+    uint64_t extraDelay = std::min(static_cast<uint64_t>(JITTER_FACTOR * state.jitterUs), MAX_EXTRA_DELAY_US);
+
+    int64_t releaseTime = static_cast<int64_t>(frameTime) + baseTransit + static_cast<int64_t>(extraDelay);
+    releaseTime = std::min(releaseTime, static_cast<int64_t>(arrivalTime + MAX_HOLD_US));
+    // never overtake a frame of the same device.
+    releaseTime = std::max(releaseTime, static_cast<int64_t>(state.lastRelease));
+    state.lastRelease = static_cast<uint64_t>(releaseTime);
+    return state.lastRelease;
+}
+
+void InjectJitterBuffer::Hold(DeviceState &state, uint64_t releaseTime, InjectEventBatch &&frame)
+{
+    state.lastRelease = std::max(state.lastRelease, releaseTime);
+    state.heldNum++;
+    held_.emplace(releaseTime, std::move(frame));
+}
+
+void InjectJitterBuffer::ReleaseDevice(const std::string &devId, uint64_t releaseTime)
+{
+    std::vector<InjectEventBatch> frames;
+    for (auto iter = held_.begin(); iter != held_.end();) {
+        if (iter->second.events.first == devId) {
+            frames.push_back(std::move(iter->second));
+            iter = held_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    // equal keys keep their insertion order, so the frames stay in order.
+    for (auto &frame : frames) {
+        held_.emplace(releaseTime, std::move(frame));
+    }
+    devices_[devId].lastRelease = releaseTime;
+}
+
+void InjectJitterBuffer::PopDue(uint64_t now, std::vector<InjectEventBatch> &due)
+{
+    while (!held_.empty() && held_.begin()->first <= now) {
+        auto iter = devices_.find(held_.begin()->second.events.first);
+        if (iter != devices_.end() && iter->second.heldNum > 0) {
+            iter->second.heldNum--;
+        }
+        due.push_back(std::move(held_.begin()->second));
+        held_.erase(held_.begin());
+    }
+}
+
+void InjectJitterBuffer::PopAll(std::vector<InjectEventBatch> &due)
+{
+    for (auto &item : held_) {
+        due.push_back(std::move(item.second));
+    }
+    held_.clear();
+    for (auto &item : devices_) {
+        item.second.heldNum = 0;
+    }
+}
+
+bool InjectJitterBuffer::GetNextReleaseTime(uint64_t &releaseTime) const
+{
+    if (held_.empty()) {
+        return false;
+    }
+    releaseTime = held_.begin()->first;
+    return true;
+}
+
+uint64_t InjectJitterBuffer::GetTargetDelayUs(const std::string &devId) const
+{
+    auto iter = devices_.find(devId);
+    if (iter == devices_.end()) {
+        return 0;
+    }
+    return std::min(static_cast<uint64_t>(JITTER_FACTOR * iter->second.jitterUs), MAX_EXTRA_DELAY_US);
+}
+
+size_t InjectJitterBuffer::GetSize() const
+{
+    return held_.size();
+}
+
+void InjectJitterBuffer::Clear()
+{
+    held_.clear();
+    devices_.clear();
+}
+
+bool InjectJitterBuffer::HasKeyEvent(const std::vector<RawEvent> &events)
+{
+    return std::any_of(events.begin(), events.end(), [](const RawEvent &event) { return event.type == EV_KEY; });
+}
+
+void InjectJitterBuffer::SplitFrames(InjectEventBatch &&batch, std::vector<InjectEventBatch> &frames)
+{
+    InjectEventBatch frame;
+    frame.events.first = batch.events.first;
+    for (auto &event : batch.events.second) {
+        bool isFrameEnd = event.type == EV_SYN && event.code == SYN_REPORT;
+        frame.events.second.push_back(std::move(event));
+        if (isFrameEnd) {
+            frames.push_back(std::move(frame));
+            frame = InjectEventBatch();
+            frame.events.first = batch.events.first;
+        }
+    }
+    if (!frame.events.second.empty()) {
+        frames.push_back(std::move(frame));
+    }
+    // the trace ends with the write of the last frame.
+    if (!frames.empty()) {
+        frames.back().stamps = std::move(batch.stamps);
+    }
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
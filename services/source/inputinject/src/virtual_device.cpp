@@ -15,6 +15,8 @@
 
 #include "virtual_device.h"
 
+#include <algorithm>
+#include <cstring>
 #include <securec.h>
 #include <unistd.h>
 
@@ -31,7 +33,9 @@ namespace {
     constexpr uint32_t ABS_MAX_POS = 2;
     constexpr uint32_t ABS_FUZZ_POS = 3;
     constexpr uint32_t ABS_FLAT_POS = 4;
-    constexpr uint32_t SLEEP_TIME_US = 10 * 1000;
+    constexpr uint32_t NODE_READY_TIMEOUT_MS = 500;
+    const std::string VIRTUAL_INPUT_SYSFS_DIR = "/sys/devices/virtual/input/";
+    const std::string EVENT_NODE_PREFIX = "event";
 }
 VirtualDevice::VirtualDevice(const InputDevice &event) : deviceName_(event.name), busType_(event.bus),
     vendorId_(event.vendor), productId_(event.product), version_(event.version), classes_(event.classes)
@@ -165,7 +169,6 @@ bool VirtualDevice::SetUp(const InputDevice &inputDevice, const std::string &dev
         return false;
     }
     DHLOGI("create fd %{public}d", fd_);
-    usleep(SLEEP_TIME_US);
     char sysfsDeviceName[16] = {0};
     if (ioctl(fd_, UI_GET_SYSNAME(sizeof(sysfsDeviceName)), sysfsDeviceName) < 0) {
         DHLOGE("Unable to get input device name");
@@ -173,19 +176,119 @@ bool VirtualDevice::SetUp(const InputDevice &inputDevice, const std::string &dev
         return false;
     }
     DHLOGI("get input device name: %{public}s, fd: %{public}d", GetAnonyString(sysfsDeviceName).c_str(), fd_);
+    // the node path is known from sysfs, no need to open every /dev/input node to match the PHYS.
+    path_ = GetEventNodePath(sysfsDeviceName);
+    if (path_.empty() || !WaitNodeReady(path_)) {
+        DHLOGW("The event node of %{public}s is not ready yet", GetAnonyString(sysfsDeviceName).c_str());
+    }
+    return true;
+}
+
+std::string VirtualDevice::GetEventNodePath(const std::string &sysName)
+{
+    // the sysfs entries are created by UI_DEV_CREATE itself, the /dev node follows asynchronously.
+    std::string sysfsPath = VIRTUAL_INPUT_SYSFS_DIR + sysName;
+    DIR *dir = opendir(sysfsPath.c_str());
+    if (dir == nullptr) {
+        DHLOGE("Open sysfs dir failed: %{public}s", ConvertErrNo().c_str());
+        return "";
+    }
+    std::string eventName;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, EVENT_NODE_PREFIX.c_str(), EVENT_NODE_PREFIX.size()) == 0) {
+            eventName = entry->d_name;
+            break;
+        }
+    }
+    closedir(dir);
+    if (eventName.empty()) {
+        DHLOGE("No event node under %{public}s", GetAnonyString(sysName).c_str());
+        return "";
+    }
+    return std::string(DEVICE_PATH) + "/" + eventName;
+}
+
+bool VirtualDevice::WaitNodeReady(const std::string &nodePath)
+{
+    int fd = OpenInputDeviceFdWhenReady(nodePath, NODE_READY_TIMEOUT_MS);
+    if (fd < 0) {
+        return false;
+    }
+    CloseFd(fd);
+    DHLOGI("The event node %{public}s is ready", nodePath.c_str());
     return true;
 }
 
 bool VirtualDevice::InjectInputEvent(const input_event &event)
 {
+    if (event.type != EV_KEY) {
+        if (write(fd_, &event, sizeof(event)) < static_cast<ssize_t>(sizeof(event))) {
+            DHLOGE("could not inject event, removed? (fd: %{public}d", fd_);
+            return false;
+        }
+        RecordEventLog(event);
+        return true;
+    }
+    // the key is written and recorded under one lock, a concurrent release can not miss it.
+    std::lock_guard<std::mutex> lock(keyStateMutex_);
     if (write(fd_, &event, sizeof(event)) < static_cast<ssize_t>(sizeof(event))) {
         DHLOGE("could not inject event, removed? (fd: %{public}d", fd_);
         return false;
     }
+    UpdatePressedKeysLocked(event);
     RecordEventLog(event);
     return true;
 }
 
+void VirtualDevice::UpdatePressedKeysLocked(const input_event &event)
+{
+    if (event.code >= KEY_CNT || event.value == KEY_REPEAT) {
+        return;
+    }
+    bool pressed = (event.value != KEY_UP_STATE);
+    if (pressedKeyBits_.test(event.code) == pressed) {
+        return;
+    }
+    pressedKeyBits_.set(event.code, pressed);
+    if (pressed) {
+        pressedKeys_.push_back(event.code);
+        return;
+    }
+    pressedKeys_.erase(std::remove(pressedKeys_.begin(), pressedKeys_.end(), event.code), pressedKeys_.end());
+}
+
+size_t VirtualDevice::ReleasePressedKeys()
+{
+    std::lock_guard<std::mutex> lock(keyStateMutex_);
+    if (pressedKeys_.empty()) {
+        return 0;
+    }
+    std::vector<input_event> events;
+    events.reserve(pressedKeys_.size() + 1);
+    for (uint16_t code : pressedKeys_) {
+        DHLOGI("Release pressed key: %{public}d, path: %{public}s", code, path_.c_str());
+        input_event event = {};
+        event.type = EV_KEY;
+        event.code = code;
+        event.value = KEY_UP_STATE;
+        events.push_back(event);
+    }
+    input_event syncEvent = {};
+    syncEvent.type = EV_SYN;
+    syncEvent.code = SYN_REPORT;
+    events.push_back(syncEvent);
+    size_t releasedNum = pressedKeys_.size();
+    pressedKeys_.clear();
+    pressedKeyBits_.reset();
+    ssize_t len = static_cast<ssize_t>(events.size() * sizeof(input_event));
+    if (write(fd_, events.data(), events.size() * sizeof(input_event)) < len) {
+        DHLOGE("Release pressed keys failed, fd: %{public}d, %{public}s", fd_, ConvertErrNo().c_str());
+        return 0;
+    }
+    return releasedNum;
+}
+
 void VirtualDevice::SetNetWorkId(const std::string &netWorkId)
 {
     DHLOGI("SetNetWorkId %{public}s\n", GetAnonyString(netWorkId).c_str());
@@ -212,6 +315,21 @@ uint16_t VirtualDevice::GetClasses()
     return classes_;
 }
 
+std::string VirtualDevice::GetDeviceName()
+{
+    return deviceName_;
+}
+
+void VirtualDevice::SetSignature(const std::string &signature)
+{
+    signature_ = signature;
+}
+
+std::string VirtualDevice::GetSignature()
+{
+    return signature_;
+}
+
 void VirtualDevice::RecordEventLog(const input_event &event)
 {
     std::string eventType = "";
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_device_pool.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "dinput_log.h"
+#include "dinput_metrics.h"
+#include "dinput_utils_tool.h"
+#include "hidumper.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr size_t MAX_POOLED_DEVICE_NUM = 8;
+    constexpr uint64_t POOLED_DEVICE_IDLE_TIMEOUT_MS = 5 * 60 * 1000;
+    constexpr uint64_t US_PER_MS = 1000;
+    constexpr size_t ABS_VALUE_POS = 0;
+}
+
+VirtualDevicePool::~VirtualDevicePool()
+{
+    Clear();
+}
+
+std::string VirtualDevicePool::GetSignature(const InputDevice &inputDevice)
+{
+    // the axis value is the live position at probe time, only min, max, fuzz, flat and resolution are hashed.
+    InputDevice capability = inputDevice;
+    for (auto &[absCode, absInfo] : capability.absInfos) {
+        if (absInfo.size() > ABS_VALUE_POS) {
+            absInfo.erase(absInfo.begin() + ABS_VALUE_POS);
+        }
+    }
+    return Sha256(InputDeviceToJson(capability));
+}
+
+void VirtualDevicePool::Park(const std::string &devId, const std::string &dhId, std::unique_ptr<VirtualDevice> device)
+{
+    if (device == nullptr || device->GetSignature().empty()) {
+        return;
+    }
+    // the next user must not see a key that was held down when the device went away.
+    device->ReleasePressedKeys();
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    auto iter = pool_.find({devId, dhId});
+    if (iter != pool_.end()) {
+        EvictLocked(iter, "replaced");
+    }
+    if (pool_.size() >= MAX_POOLED_DEVICE_NUM) {
+        auto oldest = std::min_element(pool_.begin(), pool_.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.second.parkTime < rhs.second.parkTime; });
+        EvictLocked(oldest, "pool full");
+    }
+    PooledDevice &pooled = pool_[{devId, dhId}];
+    pooled.parkTime = GetCurrentTimeUs();
+    HiDumper::GetInstance().SavePooledNodeInfo(devId, device->GetDeviceName(), dhId, pooled.parkTime);
+    pooled.device = std::move(device);
+    DHLOGI("Park virtual device, deviceId: %{public}s, dhId: %{public}s, pool size: %{public}zu",
+        GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str(), pool_.size());
+}
+
+std::unique_ptr<VirtualDevice> VirtualDevicePool::Take(const std::string &devId, const std::string &dhId,
+    const std::string &signature)
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    auto iter = pool_.find({devId, dhId});
+    if (iter == pool_.end()) {
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::VIRTUAL_DEVICE_POOL_MISSES);
+        return nullptr;
+    }
+    if (iter->second.device->GetSignature() != signature) {
+        EvictLocked(iter, "capability changed");
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::VIRTUAL_DEVICE_POOL_MISSES);
+        return nullptr;
+    }
+    std::unique_ptr<VirtualDevice> device = std::move(iter->second.device);
+    pool_.erase(iter);
+    HiDumper::GetInstance().DeletePooledNodeInfo(devId, dhId);
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::VIRTUAL_DEVICE_POOL_HITS);
+    DHLOGI("Reuse pooled virtual device, deviceId: %{public}s, dhId: %{public}s", GetAnonyString(devId).c_str(),
+        GetAnonyString(dhId).c_str());
+    return device;
+}
+
+int64_t VirtualDevicePool::EvictIdle()
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    uint64_t now = GetCurrentTimeUs();
+    uint64_t timeout = POOLED_DEVICE_IDLE_TIMEOUT_MS * US_PER_MS;
+    uint64_t nextExpiry = 0;
+    for (auto iter = pool_.begin(); iter != pool_.end();) {
+        uint64_t expiry = iter->second.parkTime + timeout;
+        if (expiry <= now) {
+            auto evicted = iter++;
+            EvictLocked(evicted, "idle timeout");
+            continue;
+        }
+        nextExpiry = (nextExpiry == 0) ? expiry : std::min(nextExpiry, expiry);
+        iter++;
+    }
+    if (nextExpiry == 0) {
+        return 0;
+    }
+    // round up, so the next check does not run just before the node expires.
+    return static_cast<int64_t>((nextExpiry - now + US_PER_MS - 1) / US_PER_MS);
+}
+
+void VirtualDevicePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    while (!pool_.empty()) {
+        EvictLocked(pool_.begin(), "cleared");
+    }
+}
+
+size_t VirtualDevicePool::GetSize()
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    return pool_.size();
+}
+
+void VirtualDevicePool::EvictLocked(std::map<PoolKey, PooledDevice>::iterator iter, const char *reason)
+{
+    DHLOGI("Destroy pooled virtual device, deviceId: %{public}s, dhId: %{public}s, reason: %{public}s",
+        GetAnonyString(iter->first.first).c_str(), GetAnonyString(iter->first.second).c_str(), reason);
+    HiDumper::GetInstance().DeletePooledNodeInfo(iter->first.first, iter->first.second);
+    DInputMetrics::GetInstance().AddCounter(MetricCounter::VIRTUAL_DEVICE_POOL_EVICTIONS);
+    pool_.erase(iter);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -15,8 +15,10 @@
 
 #include "distributed_input_sourceinject_test.h"
 
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
+#include <future>
 #include <iostream>
 #include <thread>
 #include <unistd.h>
@@ -26,7 +28,9 @@
 #include "event_handler.h"
 #include "nlohmann/json.hpp"
 
+#include "dinput_clock_sync.h"
 #include "dinput_errcode.h"
+#include "inject_jitter_buffer.h"
 #include "softbus_bus_center.h"
 
 using namespace testing::ext;
@@ -35,6 +39,35 @@ using namespace std;
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    const std::string JITTER_DEV_ID = "jitter_buffer_test_dev";
+    constexpr uint64_t JITTER_BASE_US = 1000 * 1000 * 1000;
+    constexpr int64_t JITTER_NS_PER_US = 1000;
+
+    // a pointer frame read at the given sink time.
+    InjectEventBatch MakeMotionBatch(const std::string &devId, uint64_t kernelUs)
+    {
+        int64_t when = static_cast<int64_t>(kernelUs) * JITTER_NS_PER_US;
+        InjectEventBatch batch;
+        batch.events.first = devId;
+        batch.events.second = {
+            { when, EV_REL, REL_X, 1, "dhId", "path" },
+            { when, EV_SYN, SYN_REPORT, 0, "dhId", "path" },
+        };
+        return batch;
+    }
+
+    void SyncClockWithoutOffset(const std::string &devId)
+    {
+        ClockSample sample;
+        sample.t1 = JITTER_BASE_US;
+        sample.t2 = JITTER_BASE_US + 500;
+        sample.t3 = JITTER_BASE_US + 600;
+        sample.t4 = JITTER_BASE_US + 1100;
+        DInputClockSync::GetInstance().AddSample(devId, sample);
+    }
+}
+
 void DistributedInputSourceInjectTest::SetUp()
 {
 }
@@ -427,14 +460,10 @@ HWTEST_F(DistributedInputSourceInjectTest, RegisterInjectEventCb_002, testing::e
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
-HWTEST_F(DistributedInputSourceInjectTest, GetVirtualKeyboardPaths_001, testing::ext::TestSize.Level1)
+HWTEST_F(DistributedInputSourceInjectTest, NotifyNodeMgrScanVirNode_001, testing::ext::TestSize.Level1)
 {
     std::string devId;
-    std::vector<std::string> dhIds;
-    std::vector<std::string> virKeyboardPaths;
     DistributedInputInject::GetInstance().inputNodeManager_ = nullptr;
-    DistributedInputInject::GetInstance().GetVirtualKeyboardPaths(devId, dhIds, virKeyboardPaths);
-
     std::string dhId;
     DistributedInputInject::GetInstance().NotifyNodeMgrScanVirNode(devId, dhId);
 
@@ -459,6 +488,271 @@ HWTEST_F(DistributedInputSourceInjectTest, MatchAndSavePhysicalPath_001, testing
     DistributedInputInject::GetInstance().inputNodeManager_->isInjectThreadCreated_.store(false);
     DistributedInputInject::GetInstance().inputNodeManager_->StopInjectThread();
 }
+
+HWTEST_F(DistributedInputSourceInjectTest, OpenDevicesNodeAsync_001, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string dhId = "1ds56v18e1v21v8v1erv15r1v8r1j1ty8";
+    std::atomic<int32_t> callbackNum = 0;
+    CreateNodeCallback countCallback = [&callbackNum](const std::string &, const std::string &, int32_t) {
+        callbackNum++;
+    };
+    DistributedInputNodeManager nodeManager;
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL,
+        nodeManager.OpenDevicesNodeAsync(devId, dhId, "", countCallback));
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL,
+        nodeManager.OpenDevicesNodeAsync(devId, dhId, "parameters_test", nullptr));
+
+    std::promise<int32_t> promise;
+    std::future<int32_t> future = promise.get_future();
+    auto callback = [&promise, &callbackNum, devId, dhId](const std::string &resultDevId,
+        const std::string &resultDhId, int32_t result) {
+        EXPECT_EQ(devId, resultDevId);
+        EXPECT_EQ(dhId, resultDhId);
+        callbackNum++;
+        promise.set_value(result);
+    };
+    nlohmann::json inputDevice;
+    inputDevice[DEVICE_NAME] = "async_test";
+    inputDevice[DESCRIPTOR] = dhId;
+    ASSERT_EQ(DH_SUCCESS, nodeManager.OpenDevicesNodeAsync(devId, dhId, inputDevice.dump(), callback));
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(5)));
+    int32_t result = future.get();
+    VirtualDevice *device = nullptr;
+    int32_t getRet = nodeManager.GetDevice(devId, dhId, device);
+    EXPECT_EQ(result == DH_SUCCESS, getRet == DH_SUCCESS);
+    EXPECT_EQ(1, callbackNum.load());
+
+    nodeManager.StopCreateNodeThreads();
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_OPEN_DEVICE_NODE_FAIL,
+        nodeManager.OpenDevicesNodeAsync(devId, dhId, inputDevice.dump(), countCallback));
+}
+HWTEST_F(DistributedInputSourceInjectTest, VirtualDevicePool_001, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    InputDevice inputDevice;
+    inputDevice.name = "pool_test";
+    inputDevice.descriptor = "pool_test_dhid";
+    std::string signature = VirtualDevicePool::GetSignature(inputDevice);
+    EXPECT_FALSE(signature.empty());
+    VirtualDevicePool pool;
+
+    // the nodes without signature are not kept.
+    pool.Park(devId, inputDevice.descriptor, std::make_unique<VirtualDevice>(inputDevice));
+    EXPECT_EQ(0u, pool.GetSize());
+    EXPECT_EQ(0, pool.EvictIdle());
+
+    auto device = std::make_unique<VirtualDevice>(inputDevice);
+    device->SetSignature(signature);
+    pool.Park(devId, inputDevice.descriptor, std::move(device));
+    EXPECT_EQ(1u, pool.GetSize());
+    EXPECT_GT(pool.EvictIdle(), 0);
+    EXPECT_EQ(nullptr, pool.Take("other_dev_id", inputDevice.descriptor, signature));
+    EXPECT_NE(nullptr, pool.Take(devId, inputDevice.descriptor, signature));
+    EXPECT_EQ(0u, pool.GetSize());
+
+    // a node of changed capability is destroyed instead of reused.
+    device = std::make_unique<VirtualDevice>(inputDevice);
+    device->SetSignature(signature);
+    pool.Park(devId, inputDevice.descriptor, std::move(device));
+    inputDevice.eventKeys.push_back(KEY_A);
+    EXPECT_EQ(nullptr, pool.Take(devId, inputDevice.descriptor, VirtualDevicePool::GetSignature(inputDevice)));
+    EXPECT_EQ(0u, pool.GetSize());
+
+    // the pool is bounded, the least recently parked node goes first.
+    for (int32_t i = 0; i < 16; i++) {
+        device = std::make_unique<VirtualDevice>(inputDevice);
+        device->SetSignature(signature);
+        pool.Park(devId, std::to_string(i), std::move(device));
+    }
+    EXPECT_EQ(8u, pool.GetSize());
+    EXPECT_EQ(nullptr, pool.Take(devId, "0", signature));
+    EXPECT_NE(nullptr, pool.Take(devId, "15", signature));
+    pool.Clear();
+    EXPECT_EQ(0u, pool.GetSize());
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, VirtualDevicePool_002, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string dhId = "pool_test_dhid";
+    DistributedInputNodeManager nodeManager;
+    InputDevice inputDevice;
+    inputDevice.descriptor = dhId;
+    auto device = std::make_unique<VirtualDevice>(inputDevice);
+    device->SetSignature(VirtualDevicePool::GetSignature(inputDevice));
+    nodeManager.AddDeviceLocked(devId, dhId, std::move(device));
+    EXPECT_EQ(DH_SUCCESS, nodeManager.CloseDeviceLocked(devId, dhId));
+    EXPECT_EQ(1u, nodeManager.devicePool_.GetSize());
+
+    // registering the same device again takes the parked node without creating a new one.
+    EXPECT_EQ(DH_SUCCESS, nodeManager.CreateHandle(inputDevice, devId, dhId));
+    EXPECT_EQ(0u, nodeManager.devicePool_.GetSize());
+    VirtualDevice *reused = nullptr;
+    EXPECT_EQ(DH_SUCCESS, nodeManager.GetDevice(devId, dhId, reused));
+}
+HWTEST_F(DistributedInputSourceInjectTest, VirtualDevicePool_003, testing::ext::TestSize.Level1)
+{
+    InputDevice inputDevice;
+    inputDevice.name = "pool_test";
+    inputDevice.descriptor = "pool_test_dhid";
+    inputDevice.absInfos[ABS_X] = { 100, 0, 1920, 0, 0, 10 };
+    std::string signature = VirtualDevicePool::GetSignature(inputDevice);
+
+    // the pointer moved, the node is still the same.
+    inputDevice.absInfos[ABS_X] = { 500, 0, 1920, 0, 0, 10 };
+    EXPECT_EQ(signature, VirtualDevicePool::GetSignature(inputDevice));
+
+    inputDevice.absInfos[ABS_X] = { 500, 0, 2560, 0, 0, 10 };
+    EXPECT_NE(signature, VirtualDevicePool::GetSignature(inputDevice));
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, GetEventNodePath_001, testing::ext::TestSize.Level1)
+{
+    InputDevice inputDevice;
+    VirtualDevice device(inputDevice);
+    EXPECT_EQ("", device.GetEventNodePath("input_not_exist"));
+
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string dhId = "path_test_dhid";
+    std::string nodePath = "/dev/input/event_path_test";
+    DistributedInputNodeManager nodeManager;
+    auto virtualDevice = std::make_unique<VirtualDevice>(inputDevice);
+    virtualDevice->SetPath(nodePath);
+    nodeManager.AddDeviceLocked(devId, dhId, std::move(virtualDevice));
+    nodeManager.NotifyNodeMgrScanVirNode(devId, dhId);
+    VirtualDevice *found = nullptr;
+    ASSERT_EQ(DH_SUCCESS, nodeManager.GetDevice(devId, dhId, found));
+    EXPECT_EQ(nodePath, found->GetPath());
+}
+HWTEST_F(DistributedInputSourceInjectTest, ReleasePressedKeys_001, testing::ext::TestSize.Level1)
+{
+    int fds[2] = { -1, -1 };
+    ASSERT_EQ(0, pipe(fds));
+    InputDevice inputDevice;
+    VirtualDevice device(inputDevice);
+    device.fd_ = fds[1];
+    EXPECT_EQ(0u, device.ReleasePressedKeys());
+
+    std::vector<input_event> injected = {
+        { .type = EV_KEY, .code = KEY_A, .value = KEY_DOWN_STATE },
+        { .type = EV_KEY, .code = KEY_B, .value = KEY_DOWN_STATE },
+        { .type = EV_KEY, .code = KEY_A, .value = KEY_REPEAT },
+        { .type = EV_KEY, .code = KEY_B, .value = KEY_UP_STATE },
+        { .type = EV_KEY, .code = BTN_LEFT, .value = KEY_DOWN_STATE },
+        { .type = EV_SYN, .code = SYN_REPORT, .value = 0 },
+    };
+    for (const auto &event : injected) {
+        EXPECT_TRUE(device.InjectInputEvent(event));
+    }
+    EXPECT_EQ(2u, device.ReleasePressedKeys());
+    EXPECT_EQ(0u, device.ReleasePressedKeys());
+
+    std::vector<input_event> written(injected.size() + 3);
+    ssize_t len = read(fds[0], written.data(), written.size() * sizeof(input_event));
+    ASSERT_EQ(static_cast<ssize_t>(written.size() * sizeof(input_event)), len);
+    const input_event *released = written.data() + injected.size();
+    EXPECT_EQ(KEY_A, released[0].code);
+    EXPECT_EQ(KEY_UP_STATE, static_cast<uint32_t>(released[0].value));
+    EXPECT_EQ(BTN_LEFT, released[1].code);
+    EXPECT_EQ(KEY_UP_STATE, static_cast<uint32_t>(released[1].value));
+    EXPECT_EQ(EV_SYN, released[2].type);
+    close(fds[0]);
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, InjectJitterBuffer_001, testing::ext::TestSize.Level1)
+{
+    SyncClockWithoutOffset(JITTER_DEV_ID);
+    InjectJitterBuffer jitterBuffer;
+    std::vector<InjectEventBatch> due;
+    // three frames read 8 ms apart arrive in one clump.
+    uint64_t arrivalTime = JITTER_BASE_US + 20000;
+    for (uint64_t i = 0; i < 3; i++) {
+        jitterBuffer.Push(MakeMotionBatch(JITTER_DEV_ID, JITTER_BASE_US + i * 8000), arrivalTime, arrivalTime);
+    }
+    EXPECT_EQ(3u, jitterBuffer.GetSize());
+    EXPECT_GT(jitterBuffer.GetTargetDelayUs(JITTER_DEV_ID), 0u);
+    jitterBuffer.PopDue(arrivalTime, due);
+    EXPECT_EQ(1u, due.size());
+
+    uint64_t releaseTime = 0;
+    uint64_t lastReleaseTime = arrivalTime;
+    while (jitterBuffer.GetNextReleaseTime(releaseTime)) {
+        EXPECT_GT(releaseTime, lastReleaseTime);
+        lastReleaseTime = releaseTime;
+        jitterBuffer.PopDue(releaseTime, due);
+    }
+    ASSERT_EQ(3u, due.size());
+    for (uint64_t i = 0; i < due.size(); i++) {
+        EXPECT_EQ(static_cast<int64_t>(JITTER_BASE_US + i * 8000) * JITTER_NS_PER_US,
+            due[i].events.second.front().when);
+    }
+    DInputClockSync::GetInstance().RemoveDevice(JITTER_DEV_ID);
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, InjectJitterBuffer_002, testing::ext::TestSize.Level1)
+{
+    SyncClockWithoutOffset(JITTER_DEV_ID);
+    InjectJitterBuffer jitterBuffer;
+    std::vector<InjectEventBatch> due;
+    uint64_t arrivalTime = JITTER_BASE_US + 20000;
+    jitterBuffer.Push(MakeMotionBatch(JITTER_DEV_ID, JITTER_BASE_US), arrivalTime, arrivalTime);
+    jitterBuffer.PopDue(arrivalTime, due);
+    // a faster frame lowers the base transit, it is held for the jitter seen so far.
+    arrivalTime += 8000;
+    jitterBuffer.Push(MakeMotionBatch(JITTER_DEV_ID, arrivalTime - 4000), arrivalTime, arrivalTime);
+    jitterBuffer.PopDue(arrivalTime, due);
+    EXPECT_EQ(1u, due.size());
+    EXPECT_EQ(1u, jitterBuffer.GetSize());
+
+    // a key batch bypasses the buffer and takes the held frame along, in order.
+    InjectEventBatch keyBatch = MakeMotionBatch(JITTER_DEV_ID, arrivalTime);
+    keyBatch.events.second.front().type = EV_KEY;
+    keyBatch.events.second.front().code = BTN_LEFT;
+    jitterBuffer.Push(std::move(keyBatch), arrivalTime, arrivalTime);
+    jitterBuffer.PopDue(arrivalTime, due);
+    ASSERT_EQ(3u, due.size());
+    EXPECT_EQ(EV_REL, due[1].events.second.front().type);
+    EXPECT_EQ(EV_KEY, due[2].events.second.front().type);
+    EXPECT_EQ(0u, jitterBuffer.GetSize());
+    DInputClockSync::GetInstance().RemoveDevice(JITTER_DEV_ID);
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, InjectJitterBuffer_003, testing::ext::TestSize.Level1)
+{
+    InjectJitterBuffer jitterBuffer;
+    std::vector<InjectEventBatch> due;
+    // without a clock estimate the sink time means nothing locally.
+    jitterBuffer.Push(MakeMotionBatch("jitter_buffer_unknown_dev", JITTER_BASE_US), JITTER_BASE_US + 20000,
+        JITTER_BASE_US + 20000);
+    jitterBuffer.PopDue(JITTER_BASE_US + 20000, due);
+    EXPECT_EQ(1u, due.size());
+    EXPECT_EQ(0u, jitterBuffer.GetSize());
+}
+
+HWTEST_F(DistributedInputSourceInjectTest, InjectJitterBuffer_004, testing::ext::TestSize.Level1)
+{
+    SyncClockWithoutOffset(JITTER_DEV_ID);
+    InjectJitterBuffer jitterBuffer;
+    std::vector<InjectEventBatch> due;
+    uint64_t arrivalTime = 5 * 1000 * 1000;
+    uint64_t localTime = JITTER_BASE_US + 20000;
+    jitterBuffer.Push(MakeMotionBatch(JITTER_DEV_ID, JITTER_BASE_US), arrivalTime, localTime);
+    jitterBuffer.PopDue(arrivalTime, due);
+    EXPECT_EQ(1u, due.size());
+
+    // the wall clock steps back ten seconds, the next frame is still released within the hold limit.
+    arrivalTime += 8000;
+    localTime += 8000 - 10 * 1000 * 1000;
+    jitterBuffer.Push(MakeMotionBatch(JITTER_DEV_ID, JITTER_BASE_US + 8000), arrivalTime, localTime);
+    uint64_t releaseTime = 0;
+    ASSERT_TRUE(jitterBuffer.GetNextReleaseTime(releaseTime));
+    EXPECT_LE(releaseTime, arrivalTime + 50 * 1000);
+    jitterBuffer.PopDue(arrivalTime + 50 * 1000, due);
+    EXPECT_EQ(2u, due.size());
+    EXPECT_EQ(0u, jitterBuffer.GetSize());
+    DInputClockSync::GetInstance().RemoveDevice(JITTER_DEV_ID);
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_PENDING_REQUEST_TABLE_H
+#define DINPUT_PENDING_REQUEST_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "dinput_softbus_define.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+inline uint64_t NextRequestId()
+{
+    static std::atomic<uint64_t> lastRequestId { INVALID_REQUEST_ID };
+    return ++lastRequestId;
+}
+
+/*
+ * The requests sent to the sink and waiting for the response, keyed by the correlation id carried in the
+ * softbus message. The ids are unique across the tables, so an id names one request of one operation.
+ */
+template <typename T>
+class PendingRequestTable {
+public:
+    uint64_t Add(const T &info)
+    {
+        uint64_t requestId = NextRequestId();
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        requests_.emplace(requestId, info);
+        return requestId;
+    }
+
+    bool Take(uint64_t requestId, T &info)
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        auto iter = requests_.find(requestId);
+        if (iter == requests_.end()) {
+            return false;
+        }
+        info = iter->second;
+        requests_.erase(iter);
+        return true;
+    }
+
+    /*
+     * For the responses without a correlation id, take the oldest request the match accepts.
+     */
+    bool TakeMatch(const std::function<bool(const T &)> &match, T &info, uint64_t &requestId)
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        auto oldest = requests_.end();
+        for (auto iter = requests_.begin(); iter != requests_.end(); ++iter) {
+            if (match(iter->second) && (oldest == requests_.end() || iter->first < oldest->first)) {
+                oldest = iter;
+            }
+        }
+        if (oldest == requests_.end()) {
+            return false;
+        }
+        requestId = oldest->first;
+        info = oldest->second;
+        requests_.erase(oldest);
+        return true;
+    }
+
+    bool HasMatch(const std::function<bool(const T &)> &match)
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        for (const auto &[requestId, info] : requests_) {
+            if (match(info)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        return requests_.size();
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        requests_.clear();
+    }
+
+private:
+    std::mutex requestMutex_;
+    std::unordered_map<uint64_t, T> requests_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_PENDING_REQUEST_TABLE_H
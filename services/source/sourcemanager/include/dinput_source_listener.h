@@ -50,10 +50,24 @@ public:
     void OnResponseStopRemoteInput(const std::string deviceId, const uint32_t inputTypes, bool result) override;
     void OnResponseStartRemoteInputDhid(const std::string deviceId, const std::string &dhids, bool result) override;
     void OnResponseStopRemoteInputDhid(const std::string deviceId, const std::string &dhids, bool result) override;
+    void OnResponsePrepareStartRemoteInput(const std::string deviceId, bool prepareResult, bool startResult,
+        const std::string &dhids, const std::string &object) override;
+    void OnResponseStartRemoteInputById(const std::string deviceId, const uint32_t inputTypes, bool result,
+        uint64_t requestId) override;
+    void OnResponseStopRemoteInputById(const std::string deviceId, const uint32_t inputTypes, bool result,
+        uint64_t requestId) override;
+    void OnResponseStartRemoteInputDhidById(const std::string deviceId, const std::string &dhids, bool result,
+        uint64_t requestId) override;
+    void OnResponseStopRemoteInputDhidById(const std::string deviceId, const std::string &dhids, bool result,
+        uint64_t requestId) override;
+    void OnResponsePrepareStartRemoteInputById(const std::string deviceId, bool prepareResult, bool startResult,
+        const std::string &dhids, const std::string &object, uint64_t requestId) override;
     void OnResponseKeyState(const std::string deviceId, const std::string &dhid, const uint32_t type,
         const uint32_t code, const uint32_t value) override;
     void OnResponseKeyStateBatch(const std::string deviceId, const std::string &event) override;
     void OnReceivedEventRemoteInput(const std::string deviceId, const std::string &event) override;
+    void OnReceivedTracedEventRemoteInput(const std::string deviceId, const std::string &event,
+        const TraceStamps &stamps) override;
     void OnResponseRelayPrepareRemoteInput(int32_t sessionId, const std::string &deviceId, bool result,
         const std::string &object) override;
     void OnResponseRelayUnprepareRemoteInput(int32_t sessionId, const std::string &deviceId, bool result) override;
@@ -72,6 +86,8 @@ public:
     void RecordEventLog(int64_t when, int32_t type, int32_t code, int32_t value, const std::string &path);
 
 private:
+    bool ParseEventBatch(const std::string deviceId, const std::string &event, std::vector<RawEvent> &eventBuffer);
+
     DistributedInputSourceManager *sourceManagerObj_;
 };
 } // namespace DistributedInput
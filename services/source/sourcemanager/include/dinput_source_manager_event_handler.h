@@ -53,6 +53,7 @@ private:
     void NotifyStartCallback(const AppExecFwk::InnerEvent::Pointer &event);
     void NotifyStopCallback(const AppExecFwk::InnerEvent::Pointer &event);
     void NotifyStartDhidCallback(const AppExecFwk::InnerEvent::Pointer &event);
+    void NotifyPrepareStartDhidCallback(const AppExecFwk::InnerEvent::Pointer &event);
     void NotifyStopDhidCallback(const AppExecFwk::InnerEvent::Pointer &event);
     void NotifyKeyStateCallback(const AppExecFwk::InnerEvent::Pointer &event);
     void NotifyStartServerCallback(const AppExecFwk::InnerEvent::Pointer &event);
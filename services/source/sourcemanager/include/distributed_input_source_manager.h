@@ -16,6 +16,7 @@
 #ifndef DISTRIBUTED_INPUT_SOURCE_MANAGER_SERVICE_H
 #define DISTRIBUTED_INPUT_SOURCE_MANAGER_SERVICE_H
 
+#include <condition_variable>
 #include <cstring>
 #include <mutex>
 #include <set>
@@ -32,6 +33,7 @@
 
 #include "constants_dinput.h"
 #include "dinput_context.h"
+#include "dinput_pending_request_table.h"
 #include "dinput_source_manager_callback.h"
 #include "dinput_source_trans_callback.h"
 #include "distributed_input_node_manager.h"
@@ -69,6 +71,7 @@ const uint32_t DINPUT_SOURCE_MANAGER_RELAY_STARTDHID_RESULT_MMI = 16;
 const uint32_t DINPUT_SOURCE_MANAGER_RELAY_STOPDHID_RESULT_MMI  = 17;
 const uint32_t DINPUT_SOURCE_MANAGER_RELAY_STARTTYPE_RESULT_MMI = 18;
 const uint32_t DINPUT_SOURCE_MANAGER_RELAY_STOPTYPE_RESULT_MMI  = 19;
+const uint32_t DINPUT_SOURCE_MANAGER_PREPARE_START_DHID_MSG = 20;
 
 const std::string INPUT_SOURCEMANAGER_KEY_SESSIONID = "sessionId";
 const std::string INPUT_SOURCEMANAGER_KEY_DEVID = "deviceId";
@@ -80,8 +83,10 @@ const std::string INPUT_SOURCEMANAGER_KEY_CODE = "code";
 const std::string INPUT_SOURCEMANAGER_KEY_VALUE = "value";
 const std::string INPUT_SOURCEMANAGER_KEY_RESULT = "result";
 const std::string INPUT_SOURCEMANAGER_KEY_WHITELIST = "whitelist";
+const std::string INPUT_SOURCEMANAGER_KEY_START_RESULT = "startResult";
 const std::string INPUT_SOURCEMANAGER_KEY_SRC_DEVID = "srcId";
 const std::string INPUT_SOURCEMANAGER_KEY_SINK_DEVID = "sinkId";
+const std::string INPUT_SOURCEMANAGER_KEY_REQUEST_ID = "requestId";
 
 const uint32_t DINPUT_SOURCE_SWITCH_OFF = 0;
 const uint32_t DINPUT_SOURCE_SWITCH_ON = 1;
@@ -136,6 +141,9 @@ public:
     int32_t RegisterDistributedHardware(const std::string &devId, const std::string &dhId,
         const std::string &parameters, sptr<IRegisterDInputCallback> callback) override;
 
+    int32_t RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+        sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results) override;
+
     int32_t UnregisterDistributedHardware(const std::string &devId, const std::string &dhId,
         sptr<IUnregisterDInputCallback> callback) override;
 
@@ -167,6 +175,9 @@ public:
     int32_t StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
         sptr<IStartStopDInputsCallback> callback) override;
 
+    int32_t PrepareAndStartRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
+        sptr<IPrepareDInputCallback> prepareCallback, sptr<IStartStopDInputsCallback> startCallback) override;
+
     int32_t StartRemoteInput(const std::string &srcId, const std::string &sinkId,
         const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback) override;
 
@@ -186,6 +197,15 @@ public:
         const std::string &parameters, sptr<IRegisterDInputCallback> callback);
     bool CheckUnregisterParam(const std::string &devId, const std::string &dhId,
         sptr<IUnregisterDInputCallback> callback);
+    /*
+     * Create the virtual nodes of the items concurrently and wait up to REQUEST_TIMEOUT_MS for them, results is
+     * indexed like items. A node created after the wait timed out is closed again.
+     */
+    void CreateBatchNodes(const std::vector<RegisterHardwareItem> &items, const std::vector<size_t> &indexes,
+        std::vector<int32_t> &results);
+    void CloseLateBatchNode(const std::string &devId, const std::string &dhId);
+    // record the node of a settled batch item, or drop its callback if it failed.
+    void SaveBatchItemLocked(const RegisterHardwareItem &item, int32_t result);
     int32_t Dump(int32_t fd, const std::vector<std::u16string> &args) override;
 
     class DInputSrcMgrListener : public DInputSourceManagerCallback {
@@ -251,11 +271,21 @@ public:
     void RunUnregisterCallback(const std::string &devId, const std::string &dhId, const int32_t &status);
     void RunPrepareCallback(const std::string &devId, const int32_t &status, const std::string &object);
     void RunUnprepareCallback(const std::string &devId, const int32_t &status);
-    void RunStartCallback(const std::string &devId, const uint32_t &inputTypes, const int32_t &status);
-    void RunStopCallback(const std::string &devId, const uint32_t &inputTypes, const int32_t &status);
-
-    void RunStartDhidCallback(const std::string &sinkId, const std::string &dhIds, const int32_t &status);
-    void RunStopDhidCallback(const std::string &sinkId, const std::string &dhIds, const int32_t &status);
+    /*
+     * requestId is the correlation id echoed by the sink, INVALID_REQUEST_ID falls back to matching
+     * the pending request by device and types or dhIds.
+     */
+    void RunStartCallback(const std::string &devId, const uint32_t &inputTypes, const int32_t &status,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    void RunStopCallback(const std::string &devId, const uint32_t &inputTypes, const int32_t &status,
+        uint64_t requestId = INVALID_REQUEST_ID);
+
+    void RunStartDhidCallback(const std::string &sinkId, const std::string &dhIds, const int32_t &status,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    void RunStopDhidCallback(const std::string &sinkId, const std::string &dhIds, const int32_t &status,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    void RunPrepareStartCallback(const std::string &sinkId, const std::string &dhIds, const int32_t &prepareStatus,
+        const int32_t &startStatus, const std::string &object, uint64_t requestId = INVALID_REQUEST_ID);
     void RunKeyStateCallback(const std::string &sinkId, const std::string &dhId, const uint32_t type,
         const uint32_t code, const uint32_t value);
     void RunWhiteListCallback(const std::string &devId, const std::string &object);
@@ -336,16 +366,18 @@ private:
 
     struct DInputClientStartInfo {
         std::string devId;
-        uint32_t inputTypes;
+        uint32_t inputTypes = 0;
         sptr<IStartDInputCallback> callback = nullptr;
+        DInputClientStartInfo() = default;
         DInputClientStartInfo(std::string deviceId, uint32_t types, sptr<IStartDInputCallback> cb)
             : devId(deviceId), inputTypes(types), callback(cb) {}
     };
 
     struct DInputClientStopInfo {
         std::string devId;
-        uint32_t inputTypes;
+        uint32_t inputTypes = 0;
         sptr<IStopDInputCallback> callback = nullptr;
+        DInputClientStopInfo() = default;
         DInputClientStopInfo(std::string deviceId, uint32_t types, sptr<IStopDInputCallback> cb)
             : devId(deviceId), inputTypes(types), callback(cb) {}
     };
@@ -429,11 +461,14 @@ private:
     std::vector<DInputClientUnregistInfo> unregCallbacks_;
     std::set<DInputClientPrepareInfo> preCallbacks_;
     std::set<DInputClientUnprepareInfo> unpreCallbacks_;
-    std::vector<DInputClientStartInfo> staCallbacks_;
-    std::vector<DInputClientStopInfo> stpCallbacks_;
+    // the start and stop requests waiting for the sink, keyed by the correlation id sent with the request.
+    PendingRequestTable<DInputClientStartInfo> staCallbacks_;
+    PendingRequestTable<DInputClientStopInfo> stpCallbacks_;
 
-    std::vector<DInputClientStartDhidInfo> staStringCallbacks_;
-    std::vector<DInputClientStopDhidInfo> stpStringCallbacks_;
+    PendingRequestTable<DInputClientStartDhidInfo> staStringCallbacks_;
+    PendingRequestTable<DInputClientStopDhidInfo> stpStringCallbacks_;
+    // the fused requests to a sink without the prepare and start message, started once the prepare succeeds.
+    std::map<std::string, DInputClientStartDhidInfo> pendingPrepareStarts_;
 
     std::set<DInputClientRelayPrepareInfo> relayPreCallbacks_;
     std::set<DInputClientRelayUnprepareInfo> relayUnpreCallbacks_;
@@ -456,6 +491,10 @@ private:
     void handleStartServerCallback(const std::string &devId);
 
     std::mutex regDisHardwareMutex_;
+    // the devId and dhId pairs a batch is creating the node of without regDisHardwareMutex_ held, another
+    // register of the same pair waits on regDisHardwareCv_ for the batch instead of creating a second node.
+    std::set<std::pair<std::string, std::string>> registeringDhIds_;
+    std::condition_variable regDisHardwareCv_;
     std::mutex prepareMutex_;
     std::mutex startStopMutex_;
     std::mutex startMutex_;
@@ -480,6 +519,30 @@ private:
     int32_t RelayStopRemoteInputByDhid(const std::string &srcId, const std::string &sinkId,
         const std::vector<std::string> &dhIds, sptr<IStartStopDInputsCallback> callback);
     bool IsStringDataSame(const std::vector<std::string> &oldDhIds, std::vector<std::string> newDhIds);
+    /*
+     * Fail the request with ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT if the sink does not answer in time,
+     * onTimeout takes the request out of its table and reports the result.
+     */
+    void ScheduleRequestTimeout(uint64_t requestId, const std::function<void()> &onTimeout);
+    void CancelRequestTimeout(uint64_t requestId);
+    void OnStartRequestTimeout(uint64_t requestId);
+    void OnStopRequestTimeout(uint64_t requestId);
+    void OnStartDhidRequestTimeout(uint64_t requestId);
+    void OnStopDhidRequestTimeout(uint64_t requestId);
+    /*
+     * Stop the inputs of a start the client was told failed, on its timeout or on a success answered too late,
+     * so the sink does not keep sending events nobody waits for.
+     */
+    void SendCompensatingStop(const std::string &devId, uint32_t inputTypes);
+    void SendCompensatingStop(const std::string &sinkId, const std::vector<std::string> &dhIds);
+    /*
+     * The prepare half of a fused request is keyed by the sink, it fails with
+     * ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT as the start half does.
+     */
+    void SchedulePrepareTimeout(const std::string &devId);
+    void CancelPrepareTimeout(const std::string &devId);
+    void OnPrepareRequestTimeout(const std::string &devId);
+    void StartPreparedRemoteInput(const std::string &devId, int32_t prepareStatus);
 
     void UnregisterDHFwkPublisher();
 
@@ -29,6 +29,7 @@
 #include "constants_dinput.h"
 #include "dinput_errcode.h"
 #include "dinput_log.h"
+#include "dinput_metrics.h"
 #include "dinput_utils_tool.h"
 #include "dinput_softbus_define.h"
 #include "distributed_input_inject.h"
@@ -181,6 +182,12 @@ void DInputSourceListener::OnResponseRelayUnprepareRemoteInput(int32_t toSrcSess
 
 void DInputSourceListener::OnResponseStartRemoteInput(
     const std::string deviceId, const uint32_t inputTypes, bool result)
+{
+    OnResponseStartRemoteInputById(deviceId, inputTypes, result, INVALID_REQUEST_ID);
+}
+
+void DInputSourceListener::OnResponseStartRemoteInputById(
+    const std::string deviceId, const uint32_t inputTypes, bool result, uint64_t requestId)
 {
     DHLOGI("OnResponseStartRemoteInput called, deviceId: %{public}s, inputTypes: %{public}d, result: %{public}s.",
         GetAnonyString(deviceId).c_str(), inputTypes, result ? "success" : "failed");
@@ -191,19 +198,16 @@ void DInputSourceListener::OnResponseStartRemoteInput(
     }
     if (sourceManagerObj_->GetCallbackEventHandler() == nullptr) {
         sourceManagerObj_->RunStartCallback(deviceId, inputTypes,
-            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL);
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL, requestId);
         DHLOGE("GetCallbackEventHandler is null.");
         return;
     }
-    if (result) {
-        sourceManagerObj_->SetDeviceMapValue(deviceId, DINPUT_SOURCE_SWITCH_ON);
-    }
-
     auto jsonArrayMsg = std::make_shared<nlohmann::json>();
     nlohmann::json tmpJson;
     tmpJson[INPUT_SOURCEMANAGER_KEY_DEVID] = deviceId;
     tmpJson[INPUT_SOURCEMANAGER_KEY_ITP] = inputTypes;
     tmpJson[INPUT_SOURCEMANAGER_KEY_RESULT] = result;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_REQUEST_ID] = requestId;
     jsonArrayMsg->push_back(tmpJson);
     AppExecFwk::InnerEvent::Pointer msgEvent = AppExecFwk::InnerEvent::Get(
         DINPUT_SOURCE_MANAGER_START_MSG, jsonArrayMsg, 0);
@@ -211,6 +215,12 @@ void DInputSourceListener::OnResponseStartRemoteInput(
 }
 
 void DInputSourceListener::OnResponseStopRemoteInput(const std::string deviceId, const uint32_t inputTypes, bool result)
+{
+    OnResponseStopRemoteInputById(deviceId, inputTypes, result, INVALID_REQUEST_ID);
+}
+
+void DInputSourceListener::OnResponseStopRemoteInputById(const std::string deviceId, const uint32_t inputTypes,
+    bool result, uint64_t requestId)
 {
     DHLOGI("OnResponseStopRemoteInput called, deviceId: %{public}s, inputTypes: %{public}d, result: %{public}s.",
         GetAnonyString(deviceId).c_str(), inputTypes, result ? "true" : "failed");
@@ -222,7 +232,7 @@ void DInputSourceListener::OnResponseStopRemoteInput(const std::string deviceId,
     if (sourceManagerObj_->GetCallbackEventHandler() == nullptr) {
         DHLOGE("OnResponseStopRemoteInput GetCallbackEventHandler is null.");
         sourceManagerObj_->RunStopCallback(deviceId, inputTypes,
-            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL);
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL, requestId);
         return;
     }
 
@@ -231,6 +241,7 @@ void DInputSourceListener::OnResponseStopRemoteInput(const std::string deviceId,
     tmpJson[INPUT_SOURCEMANAGER_KEY_DEVID] = deviceId;
     tmpJson[INPUT_SOURCEMANAGER_KEY_ITP] = inputTypes;
     tmpJson[INPUT_SOURCEMANAGER_KEY_RESULT] = result;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_REQUEST_ID] = requestId;
     jsonArrayMsg->push_back(tmpJson);
     AppExecFwk::InnerEvent::Pointer msgEvent = AppExecFwk::InnerEvent::Get(
         DINPUT_SOURCE_MANAGER_STOP_MSG, jsonArrayMsg, 0);
@@ -239,6 +250,12 @@ void DInputSourceListener::OnResponseStopRemoteInput(const std::string deviceId,
 
 void DInputSourceListener::OnResponseStartRemoteInputDhid(
     const std::string deviceId, const std::string &dhids, bool result)
+{
+    OnResponseStartRemoteInputDhidById(deviceId, dhids, result, INVALID_REQUEST_ID);
+}
+
+void DInputSourceListener::OnResponseStartRemoteInputDhidById(
+    const std::string deviceId, const std::string &dhids, bool result, uint64_t requestId)
 {
     DHLOGI("OnResponseStartRemoteInputDhid called, deviceId: %{public}s, result: %{public}s.",
         GetAnonyString(deviceId).c_str(), result ? "success" : "failed");
@@ -250,13 +267,9 @@ void DInputSourceListener::OnResponseStartRemoteInputDhid(
     if (sourceManagerObj_->GetCallbackEventHandler() == nullptr) {
         DHLOGE("OnResponseStartRemoteInputDhid GetCallbackEventHandler is null.");
         sourceManagerObj_->RunStartDhidCallback(deviceId, dhids,
-                                                ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL);
+                                                ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL, requestId);
         return;
     }
-    if (result) {
-        sourceManagerObj_->SetDeviceMapValue(deviceId, DINPUT_SOURCE_SWITCH_ON);
-    }
-
     std::vector<std::string> devDhIds;
     SplitStringToVector(dhids, INPUT_STRING_SPLIT_POINT, devDhIds);
 
@@ -265,14 +278,58 @@ void DInputSourceListener::OnResponseStartRemoteInputDhid(
     tmpJson[INPUT_SOURCEMANAGER_KEY_DEVID] = deviceId;
     tmpJson[INPUT_SOURCEMANAGER_KEY_DHID] = dhids;
     tmpJson[INPUT_SOURCEMANAGER_KEY_RESULT] = result;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_REQUEST_ID] = requestId;
     jsonArrayMsg->push_back(tmpJson);
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(DINPUT_SOURCE_MANAGER_START_DHID_MSG, jsonArrayMsg, 0);
     sourceManagerObj_->GetCallbackEventHandler()->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
 }
 
+void DInputSourceListener::OnResponsePrepareStartRemoteInput(const std::string deviceId, bool prepareResult,
+    bool startResult, const std::string &dhids, const std::string &object)
+{
+    OnResponsePrepareStartRemoteInputById(deviceId, prepareResult, startResult, dhids, object, INVALID_REQUEST_ID);
+}
+
+void DInputSourceListener::OnResponsePrepareStartRemoteInputById(const std::string deviceId, bool prepareResult,
+    bool startResult, const std::string &dhids, const std::string &object, uint64_t requestId)
+{
+    DHLOGI("OnResponsePrepareStartRemoteInput called, deviceId: %{public}s, prepare: %{public}s, start: %{public}s.",
+        GetAnonyString(deviceId).c_str(), prepareResult ? "success" : "failed", startResult ? "success" : "failed");
+
+    if (sourceManagerObj_ == nullptr) {
+        DHLOGE("OnResponsePrepareStartRemoteInput sourceManagerObj_ is null.");
+        return;
+    }
+    if (sourceManagerObj_->GetCallbackEventHandler() == nullptr) {
+        DHLOGE("OnResponsePrepareStartRemoteInput GetCallbackEventHandler is null.");
+        sourceManagerObj_->RunPrepareStartCallback(deviceId, dhids,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL, object, requestId);
+        return;
+    }
+    auto jsonArrayMsg = std::make_shared<nlohmann::json>();
+    nlohmann::json tmpJson;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_DEVID] = deviceId;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_DHID] = dhids;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_RESULT] = prepareResult;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_START_RESULT] = startResult;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_WHITELIST] = object;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_REQUEST_ID] = requestId;
+    jsonArrayMsg->push_back(tmpJson);
+    AppExecFwk::InnerEvent::Pointer msgEvent =
+        AppExecFwk::InnerEvent::Get(DINPUT_SOURCE_MANAGER_PREPARE_START_DHID_MSG, jsonArrayMsg, 0);
+    sourceManagerObj_->GetCallbackEventHandler()->SendEvent(msgEvent, 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
 void DInputSourceListener::OnResponseStopRemoteInputDhid(
     const std::string deviceId, const std::string &dhids, bool result)
+{
+    OnResponseStopRemoteInputDhidById(deviceId, dhids, result, INVALID_REQUEST_ID);
+}
+
+void DInputSourceListener::OnResponseStopRemoteInputDhidById(
+    const std::string deviceId, const std::string &dhids, bool result, uint64_t requestId)
 {
     DHLOGI("OnResponseStopRemoteInputDhid called, deviceId: %{public}s, result: %{public}s.",
         GetAnonyString(deviceId).c_str(), result ? "success" : "failed");
@@ -284,7 +341,7 @@ void DInputSourceListener::OnResponseStopRemoteInputDhid(
     if (sourceManagerObj_->GetCallbackEventHandler() == nullptr) {
         DHLOGE("OnResponseStopRemoteInputDhid GetCallbackEventHandler is null.");
         sourceManagerObj_->RunStopDhidCallback(deviceId, dhids,
-                                               ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL);
+                                               ERR_DH_INPUT_SERVER_SOURCE_MANAGERGET_CALLBACK_HANDLER_FAIL, requestId);
         return;
     }
 
@@ -293,6 +350,7 @@ void DInputSourceListener::OnResponseStopRemoteInputDhid(
     tmpJson[INPUT_SOURCEMANAGER_KEY_DEVID] = deviceId;
     tmpJson[INPUT_SOURCEMANAGER_KEY_DHID] = dhids;
     tmpJson[INPUT_SOURCEMANAGER_KEY_RESULT] = result;
+    tmpJson[INPUT_SOURCEMANAGER_KEY_REQUEST_ID] = requestId;
     jsonArrayMsg->push_back(tmpJson);
     AppExecFwk::InnerEvent::Pointer msgEvent =
         AppExecFwk::InnerEvent::Get(DINPUT_SOURCE_MANAGER_STOP_DHID_MSG, jsonArrayMsg, 0);
@@ -335,23 +393,47 @@ void DInputSourceListener::OnResponseKeyStateBatch(const std::string deviceId, c
 }
 
 void DInputSourceListener::OnReceivedEventRemoteInput(const std::string deviceId, const std::string &event)
+{
+    std::vector<RawEvent> mEventBuffer;
+    if (!ParseEventBatch(deviceId, event, mEventBuffer)) {
+        return;
+    }
+    DistributedInputInject::GetInstance().RegisterDistributedEvent(deviceId, mEventBuffer);
+}
+
+void DInputSourceListener::OnReceivedTracedEventRemoteInput(const std::string deviceId, const std::string &event,
+    const TraceStamps &stamps)
+{
+    std::vector<RawEvent> mEventBuffer;
+    if (!ParseEventBatch(deviceId, event, mEventBuffer)) {
+        return;
+    }
+    TraceStamps tracedStamps = stamps;
+    DInputLatencyTrace::Stamp(tracedStamps, TraceStage::EVENT_PARSED);
+    DistributedInputInject::GetInstance().RegisterDistributedEvent(deviceId, mEventBuffer, tracedStamps);
+}
+
+bool DInputSourceListener::ParseEventBatch(const std::string deviceId, const std::string &event,
+    std::vector<RawEvent> &eventBuffer)
 {
     nlohmann::json inputData = nlohmann::json::parse(event, nullptr, false);
     if (inputData.is_discarded()) {
         DHLOGE("inputData parse failed!");
-        return;
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::PARSE_FAILURES);
+        return false;
     }
 
     if (!inputData.is_array()) {
         DHLOGE("inputData not vector!");
-        return;
+        DInputMetrics::GetInstance().AddCounter(MetricCounter::PARSE_FAILURES);
+        return false;
     }
 
     size_t jsonSize = inputData.size();
     DHLOGD("OnReceivedEventRemoteInput called, deviceId: %{public}s, json size:%{public}zu.",
         GetAnonyString(deviceId).c_str(), jsonSize);
 
-    std::vector<RawEvent> mEventBuffer(jsonSize);
+    eventBuffer.resize(jsonSize);
     int idx = 0;
     for (auto it = inputData.begin(); it != inputData.end(); ++it) {
         nlohmann::json oneData = (*it);
@@ -359,20 +441,20 @@ void DInputSourceListener::OnReceivedEventRemoteInput(const std::string deviceId
             !IsUInt32(oneData, INPUT_KEY_CODE) || !IsInt32(oneData, INPUT_KEY_VALUE) ||
             !IsString(oneData, INPUT_KEY_DESCRIPTOR) || !IsString(oneData, INPUT_KEY_PATH)) {
             DHLOGE("The key is invaild.");
+            DInputMetrics::GetInstance().AddCounter(MetricCounter::PARSE_FAILURES);
             continue;
         }
-        mEventBuffer[idx].when = oneData[INPUT_KEY_WHEN];
-        mEventBuffer[idx].type = oneData[INPUT_KEY_TYPE];
-        mEventBuffer[idx].code = oneData[INPUT_KEY_CODE];
-        mEventBuffer[idx].value = oneData[INPUT_KEY_VALUE];
-        mEventBuffer[idx].descriptor = oneData[INPUT_KEY_DESCRIPTOR];
-        mEventBuffer[idx].path = oneData[INPUT_KEY_PATH];
+        eventBuffer[idx].when = oneData[INPUT_KEY_WHEN];
+        eventBuffer[idx].type = oneData[INPUT_KEY_TYPE];
+        eventBuffer[idx].code = oneData[INPUT_KEY_CODE];
+        eventBuffer[idx].value = oneData[INPUT_KEY_VALUE];
+        eventBuffer[idx].descriptor = oneData[INPUT_KEY_DESCRIPTOR];
+        eventBuffer[idx].path = oneData[INPUT_KEY_PATH];
         RecordEventLog(oneData[INPUT_KEY_WHEN], oneData[INPUT_KEY_TYPE], oneData[INPUT_KEY_CODE],
             oneData[INPUT_KEY_VALUE], oneData[INPUT_KEY_PATH]);
         ++idx;
     }
-
-    DistributedInputInject::GetInstance().RegisterDistributedEvent(deviceId, mEventBuffer);
+    return true;
 }
 
 void DInputSourceListener::OnReceiveRelayPrepareResult(int32_t status,
@@ -33,6 +33,14 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    // the sinks before the correlation id answer without it, the manager falls back to matching then.
+    uint64_t GetRequestId(const nlohmann::json &innerMsg)
+    {
+        return IsUInt64(innerMsg, INPUT_SOURCEMANAGER_KEY_REQUEST_ID) ?
+            innerMsg[INPUT_SOURCEMANAGER_KEY_REQUEST_ID].get<uint64_t>() : INVALID_REQUEST_ID;
+    }
+}
 DInputSourceManagerEventHandler::DInputSourceManagerEventHandler(
     const std::shared_ptr<AppExecFwk::EventRunner> &runner, DistributedInputSourceManager *manager)
     : AppExecFwk::EventHandler(runner)
@@ -192,14 +200,8 @@ void DInputSourceManagerEventHandler::NotifyStartCallback(const AppExecFwk::Inne
     bool result = innerMsg[INPUT_SOURCEMANAGER_KEY_RESULT];
     DHLOGI("Start DInput Recv Callback ret: %{public}s, devId: %{public}s, inputTypes: %{public}d",
         result ? "true" : "false", GetAnonyString(deviceId).c_str(), inputTypes);
-    if (result) {
-        sourceManagerObj_->SetInputTypesMap(
-            deviceId, sourceManagerObj_->GetInputTypesMap(deviceId) | inputTypes);
-    }
-    sourceManagerObj_->SetStartTransFlag((result && (sourceManagerObj_->GetInputTypesMap(deviceId) > 0)) ?
-        DInputServerType::SOURCE_SERVER_TYPE : DInputServerType::NULL_SERVER_TYPE);
     sourceManagerObj_->RunStartCallback(deviceId, inputTypes,
-        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_MSG_IS_BAD);
+        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_MSG_IS_BAD, GetRequestId(innerMsg));
 }
 
 void DInputSourceManagerEventHandler::NotifyStopCallback(const AppExecFwk::InnerEvent::Pointer &event)
@@ -244,7 +246,7 @@ void DInputSourceManagerEventHandler::NotifyStopCallback(const AppExecFwk::Inner
         sourceManagerObj_->SetStartTransFlag(DInputServerType::NULL_SERVER_TYPE);
     }
     sourceManagerObj_->RunStopCallback(deviceId, inputTypes,
-        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_MSG_IS_BAD);
+        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_MSG_IS_BAD, GetRequestId(innerMsg));
 }
 
 void DInputSourceManagerEventHandler::NotifyStartDhidCallback(const AppExecFwk::InnerEvent::Pointer &event)
@@ -271,7 +273,40 @@ void DInputSourceManagerEventHandler::NotifyStartDhidCallback(const AppExecFwk::
     bool result = innerMsg[INPUT_SOURCEMANAGER_KEY_RESULT];
 
     sourceManagerObj_->RunStartDhidCallback(deviceId, dhidStr,
-        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_MSG_IS_BAD);
+        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_MSG_IS_BAD, GetRequestId(innerMsg));
+}
+
+void DInputSourceManagerEventHandler::NotifyPrepareStartDhidCallback(const AppExecFwk::InnerEvent::Pointer &event)
+{
+    if (event == nullptr) {
+        DHLOGE("event is null.");
+        return;
+    }
+    std::shared_ptr<nlohmann::json> dataMsg = event->GetSharedObject<nlohmann::json>();
+    if (dataMsg == nullptr) {
+        DHLOGE("dataMsg is null.");
+        return;
+    }
+    auto it = dataMsg->begin();
+    nlohmann::json innerMsg = *it;
+    if (!IsString(innerMsg, INPUT_SOURCEMANAGER_KEY_DEVID) ||
+        !IsString(innerMsg, INPUT_SOURCEMANAGER_KEY_DHID) ||
+        !IsBoolean(innerMsg, INPUT_SOURCEMANAGER_KEY_RESULT) ||
+        !IsBoolean(innerMsg, INPUT_SOURCEMANAGER_KEY_START_RESULT) ||
+        !IsString(innerMsg, INPUT_SOURCEMANAGER_KEY_WHITELIST)) {
+        DHLOGE("The key is invaild.");
+        return ;
+    }
+    std::string deviceId = innerMsg[INPUT_SOURCEMANAGER_KEY_DEVID];
+    std::string dhidStr = innerMsg[INPUT_SOURCEMANAGER_KEY_DHID];
+    bool prepareResult = innerMsg[INPUT_SOURCEMANAGER_KEY_RESULT];
+    bool startResult = innerMsg[INPUT_SOURCEMANAGER_KEY_START_RESULT];
+    std::string object = innerMsg[INPUT_SOURCEMANAGER_KEY_WHITELIST];
+
+    sourceManagerObj_->RunPrepareStartCallback(deviceId, dhidStr,
+        prepareResult ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_MSG_IS_BAD,
+        startResult ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_MSG_IS_BAD, object,
+        GetRequestId(innerMsg));
 }
 
 void DInputSourceManagerEventHandler::NotifyStopDhidCallback(const AppExecFwk::InnerEvent::Pointer &event)
@@ -298,7 +333,7 @@ void DInputSourceManagerEventHandler::NotifyStopDhidCallback(const AppExecFwk::I
     bool result = innerMsg[INPUT_SOURCEMANAGER_KEY_RESULT];
 
     sourceManagerObj_->RunStopDhidCallback(deviceId, dhidStr,
-        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_MSG_IS_BAD);
+        result ? DH_SUCCESS : ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_MSG_IS_BAD, GetRequestId(innerMsg));
 }
 
 void DInputSourceManagerEventHandler::NotifyKeyStateCallback(const AppExecFwk::InnerEvent::Pointer &event)
@@ -618,6 +653,9 @@ void DInputSourceManagerEventHandler::ProcessEventInner(const AppExecFwk::InnerE
         case DINPUT_SOURCE_MANAGER_RELAY_STOPTYPE_RESULT_MMI:
             NotifyRelayStopTypeCallback(event);
             break;
+        case DINPUT_SOURCE_MANAGER_PREPARE_START_DHID_MSG:
+            NotifyPrepareStartDhidCallback(event);
+            break;
         default:
             DHLOGE("Event Id %{public}d is undefined.", event->GetInnerEventId());
     }
@@ -20,6 +20,8 @@
 #include "nlohmann/json.hpp"
 #include "system_ability_definition.h"
 #include "string_ex.h"
+#include <condition_variable>
+#include <set>
 #include <unistd.h>
 
 #include "distributed_hardware_fwk_kit.h"
@@ -49,6 +51,9 @@ namespace {
     constexpr int32_t RAND_NUM_MIN = 0;
     constexpr int32_t RAND_NUM_MAX = 20;
     constexpr int32_t US_PER_MS = 1000;
+    constexpr int64_t REQUEST_TIMEOUT_MS = 5000;
+    const std::string REQUEST_TIMEOUT_TASK_PREFIX = "dinput_request_timeout_";
+    const std::string PREPARE_TIMEOUT_TASK_PREFIX = "dinput_prepare_timeout_";
 }
 REGISTER_SYSTEM_ABILITY_BY_ID(DistributedInputSourceManager, DISTRIBUTED_HARDWARE_INPUT_SOURCE_SA_ID, true);
 
@@ -274,7 +279,8 @@ int32_t DistributedInputSourceManager::RegisterDistributedHardware(const std::st
     int32_t randNumber = GetRandomInt32(RAND_NUM_MIN, RAND_NUM_MAX);
     usleep(randNumber * US_PER_MS);
 
-    std::lock_guard<std::mutex> lock(regDisHardwareMutex_);
+    std::unique_lock<std::mutex> lock(regDisHardwareMutex_);
+    regDisHardwareCv_.wait(lock, [this, &devId, &dhId]() { return registeringDhIds_.count({devId, dhId}) == 0; });
     DInputClientRegistInfo info {devId, dhId, callback};
     regCallbacks_.push_back(info);
     InputDeviceId inputDeviceId {devId, dhId, GetNodeDesc(parameters)};
@@ -313,9 +319,190 @@ int32_t DistributedInputSourceManager::RegisterDistributedHardware(const std::st
 
     // 5. Notify node mgr to scan vir dev node info
     DistributedInputInject::GetInstance().NotifyNodeMgrScanVirNode(devId, dhId);
+
+    // 6. The sink came online, open the session ahead of its prepare if it was used recently
+    DistributedInputSourceTransport::GetInstance().PrewarmInputSoftbus(devId);
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputSourceManager::RegisterDistributedHardwareBatch(const std::vector<RegisterHardwareItem> &items,
+    sptr<IRegisterDInputCallback> callback, std::vector<int32_t> &results)
+{
+    DHLOGI("RegisterDistributedHardwareBatch called, item size: %{public}zu", items.size());
+    results.assign(items.size(), ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL);
+    if (callback == nullptr || items.empty() || items.size() > IPC_VECTOR_MAX_SIZE) {
+        DHLOGE("RegisterDistributedHardwareBatch param is invalid.");
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL;
+    }
+    // 1.check the items and find out the dh already exists or being created by another batch, the others need a node
+    std::vector<size_t> createIndexes;
+    std::vector<size_t> waitIndexes;
+    {
+        std::lock_guard<std::mutex> lock(regDisHardwareMutex_);
+        std::set<std::pair<std::string, std::string>> itemKeys;
+        for (size_t i = 0; i < items.size(); i++) {
+            const RegisterHardwareItem &item = items[i];
+            HisyseventUtil::GetInstance().SysEventWriteBehavior(DINPUT_REGISTER, item.devId, item.dhId,
+                "dinput register call.");
+            if (!itemKeys.insert({item.devId, item.dhId}).second) {
+                DHLOGE("Duplicate batch item, dhId: %{public}s", GetAnonyString(item.dhId).c_str());
+                HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_REGISTER_FAIL, item.devId, item.dhId,
+                    ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, "Dinputregister failed item is duplicate.");
+                continue;
+            }
+            if (!CheckRegisterParam(item.devId, item.dhId, item.parameters, callback)) {
+                HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_REGISTER_FAIL, item.devId, item.dhId,
+                    ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, "Dinputregister failed param is invalid.");
+                continue;
+            }
+            regCallbacks_.push_back(DInputClientRegistInfo {item.devId, item.dhId, callback});
+            InputDeviceId inputDeviceId {item.devId, item.dhId, GetNodeDesc(item.parameters)};
+            if (std::find(inputDevice_.begin(), inputDevice_.end(), inputDeviceId) != inputDevice_.end()) {
+                results[i] = DH_SUCCESS;
+                continue;
+            }
+            if (!registeringDhIds_.insert({item.devId, item.dhId}).second) {
+                waitIndexes.push_back(i);
+                continue;
+            }
+            createIndexes.push_back(i);
+        }
+    }
+
+    // 2.create the input nodes, the node manager runs them on its worker threads
+    CreateBatchNodes(items, createIndexes, results);
+
+    // 3.save the devices, drop the callbacks of the failed ones, then hand the pairs over to their waiters
+    {
+        std::unique_lock<std::mutex> lock(regDisHardwareMutex_);
+        for (size_t i : createIndexes) {
+            SaveBatchItemLocked(items[i], results[i]);
+            registeringDhIds_.erase({items[i].devId, items[i].dhId});
+        }
+        regDisHardwareCv_.notify_all();
+        // the items another batch was creating take its result.
+        for (size_t i : waitIndexes) {
+            const RegisterHardwareItem &item = items[i];
+            regDisHardwareCv_.wait(lock, [this, &item]() {
+                return registeringDhIds_.count({item.devId, item.dhId}) == 0;
+            });
+            InputDeviceId inputDeviceId {item.devId, item.dhId, GetNodeDesc(item.parameters)};
+            if (std::find(inputDevice_.begin(), inputDevice_.end(), inputDeviceId) != inputDevice_.end()) {
+                results[i] = DH_SUCCESS;
+            }
+            SaveBatchItemLocked(item, results[i]);
+        }
+    }
+
+    // 4.notify source distributedfwk the result of every item, and scan the new nodes
+    int32_t ret = DH_SUCCESS;
+    for (size_t i = 0; i < items.size(); i++) {
+        callback->OnResult(items[i].devId, items[i].dhId, results[i]);
+        if (results[i] != DH_SUCCESS) {
+            ret = ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL;
+        }
+    }
+    for (size_t i : createIndexes) {
+        if (results[i] == DH_SUCCESS) {
+            DistributedInputInject::GetInstance().NotifyNodeMgrScanVirNode(items[i].devId, items[i].dhId);
+            DistributedInputSourceTransport::GetInstance().PrewarmInputSoftbus(items[i].devId);
+        }
+    }
+    DHLOGI("RegisterDistributedHardwareBatch end, created node size: %{public}zu", createIndexes.size());
+    return ret;
+}
+
+void DistributedInputSourceManager::SaveBatchItemLocked(const RegisterHardwareItem &item, int32_t result)
+{
+    if (result == DH_SUCCESS) {
+        InputDeviceId inputDeviceId {item.devId, item.dhId, GetNodeDesc(item.parameters)};
+        if (std::find(inputDevice_.begin(), inputDevice_.end(), inputDeviceId) == inputDevice_.end()) {
+            inputDevice_.push_back(inputDeviceId);
+        }
+        return;
+    }
+    HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_REGISTER_FAIL, item.devId, item.dhId,
+        ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, "Dinputregister failed in create input node.");
+    for (auto iter = regCallbacks_.begin(); iter != regCallbacks_.end(); ++iter) {
+        if (iter->devId == item.devId && iter->dhId == item.dhId) {
+            regCallbacks_.erase(iter);
+            break;
+        }
+    }
+}
+
+void DistributedInputSourceManager::CreateBatchNodes(const std::vector<RegisterHardwareItem> &items,
+    const std::vector<size_t> &indexes, std::vector<int32_t> &results)
+{
+    struct BatchState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t pending = 0;
+        // set once the wait timed out, the nodes created after are closed again.
+        bool isExpired = false;
+        std::vector<int32_t> results;
+    };
+    auto state = std::make_shared<BatchState>();
+    state->results.assign(items.size(), ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL);
+    for (size_t i : indexes) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending++;
+        }
+        int32_t ret = DistributedInputInject::GetInstance().RegisterDistributedHardwareAsync(items[i].devId,
+            items[i].dhId, items[i].parameters, [this, state, i](const std::string &devId, const std::string &dhId,
+                int32_t result) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->isExpired) {
+                    if (result == DH_SUCCESS) {
+                        CloseLateBatchNode(devId, dhId);
+                    }
+                    return;
+                }
+                state->results[i] = (result == DH_SUCCESS) ? DH_SUCCESS :
+                    ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL;
+                state->pending--;
+                state->cv.notify_all();
+            });
+        if (ret != DH_SUCCESS) {
+            DHLOGE("Create node of dhId: %{public}s fail, ret: %{public}d", GetAnonyString(items[i].dhId).c_str(),
+                ret);
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending--;
+        }
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->cv.wait_for(lock, std::chrono::milliseconds(REQUEST_TIMEOUT_MS),
+        [state]() { return state->pending == 0; })) {
+        DHLOGE("Create batch nodes timeout, pending size: %{public}zu", state->pending);
+        state->isExpired = true;
+    }
+    for (size_t i : indexes) {
+        results[i] = state->results[i];
+    }
+}
+
+void DistributedInputSourceManager::CloseLateBatchNode(const std::string &devId, const std::string &dhId)
+{
+    if (callBackHandler_ == nullptr) {
+        DHLOGE("callBackHandler_ is null, the late node of dhId: %{public}s is kept.", GetAnonyString(dhId).c_str());
+        return;
+    }
+    // the create-node worker must not take the inject lock, close it on the handler.
+    callBackHandler_->PostTask([this, devId, dhId]() {
+        {
+            std::lock_guard<std::mutex> lock(regDisHardwareMutex_);
+            for (const auto &inputDevice : inputDevice_) {
+                if (inputDevice.devId == devId && inputDevice.dhId == dhId) {
+                    return;
+                }
+            }
+        }
+        DHLOGI("Close the late batch node, dhId: %{public}s", GetAnonyString(dhId).c_str());
+        DistributedInputInject::GetInstance().UnregisterDistributedHardware(devId, dhId);
+    });
+}
+
 void DistributedInputSourceManager::handleStartServerCallback(const std::string &devId)
 {
     bool isFindDevice = false;
@@ -551,31 +738,29 @@ int32_t DistributedInputSourceManager::StartRemoteInput(
 
     DHLOGI("Start called, deviceId: %{public}s, inputTypes: %{public}d", GetAnonyString(deviceId).c_str(), inputTypes);
     std::lock_guard<std::mutex> startlock(startMutex_);
-    for (auto iter : staCallbacks_) {
-        if (iter.devId == deviceId && iter.inputTypes == inputTypes) {
-            callback->OnResult(deviceId, inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL);
-            HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
-                ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "Dinput start use failed in already started.");
-            FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
-            return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
-        }
+    if (staCallbacks_.HasMatch([&deviceId, inputTypes](const DInputClientStartInfo &info) {
+        return info.devId == deviceId && info.inputTypes == inputTypes;
+    })) {
+        callback->OnResult(deviceId, inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL);
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "Dinput start use failed in already started.");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
     }
 
-    DInputClientStartInfo info {deviceId, inputTypes, callback};
-    staCallbacks_.push_back(info);
+    uint64_t requestId = staCallbacks_.Add(DInputClientStartInfo {deviceId, inputTypes, callback});
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartRequestTimeout(requestId); });
     DeviceMap_[deviceId] = DINPUT_SOURCE_SWITCH_OFF;
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(deviceId, inputTypes);
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(deviceId, inputTypes, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "Dinput start use failed in transport start");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
         DHLOGE("Start fail.");
-        for (auto iter = staCallbacks_.begin(); iter != staCallbacks_.end(); ++iter) {
-            if (iter->devId == deviceId && iter->inputTypes == inputTypes) {
-                iter->callback->OnResult(iter->devId, iter->inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL);
-                staCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
-            }
+        CancelRequestTimeout(requestId);
+        DInputClientStartInfo info;
+        if (staCallbacks_.Take(requestId, info)) {
+            info.callback->OnResult(info.devId, info.inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL);
         }
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
     }
@@ -596,30 +781,28 @@ int32_t DistributedInputSourceManager::StopRemoteInput(
 
     DHLOGI("Stop called, deviceId: %{public}s, inputTypes: %{public}d", GetAnonyString(deviceId).c_str(), inputTypes);
     std::lock_guard<std::mutex> stoplock(stopMutex_);
-    for (auto iter : stpCallbacks_) {
-        if (iter.devId == deviceId && iter.inputTypes == inputTypes) {
-            callback->OnResult(deviceId, inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL);
-            HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
-                ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "Dinput stop use failed in already stoped.");
-            FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
-            return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
-        }
+    if (stpCallbacks_.HasMatch([&deviceId, inputTypes](const DInputClientStopInfo &info) {
+        return info.devId == deviceId && info.inputTypes == inputTypes;
+    })) {
+        callback->OnResult(deviceId, inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL);
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "Dinput stop use failed in already stoped.");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
     }
 
-    DInputClientStopInfo info {deviceId, inputTypes, callback};
-    stpCallbacks_.push_back(info);
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(deviceId, inputTypes);
+    uint64_t requestId = stpCallbacks_.Add(DInputClientStopInfo {deviceId, inputTypes, callback});
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStopRequestTimeout(requestId); });
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(deviceId, inputTypes, requestId);
     if (ret != DH_SUCCESS) {
         DHLOGE("Stop fail.");
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, deviceId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "Dinput stop use failed in transport stop.");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
-        for (auto iter = stpCallbacks_.begin(); iter != stpCallbacks_.end(); ++iter) {
-            if (iter->devId == deviceId && iter->inputTypes == inputTypes) {
-                iter->callback->OnResult(iter->devId, iter->inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL);
-                stpCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
-            }
+        CancelRequestTimeout(requestId);
+        DInputClientStopInfo info;
+        if (stpCallbacks_.Take(requestId, info)) {
+            info.callback->OnResult(info.devId, info.inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL);
         }
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
     }
@@ -651,21 +834,18 @@ int32_t DistributedInputSourceManager::StartRemoteInput(const std::string &srcId
         return RelayStartRemoteInputByType(srcId, sinkId, inputTypes, callback);
     }
     std::lock_guard<std::mutex> startlock(startMutex_);
-    DInputClientStartInfo info {sinkId, inputTypes, callback};
-    staCallbacks_.push_back(info);
+    uint64_t requestId = staCallbacks_.Add(DInputClientStartInfo {sinkId, inputTypes, callback});
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartRequestTimeout(requestId); });
     DeviceMap_[sinkId] = DINPUT_SOURCE_SWITCH_OFF; // when sink device start success,set DINPUT_SOURCE_SWITCH_ON
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, inputTypes);
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, inputTypes, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "Dinput start use failed in transport start.");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
         DHLOGE("StartRemoteInput called, start fail.");
-        for (auto it = staCallbacks_.begin(); it != staCallbacks_.end(); ++it) {
-            if (it->devId == sinkId && it->inputTypes == inputTypes) {
-                staCallbacks_.erase(it);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        DInputClientStartInfo info;
+        staCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
     }
     return DH_SUCCESS;
@@ -695,20 +875,17 @@ int32_t DistributedInputSourceManager::StopRemoteInput(const std::string &srcId,
         return RelayStopRemoteInputByType(srcId, sinkId, inputTypes, callback);
     }
     std::lock_guard<std::mutex> stoplock(stopMutex_);
-    DInputClientStopInfo info {sinkId, inputTypes, callback};
-    stpCallbacks_.push_back(info);
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, inputTypes);
+    uint64_t requestId = stpCallbacks_.Add(DInputClientStopInfo {sinkId, inputTypes, callback});
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStopRequestTimeout(requestId); });
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, inputTypes, requestId);
     if (ret != DH_SUCCESS) {
         DHLOGE("StopRemoteInput called, stop fail.");
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "Dinput stop use failed in transport stop.");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
-        for (auto it = stpCallbacks_.begin(); it != stpCallbacks_.end(); ++it) {
-            if (it->devId == sinkId && it->inputTypes == inputTypes) {
-                stpCallbacks_.erase(it);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        DInputClientStopInfo info;
+        stpCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
     }
     return DH_SUCCESS;
@@ -867,25 +1044,93 @@ int32_t DistributedInputSourceManager::StartRemoteInput(const std::string &sinkI
 
     // current device is source device
     DInputClientStartDhidInfo info {localNetworkId, sinkId, dhIds, callback};
-    staStringCallbacks_.push_back(info);
+    uint64_t requestId = staStringCallbacks_.Add(info);
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartDhidRequestTimeout(requestId); });
     DeviceMap_[sinkId] = DINPUT_SOURCE_SWITCH_OFF; // when sink device start success,set DINPUT_SOURCE_SWITCH_ON
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, dhIds);
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, dhIds, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "dinput start use failed in transport start");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
         DHLOGE("StartRemoteInput start fail.");
-        for (auto iter = staStringCallbacks_.begin(); iter != staStringCallbacks_.end(); ++iter) {
-            if (iter->sinkId == sinkId && IsStringDataSame(iter->dhIds, dhIds)) {
-                staStringCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        staStringCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
     }
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputSourceManager::PrepareAndStartRemoteInput(const std::string &sinkId,
+    const std::vector<std::string> &dhIds, sptr<IPrepareDInputCallback> prepareCallback,
+    sptr<IStartStopDInputsCallback> startCallback)
+{
+    StartAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+    HisyseventUtil::GetInstance().SysEventWriteBehavior(DINPUT_PREPARE, sinkId, "Dinput prepare and start call.");
+    if (!DInputCheckParam::GetInstance().CheckParam(sinkId, prepareCallback) ||
+        !DInputCheckParam::GetInstance().CheckParam(sinkId, dhIds, startCallback)) {
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL, "Dinput prepare and start param is failed.");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL;
+    }
+    DHLOGI("Dinput prepare and start, sinkId: %{public}s, vector.string.size: %{public}zu",
+        GetAnonyString(sinkId).c_str(), dhIds.size());
+    std::string localNetworkId = GetLocalNetworkId();
+    if (localNetworkId.empty()) {
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL, "Dinput prepare and start failed in get networkId");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL;
+    }
+    int32_t ret = DistributedInputSourceTransport::GetInstance().OpenInputSoftbus(sinkId, false);
+    if (ret != DH_SUCCESS) {
+        DHLOGE("Open softbus session fail, ret: %{public}d", ret);
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL, "Dinput prepare and start failed in open softbus");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL;
+    }
+
+    DInputClientPrepareInfo prepareInfo {sinkId, prepareCallback};
+    AddPrepareCallbacks(prepareInfo);
+    SchedulePrepareTimeout(sinkId);
+    DInputClientStartDhidInfo startInfo {localNetworkId, sinkId, dhIds, startCallback};
+    DeviceMap_[sinkId] = DINPUT_SOURCE_SWITCH_OFF; // when sink device start success,set DINPUT_SOURCE_SWITCH_ON
+
+    if (!DistributedInputSourceTransport::GetInstance().IsPrepareStartSupported(sinkId)) {
+        // an older sink drops the fused message, prepare it and start once the prepare succeeds.
+        DHLOGI("Sink has not announced prepare and start, send them separately.");
+        {
+            std::lock_guard<std::mutex> lock(prepareMutex_);
+            pendingPrepareStarts_[sinkId] = startInfo;
+        }
+        ret = DistributedInputSourceTransport::GetInstance().PrepareRemoteInput(sinkId);
+    } else {
+        uint64_t requestId = staStringCallbacks_.Add(startInfo);
+        ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartDhidRequestTimeout(requestId); });
+        ret = DistributedInputSourceTransport::GetInstance().PrepareAndStartRemoteInput(sinkId, dhIds, requestId);
+        if (ret != DH_SUCCESS) {
+            CancelRequestTimeout(requestId);
+            staStringCallbacks_.Take(requestId, startInfo);
+        }
+    }
+    if (ret != DH_SUCCESS) {
+        HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
+            ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL, "Dinput prepare and start failed in transport");
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+        DHLOGE("Can not send message by softbus, prepare and start fail, ret: %{public}d", ret);
+        CancelPrepareTimeout(sinkId);
+        {
+            std::lock_guard<std::mutex> lock(prepareMutex_);
+            pendingPrepareStarts_.erase(sinkId);
+        }
+        prepareInfo.preCallback->OnResult(sinkId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL);
+        RemovePrepareCallbacks(prepareInfo);
+        return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_FAIL;
+    }
+    return DH_SUCCESS;
+}
+
 int32_t DistributedInputSourceManager::StopRemoteInput(const std::string &sinkId, const std::vector<std::string> &dhIds,
     sptr<IStartStopDInputsCallback> callback)
 {
@@ -908,19 +1153,16 @@ int32_t DistributedInputSourceManager::StopRemoteInput(const std::string &sinkId
     }
 
     DInputClientStopDhidInfo info {localNetworkId, sinkId, dhIds, callback};
-    stpStringCallbacks_.push_back(info);
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, dhIds);
+    uint64_t requestId = stpStringCallbacks_.Add(info);
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStopDhidRequestTimeout(requestId); });
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, dhIds, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "dinput stop use failed in transport stop");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
         DHLOGE("StopRemoteInput stop fail.");
-        for (auto iter = stpStringCallbacks_.begin(); iter != stpStringCallbacks_.end(); ++iter) {
-            if (iter->sinkId == sinkId && IsStringDataSame(iter->dhIds, dhIds)) {
-                stpStringCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        stpStringCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
     }
     return DH_SUCCESS;
@@ -951,20 +1193,17 @@ int32_t DistributedInputSourceManager::StartRemoteInput(const std::string &srcId
     }
 
     DInputClientStartDhidInfo info {srcId, sinkId, dhIds, callback};
-    staStringCallbacks_.push_back(info);
+    uint64_t requestId = staStringCallbacks_.Add(info);
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartDhidRequestTimeout(requestId); });
     DeviceMap_[sinkId] = DINPUT_SOURCE_SWITCH_OFF;
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, dhIds);
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(sinkId, dhIds, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, "Dinput start use failed in transport start.");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
         DHLOGE("StartRemoteInput start fail.");
-        for (auto iter = staStringCallbacks_.begin(); iter != staStringCallbacks_.end(); ++iter) {
-            if (iter->srcId == srcId && iter->sinkId == sinkId && IsStringDataSame(iter->dhIds, dhIds)) {
-                staStringCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        staStringCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL;
     }
     return DH_SUCCESS;
@@ -995,19 +1234,16 @@ int32_t DistributedInputSourceManager::StopRemoteInput(const std::string &srcId,
     }
 
     DInputClientStopDhidInfo info {srcId, sinkId, dhIds, callback};
-    stpStringCallbacks_.push_back(info);
-    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, dhIds);
+    uint64_t requestId = stpStringCallbacks_.Add(info);
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStopDhidRequestTimeout(requestId); });
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, dhIds, requestId);
     if (ret != DH_SUCCESS) {
         HisyseventUtil::GetInstance().SysEventWriteFault(DINPUT_OPT_FAIL, sinkId,
             ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, "Dinput stop use failed in transport stop.");
         FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
         DHLOGE("StopRemoteInput stop fail.");
-        for (auto iter = stpStringCallbacks_.begin(); iter != stpStringCallbacks_.end(); ++iter) {
-            if (iter->srcId == srcId && iter->sinkId == sinkId && IsStringDataSame(iter->dhIds, dhIds)) {
-                stpStringCallbacks_.erase(iter);
-                return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
-            }
-        }
+        CancelRequestTimeout(requestId);
+        stpStringCallbacks_.Take(requestId, info);
         return ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL;
     }
     return DH_SUCCESS;
@@ -1189,17 +1425,25 @@ void DistributedInputSourceManager::RunPrepareCallback(
     const std::string &devId, const int32_t &status, const std::string &object)
 {
     FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
-    std::lock_guard<std::mutex> lock(prepareMutex_);
-    for (auto iter = preCallbacks_.begin(); iter != preCallbacks_.end(); ++iter) {
-        if (iter->devId == devId) {
-            DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_PREPARE_MSG");
-            iter->preCallback->OnResult(devId, status);
-            preCallbacks_.erase(iter);
-            RunWhiteListCallback(devId, object);
-            return;
+    CancelPrepareTimeout(devId);
+    bool isFound = false;
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex_);
+        for (auto iter = preCallbacks_.begin(); iter != preCallbacks_.end(); ++iter) {
+            if (iter->devId == devId) {
+                DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_PREPARE_MSG");
+                iter->preCallback->OnResult(devId, status);
+                preCallbacks_.erase(iter);
+                RunWhiteListCallback(devId, object);
+                isFound = true;
+                break;
+            }
         }
     }
-    DHLOGE("ProcessEvent parepareCallback is null.");
+    if (!isFound) {
+        DHLOGE("ProcessEvent parepareCallback is null.");
+    }
+    StartPreparedRemoteInput(devId, status);
 }
 
 void DistributedInputSourceManager::RunWhiteListCallback(const std::string &devId, const std::string &object)
@@ -1284,37 +1528,57 @@ void DistributedInputSourceManager::RunUnprepareCallback(const std::string &devI
 }
 
 void DistributedInputSourceManager::RunStartCallback(
-    const std::string &devId, const uint32_t &inputTypes, const int32_t &status)
+    const std::string &devId, const uint32_t &inputTypes, const int32_t &status, uint64_t requestId)
 {
     FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
     std::lock_guard<std::mutex> startlock(startMutex_);
-    for (auto iter = staCallbacks_.begin(); iter != staCallbacks_.end(); ++iter) {
-        if (iter->devId == devId && iter->inputTypes == inputTypes) {
-            DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_START_MSG");
-            iter->callback->OnResult(devId, inputTypes, status);
-            staCallbacks_.erase(iter);
-            break;
+    DInputClientStartInfo info;
+    bool isFound = (requestId != INVALID_REQUEST_ID) ? staCallbacks_.Take(requestId, info) :
+        staCallbacks_.TakeMatch([&devId, inputTypes](const DInputClientStartInfo &item) {
+            return item.devId == devId && item.inputTypes == inputTypes;
+        }, info, requestId);
+    if (!isFound) {
+        DHLOGE("No start request waits for the response, requestId: %{public}" PRIu64 "", requestId);
+        // a retry of the same types is answered after this response and keeps them.
+        if (status == DH_SUCCESS && !staCallbacks_.HasMatch([&devId, inputTypes](const DInputClientStartInfo &item) {
+            return item.devId == devId && (item.inputTypes & inputTypes) != 0;
+        })) {
+            SendCompensatingStop(devId, inputTypes);
         }
+        return;
+    }
+    CancelRequestTimeout(requestId);
+    if (status == DH_SUCCESS) {
+        SetDeviceMapValue(devId, DINPUT_SOURCE_SWITCH_ON);
+        SetInputTypesMap(devId, GetInputTypesMap(devId) | inputTypes);
     }
+    SetStartTransFlag((status == DH_SUCCESS && GetInputTypesMap(devId) > 0) ?
+        DInputServerType::SOURCE_SERVER_TYPE : DInputServerType::NULL_SERVER_TYPE);
+    DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_START_MSG");
+    info.callback->OnResult(devId, inputTypes, status);
 }
 
 void DistributedInputSourceManager::RunStopCallback(
-    const std::string &devId, const uint32_t &inputTypes, const int32_t &status)
+    const std::string &devId, const uint32_t &inputTypes, const int32_t &status, uint64_t requestId)
 {
     FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
     std::lock_guard<std::mutex> stoplock(stopMutex_);
-    for (auto iter = stpCallbacks_.begin(); iter != stpCallbacks_.end(); ++iter) {
-        if (iter->devId == devId && iter->inputTypes == inputTypes) {
-            DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_STOP_MSG");
-            iter->callback->OnResult(devId, inputTypes, status);
-            stpCallbacks_.erase(iter);
-            break;
-        }
+    DInputClientStopInfo info;
+    bool isFound = (requestId != INVALID_REQUEST_ID) ? stpCallbacks_.Take(requestId, info) :
+        stpCallbacks_.TakeMatch([&devId, inputTypes](const DInputClientStopInfo &item) {
+            return item.devId == devId && item.inputTypes == inputTypes;
+        }, info, requestId);
+    if (!isFound) {
+        DHLOGE("No stop request waits for the response, requestId: %{public}" PRIu64 "", requestId);
+        return;
     }
+    CancelRequestTimeout(requestId);
+    DHLOGI("ProcessEvent DINPUT_SOURCE_MANAGER_STOP_MSG");
+    info.callback->OnResult(devId, inputTypes, status);
 }
 
 void DistributedInputSourceManager::RunStartDhidCallback(const std::string &sinkId, const std::string &dhIds,
-    const int32_t &status)
+    const int32_t &status, uint64_t requestId)
 {
     std::vector<std::string> dhidsVec;
     SplitStringToVector(dhIds, INPUT_STRING_SPLIT_POINT, dhidsVec);
@@ -1325,18 +1589,37 @@ void DistributedInputSourceManager::RunStartDhidCallback(const std::string &sink
         return;
     }
 
-    for (auto iter = staStringCallbacks_.begin(); iter != staStringCallbacks_.end(); ++iter) {
-        if (iter->sinkId != sinkId || !IsStringDataSame(iter->dhIds, dhidsVec)) {
-            continue;
+    DInputClientStartDhidInfo info;
+    bool isFound = (requestId != INVALID_REQUEST_ID) ? staStringCallbacks_.Take(requestId, info) :
+        staStringCallbacks_.TakeMatch([this, &sinkId, &dhidsVec](const DInputClientStartDhidInfo &item) {
+            return item.sinkId == sinkId && IsStringDataSame(item.dhIds, dhidsVec);
+        }, info, requestId);
+    if (!isFound) {
+        DHLOGE("No start dhid request waits for the response, requestId: %{public}" PRIu64 "", requestId);
+        if (status == DH_SUCCESS && !staStringCallbacks_.HasMatch(
+            [this, &sinkId, &dhidsVec](const DInputClientStartDhidInfo &item) {
+                return item.sinkId == sinkId && IsStringDataSame(item.dhIds, dhidsVec);
+            })) {
+            SendCompensatingStop(sinkId, dhidsVec);
         }
-        iter->callback->OnResultDhids(sinkId, status);
-        staStringCallbacks_.erase(iter);
-        break;
+        return;
     }
+    CancelRequestTimeout(requestId);
+    if (status == DH_SUCCESS) {
+        SetDeviceMapValue(sinkId, DINPUT_SOURCE_SWITCH_ON);
+    }
+    info.callback->OnResultDhids(sinkId, status);
+}
+
+void DistributedInputSourceManager::RunPrepareStartCallback(const std::string &sinkId, const std::string &dhIds,
+    const int32_t &prepareStatus, const int32_t &startStatus, const std::string &object, uint64_t requestId)
+{
+    RunPrepareCallback(sinkId, prepareStatus, object);
+    RunStartDhidCallback(sinkId, dhIds, startStatus, requestId);
 }
 
 void DistributedInputSourceManager::RunStopDhidCallback(const std::string &sinkId, const std::string &dhIds,
-    const int32_t &status)
+    const int32_t &status, uint64_t requestId)
 {
     std::vector<std::string> dhidsVec;
     SplitStringToVector(dhIds, INPUT_STRING_SPLIT_POINT, dhidsVec);
@@ -1345,14 +1628,168 @@ void DistributedInputSourceManager::RunStopDhidCallback(const std::string &sinkI
         return;
     }
 
-    for (auto iter = stpStringCallbacks_.begin();
-        iter != stpStringCallbacks_.end(); ++iter) {
-        if (iter->sinkId != sinkId || !IsStringDataSame(iter->dhIds, dhidsVec)) {
-            continue;
+    DInputClientStopDhidInfo info;
+    bool isFound = (requestId != INVALID_REQUEST_ID) ? stpStringCallbacks_.Take(requestId, info) :
+        stpStringCallbacks_.TakeMatch([this, &sinkId, &dhidsVec](const DInputClientStopDhidInfo &item) {
+            return item.sinkId == sinkId && IsStringDataSame(item.dhIds, dhidsVec);
+        }, info, requestId);
+    if (!isFound) {
+        DHLOGE("No stop dhid request waits for the response, requestId: %{public}" PRIu64 "", requestId);
+        return;
+    }
+    CancelRequestTimeout(requestId);
+    info.callback->OnResultDhids(sinkId, status);
+}
+
+void DistributedInputSourceManager::ScheduleRequestTimeout(uint64_t requestId, const std::function<void()> &onTimeout)
+{
+    if (callBackHandler_ == nullptr) {
+        DHLOGE("callBackHandler_ is null, requestId: %{public}" PRIu64 " has no timeout.", requestId);
+        return;
+    }
+    callBackHandler_->PostTask(onTimeout, REQUEST_TIMEOUT_TASK_PREFIX + std::to_string(requestId),
+        REQUEST_TIMEOUT_MS);
+}
+
+void DistributedInputSourceManager::CancelRequestTimeout(uint64_t requestId)
+{
+    if (callBackHandler_ == nullptr) {
+        return;
+    }
+    callBackHandler_->RemoveTask(REQUEST_TIMEOUT_TASK_PREFIX + std::to_string(requestId));
+}
+
+void DistributedInputSourceManager::OnStartRequestTimeout(uint64_t requestId)
+{
+    std::lock_guard<std::mutex> startlock(startMutex_);
+    DInputClientStartInfo info;
+    if (!staCallbacks_.Take(requestId, info)) {
+        return;
+    }
+    DHLOGE("Start request timeout, devId: %{public}s, requestId: %{public}" PRIu64 "",
+        GetAnonyString(info.devId).c_str(), requestId);
+    FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_START_START, DINPUT_START_TASK);
+    info.callback->OnResult(info.devId, info.inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+    SendCompensatingStop(info.devId, info.inputTypes);
+}
+
+void DistributedInputSourceManager::OnStopRequestTimeout(uint64_t requestId)
+{
+    std::lock_guard<std::mutex> stoplock(stopMutex_);
+    DInputClientStopInfo info;
+    if (!stpCallbacks_.Take(requestId, info)) {
+        return;
+    }
+    DHLOGE("Stop request timeout, devId: %{public}s, requestId: %{public}" PRIu64 "",
+        GetAnonyString(info.devId).c_str(), requestId);
+    FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_STOP_START, DINPUT_STOP_TASK);
+    info.callback->OnResult(info.devId, info.inputTypes, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+}
+
+void DistributedInputSourceManager::OnStartDhidRequestTimeout(uint64_t requestId)
+{
+    DInputClientStartDhidInfo info;
+    if (!staStringCallbacks_.Take(requestId, info)) {
+        return;
+    }
+    DHLOGE("Start dhid request timeout, sinkId: %{public}s, requestId: %{public}" PRIu64 "",
+        GetAnonyString(info.sinkId).c_str(), requestId);
+    info.callback->OnResultDhids(info.sinkId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+    SendCompensatingStop(info.sinkId, info.dhIds);
+}
+
+void DistributedInputSourceManager::OnStopDhidRequestTimeout(uint64_t requestId)
+{
+    DInputClientStopDhidInfo info;
+    if (!stpStringCallbacks_.Take(requestId, info)) {
+        return;
+    }
+    DHLOGE("Stop dhid request timeout, sinkId: %{public}s, requestId: %{public}" PRIu64 "",
+        GetAnonyString(info.sinkId).c_str(), requestId);
+    info.callback->OnResultDhids(info.sinkId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+}
+
+void DistributedInputSourceManager::SendCompensatingStop(const std::string &devId, uint32_t inputTypes)
+{
+    // a fresh id, so the answer of the sink matches no stop request of the client.
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(devId, inputTypes, NextRequestId());
+    DHLOGI("Stop the unanswered start, devId: %{public}s, inputTypes: %{public}u, ret: %{public}d",
+        GetAnonyString(devId).c_str(), inputTypes, ret);
+}
+
+void DistributedInputSourceManager::SendCompensatingStop(const std::string &sinkId,
+    const std::vector<std::string> &dhIds)
+{
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StopRemoteInput(sinkId, dhIds, NextRequestId());
+    DHLOGI("Stop the unanswered start, sinkId: %{public}s, dhIds size: %{public}zu, ret: %{public}d",
+        GetAnonyString(sinkId).c_str(), dhIds.size(), ret);
+}
+
+void DistributedInputSourceManager::SchedulePrepareTimeout(const std::string &devId)
+{
+    if (callBackHandler_ == nullptr) {
+        DHLOGE("callBackHandler_ is null, prepare of %{public}s has no timeout.", GetAnonyString(devId).c_str());
+        return;
+    }
+    callBackHandler_->PostTask([this, devId]() { OnPrepareRequestTimeout(devId); },
+        PREPARE_TIMEOUT_TASK_PREFIX + devId, REQUEST_TIMEOUT_MS);
+}
+
+void DistributedInputSourceManager::CancelPrepareTimeout(const std::string &devId)
+{
+    if (callBackHandler_ == nullptr) {
+        return;
+    }
+    callBackHandler_->RemoveTask(PREPARE_TIMEOUT_TASK_PREFIX + devId);
+}
+
+void DistributedInputSourceManager::OnPrepareRequestTimeout(const std::string &devId)
+{
+    sptr<IPrepareDInputCallback> callback = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex_);
+        for (auto iter = preCallbacks_.begin(); iter != preCallbacks_.end(); ++iter) {
+            if (iter->devId == devId) {
+                callback = iter->preCallback;
+                preCallbacks_.erase(iter);
+                break;
+            }
+        }
+    }
+    if (callback != nullptr) {
+        DHLOGE("Prepare request timeout, devId: %{public}s", GetAnonyString(devId).c_str());
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_PREPARE_START, DINPUT_PREPARE_TASK);
+        callback->OnResult(devId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+    }
+    StartPreparedRemoteInput(devId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REQUEST_TIMEOUT);
+}
+
+void DistributedInputSourceManager::StartPreparedRemoteInput(const std::string &devId, int32_t prepareStatus)
+{
+    DInputClientStartDhidInfo info;
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex_);
+        auto iter = pendingPrepareStarts_.find(devId);
+        if (iter == pendingPrepareStarts_.end()) {
+            return;
+        }
+        info = iter->second;
+        pendingPrepareStarts_.erase(iter);
+    }
+    if (prepareStatus != DH_SUCCESS) {
+        DHLOGE("Prepare failed, the start is not sent, status: %{public}d", prepareStatus);
+        info.callback->OnResultDhids(devId, prepareStatus);
+        return;
+    }
+    uint64_t requestId = staStringCallbacks_.Add(info);
+    ScheduleRequestTimeout(requestId, [this, requestId]() { OnStartDhidRequestTimeout(requestId); });
+    int32_t ret = DistributedInputSourceTransport::GetInstance().StartRemoteInput(devId, info.dhIds, requestId);
+    if (ret != DH_SUCCESS) {
+        DHLOGE("Start after prepare fail, ret: %{public}d", ret);
+        CancelRequestTimeout(requestId);
+        if (staStringCallbacks_.Take(requestId, info)) {
+            info.callback->OnResultDhids(devId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL);
         }
-        iter->callback->OnResultDhids(sinkId, status);
-        stpStringCallbacks_.erase(iter);
-        break;
     }
 }
 
@@ -15,6 +15,7 @@
 
 #include "distributed_input_sourcemanager_test.h"
 
+#include <chrono>
 #include <cstdlib>
 #include <fcntl.h>
 #include <iostream>
@@ -72,6 +73,20 @@ bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
     return true;
 }
 
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    return true;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    (void)networkId;
+}
+
 void DistributedInputSourceManagerTest::SetUp()
 {
     sourceManager_ = new DistributedInputSourceManager(DISTRIBUTED_HARDWARE_INPUT_SOURCE_SA_ID, true);
@@ -342,6 +357,92 @@ HWTEST_F(DistributedInputSourceManagerTest, RegisterDistributedHardware_02, test
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
+HWTEST_F(DistributedInputSourceManagerTest, RegisterDistributedHardwareBatch_01, testing::ext::TestSize.Level1)
+{
+    std::vector<RegisterHardwareItem> items;
+    std::vector<int32_t> results;
+    sptr<TestRegisterDInputCb> callback(new TestRegisterDInputCb());
+    int32_t ret = sourceManager_->RegisterDistributedHardwareBatch(items, callback, results);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, ret);
+
+    items.push_back({"umkyu1b165e1be98151891erbe8r91ev", "1ds56v18e1v21v8v1erv15r1v8r1j1ty8", "parameters"});
+    ret = sourceManager_->RegisterDistributedHardwareBatch(items, nullptr, results);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, ret);
+    ASSERT_EQ(items.size(), results.size());
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, results[0]);
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, RegisterDistributedHardwareBatch_02, testing::ext::TestSize.Level1)
+{
+    InputDevice pBuffer;
+    pBuffer.name = "uinput_name_touch";
+    pBuffer.bus = 0x03;
+    pBuffer.vendor = 0x1233;
+    pBuffer.product = 0xfedb;
+    pBuffer.version = 3;
+    pBuffer.physicalPath = "usb-hiusb-ehci-2.1/input1";
+    pBuffer.uniqueId = "3";
+    pBuffer.classes = INPUT_DEVICE_CLASS_TOUCH;
+    pBuffer.descriptor = "1ds56v18e1v21v8v1erv15r1v8r1j1ty8";
+
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string parameters;
+    StructTransJson(pBuffer, parameters);
+    DistributedInputSourceManager::InputDeviceId inputDeviceId {devId, pBuffer.descriptor, GetNodeDesc(parameters)};
+    sourceManager_->inputDevice_.push_back(inputDeviceId);
+    sourceManager_->regCallbacks_.clear();
+
+    // the node exists already, the same item again and an invalid one fail on their own.
+    std::vector<RegisterHardwareItem> items = {
+        {devId, pBuffer.descriptor, parameters},
+        {devId, pBuffer.descriptor, parameters},
+        {"", pBuffer.descriptor, parameters},
+    };
+    std::vector<int32_t> results;
+    sptr<TestRegisterDInputCb> callback(new TestRegisterDInputCb());
+    int32_t ret = sourceManager_->RegisterDistributedHardwareBatch(items, callback, results);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, ret);
+    ASSERT_EQ(items.size(), results.size());
+    EXPECT_EQ(DH_SUCCESS, results[0]);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, results[1]);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_REGISTER_FAIL, results[2]);
+    EXPECT_EQ(1, sourceManager_->regCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->inputDevice_.size());
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, RegisterDistributedHardwareBatch_03, testing::ext::TestSize.Level1)
+{
+    InputDevice pBuffer;
+    pBuffer.name = "uinput_name_touch";
+    pBuffer.classes = INPUT_DEVICE_CLASS_TOUCH;
+    pBuffer.descriptor = "1ds56v18e1v21v8v1erv15r1v8r1j1ty8";
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string parameters;
+    StructTransJson(pBuffer, parameters);
+    sourceManager_->inputDevice_.clear();
+    sourceManager_->regCallbacks_.clear();
+
+    // another batch is creating the node, this one takes its result instead of creating a second node.
+    sourceManager_->registeringDhIds_.insert({devId, pBuffer.descriptor});
+    std::thread otherBatch([this, &devId, &pBuffer, &parameters]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> lock(sourceManager_->regDisHardwareMutex_);
+        sourceManager_->inputDevice_.push_back({devId, pBuffer.descriptor, GetNodeDesc(parameters)});
+        sourceManager_->registeringDhIds_.erase({devId, pBuffer.descriptor});
+        sourceManager_->regDisHardwareCv_.notify_all();
+    });
+    std::vector<RegisterHardwareItem> items = {{devId, pBuffer.descriptor, parameters}};
+    std::vector<int32_t> results;
+    sptr<TestRegisterDInputCb> callback(new TestRegisterDInputCb());
+    int32_t ret = sourceManager_->RegisterDistributedHardwareBatch(items, callback, results);
+    otherBatch.join();
+    EXPECT_EQ(DH_SUCCESS, ret);
+    ASSERT_EQ(items.size(), results.size());
+    EXPECT_EQ(DH_SUCCESS, results[0]);
+    EXPECT_EQ(1, sourceManager_->inputDevice_.size());
+    EXPECT_TRUE(sourceManager_->registeringDhIds_.empty());
+}
+
 HWTEST_F(DistributedInputSourceManagerTest, handleStartServerCallback_01, testing::ext::TestSize.Level1)
 {
     std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
@@ -510,7 +611,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_02, testing::ext::T
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
     devId = "umkyu1b165e1be98151891erbe8r91ev";
     DistributedInputSourceManager::DInputClientStartInfo info {devId, INPUTTYPE, callback};
-    sourceManager_->staCallbacks_.push_back(info);
+    sourceManager_->staCallbacks_.Add(info);
     ret = sourceManager_->StartRemoteInput(devId, INPUTTYPE, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
 
@@ -551,7 +652,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_02, testing::ext::Te
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
     devId = "umkyu1b165e1be98151891erbe8r91ev";
     DistributedInputSourceManager::DInputClientStopInfo info {devId, INPUTTYPE, callback};
-    sourceManager_->stpCallbacks_.push_back(info);
+    sourceManager_->stpCallbacks_.Add(info);
     ret = sourceManager_->StopRemoteInput(devId, INPUTTYPE, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
 }
@@ -594,7 +695,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_05, testing::ext::T
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
     srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     DistributedInputSourceManager::DInputClientStartInfo startInfo {sinkId, INPUTTYPE, callback};
-    sourceManager_->staCallbacks_.push_back(startInfo);
+    sourceManager_->staCallbacks_.Add(startInfo);
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     ret = sourceManager_->StartRemoteInput(srcId, sinkId, INPUTTYPE, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
@@ -642,7 +743,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_05, testing::ext::Te
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
     srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     DistributedInputSourceManager::DInputClientStopInfo stopInfo {sinkId, INPUTTYPE, callback};
-    sourceManager_->stpCallbacks_.push_back(stopInfo);
+    sourceManager_->stpCallbacks_.Add(stopInfo);
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     ret = sourceManager_->StopRemoteInput(srcId, sinkId, INPUTTYPE, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
@@ -822,7 +923,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_08, testing::ext::T
 
     sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     DistributedInputSourceManager::DInputClientStartDhidInfo info {srcId, sinkId, dhIds, callback};
-    sourceManager_->staStringCallbacks_.push_back(info);
+    sourceManager_->staStringCallbacks_.Add(info);
     ret = sourceManager_->StartRemoteInput(sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
 }
@@ -834,7 +935,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_09, testing::ext::T
     std::string srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     sptr<TestStartStopVectorCallbackStub> callback(new TestStartStopVectorCallbackStub());
-    sourceManager_->staStringCallbacks_.clear();
+    sourceManager_->staStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     int32_t ret = sourceManager_->StartRemoteInput(sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
@@ -879,7 +980,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_08, testing::ext::Te
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
     sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     DistributedInputSourceManager::DInputClientStopDhidInfo info {srcId, sinkId, dhIds, callback};
-    sourceManager_->stpStringCallbacks_.push_back(info);
+    sourceManager_->stpStringCallbacks_.Add(info);
     ret = sourceManager_->StopRemoteInput(sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
 }
@@ -891,7 +992,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_09, testing::ext::Te
     std::string srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     sptr<TestStartStopVectorCallbackStub> callback(new TestStartStopVectorCallbackStub());
-    sourceManager_->stpStringCallbacks_.clear();
+    sourceManager_->stpStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     int32_t ret = sourceManager_->StopRemoteInput(sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
@@ -911,7 +1012,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_10, testing::ext::T
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     dhIds.push_back("Input_slkdiek3kddkeojfe");
     int32_t sessionId = 1;
-    sourceManager_->stpStringCallbacks_.clear();
+    sourceManager_->stpStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_[sinkId] = sessionId;
     int32_t ret = sourceManager_->StartRemoteInput(srcId, sinkId, dhIds, callback);
@@ -947,7 +1048,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_11, testing::ext::T
 
     srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     DistributedInputSourceManager::DInputClientStartDhidInfo startDhIdInfo {srcId, sinkId, dhIds, callback};
-    sourceManager_->staStringCallbacks_.push_back(startDhIdInfo);
+    sourceManager_->staStringCallbacks_.Add(startDhIdInfo);
     ret = sourceManager_->StartRemoteInput(srcId, sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
 }
@@ -959,7 +1060,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StartRemoteInput_12, testing::ext::T
     std::string srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     sptr<TestStartStopVectorCallbackStub> callback(new TestStartStopVectorCallbackStub());
-    sourceManager_->staStringCallbacks_.clear();
+    sourceManager_->staStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     int32_t ret = sourceManager_->StartRemoteInput(srcId, sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_START_FAIL, ret);
@@ -979,7 +1080,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_10, testing::ext::Te
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     dhIds.push_back("Input_slkdiek3kddkeojfe");
     int32_t sessionId = 1;
-    sourceManager_->stpStringCallbacks_.clear();
+    sourceManager_->stpStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_[sinkId] = sessionId;
     int32_t ret = sourceManager_->StopRemoteInput(srcId, sinkId, dhIds, callback);
@@ -1015,7 +1116,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_11, testing::ext::Te
 
     srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     DistributedInputSourceManager::DInputClientStopDhidInfo stopDhIdInfo {srcId, sinkId, dhIds, callback};
-    sourceManager_->stpStringCallbacks_.push_back(stopDhIdInfo);
+    sourceManager_->stpStringCallbacks_.Add(stopDhIdInfo);
     ret = sourceManager_->StopRemoteInput(srcId, sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
 }
@@ -1027,7 +1128,7 @@ HWTEST_F(DistributedInputSourceManagerTest, StopRemoteInput_12, testing::ext::Te
     std::string srcId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
     std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
     sptr<TestStartStopVectorCallbackStub> callback(new TestStartStopVectorCallbackStub());
-    sourceManager_->stpStringCallbacks_.clear();
+    sourceManager_->stpStringCallbacks_.Clear();
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
     int32_t ret = sourceManager_->StopRemoteInput(srcId, sinkId, dhIds, callback);
     EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_MANAGER_STOP_FAIL, ret);
@@ -1289,6 +1390,34 @@ HWTEST_F(DistributedInputSourceManagerTest, RunPrepareCallback_01, testing::ext:
     EXPECT_EQ(1, sourceManager_->preCallbacks_.size());
 }
 
+HWTEST_F(DistributedInputSourceManagerTest, OnPrepareRequestTimeout_01, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    sptr<TestPrepareDInputCallback> prepareCallback(new TestPrepareDInputCallback());
+    sptr<TestStartStopVectorCallbackStub> startCallback(new TestStartStopVectorCallbackStub());
+    DistributedInputSourceManager::DInputClientPrepareInfo info {devId, prepareCallback};
+    sourceManager_->preCallbacks_.insert(info);
+    sourceManager_->pendingPrepareStarts_[devId] = {"localId", devId, {"dhId_1"}, startCallback};
+    sourceManager_->OnPrepareRequestTimeout(devId);
+    EXPECT_EQ(0, sourceManager_->preCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->pendingPrepareStarts_.size());
+    EXPECT_EQ(0, sourceManager_->staStringCallbacks_.Size());
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, RunPrepareCallback_02, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    sptr<TestPrepareDInputCallback> prepareCallback(new TestPrepareDInputCallback());
+    sptr<TestStartStopVectorCallbackStub> startCallback(new TestStartStopVectorCallbackStub());
+    DistributedInputSourceManager::DInputClientPrepareInfo info {devId, prepareCallback};
+    sourceManager_->preCallbacks_.insert(info);
+    sourceManager_->pendingPrepareStarts_[devId] = {"localId", devId, {"dhId_1"}, startCallback};
+    sourceManager_->RunPrepareCallback(devId, ERR_DH_INPUT_SERVER_SOURCE_MANAGER_PREPARE_MSG_IS_BAD, "");
+    EXPECT_EQ(0, sourceManager_->preCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->pendingPrepareStarts_.size());
+    EXPECT_EQ(0, sourceManager_->staStringCallbacks_.Size());
+}
+
 HWTEST_F(DistributedInputSourceManagerTest, RunWhiteListCallback_01, testing::ext::TestSize.Level1)
 {
     std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
@@ -1378,23 +1507,23 @@ HWTEST_F(DistributedInputSourceManagerTest, RunStartCallback_01, testing::ext::T
     uint32_t inputTypes = 1;
     sptr<TestStartDInputCallback> callback(new TestStartDInputCallback());
     DistributedInputSourceManager::DInputClientStartInfo info {devId, inputTypes, callback};
-    sourceManager_->staCallbacks_.push_back(info);
+    sourceManager_->staCallbacks_.Add(info);
     sourceManager_->RunStartCallback(devId, inputTypes, status);
-    EXPECT_EQ(0, sourceManager_->staCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->staCallbacks_.Size());
 
     DistributedInputSourceManager::DInputClientStartInfo startInfo {devId, inputTypes, callback};
-    sourceManager_->staCallbacks_.push_back(startInfo);
+    sourceManager_->staCallbacks_.Add(startInfo);
     devId = "devId_20221221_test";
     sourceManager_->RunStartCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->staCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->staCallbacks_.Size());
 
     inputTypes = 3;
     sourceManager_->RunStartCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->staCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->staCallbacks_.Size());
 
     devId = "umkyu1b165e1be98151891erbe8r91ev";
     sourceManager_->RunStartCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->staCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->staCallbacks_.Size());
 }
 
 HWTEST_F(DistributedInputSourceManagerTest, RunStopCallback_01, testing::ext::TestSize.Level1)
@@ -1404,23 +1533,23 @@ HWTEST_F(DistributedInputSourceManagerTest, RunStopCallback_01, testing::ext::Te
     uint32_t inputTypes = 1;
     sptr<TestStopDInputCallback> callback(new TestStopDInputCallback());
     DistributedInputSourceManager::DInputClientStopInfo info {devId, inputTypes, callback};
-    sourceManager_->stpCallbacks_.push_back(info);
+    sourceManager_->stpCallbacks_.Add(info);
     sourceManager_->RunStopCallback(devId, inputTypes, status);
-    EXPECT_EQ(0, sourceManager_->stpCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->stpCallbacks_.Size());
 
     DistributedInputSourceManager::DInputClientStopInfo stopInfo {devId, inputTypes, callback};
-    sourceManager_->stpCallbacks_.push_back(stopInfo);
+    sourceManager_->stpCallbacks_.Add(stopInfo);
     devId = "devId_20221221_test";
     sourceManager_->RunStopCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->stpCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->stpCallbacks_.Size());
 
     inputTypes = 3;
     sourceManager_->RunStopCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->stpCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->stpCallbacks_.Size());
 
     devId = "umkyu1b165e1be98151891erbe8r91ev";
     sourceManager_->RunStopCallback(devId, inputTypes, status);
-    EXPECT_EQ(1, sourceManager_->stpCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->stpCallbacks_.Size());
 }
 
 HWTEST_F(DistributedInputSourceManagerTest, RunStartDhidCallback_01, testing::ext::TestSize.Level1)
@@ -1433,20 +1562,39 @@ HWTEST_F(DistributedInputSourceManagerTest, RunStartDhidCallback_01, testing::ex
     dhIds.push_back("input_slkdiek3kddkeojfe");
     sptr<TestStartStopDInputsCb> callback(new TestStartStopDInputsCb());
     DistributedInputSourceManager::DInputClientStartDhidInfo info {localNetworkId, sinkId, dhIds, callback};
-    sourceManager_->staStringCallbacks_.push_back(info);
+    sourceManager_->staStringCallbacks_.Add(info);
     sourceManager_->RunStartDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(0, sourceManager_->staStringCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->staStringCallbacks_.Size());
 
     DistributedInputSourceManager::DInputClientStartDhidInfo startInfo {localNetworkId, sinkId, dhIds, callback};
-    sourceManager_->staStringCallbacks_.push_back(startInfo);
+    sourceManager_->staStringCallbacks_.Add(startInfo);
     sinkId = "sinkId_20221221_test";
     sourceManager_->RunStartDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(1, sourceManager_->staStringCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->staStringCallbacks_.Size());
 
     dhIds.clear();
     dhIds.push_back("input_48104809_test");
     sourceManager_->RunStartDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(1, sourceManager_->staStringCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->staStringCallbacks_.Size());
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, RunStartDhidCallback_02, testing::ext::TestSize.Level1)
+{
+    std::string sinkId = "umkyu1b165e1be98151891erbe8r91ev";
+    std::string dhId = "input_slkdiek3kddkeojfe";
+    std::string localNetworkId = "networkidc08647073e02e7a78f09473aa122ff57fc81c00";
+    std::vector<std::string> dhIds;
+    dhIds.push_back(dhId);
+    sourceManager_->DeviceMap_[sinkId] = DINPUT_SOURCE_SWITCH_OFF;
+    sourceManager_->RunStartDhidCallback(sinkId, dhId, DH_SUCCESS, NextRequestId());
+    EXPECT_EQ(DINPUT_SOURCE_SWITCH_OFF, sourceManager_->DeviceMap_[sinkId]);
+
+    sptr<TestStartStopDInputsCb> callback(new TestStartStopDInputsCb());
+    DistributedInputSourceManager::DInputClientStartDhidInfo info {localNetworkId, sinkId, dhIds, callback};
+    uint64_t requestId = sourceManager_->staStringCallbacks_.Add(info);
+    sourceManager_->RunStartDhidCallback(sinkId, dhId, DH_SUCCESS, requestId);
+    EXPECT_EQ(DINPUT_SOURCE_SWITCH_ON, sourceManager_->DeviceMap_[sinkId]);
+    EXPECT_EQ(0, sourceManager_->staStringCallbacks_.Size());
 }
 
 HWTEST_F(DistributedInputSourceManagerTest, RunStopDhidCallback_01, testing::ext::TestSize.Level1)
@@ -1459,20 +1607,53 @@ HWTEST_F(DistributedInputSourceManagerTest, RunStopDhidCallback_01, testing::ext
     dhIds.push_back(dhId);
     sptr<TestStartStopDInputsCb> callback(new TestStartStopDInputsCb());
     DistributedInputSourceManager::DInputClientStopDhidInfo info {localNetworkId, sinkId, dhIds, callback};
-    sourceManager_->stpStringCallbacks_.push_back(info);
+    sourceManager_->stpStringCallbacks_.Add(info);
     sourceManager_->RunStopDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(0, sourceManager_->stpStringCallbacks_.size());
+    EXPECT_EQ(0, sourceManager_->stpStringCallbacks_.Size());
 
     DistributedInputSourceManager::DInputClientStopDhidInfo stopInfo {localNetworkId, sinkId, dhIds, callback};
-    sourceManager_->stpStringCallbacks_.push_back(stopInfo);
+    sourceManager_->stpStringCallbacks_.Add(stopInfo);
     sinkId = "sinkId_20221221_test";
     sourceManager_->RunStopDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(1, sourceManager_->stpStringCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->stpStringCallbacks_.Size());
 
     dhIds.clear();
     dhIds.push_back("input_48104809_test");
     sourceManager_->RunStopDhidCallback(sinkId, dhId, status);
-    EXPECT_EQ(1, sourceManager_->stpStringCallbacks_.size());
+    EXPECT_EQ(1, sourceManager_->stpStringCallbacks_.Size());
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, RunStartCallback_02, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    int32_t status = 0;
+    uint32_t inputTypes = 1;
+    sptr<TestStartDInputCallback> callback(new TestStartDInputCallback());
+    DistributedInputSourceManager::DInputClientStartInfo info {devId, inputTypes, callback};
+    uint64_t firstId = sourceManager_->staCallbacks_.Add(info);
+    uint64_t secondId = sourceManager_->staCallbacks_.Add(info);
+    sourceManager_->RunStartCallback(devId, inputTypes, status, secondId);
+    EXPECT_EQ(1, sourceManager_->staCallbacks_.Size());
+    sourceManager_->RunStartCallback(devId, inputTypes, status, secondId);
+    EXPECT_EQ(1, sourceManager_->staCallbacks_.Size());
+
+    DistributedInputSourceManager::DInputClientStartInfo pendingInfo;
+    EXPECT_EQ(true, sourceManager_->staCallbacks_.Take(firstId, pendingInfo));
+    EXPECT_EQ(0, sourceManager_->staCallbacks_.Size());
+}
+
+HWTEST_F(DistributedInputSourceManagerTest, OnStartRequestTimeout_01, testing::ext::TestSize.Level1)
+{
+    std::string devId = "umkyu1b165e1be98151891erbe8r91ev";
+    uint32_t inputTypes = 1;
+    sptr<TestStartDInputCallback> callback(new TestStartDInputCallback());
+    DistributedInputSourceManager::DInputClientStartInfo info {devId, inputTypes, callback};
+    uint64_t requestId = sourceManager_->staCallbacks_.Add(info);
+    sourceManager_->OnStartRequestTimeout(requestId);
+    EXPECT_EQ(0, sourceManager_->staCallbacks_.Size());
+
+    sourceManager_->RunStartCallback(devId, inputTypes, DH_SUCCESS, requestId);
+    EXPECT_EQ(0, sourceManager_->staCallbacks_.Size());
 }
 
 HWTEST_F(DistributedInputSourceManagerTest, RunRelayStartDhidCallback_01, testing::ext::TestSize.Level1)
@@ -1760,6 +1941,20 @@ HWTEST_F(DistributedInputSourceManagerTest, OnResponseStartRemoteInputDhid_01, t
     EXPECT_EQ(ERR_DH_INPUT_HIDUMP_DUMP_PROCESS_FAIL, ret);
 }
 
+HWTEST_F(DistributedInputSourceManagerTest, OnResponsePrepareStartRemoteInput_01, testing::ext::TestSize.Level1)
+{
+    std::string deviceId = "djfhskjdhf5465456ds4f654sdf6";
+    std::string dhids = "Input_s4df65s5d6f56asd5f6asdfasdfasdfv";
+    std::string object = "";
+    callback_->OnResponsePrepareStartRemoteInput(deviceId, true, true, dhids, object);
+    callback_->OnResponsePrepareStartRemoteInput(deviceId, true, false, dhids, object);
+
+    int32_t fd = 1;
+    std::vector<std::u16string> args;
+    int32_t ret = sourceManager_->Dump(fd, args);
+    EXPECT_EQ(ERR_DH_INPUT_HIDUMP_DUMP_PROCESS_FAIL, ret);
+}
+
 HWTEST_F(DistributedInputSourceManagerTest, OnResponseStopRemoteInputDhid_01, testing::ext::TestSize.Level1)
 {
     std::string deviceId = "djfhskjdhf5465456ds4f654sdf6";
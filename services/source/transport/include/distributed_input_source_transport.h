@@ -29,6 +29,8 @@
 #include "nlohmann/json.hpp"
 #include "securec.h"
 
+#include "dinput_latency_histogram.h"
+#include "dinput_softbus_define.h"
 #include "dinput_source_trans_callback.h"
 #include "dinput_transbase_source_callback.h"
 
@@ -56,20 +58,43 @@ public:
 
     int32_t OpenInputSoftbus(const std::string &remoteDevId, bool isToSrc);
     void CloseInputSoftbus(const std::string &remoteDevId, bool isToSrc);
+    /*
+     * Open an idle session to a recently used sink ahead of its prepare, see SessionKeepPolicy.
+     */
+    void PrewarmInputSoftbus(const std::string &remoteDevId);
 
     void RegisterSourceRespCallback(std::shared_ptr<DInputSourceTransCallback> callback);
 
     int32_t PrepareRemoteInput(const std::string &deviceId);
     int32_t UnprepareRemoteInput(const std::string &deviceId);
-    int32_t StartRemoteInput(const std::string &deviceId, const uint32_t &inputTypes);
-    int32_t StopRemoteInput(const std::string &deviceId, const uint32_t &inputTypes);
+    /*
+     * requestId is sent along for the sink to echo in its response, INVALID_REQUEST_ID sends none.
+     */
+    int32_t StartRemoteInput(const std::string &deviceId, const uint32_t &inputTypes,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    int32_t StopRemoteInput(const std::string &deviceId, const uint32_t &inputTypes,
+        uint64_t requestId = INVALID_REQUEST_ID);
     int32_t LatencyCount(const std::string &deviceId);
-    void StartLatencyCount(const std::string &deviceId);
-    void StartLatencyThread(const std::string &deviceId);
+    void StartLatencyCount();
+    void StartLatencyThread();
     void StopLatencyThread();
-
-    int32_t StartRemoteInput(const std::string &deviceId, const std::vector<std::string> &dhids);
-    int32_t StopRemoteInput(const std::string &deviceId, const std::vector<std::string> &dhids);
+    void AddLatencyProbeDevice(const std::string &deviceId);
+    void RemoveLatencyProbeDevice(const std::string &deviceId);
+
+    int32_t StartRemoteInput(const std::string &deviceId, const std::vector<std::string> &dhids,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    int32_t StopRemoteInput(const std::string &deviceId, const std::vector<std::string> &dhids,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    /*
+     * Prepare and start the dhids with one message, the sink answers with TRANS_SINK_MSG_ON_PREPARE_START.
+     */
+    int32_t PrepareAndStartRemoteInput(const std::string &deviceId, const std::vector<std::string> &dhids,
+        uint64_t requestId = INVALID_REQUEST_ID);
+    /*
+     * Whether the last prepare response of the sink announced TRANS_SOURCE_MSG_PREPARE_START_DHID, an older sink
+     * drops that message.
+     */
+    bool IsPrepareStartSupported(const std::string &deviceId);
 
     int32_t SendRelayPrepareRequest(const std::string &srcId, const std::string &sinkId);
     int32_t SendRelayUnprepareRequest(const std::string &srcId, const std::string &sinkId);
@@ -100,9 +125,10 @@ private:
     void NotifyResponseStopRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyResponseStartRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyResponseStopRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg);
+    void NotifyResponsePrepareStartRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyResponseKeyState(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyResponseKeyStateBatch(int32_t sessionId, const nlohmann::json &recMsg);
-    void NotifyReceivedEventRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
+    void NotifyReceivedEventRemoteInput(int32_t sessionId, const nlohmann::json &recMsg, uint64_t recvTime = 0);
     void ReceiveSrcTSrcRelayPrepare(int32_t sessionId, const nlohmann::json &recMsg);
     void ReceiveSrcTSrcRelayUnprepare(int32_t sessionId, const nlohmann::json &recMsg);
     void NotifyResponseRelayPrepareRemoteInput(int32_t sessionId, const nlohmann::json &recMsg);
@@ -139,20 +165,33 @@ private:
     void CalculateLatency(int32_t sessionId, const nlohmann::json &recMsg);
     void ResetKeyboardKeyState(const std::string &deviceId, const std::vector<std::string> &dhids);
 private:
+    /*
+     * RTT probe state of one sink device, the histogram is reset every INPUT_LATENCY_DELAY_TIMES probes.
+     */
+    struct LatencyProbeInfo {
+        uint64_t sendTime = 0;
+        uint32_t sendNum = 0;
+        uint32_t recvNum = 0;
+        LatencyHistogram rttHistogram;
+        // sent with the next probe, so the sink sees the queueing on the link.
+        uint64_t lastRtt = 0;
+    };
+    void ProbeLatency(const std::string &deviceId);
+
     std::mutex operationMutex_;
     std::set<int32_t> sessionIdSet_;
     std::shared_ptr<DInputSourceTransCallback> callback_;
     std::shared_ptr<DistributedInputSourceTransport::DInputTransbaseSourceListener> statuslistener_;
     std::string mySessionName_ = "";
     std::condition_variable openSessionWaitCond_;
-    uint64_t deltaTime_ = 0;
-    uint64_t deltaTimeAll_ = 0;
-    uint64_t sendTime_ = 0;
-    uint32_t sendNum_ = 0;
-    uint32_t recvNum_ = 0;
     std::atomic<bool> isLatencyThreadRunning_ = false;
     std::thread latencyThread_;
-    std::string eachLatencyDetails_ = "";
+    // the map's key is remote deviceId, all the devices are probed by the single latency thread.
+    std::map<std::string, LatencyProbeInfo> latencyProbeInfos_;
+    std::mutex latencyMutex_;
+    // the sinks which announced the prepare and start message since their session was opened.
+    std::set<std::string> prepareStartDevices_;
+    std::mutex prepareStartMutex_;
     std::atomic<int32_t> injectThreadNum = 0;
     std::atomic<int32_t> latencyThreadNum = 0;
 };
@@ -24,9 +24,11 @@
 #include "system_ability_definition.h"
 
 #include "constants_dinput.h"
+#include "dinput_clock_sync.h"
 #include "dinput_context.h"
 #include "dinput_errcode.h"
 #include "dinput_hitrace.h"
+#include "dinput_latency_trace.h"
 #include "dinput_log.h"
 #include "dinput_softbus_define.h"
 #include "dinput_utils_tool.h"
@@ -40,6 +42,16 @@ namespace DistributedHardware {
 namespace DistributedInput {
 namespace {
     const uint64_t MSG_LATENCY_ALARM_US = 20 * 1000;
+#ifdef DINPUT_SESSION_PREWARM
+    const int64_t SESSION_IDLE_GRACE_MS = 30 * 1000;
+    const size_t SESSION_RECENT_PEER_NUM = 8;
+#endif
+
+    uint64_t GetRequestId(const nlohmann::json &recMsg)
+    {
+        return IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_REQUEST_ID) ?
+            recMsg[DINPUT_SOFTBUS_KEY_REQUEST_ID].get<uint64_t>() : INVALID_REQUEST_ID;
+    }
 }
 DistributedInputSourceTransport::~DistributedInputSourceTransport()
 {
@@ -65,6 +77,14 @@ int32_t DistributedInputSourceTransport::Init()
 
     statuslistener_ = std::make_shared<DInputTransbaseSourceListener>(this);
     DistributedInputTransportBase::GetInstance().RegisterSrcHandleSessionCallback(statuslistener_);
+
+#ifdef DINPUT_SESSION_PREWARM
+    SessionKeepPolicy keepPolicy;
+    keepPolicy.prewarm = true;
+    keepPolicy.idleGraceMs = SESSION_IDLE_GRACE_MS;
+    keepPolicy.maxRecentPeers = SESSION_RECENT_PEER_NUM;
+    DistributedInputTransportBase::GetInstance().SetSessionKeepPolicy(keepPolicy);
+#endif
     return DH_SUCCESS;
 }
 
@@ -81,6 +101,16 @@ void DistributedInputSourceTransport::Release()
         StopLatencyThread();
         latencyThreadNum = 0;
     }
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        for (const auto &item : latencyProbeInfos_) {
+            HiDumper::GetInstance().DeleteLatencyInfo(item.first);
+            DInputClockSync::GetInstance().RemoveDevice(item.first);
+        }
+        latencyProbeInfos_.clear();
+    }
+    // the transport base outlives the source, the sink keeps its sessions closing at once.
+    DistributedInputTransportBase::GetInstance().SetSessionKeepPolicy(SessionKeepPolicy());
     return;
 }
 
@@ -96,8 +126,9 @@ int32_t DistributedInputSourceTransport::OpenInputSoftbus(const std::string &rem
         return DH_SUCCESS;
     }
 
+    AddLatencyProbeDevice(remoteDevId);
     if (latencyThreadNum == 0) {
-        StartLatencyThread(remoteDevId);
+        StartLatencyThread();
         DHLOGI("LatencyThread started, remoteDevId: %{public}s.", GetAnonyString(remoteDevId).c_str());
     } else {
         DHLOGI("LatencyThread already started.");
@@ -115,6 +146,11 @@ int32_t DistributedInputSourceTransport::OpenInputSoftbus(const std::string &rem
     return DH_SUCCESS;
 }
 
+void DistributedInputSourceTransport::PrewarmInputSoftbus(const std::string &remoteDevId)
+{
+    DistributedInputTransportBase::GetInstance().PrewarmSession(remoteDevId);
+}
+
 void DistributedInputSourceTransport::CloseInputSoftbus(const std::string &remoteDevId, bool isToSrc)
 {
     DistributedInputTransportBase::GetInstance().StopSession(remoteDevId);
@@ -123,6 +159,11 @@ void DistributedInputSourceTransport::CloseInputSoftbus(const std::string &remot
         return;
     }
 
+    RemoveLatencyProbeDevice(remoteDevId);
+    {
+        std::lock_guard<std::mutex> lock(prepareStartMutex_);
+        prepareStartDevices_.erase(remoteDevId);
+    }
     SessionClosed();
     return;
 }
@@ -531,7 +572,8 @@ int32_t DistributedInputSourceTransport::NotifyOriginStopTypeResult(int32_t srcT
     return DH_SUCCESS;
 }
 
-int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &deviceId, const uint32_t &inputTypes)
+int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &deviceId, const uint32_t &inputTypes,
+    uint64_t requestId)
 {
     int32_t sessionId = DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId);
     if (sessionId < 0) {
@@ -545,6 +587,9 @@ int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &dev
     jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
     jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
     jsonStr[DINPUT_SOFTBUS_KEY_INPUT_TYPE] = inputTypes;
+    if (requestId != INVALID_REQUEST_ID) {
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = requestId;
+    }
     std::string smsg = jsonStr.dump();
     int32_t ret = SendMessage(sessionId, smsg);
     if (ret != DH_SUCCESS) {
@@ -558,7 +603,7 @@ int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &dev
 }
 
 int32_t DistributedInputSourceTransport::StopRemoteInput(
-    const std::string &deviceId, const uint32_t &inputTypes)
+    const std::string &deviceId, const uint32_t &inputTypes, uint64_t requestId)
 {
     int32_t sessionId = DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId);
     if (sessionId < 0) {
@@ -572,6 +617,9 @@ int32_t DistributedInputSourceTransport::StopRemoteInput(
     jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
     jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
     jsonStr[DINPUT_SOFTBUS_KEY_INPUT_TYPE] = inputTypes;
+    if (requestId != INVALID_REQUEST_ID) {
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = requestId;
+    }
     std::string smsg = jsonStr.dump();
     int32_t ret = SendMessage(sessionId, smsg);
     if (ret != DH_SUCCESS) {
@@ -596,6 +644,15 @@ int32_t DistributedInputSourceTransport::LatencyCount(const std::string &deviceI
     jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SOURCE_MSG_LATENCY;
     jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
     jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
+    jsonStr[DINPUT_SOFTBUS_KEY_TRACE_ENABLE] = DInputLatencyTrace::GetInstance().IsEnabled();
+    jsonStr[DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME] = GetCurrentTimeUs();
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        auto iter = latencyProbeInfos_.find(deviceId);
+        if (iter != latencyProbeInfos_.end() && iter->second.lastRtt > 0) {
+            jsonStr[DINPUT_SOFTBUS_KEY_LATENCY_RTT] = iter->second.lastRtt;
+        }
+    }
     std::string smsg = jsonStr.dump();
     int32_t ret = SendMessage(sessionId, smsg);
     if (ret != DH_SUCCESS) {
@@ -607,38 +664,96 @@ int32_t DistributedInputSourceTransport::LatencyCount(const std::string &deviceI
     return DH_SUCCESS;
 }
 
-void DistributedInputSourceTransport::StartLatencyCount(const std::string &deviceId)
+void DistributedInputSourceTransport::StartLatencyCount()
 {
     int32_t ret = pthread_setname_np(pthread_self(), LATENCY_COUNT_THREAD_NAME);
     if (ret != 0) {
         DHLOGE("StartLatencyCount setname failed.");
     }
     while (isLatencyThreadRunning_.load()) {
-        if (sendNum_ >= INPUT_LATENCY_DELAY_TIMES) {
-            uint64_t latency = (uint64_t)(deltaTimeAll_ / 2 / INPUT_LATENCY_DELAY_TIMES);
-            DHLOGI("LatencyCount average single-channel latency is %{public}" PRIu64 " us, send times is %{public}d, "
-                "recive times is %{public}d.", latency, sendNum_, recvNum_);
-            DHLOGD("each RTT latency details is %{public}s", eachLatencyDetails_.c_str());
-            deltaTimeAll_ = 0;
-            sendNum_ = 0;
-            recvNum_ = 0;
-            eachLatencyDetails_ = "";
+        std::vector<std::string> deviceIds;
+        {
+            std::lock_guard<std::mutex> lock(latencyMutex_);
+            for (const auto &item : latencyProbeInfos_) {
+                deviceIds.push_back(item.first);
+            }
+        }
+        for (const auto &deviceId : deviceIds) {
+            ProbeLatency(deviceId);
         }
-        sendTime_ = GetCurrentTimeUs();
-        LatencyCount(deviceId);
-        sendNum_ += 1;
         usleep(INPUT_LATENCY_DELAYTIME_US);
     }
 }
 
-void DistributedInputSourceTransport::StartLatencyThread(const std::string &deviceId)
+void DistributedInputSourceTransport::ProbeLatency(const std::string &deviceId)
+{
+    if (DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId) < 0) {
+        DHLOGI("Session of deviceId: %{public}s closed, stop probing it.", GetAnonyString(deviceId).c_str());
+        RemoveLatencyProbeDevice(deviceId);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        auto iter = latencyProbeInfos_.find(deviceId);
+        if (iter == latencyProbeInfos_.end()) {
+            return;
+        }
+        LatencyProbeInfo &info = iter->second;
+        if (info.sendNum >= INPUT_LATENCY_DELAY_TIMES) {
+            LatencyInfo latencyInfo = {
+                .sendNum = info.sendNum,
+                .recvNum = info.recvNum,
+                .rtt = info.rttHistogram.GetSummary(),
+            };
+            ClockEstimate estimate;
+            if (DInputClockSync::GetInstance().GetEstimate(deviceId, estimate)) {
+                latencyInfo.hasClockEstimate = true;
+                latencyInfo.clockOffsetUs = estimate.offsetUs;
+                latencyInfo.clockDriftPpm = estimate.driftPpm;
+            }
+            DHLOGI("LatencyCount deviceId: %{public}s, RTT p50: %{public}" PRIu64 " us, p90: %{public}" PRIu64 " us, "
+                "p99: %{public}" PRIu64 " us, max: %{public}" PRIu64 " us, send times is %{public}u, "
+                "recive times is %{public}u.", GetAnonyString(deviceId).c_str(), latencyInfo.rtt.p50,
+                latencyInfo.rtt.p90, latencyInfo.rtt.p99, latencyInfo.rtt.max, info.sendNum, info.recvNum);
+            HiDumper::GetInstance().SaveLatencyInfo(deviceId, latencyInfo);
+            info.sendNum = 0;
+            info.recvNum = 0;
+            info.rttHistogram.Reset();
+        }
+        info.sendTime = GetCurrentTimeUs();
+        info.sendNum += 1;
+    }
+    LatencyCount(deviceId);
+}
+
+void DistributedInputSourceTransport::StartLatencyThread()
 {
     DHLOGI("start");
     isLatencyThreadRunning_.store(true);
-    latencyThread_ = std::thread([this, deviceId]() { this->StartLatencyCount(deviceId); });
+    latencyThread_ = std::thread([this]() { this->StartLatencyCount(); });
     DHLOGI("end");
 }
 
+void DistributedInputSourceTransport::AddLatencyProbeDevice(const std::string &deviceId)
+{
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    if (latencyProbeInfos_.find(deviceId) != latencyProbeInfos_.end()) {
+        return;
+    }
+    latencyProbeInfos_[deviceId] = LatencyProbeInfo();
+    DHLOGI("Add latency probe device: %{public}s.", GetAnonyString(deviceId).c_str());
+}
+
+void DistributedInputSourceTransport::RemoveLatencyProbeDevice(const std::string &deviceId)
+{
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        latencyProbeInfos_.erase(deviceId);
+    }
+    HiDumper::GetInstance().DeleteLatencyInfo(deviceId);
+    DInputClockSync::GetInstance().RemoveDevice(deviceId);
+}
+
 void DistributedInputSourceTransport::StopLatencyThread()
 {
     DHLOGI("start");
@@ -678,7 +793,7 @@ void DistributedInputSourceTransport::SessionClosed()
 }
 
 int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &deviceId,
-    const std::vector<std::string> &dhids)
+    const std::vector<std::string> &dhids, uint64_t requestId)
 {
     int32_t sessionId = DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId);
     if (sessionId < 0) {
@@ -692,6 +807,9 @@ int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &dev
     jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
     jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
     jsonStr[DINPUT_SOFTBUS_KEY_VECTOR_DHID] = JointDhIds(dhids);
+    if (requestId != INVALID_REQUEST_ID) {
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = requestId;
+    }
     std::string smsg = jsonStr.dump();
     int32_t ret = SendMessage(sessionId, smsg);
     if (ret != DH_SUCCESS) {
@@ -704,18 +822,45 @@ int32_t DistributedInputSourceTransport::StartRemoteInput(const std::string &dev
     return DH_SUCCESS;
 }
 
+int32_t DistributedInputSourceTransport::PrepareAndStartRemoteInput(const std::string &deviceId,
+    const std::vector<std::string> &dhids, uint64_t requestId)
+{
+    int32_t sessionId = DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId);
+    if (sessionId < 0) {
+        DHLOGE("PrepareAndStartRemoteInput error, not find this device:%{public}s.", GetAnonyString(deviceId).c_str());
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_PREPARE_FAIL;
+    }
+    DHLOGI("PrepareAndStartRemoteInput sessionId:%{public}d.", sessionId);
+
+    nlohmann::json jsonStr;
+    jsonStr[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SOURCE_MSG_PREPARE_START_DHID;
+    jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
+    jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
+    jsonStr[DINPUT_SOFTBUS_KEY_VECTOR_DHID] = JointDhIds(dhids);
+    if (requestId != INVALID_REQUEST_ID) {
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = requestId;
+    }
+    std::string smsg = jsonStr.dump();
+    int32_t ret = SendMessage(sessionId, smsg);
+    if (ret != DH_SUCCESS) {
+        DHLOGE("PrepareAndStartRemoteInput deviceId:%{public}s, sessionId: %{public}d, smsg:%{public}s, SendMsg "
+            "error, ret:%{public}d.", GetAnonyString(deviceId).c_str(), sessionId, SetAnonyId(smsg).c_str(), ret);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_PREPARE_FAIL;
+    }
+    DHLOGI("PrepareAndStartRemoteInput deviceId:%{public}s, sessionId: %{public}d, smsg:%{public}s.",
+        GetAnonyString(deviceId).c_str(), sessionId, SetAnonyId(smsg).c_str());
+    return DH_SUCCESS;
+}
+
 void DistributedInputSourceTransport::ResetKeyboardKeyState(const std::string &deviceId,
     const std::vector<std::string> &dhids)
 {
-    std::vector<std::string> keyboardNodePaths;
-    DistributedInputInject::GetInstance().GetVirtualKeyboardPaths(deviceId, dhids, keyboardNodePaths);
-    DHLOGI("Try reset keyboard states, dhIds: %{public}s, nodePaths: %{public}s",
-        GetString(dhids).c_str(), GetString(keyboardNodePaths).c_str());
-    ResetVirtualDevicePressedKeys(keyboardNodePaths);
+    DHLOGI("Try reset keyboard states, dhIds: %{public}s", GetString(dhids).c_str());
+    DistributedInputInject::GetInstance().ResetPressedKeys(deviceId, dhids);
 }
 
 int32_t DistributedInputSourceTransport::StopRemoteInput(const std::string &deviceId,
-    const std::vector<std::string> &dhids)
+    const std::vector<std::string> &dhids, uint64_t requestId)
 {
     int32_t sessionId = DistributedInputTransportBase::GetInstance().GetSessionIdByDevId(deviceId);
     if (sessionId < 0) {
@@ -730,6 +875,9 @@ int32_t DistributedInputSourceTransport::StopRemoteInput(const std::string &devi
     jsonStr[DINPUT_SOFTBUS_KEY_DEVICE_ID] = deviceId;
     jsonStr[DINPUT_SOFTBUS_KEY_SESSION_ID] = sessionId;
     jsonStr[DINPUT_SOFTBUS_KEY_VECTOR_DHID] = JointDhIds(dhids);
+    if (requestId != INVALID_REQUEST_ID) {
+        jsonStr[DINPUT_SOFTBUS_KEY_REQUEST_ID] = requestId;
+    }
     std::string smsg = jsonStr.dump();
     int32_t ret = SendMessage(sessionId, smsg);
     if (ret != DH_SUCCESS) {
@@ -884,6 +1032,16 @@ void DistributedInputSourceTransport::NotifyResponsePrepareRemoteInput(int32_t s
         DHLOGE("OnBytesReceived cmdType is TRANS_SINK_MSG_ONPREPARE, deviceId is error.");
         return;
     }
+    bool isPrepareStartSupported = IsBoolean(recMsg, DINPUT_SOFTBUS_KEY_PREPARE_START) &&
+        recMsg[DINPUT_SOFTBUS_KEY_PREPARE_START].get<bool>();
+    {
+        std::lock_guard<std::mutex> lock(prepareStartMutex_);
+        if (isPrepareStartSupported) {
+            prepareStartDevices_.insert(deviceId);
+        } else {
+            prepareStartDevices_.erase(deviceId);
+        }
+    }
     callback_->OnResponsePrepareRemoteInput(deviceId, recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE],
         recMsg[DINPUT_SOFTBUS_KEY_WHITE_LIST]);
 }
@@ -918,8 +1076,8 @@ void DistributedInputSourceTransport::NotifyResponseStartRemoteInput(int32_t ses
         DHLOGE("OnBytesReceived cmdType is TRANS_SINK_MSG_ONSTART, deviceId is error.");
         return;
     }
-    callback_->OnResponseStartRemoteInput(
-        deviceId, recMsg[DINPUT_SOFTBUS_KEY_INPUT_TYPE], recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE]);
+    callback_->OnResponseStartRemoteInputById(deviceId, recMsg[DINPUT_SOFTBUS_KEY_INPUT_TYPE],
+        recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE], GetRequestId(recMsg));
 }
 
 void DistributedInputSourceTransport::NotifyResponseStopRemoteInput(int32_t sessionId, const nlohmann::json &recMsg)
@@ -935,8 +1093,8 @@ void DistributedInputSourceTransport::NotifyResponseStopRemoteInput(int32_t sess
         DHLOGE("OnBytesReceived cmdType TRANS_SINK_MSG_ONSTOP, deviceId is error.");
         return;
     }
-    callback_->OnResponseStopRemoteInput(
-        deviceId, recMsg[DINPUT_SOFTBUS_KEY_INPUT_TYPE], recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE]);
+    callback_->OnResponseStopRemoteInputById(deviceId, recMsg[DINPUT_SOFTBUS_KEY_INPUT_TYPE],
+        recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE], GetRequestId(recMsg));
 }
 
 void DistributedInputSourceTransport::NotifyResponseStartRemoteInputDhid(int32_t sessionId,
@@ -953,8 +1111,35 @@ void DistributedInputSourceTransport::NotifyResponseStartRemoteInputDhid(int32_t
         DHLOGE("OnBytesReceived cmdType is TRANS_SINK_MSG_DHID_ONSTART, deviceId is error.");
         return;
     }
-    callback_->OnResponseStartRemoteInputDhid(
-        deviceId, recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID], recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE]);
+    callback_->OnResponseStartRemoteInputDhidById(deviceId, recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID],
+        recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE], GetRequestId(recMsg));
+}
+
+bool DistributedInputSourceTransport::IsPrepareStartSupported(const std::string &deviceId)
+{
+    std::lock_guard<std::mutex> lock(prepareStartMutex_);
+    return prepareStartDevices_.count(deviceId) != 0;
+}
+
+void DistributedInputSourceTransport::NotifyResponsePrepareStartRemoteInput(int32_t sessionId,
+    const nlohmann::json &recMsg)
+{
+    DHLOGI("OnBytesReceived cmdType is TRANS_SINK_MSG_ON_PREPARE_START.");
+    if (!IsBoolean(recMsg, DINPUT_SOFTBUS_KEY_RESP_VALUE) ||
+        !IsBoolean(recMsg, DINPUT_SOFTBUS_KEY_START_RESP_VALUE) ||
+        !IsString(recMsg, DINPUT_SOFTBUS_KEY_VECTOR_DHID) ||
+        !IsString(recMsg, DINPUT_SOFTBUS_KEY_WHITE_LIST)) {
+        DHLOGE("The key is invaild.");
+        return;
+    }
+    std::string deviceId = DistributedInputTransportBase::GetInstance().GetDevIdBySessionId(sessionId);
+    if (deviceId.empty()) {
+        DHLOGE("OnBytesReceived cmdType is TRANS_SINK_MSG_ON_PREPARE_START, deviceId is error.");
+        return;
+    }
+    callback_->OnResponsePrepareStartRemoteInputById(deviceId, recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE],
+        recMsg[DINPUT_SOFTBUS_KEY_START_RESP_VALUE], recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID],
+        recMsg[DINPUT_SOFTBUS_KEY_WHITE_LIST], GetRequestId(recMsg));
 }
 
 void DistributedInputSourceTransport::NotifyResponseStopRemoteInputDhid(int32_t sessionId, const nlohmann::json &recMsg)
@@ -970,8 +1155,8 @@ void DistributedInputSourceTransport::NotifyResponseStopRemoteInputDhid(int32_t
         DHLOGE("OnBytesReceived cmdType is TRANS_SINK_MSG_DHID_ONSTOP, deviceId is error.");
         return;
     }
-    callback_->OnResponseStopRemoteInputDhid(
-        deviceId, recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID], recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE]);
+    callback_->OnResponseStopRemoteInputDhidById(deviceId, recMsg[DINPUT_SOFTBUS_KEY_VECTOR_DHID],
+        recMsg[DINPUT_SOFTBUS_KEY_RESP_VALUE], GetRequestId(recMsg));
 }
 
 void DistributedInputSourceTransport::NotifyResponseKeyState(int32_t sessionId, const nlohmann::json &recMsg)
@@ -1010,7 +1195,8 @@ void DistributedInputSourceTransport::NotifyResponseKeyStateBatch(int32_t sessio
     callback_->OnResponseKeyStateBatch(deviceId, inputDataStr);
 }
 
-void DistributedInputSourceTransport::NotifyReceivedEventRemoteInput(int32_t sessionId, const nlohmann::json &recMsg)
+void DistributedInputSourceTransport::NotifyReceivedEventRemoteInput(int32_t sessionId, const nlohmann::json &recMsg,
+    uint64_t recvTime)
 {
     DHLOGD("OnBytesReceived cmdType is TRANS_SINK_MSG_BODY_DATA.");
     if (!IsString(recMsg, DINPUT_SOFTBUS_KEY_INPUT_DATA)) {
@@ -1024,6 +1210,13 @@ void DistributedInputSourceTransport::NotifyReceivedEventRemoteInput(int32_t ses
         return;
     }
     std::string inputDataStr = recMsg[DINPUT_SOFTBUS_KEY_INPUT_DATA];
+    TraceStamps stamps {};
+    if (recvTime != 0 && recMsg.contains(DINPUT_SOFTBUS_KEY_TRACE_STAMPS) &&
+        DInputLatencyTrace::StampsFromJson(recMsg[DINPUT_SOFTBUS_KEY_TRACE_STAMPS], stamps)) {
+        stamps[static_cast<size_t>(TraceStage::BYTES_RECEIVED)] = recvTime;
+        callback_->OnReceivedTracedEventRemoteInput(deviceId, inputDataStr, stamps);
+        return;
+    }
     callback_->OnReceivedEventRemoteInput(deviceId, inputDataStr);
 }
 
@@ -1036,18 +1229,39 @@ void DistributedInputSourceTransport::CalculateLatency(int32_t sessionId, const
     }
 
     uint64_t curTimeUs = GetCurrentTimeUs();
-    if (curTimeUs <= sendTime_) {
+    uint64_t originTime = 0;
+    // the stamps are echoed by the sink, a lost or late probe can not pair the wrong send time.
+    if (IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME) &&
+        IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_LATENCY_RECEIVE_TIME) &&
+        IsUInt64(recMsg, DINPUT_SOFTBUS_KEY_LATENCY_TRANSMIT_TIME)) {
+        ClockSample sample;
+        sample.t1 = recMsg[DINPUT_SOFTBUS_KEY_LATENCY_ORIGIN_TIME].get<uint64_t>();
+        sample.t2 = recMsg[DINPUT_SOFTBUS_KEY_LATENCY_RECEIVE_TIME].get<uint64_t>();
+        sample.t3 = recMsg[DINPUT_SOFTBUS_KEY_LATENCY_TRANSMIT_TIME].get<uint64_t>();
+        sample.t4 = curTimeUs;
+        DInputClockSync::GetInstance().AddSample(deviceId, sample);
+        originTime = sample.t1;
+    }
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    auto iter = latencyProbeInfos_.find(deviceId);
+    if (iter == latencyProbeInfos_.end()) {
+        DHLOGE("Latency probe of deviceId: %{public}s not started.", GetAnonyString(deviceId).c_str());
+        return;
+    }
+    LatencyProbeInfo &info = iter->second;
+    if (curTimeUs <= info.sendTime) {
         DHLOGE("Latency time error, currtime is before than send time, curTime: %{public}" PRIu64 " us, "
-            "sendTime: %{public}" PRIu64 " us", curTimeUs, sendTime_);
+            "sendTime: %{public}" PRIu64 " us", curTimeUs, info.sendTime);
         return;
     }
 
-    deltaTime_ = curTimeUs - sendTime_;
-    deltaTimeAll_ += deltaTime_;
-    recvNum_ += 1;
-    eachLatencyDetails_ += (std::to_string(deltaTime_) + DINPUT_SPLIT_COMMA);
-    if (deltaTime_ >= MSG_LATENCY_ALARM_US) {
-        DHLOGW("The RTT time between send req and receive rsp is too long: %{public}" PRIu64 " us", deltaTime_);
+    uint64_t deltaTime = curTimeUs - info.sendTime;
+    info.recvNum += 1;
+    info.rttHistogram.Record(deltaTime);
+    // a probe answered after the next one was sent is only measured right from its echoed origin time.
+    info.lastRtt = (originTime > 0 && curTimeUs > originTime) ? curTimeUs - originTime : deltaTime;
+    if (deltaTime >= MSG_LATENCY_ALARM_US) {
+        DHLOGW("The RTT time between send req and receive rsp is too long: %{public}" PRIu64 " us", deltaTime);
     }
 }
 
@@ -1526,6 +1740,7 @@ void DistributedInputSourceTransport::HandleData(int32_t sessionId, const std::s
         DHLOGE("OnBytesReceived the callback_ is null, the message:%{public}s abort.", SetAnonyId(message).c_str());
         return;
     }
+    uint64_t recvTime = DInputLatencyTrace::GetInstance().IsEnabled() ? GetCurrentTimeUs() : 0;
     nlohmann::json recMsg = nlohmann::json::parse(message, nullptr, false);
     if (recMsg.is_discarded()) {
         DHLOGE("recMsg parse failed!");
@@ -1550,7 +1765,7 @@ void DistributedInputSourceTransport::HandleData(int32_t sessionId, const std::s
             NotifyResponseStopRemoteInput(sessionId, recMsg);
             break;
         case TRANS_SINK_MSG_BODY_DATA:
-            NotifyReceivedEventRemoteInput(sessionId, recMsg);
+            NotifyReceivedEventRemoteInput(sessionId, recMsg, recvTime);
             break;
         case TRANS_SINK_MSG_LATENCY:
             CalculateLatency(sessionId, recMsg);
@@ -1564,6 +1779,9 @@ void DistributedInputSourceTransport::HandleData(int32_t sessionId, const std::s
         case TRANS_SINK_MSG_KEY_STATE:
             NotifyResponseKeyState(sessionId, recMsg);
             break;
+        case TRANS_SINK_MSG_ON_PREPARE_START:
+            NotifyResponsePrepareStartRemoteInput(sessionId, recMsg);
+            break;
         default:
             HandleEventFirst(sessionId, recMsg);
     }
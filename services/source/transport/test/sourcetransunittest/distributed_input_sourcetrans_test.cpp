@@ -54,6 +54,20 @@ bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
     return true;
 }
 
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    return true;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    (void)networkId;
+}
+
 void DistributedInputSourceTransTest::SetUp()
 {
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,8 +16,7 @@
 #ifndef DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_MGR_H
 #define DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_MGR_H
 
-#include "touchpad_event_fragment.h"
-
+#include <array>
 #include <map>
 #include <mutex>
 #include <string>
@@ -28,9 +27,39 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+constexpr size_t TOUCHPAD_MAX_SLOT_NUM = 10;
+
+/*
+ * The state of the in-flight gesture of one touchpad. Its size does not depend on the gesture length,
+ * the events to send back are synthesized from it.
+ */
+struct TouchPadState {
+    // the node path of the touchpad, carried by the synthesized events.
+    std::string path;
+    // bits of TOUCHPAD_TRACKED_KEYS that are down now.
+    uint32_t downKeys = 0;
+    // bits of TOUCHPAD_TRACKED_KEYS that went down during the gesture.
+    uint32_t gestureKeys = 0;
+    // bits of the slots with a contact during the gesture.
+    uint32_t gestureSlots = 0;
+    bool touching = false;
+    // the BTN_TOUCH down of the gesture is seen on this device.
+    bool started = false;
+    // BTN_TOUCH went up in the frame not yet closed by SYN_REPORT.
+    bool touchUp = false;
+    int64_t lastWhen = 0;
+    int32_t slot = 0;
+    std::array<int32_t, TOUCHPAD_MAX_SLOT_NUM> trackingIds;
+
+    TouchPadState()
+    {
+        trackingIds.fill(-1);
+    }
+};
+
 class TouchPadEventFragmentMgr {
 public:
-    TouchPadEventFragmentMgr() : fragments_({}) {}
+    TouchPadEventFragmentMgr() : states_({}) {}
 
     /**
      * @brief Push the touchpad event
@@ -43,19 +72,27 @@ public:
      */
     std::pair<bool, std::vector<RawEvent>> PushEvent(const std::string &dhId, const RawEvent &event);
     void Clear(const std::string &dhId);
+    /**
+     * @brief Get the events that bring a touchpad to the current state of the in-flight gesture,
+     *     and forget the gesture.
+     */
     std::vector<RawEvent> GetAndClearEvents(const std::string &dhId);
 
 private:
     bool IsPositionEvent(const RawEvent &event);
     bool IsSynEvent(const RawEvent &event);
-    bool IsWholeTouchFragments(const std::vector<TouchPadEventFragment> &fragments);
-    std::pair<bool, std::vector<RawEvent>> DealSynEvent(const std::string &dhId);
+    void UpdateState(TouchPadState &state, const RawEvent &event);
+    std::pair<bool, std::vector<RawEvent>> DealSynEvent(const std::string &dhId, TouchPadState &state);
+    // the up events of everything that went down during the gesture.
+    std::vector<RawEvent> MakeResetEvents(const std::string &dhId, const TouchPadState &state);
+    // the down events of everything that is down now.
+    std::vector<RawEvent> MakeStateEvents(const std::string &dhId, const TouchPadState &state);
 private:
     std::mutex fragmentsMtx_;
-    // record the event fragments for the dhid. { dhId, { events }}
-    std::map<std::string, std::vector<TouchPadEventFragment>> fragments_;
+    // the gesture state of the touchpads. { dhId, state }
+    std::map<std::string, TouchPadState> states_;
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
-#endif // DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_MGR_H
\ No newline at end of file
+#endif // DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_MGR_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -23,6 +23,31 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+namespace {
+    // the keys of a touchpad whose down state is kept, the index is the bit in TouchPadState.
+    constexpr uint32_t TOUCHPAD_TRACKED_KEYS[] = {
+        BTN_LEFT, BTN_RIGHT, BTN_MIDDLE, BTN_TOOL_FINGER, BTN_TOOL_DOUBLETAP, BTN_TOOL_TRIPLETAP,
+        BTN_TOOL_QUADTAP, BTN_TOOL_QUINTTAP, BTN_TOOL_PEN, BTN_TOOL_RUBBER, BTN_STYLUS, BTN_STYLUS2,
+    };
+    constexpr size_t TOUCHPAD_TRACKED_KEY_NUM = sizeof(TOUCHPAD_TRACKED_KEYS) / sizeof(TOUCHPAD_TRACKED_KEYS[0]);
+    constexpr int32_t INVALID_TRACKING_ID = -1;
+
+    int32_t GetTrackedKeyIndex(uint32_t code)
+    {
+        for (size_t i = 0; i < TOUCHPAD_TRACKED_KEY_NUM; i++) {
+            if (TOUCHPAD_TRACKED_KEYS[i] == code) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    bool IsSlotValid(int32_t slot)
+    {
+        return slot >= 0 && static_cast<size_t>(slot) < TOUCHPAD_MAX_SLOT_NUM;
+    }
+}
+
 bool TouchPadEventFragmentMgr::IsPositionEvent(const RawEvent &event)
 {
     if (event.type == EV_ABS && (event.code == ABS_MT_POSITION_X || event.code == ABS_MT_POSITION_Y ||
@@ -38,11 +63,6 @@ bool TouchPadEventFragmentMgr::IsSynEvent(const RawEvent &event)
     return event.type == EV_SYN && event.code == SYN_REPORT;
 }
 
-bool TouchPadEventFragmentMgr::IsWholeTouchFragments(const std::vector<TouchPadEventFragment> &events)
-{
-    return events.front().IsTouchPadOptStart() && events.back().IsTouchPadOptFinish();
-}
-
 std::pair<bool, std::vector<RawEvent>> TouchPadEventFragmentMgr::PushEvent(const std::string &dhId,
     const RawEvent &event)
 {
@@ -50,66 +70,150 @@ std::pair<bool, std::vector<RawEvent>> TouchPadEventFragmentMgr::PushEvent(const
         return {false, {}};
     }
     std::lock_guard<std::mutex> lock(fragmentsMtx_);
-    if (fragments_.find(dhId) == fragments_.end()) {
-        fragments_[dhId] = {{}};
+    auto iter = states_.find(dhId);
+    if (iter == states_.end()) {
+        iter = states_.emplace(dhId, TouchPadState()).first;
+        iter->second.path = event.path;
     }
-
-    fragments_[dhId].back().PushEvent(event);
+    TouchPadState &state = iter->second;
+    state.lastWhen = event.when;
     if (IsSynEvent(event)) {
-        return DealSynEvent(dhId);
+        return DealSynEvent(dhId, state);
     }
+    UpdateState(state, event);
     return {false, {}};
 }
 
-std::pair<bool, std::vector<RawEvent>> TouchPadEventFragmentMgr::DealSynEvent(const std::string &dhId)
+void TouchPadEventFragmentMgr::UpdateState(TouchPadState &state, const RawEvent &event)
 {
-    if (fragments_[dhId].back().IsTouchPadOptFinish()) {
-        bool needSim = false;
-        std::vector<RawEvent> allEvents = {};
-        if (!IsWholeTouchFragments(fragments_[dhId])) {
-            // If not whole touch events, this means the down event occurs on the other device,
-            // so we need simulate the up actions to the other side to reset the touchpad states.
-            for (auto &frag : fragments_[dhId]) {
-                std::vector<RawEvent> fragEvents = frag.GetEvents();
-                allEvents.insert(allEvents.end(), fragEvents.begin(), fragEvents.end());
-            }
-            needSim = true;
-            DHLOGI("Find NOT Whole touchpad events need send back, dhId: %{public}s", GetAnonyString(dhId).c_str());
+    if (event.type == EV_KEY && event.code == BTN_TOUCH) {
+        if (event.value == KEY_DOWN_STATE) {
+            state.started = true;
+        } else if (event.value == KEY_UP_STATE) {
+            state.touchUp = true;
+        }
+        state.touching = (event.value != KEY_UP_STATE);
+        return;
+    }
+    if (event.type == EV_KEY) {
+        int32_t index = GetTrackedKeyIndex(event.code);
+        if (index < 0 || event.value == KEY_REPEAT) {
+            return;
+        }
+        uint32_t bit = 1u << static_cast<uint32_t>(index);
+        if (event.value == KEY_UP_STATE) {
+            state.downKeys &= ~bit;
+        } else {
+            state.downKeys |= bit;
+            state.gestureKeys |= bit;
+        }
+        return;
+    }
+    if (event.type == EV_ABS && event.code == ABS_MT_SLOT) {
+        state.slot = event.value;
+        return;
+    }
+    if (event.type == EV_ABS && event.code == ABS_MT_TRACKING_ID && IsSlotValid(state.slot)) {
+        state.trackingIds[state.slot] = event.value;
+        if (event.value != INVALID_TRACKING_ID) {
+            state.gestureSlots |= 1u << static_cast<uint32_t>(state.slot);
         }
-        fragments_[dhId].clear();
-        fragments_[dhId].push_back({});
-        return {needSim, allEvents};
     }
+}
 
-    if (fragments_[dhId].back().IsShouldDrop()) {
-        fragments_[dhId].pop_back();
+std::pair<bool, std::vector<RawEvent>> TouchPadEventFragmentMgr::DealSynEvent(const std::string &dhId,
+    TouchPadState &state)
+{
+    if (!state.touchUp) {
+        return {false, {}};
     }
-    fragments_[dhId].push_back({});
-    return {false, {}};
+    bool needSim = false;
+    std::vector<RawEvent> resetEvents = {};
+    if (!state.started) {
+        // If not whole touch events, this means the down event occurs on the other device,
+        // so we need simulate the up actions to the other side to reset the touchpad states.
+        resetEvents = MakeResetEvents(dhId, state);
+        needSim = true;
+        DHLOGI("Find NOT Whole touchpad events need send back, dhId: %{public}s", GetAnonyString(dhId).c_str());
+    }
+    // the next gesture starts from what is still down.
+    state.started = false;
+    state.touchUp = false;
+    state.gestureKeys = state.downKeys;
+    state.gestureSlots = 0;
+    for (size_t i = 0; i < TOUCHPAD_MAX_SLOT_NUM; i++) {
+        if (state.trackingIds[i] != INVALID_TRACKING_ID) {
+            state.gestureSlots |= 1u << static_cast<uint32_t>(i);
+        }
+    }
+    return {needSim, resetEvents};
+}
+
+std::vector<RawEvent> TouchPadEventFragmentMgr::MakeResetEvents(const std::string &dhId, const TouchPadState &state)
+{
+    std::vector<RawEvent> events;
+    for (size_t i = 0; i < TOUCHPAD_MAX_SLOT_NUM; i++) {
+        if ((state.gestureSlots & (1u << static_cast<uint32_t>(i))) == 0) {
+            continue;
+        }
+        events.push_back({ state.lastWhen, EV_ABS, ABS_MT_SLOT, static_cast<int32_t>(i), dhId, state.path });
+        events.push_back({ state.lastWhen, EV_ABS, ABS_MT_TRACKING_ID, INVALID_TRACKING_ID, dhId, state.path });
+    }
+    for (size_t i = 0; i < TOUCHPAD_TRACKED_KEY_NUM; i++) {
+        if ((state.gestureKeys & (1u << static_cast<uint32_t>(i))) != 0) {
+            events.push_back({ state.lastWhen, EV_KEY, TOUCHPAD_TRACKED_KEYS[i], KEY_UP_STATE, dhId, state.path });
+        }
+    }
+    events.push_back({ state.lastWhen, EV_KEY, BTN_TOUCH, KEY_UP_STATE, dhId, state.path });
+    events.push_back({ state.lastWhen, EV_SYN, SYN_REPORT, 0, dhId, state.path });
+    return events;
+}
+
+std::vector<RawEvent> TouchPadEventFragmentMgr::MakeStateEvents(const std::string &dhId, const TouchPadState &state)
+{
+    std::vector<RawEvent> events;
+    for (size_t i = 0; i < TOUCHPAD_MAX_SLOT_NUM; i++) {
+        if (state.trackingIds[i] == INVALID_TRACKING_ID) {
+            continue;
+        }
+        events.push_back({ state.lastWhen, EV_ABS, ABS_MT_SLOT, static_cast<int32_t>(i), dhId, state.path });
+        events.push_back({ state.lastWhen, EV_ABS, ABS_MT_TRACKING_ID, state.trackingIds[i], dhId, state.path });
+    }
+    if (!events.empty()) {
+        events.push_back({ state.lastWhen, EV_ABS, ABS_MT_SLOT, state.slot, dhId, state.path });
+    }
+    for (size_t i = 0; i < TOUCHPAD_TRACKED_KEY_NUM; i++) {
+        if ((state.downKeys & (1u << static_cast<uint32_t>(i))) != 0) {
+            events.push_back({ state.lastWhen, EV_KEY, TOUCHPAD_TRACKED_KEYS[i], KEY_DOWN_STATE, dhId, state.path });
+        }
+    }
+    if (state.touching) {
+        events.push_back({ state.lastWhen, EV_KEY, BTN_TOUCH, KEY_DOWN_STATE, dhId, state.path });
+    }
+    if (events.empty()) {
+        return {};
+    }
+    events.push_back({ state.lastWhen, EV_SYN, SYN_REPORT, 0, dhId, state.path });
+    return events;
 }
 
 void TouchPadEventFragmentMgr::Clear(const std::string &dhId)
 {
     std::lock_guard<std::mutex> lock(fragmentsMtx_);
-    fragments_.erase(dhId);
+    states_.erase(dhId);
 }
 
 std::vector<RawEvent> TouchPadEventFragmentMgr::GetAndClearEvents(const std::string &dhId)
 {
     std::lock_guard<std::mutex> lock(fragmentsMtx_);
-    std::vector<RawEvent> allEvents;
-    if (fragments_.find(dhId) == fragments_.end()) {
+    auto iter = states_.find(dhId);
+    if (iter == states_.end()) {
         return {};
     }
-
-    for (auto &frag : fragments_[dhId]) {
-        std::vector<RawEvent> fragEvents = frag.GetEvents();
-        allEvents.insert(allEvents.end(), fragEvents.begin(), fragEvents.end());
-    }
-
-    fragments_.erase(dhId);
-    return allEvents;
+    std::vector<RawEvent> events = MakeStateEvents(dhId, iter->second);
+    states_.erase(iter);
+    return events;
 }
 } // namespace DistributedInput
 } // namespace DistributedHardware
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
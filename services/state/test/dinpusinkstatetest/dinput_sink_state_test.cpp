@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <string>
 
@@ -171,6 +172,56 @@ HWTEST_F(DinputSinkStateTest, GetAndClearEvents_001, testing::ext::TestSize.Leve
     auto ret = DInputSinkState::GetInstance().GetTouchPadEventFragMgr()->GetAndClearEvents(dhId);
     EXPECT_EQ(0, ret.size());
 }
+
+HWTEST_F(DinputSinkStateTest, PushEvent_002, testing::ext::TestSize.Level1)
+{
+    TouchPadEventFragmentMgr mgr;
+    std::string dhId = "touchpad_dhid";
+    auto push = [&mgr, &dhId](uint32_t type, uint32_t code, int32_t value) {
+        return mgr.PushEvent(dhId, { 0, type, code, value, dhId, "/dev/input/event_touchpad" });
+    };
+    // a whole gesture seen on this device needs no reset.
+    push(EV_ABS, ABS_MT_TRACKING_ID, 1);
+    push(EV_KEY, BTN_TOUCH, KEY_DOWN_STATE);
+    push(EV_KEY, BTN_TOOL_FINGER, KEY_DOWN_STATE);
+    EXPECT_FALSE(push(EV_SYN, SYN_REPORT, 0).first);
+    push(EV_ABS, ABS_MT_TRACKING_ID, -1);
+    push(EV_KEY, BTN_TOUCH, KEY_UP_STATE);
+    push(EV_KEY, BTN_TOOL_FINGER, KEY_UP_STATE);
+    EXPECT_FALSE(push(EV_SYN, SYN_REPORT, 0).first);
+
+    // the gesture went down before the state was taken away, its end is sent back as a reset.
+    push(EV_ABS, ABS_MT_SLOT, 1);
+    push(EV_ABS, ABS_MT_TRACKING_ID, 2);
+    push(EV_KEY, BTN_TOUCH, KEY_DOWN_STATE);
+    push(EV_KEY, BTN_TOOL_DOUBLETAP, KEY_DOWN_STATE);
+    push(EV_SYN, SYN_REPORT, 0);
+    std::vector<RawEvent> stateEvents = mgr.GetAndClearEvents(dhId);
+    ASSERT_FALSE(stateEvents.empty());
+    EXPECT_EQ(static_cast<uint32_t>(EV_SYN), stateEvents.back().type);
+    EXPECT_TRUE(std::any_of(stateEvents.begin(), stateEvents.end(), [](const RawEvent &ev) {
+        return ev.type == EV_KEY && ev.code == BTN_TOOL_DOUBLETAP && ev.value == KEY_DOWN_STATE;
+    }));
+    EXPECT_TRUE(std::any_of(stateEvents.begin(), stateEvents.end(), [](const RawEvent &ev) {
+        return ev.type == EV_ABS && ev.code == ABS_MT_TRACKING_ID && ev.value == 2;
+    }));
+
+    push(EV_KEY, BTN_TOOL_DOUBLETAP, KEY_DOWN_STATE);
+    push(EV_SYN, SYN_REPORT, 0);
+    push(EV_KEY, BTN_TOUCH, KEY_UP_STATE);
+    push(EV_KEY, BTN_TOOL_DOUBLETAP, KEY_UP_STATE);
+    auto ret = push(EV_SYN, SYN_REPORT, 0);
+    EXPECT_TRUE(ret.first);
+    ASSERT_FALSE(ret.second.empty());
+    EXPECT_EQ("/dev/input/event_touchpad", ret.second.back().path);
+    EXPECT_TRUE(std::any_of(ret.second.begin(), ret.second.end(), [](const RawEvent &ev) {
+        return ev.type == EV_KEY && ev.code == BTN_TOOL_DOUBLETAP && ev.value == KEY_UP_STATE;
+    }));
+    EXPECT_TRUE(std::any_of(ret.second.begin(), ret.second.end(), [](const RawEvent &ev) {
+        return ev.type == EV_KEY && ev.code == BTN_TOUCH && ev.value == KEY_UP_STATE;
+    }));
+    EXPECT_TRUE(mgr.GetAndClearEvents(dhId).empty());
+}
+}
 }
 }
-}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_INPUT_TRANSPORT_BACKEND_H
+#define DISTRIBUTED_INPUT_TRANSPORT_BACKEND_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "dinput_errcode.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Receives the session events of a transport backend. The calls come from the backend's own threads.
+ */
+class DInputTransportBackendListener {
+public:
+    virtual ~DInputTransportBackendListener() = default;
+
+    /*
+     * A peer opened a session to the local server endpoint.
+     */
+    virtual void OnSessionOpened(int32_t sessionId, const std::string &peerNetworkId,
+        const std::string &peerSessionName) = 0;
+    /*
+     * The peer shut down the session, or the link broke.
+     */
+    virtual void OnSessionClosed(int32_t sessionId) = 0;
+    virtual void OnBytesReceived(int32_t sessionId, const void *data, uint32_t dataLen) = 0;
+};
+
+/*
+ * The byte channel DistributedInputTransportBase runs its sessions on. Sessions are message oriented,
+ * every SendBytes arrives as one OnBytesReceived on the peer, in order. Session ids are positive.
+ */
+class DInputTransportBackend {
+public:
+    virtual ~DInputTransportBackend() = default;
+
+    /*
+     * Create the local server endpoint and start delivering the session events to the listener.
+     */
+    virtual int32_t Init(std::shared_ptr<DInputTransportBackendListener> listener) = 0;
+    virtual void Release() = 0;
+    /*
+     * Open a session to the remote device, return the session id or a negative error code.
+     * The opening side is not notified by OnSessionOpened.
+     */
+    virtual int32_t Connect(const std::string &remoteDevId) = 0;
+    /*
+     * Open the data session carrying only the event batches to the remote device, the peer reports it by
+     * OnSessionOpened with a peer session name starting with DATA_SESSION_NAME. A backend or a peer without
+     * data sessions fails it, the event batches then share the session opened by Connect.
+     */
+    virtual int32_t ConnectData(const std::string &remoteDevId)
+    {
+        (void)remoteDevId;
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    virtual void Shutdown(int32_t sessionId) = 0;
+    virtual int32_t SendBytes(int32_t sessionId, const void *data, uint32_t dataLen) = 0;
+    virtual std::string GetLocalSessionName() = 0;
+};
+
+/*
+ * Link conditions injected by the loopback and unix socket test backends on the sending side.
+ */
+struct TransportLinkCondition {
+    // base one way delay of every message.
+    uint32_t latencyUs = 0;
+    // a uniformly distributed extra delay in [0, jitterUs], messages are never reordered.
+    uint32_t jitterUs = 0;
+    // the probability in [0, 1] that a message is silently dropped.
+    double lossRate = 0;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DISTRIBUTED_INPUT_TRANSPORT_BACKEND_H
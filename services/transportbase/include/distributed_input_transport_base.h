@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <list>
 #include <map>
 #include <mutex>
 #include <set>
@@ -28,6 +29,7 @@
 #include "constants.h"
 #include "event_handler.h"
 #include "nlohmann/json.hpp"
+#include "publisher_listener_stub.h"
 #include "securec.h"
 #include "single_instance.h"
 
@@ -38,18 +40,51 @@
 #include "dinput_source_manager_callback.h"
 #include "dinput_transbase_source_callback.h"
 #include "dinput_transbase_sink_callback.h"
+#include "distributed_input_transport_backend.h"
 #include "i_session_state_callback.h"
 
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+/*
+ * How long sessions outlive their prepare. Both are off by default, which closes a session on StopSession.
+ */
+struct SessionKeepPolicy {
+    // open the session to a recently used peer in the background when PrewarmSession is called.
+    bool prewarm = false;
+    // keep an unprepared or pre-warmed session idle for this long before it is shut down, 0 shuts it down at once.
+    int64_t idleGraceMs = 0;
+    // the number of recently used peers remembered for pre-warming.
+    size_t maxRecentPeers = 8;
+};
+
 class DistributedInputTransportBase {
     DECLARE_SINGLE_INSTANCE_BASE(DistributedInputTransportBase);
 public:
+    /*
+     * Replace the softbus backend, e.g. by the loopback or unix socket backend of the tests, which are not
+     * built into the SA.
+     * It must be called before Init.
+     */
+    void SetTransportBackend(std::shared_ptr<DInputTransportBackend> backend);
     int32_t Init();
     int32_t StartSession(const std::string &remoteDevId);
+    /*
+     * Release the session of a prepare. Within the idle grace period of the keep policy the socket stays open
+     * and the next StartSession to the peer reuses it.
+     */
     void StopSession(const std::string &remoteDevId);
     void StopAllSession();
+    /*
+     * The policy applies to the sessions opened by StartSession or PrewarmSession, the sessions opened by
+     * the peer are closed as before.
+     */
+    void SetSessionKeepPolicy(const SessionKeepPolicy &policy);
+    /*
+     * Open an idle session to the peer in the background if the policy allows pre-warming and the peer is
+     * one of the recently used ones, so the next prepare does not wait for the socket setup.
+     */
+    void PrewarmSession(const std::string &remoteDevId);
 
     void RegisterSrcHandleSessionCallback(std::shared_ptr<DInputTransbaseSourceCallback> callback);
     void RegisterSinkHandleSessionCallback(std::shared_ptr<DInputTransbaseSinkCallback> callback);
@@ -66,30 +101,81 @@ public:
     void EraseSessionId(const std::string &remoteDevId);
     int32_t GetSessionIdByDevId(const std::string &srcId);
     std::string GetDevIdBySessionId(int32_t sessionId);
+    /*
+     * The session the event batches to the peer of the session go on, the session itself if the peer has no
+     * data session.
+     */
+    int32_t GetDataSessionId(int32_t sessionId);
     int32_t SendMsg(int32_t sessionId, std::string &message);
     bool OnNegotiate2(int32_t socket, PeerSocketInfo info, SocketAccessInfo *peerInfo, SocketAccessInfo *localInfo);
 private:
-    DistributedInputTransportBase() = default;
+    DistributedInputTransportBase();
     ~DistributedInputTransportBase();
     int32_t CheckDeviceSessionState(const std::string &remoteDevId);
     bool CheckRecivedData(const std::string &message);
     void HandleSession(int32_t sessionId, const std::string &message);
     void Release();
     void RunSessionStateCallback(const std::string &remoteDevId, const uint32_t sessionState);
+    bool ClaimIdleSession(const std::string &remoteDevId);
+    void OpenIdleSession(const std::string &remoteDevId);
+    void ShutdownIdleSession(const std::string &remoteDevId);
+    void CloseSessionLocked(const std::string &remoteDevId, int32_t sessionId);
+    void ScheduleIdleShutdownLocked(const std::string &remoteDevId);
+    void TouchRecentPeer(const std::string &remoteDevId);
+    void StopSessionInner(const std::string &remoteDevId, bool keepIdle);
+    /*
+     * Open the data session on dataHandler_, so a prepare does not wait for the second socket.
+     */
+    void ScheduleDataSession(const std::string &remoteDevId);
+    void ConnectDataSession(const std::string &remoteDevId);
+    void CloseDataSessionLocked(const std::string &remoteDevId);
+    void UpdateSessionActivity(int32_t sessionId, uint32_t cmdType);
+
+    /*
+     * A device going offline, e.g. because its trust is removed, drops the cached permissions of the device.
+     */
+    class TrustChangeListener : public PublisherListenerStub {
+    public:
+        TrustChangeListener() = default;
+        ~TrustChangeListener() = default;
+        void OnMessage(const DHTopic topic, const std::string &message) override;
+    };
 
-    int32_t CreateServerSocket();
-    int32_t CreateClientSocket(const std::string &remoteDevId);
+    class BackendListener : public DInputTransportBackendListener {
+    public:
+        void OnSessionOpened(int32_t sessionId, const std::string &peerNetworkId,
+            const std::string &peerSessionName) override;
+        void OnSessionClosed(int32_t sessionId) override;
+        void OnBytesReceived(int32_t sessionId, const void *data, uint32_t dataLen) override;
+    };
 
 private:
     std::atomic<bool> isSessSerCreateFlag_ = false;
-    std::atomic<int32_t> localServerSocket_;
     std::mutex sessSerOperMutex_;
+    std::shared_ptr<DInputTransportBackend> backend_;
     std::mutex operationMutex_;
     std::string remoteDeviceId_;
     std::map<std::string, int32_t> remoteDevSessionMap_;
     std::map<std::string, bool> channelStatusMap_;
-    std::string localSessionName_ = "";
+    // the sessions carrying only the event batches, keyed by the peer of the control session.
+    std::map<std::string, int32_t> dataSessionMap_;
+    // the peers that failed to open a data session and the steady time in ms of the failure, they get the
+    // event batches on the control session until DATA_SESSION_RETRY_MS passed or the control session closes.
+    std::map<std::string, int64_t> singleSessionPeers_;
     int32_t sessionId_ = 0;
+    SessionKeepPolicy keepPolicy_;
+    // the sessions kept open without a prepare, they are shut down by a named task on keepHandler_.
+    std::set<std::string> idleSessions_;
+    // the peers whose control session was opened by this side, only they follow the keep policy.
+    std::set<std::string> localSessions_;
+    // the control sessions opened by the peer that carry no prepare, they hold no low latency mode and are
+    // reported as opened only once the first prepare arrives.
+    std::set<std::string> inactiveSessions_;
+    // the most recently used peer first.
+    std::list<std::string> recentPeers_;
+    std::shared_ptr<AppExecFwk::EventHandler> keepHandler_;
+    std::shared_ptr<AppExecFwk::EventHandler> dataHandler_;
+    sptr<TrustChangeListener> trustChangeListener_ = nullptr;
 
     std::shared_ptr<DInputTransbaseSourceCallback> srcCallback_;
     std::shared_ptr<DInputTransbaseSinkCallback> sinkCallback_;
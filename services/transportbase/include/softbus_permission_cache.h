@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_INPUT_TRANSPORT_BASE_SOFTBUS_PERMISSION_CACHE_H
+#define DISTRIBUTED_INPUT_TRANSPORT_BASE_SOFTBUS_PERMISSION_CACHE_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "single_instance.h"
+
+#include "softbus_permission_check.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+enum class PermissionDirection : uint32_t {
+    // the local source opens a session to the sink.
+    SRC = 0,
+    // the local sink accepts a session from the source.
+    SINK = 1,
+};
+
+struct PermissionCacheKey {
+    PermissionDirection direction = PermissionDirection::SRC;
+    std::string networkId;
+    std::string accountId;
+    int32_t userId = INVALID_USER_ID;
+    uint64_t tokenId = 0;
+
+    bool operator<(const PermissionCacheKey &other) const
+    {
+        return std::tie(direction, networkId, accountId, userId, tokenId) <
+            std::tie(other.direction, other.networkId, other.accountId, other.userId, other.tokenId);
+    }
+};
+
+/*
+ * Remembers the local account info and the granted session permissions for a bounded time, so a reconnect
+ * to the same peer skips the account, device manager and access token queries. Denials are not cached.
+ * The entries are dropped when the account, login or trust state changes.
+ * Every drop starts a new epoch. A check takes the epoch before its unlocked queries and the cache refuses
+ * to store their result if the epoch moved meanwhile, so a stale decision can not outlive the drop.
+ */
+class SoftBusPermissionCache {
+DECLARE_SINGLE_INSTANCE_BASE(SoftBusPermissionCache);
+public:
+    /*
+     * 0 disables the cache.
+     */
+    void SetTtl(int64_t ttlMs);
+    uint64_t GetEpoch();
+    bool GetLocalAccountInfo(AccountInfo &localAccountInfo);
+    void PutLocalAccountInfo(const AccountInfo &localAccountInfo, uint64_t epoch);
+    bool IsGranted(const PermissionCacheKey &key);
+    void Grant(const PermissionCacheKey &key, uint64_t epoch);
+    /*
+     * Drop the decisions about one peer.
+     */
+    void InvalidatePeer(const std::string &networkId);
+    /*
+     * Drop everything, including the local account info.
+     */
+    void InvalidateAll();
+    size_t GetGrantNum();
+
+private:
+    SoftBusPermissionCache() = default;
+    ~SoftBusPermissionCache() = default;
+    void EvictExpiredLocked(std::chrono::steady_clock::time_point now);
+
+    std::mutex cacheMutex_;
+    std::chrono::milliseconds ttl_ = std::chrono::milliseconds(60 * 1000);
+    uint64_t epoch_ = 0;
+    bool hasLocalAccountInfo_ = false;
+    AccountInfo localAccountInfo_;
+    std::chrono::steady_clock::time_point localAccountInfoExpiry_;
+    // the value is the expiry of the grant.
+    std::map<PermissionCacheKey, std::chrono::steady_clock::time_point> grants_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DISTRIBUTED_INPUT_TRANSPORT_BASE_SOFTBUS_PERMISSION_CACHE_H
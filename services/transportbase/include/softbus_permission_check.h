@@ -41,6 +41,20 @@ public:
         AccountInfo &callerAccountInfo, const std::string &networkId);
     static bool FillLocalInfo(SocketAccessInfo *localInfo);
     static bool SetAccessInfoToSocket(const int32_t sessionId);
+    /*
+     * Drop the cached permission decisions when the os account switches or the distributed account logs
+     * in or out, it is called once per process.
+     * Returns false if any of the events is not subscribed.
+     */
+    static bool SubscribeAccountEvents();
+    /*
+     * Stop caching the permission decisions, e.g. when the account events that invalidate them are missed.
+     */
+    static void DisablePermissionCache();
+    /*
+     * Drop the cached permission decisions about the peer, or all of them if networkId is empty.
+     */
+    static void InvalidateCachedPermission(const std::string &networkId);
 private:
     static bool CheckSrcIsSameAccount(const std::string &sinkNetworkId, const AccountInfo &localAccountInfo);
     static bool CheckSinkIsSameAccount(const AccountInfo &callerAccountInfo, const AccountInfo &calleeAccountInfo);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOFTBUS_TRANSPORT_BACKEND_H
+#define SOFTBUS_TRANSPORT_BACKEND_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "socket.h"
+
+#include "distributed_input_transport_backend.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * The production backend, sessions are dsoftbus sockets. Softbus calls back without a user context,
+ * so only one instance may be initialized at a time.
+ */
+class SoftbusTransportBackend : public DInputTransportBackend {
+public:
+    int32_t Init(std::shared_ptr<DInputTransportBackendListener> listener) override;
+    void Release() override;
+    int32_t Connect(const std::string &remoteDevId) override;
+    int32_t ConnectData(const std::string &remoteDevId) override;
+    void Shutdown(int32_t sessionId) override;
+    int32_t SendBytes(int32_t sessionId, const void *data, uint32_t dataLen) override;
+    std::string GetLocalSessionName() override;
+
+private:
+    int32_t CreateServerSocket();
+    int32_t CreateDataServerSocket();
+    int32_t CreateClientSocket(const std::string &localName, const std::string &peerName,
+        const std::string &remoteDevId);
+    int32_t BindClientSocket(const std::string &localName, const std::string &peerName,
+        const std::string &remoteDevId, const QosTV *qos, uint32_t qosCount);
+
+    std::mutex socketMutex_;
+    std::atomic<int32_t> localServerSocket_ = -1;
+    // the server of the data sessions, -1 if it could not be created, the peers then fall back to one session.
+    std::atomic<int32_t> localDataServerSocket_ = -1;
+    std::string localDataSessionName_ = "";
+    std::string localSessionName_ = "";
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // SOFTBUS_TRANSPORT_BACKEND_H
@@ -16,6 +16,8 @@
 #include "distributed_input_transport_base.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cstring>
 
 #include "distributed_hardware_fwk_kit.h"
@@ -34,6 +36,7 @@
 
 #include "softbus_common.h"
 #include "softbus_permission_check.h"
+#include "softbus_transport_backend.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -41,12 +44,17 @@ namespace DistributedInput {
 namespace {
 const int32_t SESSION_STATUS_OPENED = 0;
 const int32_t SESSION_STATUS_CLOSED = 1;
-static QosTV g_qosInfo[] = {
-    { .qos = QOS_TYPE_MIN_BW, .value = 80 * 1024 * 1024},
-    { .qos = QOS_TYPE_MAX_LATENCY, .value = 8000 },
-    { .qos = QOS_TYPE_MIN_LATENCY, .value = 2000 }
-};
-static uint32_t g_QosTV_Param_Index = static_cast<uint32_t>(sizeof(g_qosInfo) / sizeof(g_qosInfo[0]));
+const std::string PREWARM_TASK_PREFIX = "dinput_session_prewarm_";
+const std::string IDLE_TASK_PREFIX = "dinput_session_idle_";
+const std::string DATA_SESSION_TASK_PREFIX = "dinput_data_session_";
+// a peer that failed to open a data session is asked again after this long.
+constexpr int64_t DATA_SESSION_RETRY_MS = 30 * 1000;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 }
 IMPLEMENT_SINGLE_INSTANCE(DistributedInputTransportBase);
 DistributedInputTransportBase::~DistributedInputTransportBase()
@@ -55,69 +63,53 @@ DistributedInputTransportBase::~DistributedInputTransportBase()
     Release();
 }
 
-void OnBind(int32_t socket, PeerSocketInfo info)
+DistributedInputTransportBase::DistributedInputTransportBase()
+    : backend_(std::make_shared<SoftbusTransportBackend>())
 {
-    DistributedInput::DistributedInputTransportBase::GetInstance().OnSessionOpened(socket, info);
 }
 
-void OnShutdown(int32_t socket, ShutdownReason reason)
+void DistributedInputTransportBase::SetTransportBackend(std::shared_ptr<DInputTransportBackend> backend)
 {
-    DistributedInput::DistributedInputTransportBase::GetInstance().OnSessionClosed(socket, reason);
-}
-
-void OnBytes(int32_t socket, const void *data, uint32_t dataLen)
-{
-    DistributedInput::DistributedInputTransportBase::GetInstance().OnBytesReceived(socket, data, dataLen);
+    std::unique_lock<std::mutex> sessionServerLock(sessSerOperMutex_);
+    if (backend == nullptr || isSessSerCreateFlag_.load()) {
+        DHLOGE("SetTransportBackend failed, backend is null or the session server is running.");
+        return;
+    }
+    backend_ = backend;
 }
 
-void OnMessage(int32_t socket, const void *data, uint32_t dataLen)
+void DistributedInputTransportBase::BackendListener::OnSessionOpened(int32_t sessionId,
+    const std::string &peerNetworkId, const std::string &peerSessionName)
 {
-    (void)socket;
-    (void)data;
-    (void)dataLen;
-    DHLOGI("socket: %{public}d, dataLen:%{public}d", socket, dataLen);
+    PeerSocketInfo info = {
+        .name = const_cast<char*>(peerSessionName.c_str()),
+        .networkId = const_cast<char*>(peerNetworkId.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    DistributedInputTransportBase::GetInstance().OnSessionOpened(sessionId, info);
 }
 
-void OnStream(int32_t socket, const StreamData *data, const StreamData *ext,
-    const StreamFrameInfo *param)
+void DistributedInputTransportBase::BackendListener::OnSessionClosed(int32_t sessionId)
 {
-    (void)socket;
-    (void)data;
-    (void)ext;
-    (void)param;
-    DHLOGI("socket: %{public}d", socket);
+    DistributedInputTransportBase::GetInstance().OnSessionClosed(sessionId, SHUTDOWN_REASON_PEER);
 }
 
-void OnFile(int32_t socket, FileEvent *event)
+void DistributedInputTransportBase::BackendListener::OnBytesReceived(int32_t sessionId, const void *data,
+    uint32_t dataLen)
 {
-    (void)event;
-    DHLOGI("socket: %{public}d", socket);
+    DistributedInputTransportBase::GetInstance().OnBytesReceived(sessionId, data, dataLen);
 }
 
-void OnQos(int32_t socket, QoSEvent eventId, const QosTV *qos, uint32_t qosCount)
+void DistributedInputTransportBase::TrustChangeListener::OnMessage(const DHTopic topic, const std::string &message)
 {
-    DHLOGI("OnQos, socket: %{public}d, QoSEvent: %{public}d, qosCount: %{public}u", socket, (int32_t)eventId, qosCount);
-    for (uint32_t idx = 0; idx < qosCount; idx++) {
-        DHLOGI("QosTV: type: %{public}d, value: %{public}d", (int32_t)qos[idx].qos, qos[idx].value);
+    if (topic != DHTopic::TOPIC_DEV_OFFLINE) {
+        DHLOGE("this topic is wrong, %{public}u", static_cast<uint32_t>(topic));
+        return;
     }
+    SoftBusPermissionCheck::InvalidateCachedPermission(message);
 }
 
-static bool OnNegotiate2(int32_t socket, PeerSocketInfo info, SocketAccessInfo *peerInfo, SocketAccessInfo *localInfo)
-{
-    return DistributedInputTransportBase::GetInstance().OnNegotiate2(socket, info, peerInfo, localInfo);
-}
-
-ISocketListener iSocketListener = {
-    .OnBind = OnBind,
-    .OnShutdown = OnShutdown,
-    .OnBytes = OnBytes,
-    .OnMessage = OnMessage,
-    .OnStream = OnStream,
-    .OnFile = OnFile,
-    .OnQos = OnQos,
-    .OnNegotiate2 = OnNegotiate2
-};
-
 int32_t DistributedInputTransportBase::Init()
 {
     DHLOGI("Init Transport Base Session");
@@ -126,54 +118,46 @@ int32_t DistributedInputTransportBase::Init()
         DHLOGI("SessionServer already create success.");
         return DH_SUCCESS;
     }
-    int32_t socket = CreateServerSocket();
-    if (socket < DH_SUCCESS) {
-        DHLOGE("CreateServerSocket failed, ret: %{public}d", socket);
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
-    }
-
-    int32_t ret = Listen(socket, g_qosInfo, g_QosTV_Param_Index, &iSocketListener);
+    int32_t ret = backend_->Init(std::make_shared<BackendListener>());
     if (ret != DH_SUCCESS) {
-        DHLOGE("Socket Listen failed, error code %{public}d.", ret);
+        DHLOGE("Transport backend init failed, ret: %{public}d", ret);
         return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
     }
     isSessSerCreateFlag_.store(true);
-    localServerSocket_ = socket;
-    DHLOGI("Finish Init DSoftBus Server Socket, socket: %{public}d", socket);
-    return DH_SUCCESS;
-}
 
-int32_t DistributedInputTransportBase::CreateServerSocket()
-{
-    DHLOGI("CreateServerSocket start");
-    auto localNode = std::make_unique<NodeBasicInfo>();
-    int32_t retCode = GetLocalNodeDeviceInfo(DINPUT_PKG_NAME.c_str(), localNode.get());
-    if (retCode != DH_SUCCESS) {
-        DHLOGE("Init Could not get local device id.");
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    if (!SoftBusPermissionCheck::SubscribeAccountEvents()) {
+        // a missed account switch would leave the cached grants of the old account valid.
+        DHLOGE("Subscribe account events failed, the permission cache is disabled.");
+        SoftBusPermissionCheck::DisablePermissionCache();
     }
-    std::string networkId = localNode->networkId;
-    localSessionName_ = SESSION_NAME + networkId.substr(0, INTERCEPT_STRING_LENGTH);
-    DHLOGI("CreateServerSocket local networkId is %{public}s, local socketName: %{public}s",
-        GetAnonyString(networkId).c_str(), localSessionName_.c_str());
-    SocketInfo info = {
-        .name = const_cast<char*>(localSessionName_.c_str()),
-        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
-        .dataType = DATA_TYPE_BYTES
-    };
-    int32_t socket = Socket(info);
-    DHLOGI("CreateServerSocket Finish, socket: %{public}d", socket);
-    return socket;
+    std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
+    if (dhFwkKit != nullptr && trustChangeListener_ == nullptr) {
+        trustChangeListener_ = new(std::nothrow) TrustChangeListener();
+        dhFwkKit->RegisterPublisherListener(DHTopic::TOPIC_DEV_OFFLINE, trustChangeListener_);
+    }
+    DHLOGI("Finish Init Transport Base Session");
+    return DH_SUCCESS;
 }
 
 void DistributedInputTransportBase::Release()
 {
     std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    if (keepHandler_ != nullptr) {
+        keepHandler_->RemoveAllEvents();
+    }
+    if (dataHandler_ != nullptr) {
+        dataHandler_->RemoveAllEvents();
+    }
     auto iter = remoteDevSessionMap_.begin();
     for (; iter != remoteDevSessionMap_.end(); ++iter) {
         DHLOGI("Shutdown client socket: %{public}d to remote dev: %{public}s", iter->second,
             GetAnonyString(iter->first).c_str());
-        Shutdown(iter->second);
+        backend_->Shutdown(iter->second);
+    }
+    for (const auto &[devId, dataSessionId] : dataSessionMap_) {
+        DHLOGI("Shutdown data socket: %{public}d to remote dev: %{public}s", dataSessionId,
+            GetAnonyString(devId).c_str());
+        backend_->Shutdown(dataSessionId);
     }
 
     {
@@ -181,14 +165,24 @@ void DistributedInputTransportBase::Release()
         if (!isSessSerCreateFlag_.load()) {
             DHLOGI("DSoftBus Server Socket already remove success.");
         } else {
-            DHLOGI("Shutdown DSoftBus Server Socket, socket: %{public}d", localServerSocket_.load());
-            Shutdown(localServerSocket_.load());
-            localServerSocket_ = -1;
+            backend_->Release();
             isSessSerCreateFlag_.store(false);
         }
     }
     remoteDevSessionMap_.clear();
     channelStatusMap_.clear();
+    dataSessionMap_.clear();
+    singleSessionPeers_.clear();
+    idleSessions_.clear();
+    localSessions_.clear();
+    inactiveSessions_.clear();
+
+    std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
+    if (dhFwkKit != nullptr && trustChangeListener_ != nullptr) {
+        DHLOGI("UnPublish TrustChangeListener");
+        dhFwkKit->UnregisterPublisherListener(DHTopic::TOPIC_DEV_OFFLINE, trustChangeListener_);
+    }
+    trustChangeListener_ = nullptr;
 }
 
 int32_t DistributedInputTransportBase::CheckDeviceSessionState(const std::string &remoteDevId)
@@ -209,65 +203,54 @@ std::string DistributedInputTransportBase::GetDevIdBySessionId(int32_t sessionId
             return iter->first;
         }
     }
+    for (const auto &[devId, dataSessionId] : dataSessionMap_) {
+        if (dataSessionId == sessionId) {
+            return devId;
+        }
+    }
     return "";
 }
 
-int32_t DistributedInputTransportBase::CreateClientSocket(const std::string &remoteDevId)
+int32_t DistributedInputTransportBase::GetDataSessionId(int32_t sessionId)
 {
-    DHLOGI("CreateClientSocket start, peerNetworkId: %{public}s", GetAnonyString(remoteDevId).c_str());
-    std::string localSesionName = localSessionName_ + "_" + std::to_string(GetCurrentTimeUs());
-    std::string peerSessionName = SESSION_NAME + remoteDevId.substr(0, INTERCEPT_STRING_LENGTH);
-    SocketInfo info = {
-        .name = const_cast<char*>(localSesionName.c_str()),
-        .peerName = const_cast<char*>(peerSessionName.c_str()),
-        .peerNetworkId = const_cast<char*>(remoteDevId.c_str()),
-        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
-        .dataType = DATA_TYPE_BYTES
-    };
-    int32_t socket = Socket(info);
-    DHLOGI("Bind Socket server, socket: %{public}d, localSessionName: %{public}s, peerSessionName: %{public}s",
-        socket, localSesionName.c_str(), peerSessionName.c_str());
-    return socket;
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    for (const auto &[devId, controlSessionId] : remoteDevSessionMap_) {
+        if (controlSessionId != sessionId) {
+            continue;
+        }
+        auto iter = dataSessionMap_.find(devId);
+        return iter == dataSessionMap_.end() ? sessionId : iter->second;
+    }
+    return sessionId;
 }
 
 int32_t DistributedInputTransportBase::StartSession(const std::string &remoteDevId)
 {
+    TouchRecentPeer(remoteDevId);
+    if (ClaimIdleSession(remoteDevId)) {
+        return DH_SUCCESS;
+    }
     int32_t ret = CheckDeviceSessionState(remoteDevId);
     if (ret == DH_SUCCESS) {
         DHLOGE("Softbus session has already opened, deviceId: %{public}s", GetAnonyString(remoteDevId).c_str());
         return DH_SUCCESS;
     }
-    if (!SoftBusPermissionCheck::CheckSrcPermission(remoteDevId)) {
-        DHLOGE("Permission denied");
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_PERMISSION_DENIED;
-    }
-
-    int socket = CreateClientSocket(remoteDevId);
+    int32_t socket = backend_->Connect(remoteDevId);
     if (socket < DH_SUCCESS) {
         DHLOGE("StartSession failed, ret: %{public}d", socket);
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
-    }
-    if (!SoftBusPermissionCheck::SetAccessInfoToSocket(socket)) {
-        DHLOGW("Fill and set accessInfo failed");
-        Shutdown(socket);
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_CONTEXT;
-    }
-    StartAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
-    ret = Bind(socket, g_qosInfo, g_QosTV_Param_Index, &iSocketListener);
-    if (ret < DH_SUCCESS) {
-        DHLOGE("OpenSession fail, remoteDevId: %{public}s, socket: %{public}d", GetAnonyString(remoteDevId).c_str(),
-            socket);
-        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
-        Shutdown(socket);
-        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+        return socket;
     }
 
     std::string peerSessionName = SESSION_NAME + remoteDevId.substr(0, INTERCEPT_STRING_LENGTH);
-    HiDumper::GetInstance().CreateSessionInfo(remoteDevId, socket, localSessionName_, peerSessionName,
+    HiDumper::GetInstance().CreateSessionInfo(remoteDevId, socket, backend_->GetLocalSessionName(), peerSessionName,
         SessionStatus::OPENED);
     DHLOGI("OpenSession success, remoteDevId:%{public}s, sessionId: %{public}d", GetAnonyString(remoteDevId).c_str(),
         socket);
     sessionId_ = socket;
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        localSessions_.insert(remoteDevId);
+    }
 
     std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
     if (dhFwkKit != nullptr) {
@@ -282,9 +265,70 @@ int32_t DistributedInputTransportBase::StartSession(const std::string &remoteDev
         .dataType = DATA_TYPE_BYTES
     };
     OnSessionOpened(socket, peerSocketInfo);
+    ScheduleDataSession(remoteDevId);
     return DH_SUCCESS;
 }
 
+void DistributedInputTransportBase::ScheduleDataSession(const std::string &remoteDevId)
+{
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    if (dataHandler_ == nullptr) {
+        std::shared_ptr<AppExecFwk::EventRunner> runner = AppExecFwk::EventRunner::Create(true);
+        dataHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    std::string taskName = DATA_SESSION_TASK_PREFIX + remoteDevId;
+    dataHandler_->RemoveTask(taskName);
+    dataHandler_->PostTask([this, remoteDevId]() { ConnectDataSession(remoteDevId); }, taskName, 0);
+}
+
+void DistributedInputTransportBase::ConnectDataSession(const std::string &remoteDevId)
+{
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        if (dataSessionMap_.count(remoteDevId) > 0 || remoteDevSessionMap_.count(remoteDevId) == 0) {
+            return;
+        }
+        auto iter = singleSessionPeers_.find(remoteDevId);
+        if (iter != singleSessionPeers_.end()) {
+            if (GetSteadyTimeMs() - iter->second < DATA_SESSION_RETRY_MS) {
+                return;
+            }
+            singleSessionPeers_.erase(iter);
+        }
+    }
+    int32_t socket = backend_->ConnectData(remoteDevId);
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    if (socket < DH_SUCCESS) {
+        DHLOGW("Open data session failed, remoteDevId: %{public}s, ret: %{public}d, events share the control "
+            "session", GetAnonyString(remoteDevId).c_str(), socket);
+        singleSessionPeers_[remoteDevId] = GetSteadyTimeMs();
+        return;
+    }
+    if (remoteDevSessionMap_.count(remoteDevId) == 0 || dataSessionMap_.count(remoteDevId) > 0) {
+        // the control session was closed or another data session opened meanwhile.
+        backend_->Shutdown(socket);
+        return;
+    }
+    DHLOGI("Open data session success, remoteDevId: %{public}s, dataSessionId: %{public}d",
+        GetAnonyString(remoteDevId).c_str(), socket);
+    dataSessionMap_[remoteDevId] = socket;
+}
+
+void DistributedInputTransportBase::CloseDataSessionLocked(const std::string &remoteDevId)
+{
+    // the next control session to the peer tries a data session again.
+    singleSessionPeers_.erase(remoteDevId);
+    if (dataHandler_ != nullptr) {
+        dataHandler_->RemoveTask(DATA_SESSION_TASK_PREFIX + remoteDevId);
+    }
+    auto iter = dataSessionMap_.find(remoteDevId);
+    if (iter == dataSessionMap_.end()) {
+        return;
+    }
+    backend_->Shutdown(iter->second);
+    dataSessionMap_.erase(iter);
+}
+
 int32_t DistributedInputTransportBase::GetCurrentSessionId()
 {
     return sessionId_;
@@ -303,11 +347,16 @@ void DistributedInputTransportBase::StopAllSession()
 
     std::for_each(remoteDevSessions.begin(), remoteDevSessions.end(),
         [this](const std::pair<std::string, int32_t> &pair) {
-        StopSession(pair.first);
+        StopSessionInner(pair.first, false);
     });
 }
 
 void DistributedInputTransportBase::StopSession(const std::string &remoteDevId)
+{
+    StopSessionInner(remoteDevId, true);
+}
+
+void DistributedInputTransportBase::StopSessionInner(const std::string &remoteDevId, bool keepIdle)
 {
     std::unique_lock<std::mutex> sessionLock(operationMutex_);
     if (remoteDevSessionMap_.count(remoteDevId) == 0) {
@@ -315,23 +364,180 @@ void DistributedInputTransportBase::StopSession(const std::string &remoteDevId)
         return;
     }
     int32_t sessionId = remoteDevSessionMap_[remoteDevId];
-
-    DHLOGI("RemoteDevId: %{public}s, sessionId: %{public}d", GetAnonyString(remoteDevId).c_str(), sessionId);
-    HiDumper::GetInstance().SetSessionStatus(remoteDevId, SessionStatus::CLOSING);
-    Shutdown(sessionId);
-    remoteDevSessionMap_.erase(remoteDevId);
-    channelStatusMap_.erase(remoteDevId);
+    bool wasIdle = idleSessions_.count(remoteDevId) > 0;
+    if (keepIdle && wasIdle) {
+        DHLOGI("Session of remoteDevId: %{public}s is already idle", GetAnonyString(remoteDevId).c_str());
+        return;
+    }
 
     std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
-    if (dhFwkKit != nullptr) {
+    // the keep policy is the one of the source, a session opened by the peer is closed at once.
+    bool isLocal = localSessions_.count(remoteDevId) > 0;
+    if (keepIdle && isLocal && keepPolicy_.idleGraceMs > 0 && keepHandler_ != nullptr) {
+        DHLOGI("Keep session idle, remoteDevId: %{public}s, sessionId: %{public}d, grace: %{public}" PRId64 "ms",
+            GetAnonyString(remoteDevId).c_str(), sessionId, keepPolicy_.idleGraceMs);
+        idleSessions_.insert(remoteDevId);
+        HiDumper::GetInstance().SetSessionStatus(remoteDevId, SessionStatus::IDLE);
+        ScheduleIdleShutdownLocked(remoteDevId);
+        if (dhFwkKit != nullptr) {
+            DHLOGD("Disable low Latency!");
+            dhFwkKit->PublishMessage(DHTopic::TOPIC_LOW_LATENCY, DISABLE_LOW_LATENCY.dump());
+        }
+        return;
+    }
+
+    DHLOGI("RemoteDevId: %{public}s, sessionId: %{public}d", GetAnonyString(remoteDevId).c_str(), sessionId);
+    CloseSessionLocked(remoteDevId, sessionId);
+    // an idle session has already given up the low latency mode.
+    if (!wasIdle && dhFwkKit != nullptr) {
         DHLOGD("Disable low Latency!");
         dhFwkKit->PublishMessage(DHTopic::TOPIC_LOW_LATENCY, DISABLE_LOW_LATENCY.dump());
     }
+}
 
+void DistributedInputTransportBase::CloseSessionLocked(const std::string &remoteDevId, int32_t sessionId)
+{
+    if (idleSessions_.erase(remoteDevId) > 0 && keepHandler_ != nullptr) {
+        keepHandler_->RemoveTask(IDLE_TASK_PREFIX + remoteDevId);
+    }
+    HiDumper::GetInstance().SetSessionStatus(remoteDevId, SessionStatus::CLOSING);
+    CloseDataSessionLocked(remoteDevId);
+    backend_->Shutdown(sessionId);
+    remoteDevSessionMap_.erase(remoteDevId);
+    channelStatusMap_.erase(remoteDevId);
+    localSessions_.erase(remoteDevId);
+    inactiveSessions_.erase(remoteDevId);
     HiDumper::GetInstance().SetSessionStatus(remoteDevId, SessionStatus::CLOSED);
     HiDumper::GetInstance().DeleteSessionInfo(remoteDevId);
 }
 
+void DistributedInputTransportBase::SetSessionKeepPolicy(const SessionKeepPolicy &policy)
+{
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    DHLOGI("SetSessionKeepPolicy, prewarm: %{public}d, idleGraceMs: %{public}" PRId64 ", maxRecentPeers: "
+        "%{public}zu", policy.prewarm, policy.idleGraceMs, policy.maxRecentPeers);
+    keepPolicy_ = policy;
+    if (keepHandler_ == nullptr && (policy.prewarm || policy.idleGraceMs > 0)) {
+        std::shared_ptr<AppExecFwk::EventRunner> runner = AppExecFwk::EventRunner::Create(true);
+        keepHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    while (recentPeers_.size() > keepPolicy_.maxRecentPeers) {
+        recentPeers_.pop_back();
+    }
+}
+
+void DistributedInputTransportBase::TouchRecentPeer(const std::string &remoteDevId)
+{
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    recentPeers_.remove(remoteDevId);
+    if (keepPolicy_.maxRecentPeers == 0) {
+        return;
+    }
+    recentPeers_.push_front(remoteDevId);
+    if (recentPeers_.size() > keepPolicy_.maxRecentPeers) {
+        recentPeers_.pop_back();
+    }
+}
+
+void DistributedInputTransportBase::PrewarmSession(const std::string &remoteDevId)
+{
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    if (!keepPolicy_.prewarm || keepPolicy_.idleGraceMs <= 0 || keepHandler_ == nullptr) {
+        return;
+    }
+    if (std::find(recentPeers_.begin(), recentPeers_.end(), remoteDevId) == recentPeers_.end()) {
+        DHLOGD("Skip prewarm, remoteDevId: %{public}s is not a recent peer", GetAnonyString(remoteDevId).c_str());
+        return;
+    }
+    if (remoteDevSessionMap_.count(remoteDevId) > 0) {
+        return;
+    }
+    std::string taskName = PREWARM_TASK_PREFIX + remoteDevId;
+    keepHandler_->RemoveTask(taskName);
+    keepHandler_->PostTask([this, remoteDevId]() { OpenIdleSession(remoteDevId); }, taskName, 0);
+}
+
+void DistributedInputTransportBase::OpenIdleSession(const std::string &remoteDevId)
+{
+    if (CheckDeviceSessionState(remoteDevId) == DH_SUCCESS) {
+        return;
+    }
+    int32_t socket = backend_->Connect(remoteDevId);
+    if (socket < DH_SUCCESS) {
+        DHLOGE("Prewarm session failed, remoteDevId: %{public}s, ret: %{public}d",
+            GetAnonyString(remoteDevId).c_str(), socket);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        if (remoteDevSessionMap_.count(remoteDevId) > 0) {
+            // a prepare opened its own session meanwhile.
+            backend_->Shutdown(socket);
+            return;
+        }
+        std::string peerSessionName = SESSION_NAME + remoteDevId.substr(0, INTERCEPT_STRING_LENGTH);
+        HiDumper::GetInstance().CreateSessionInfo(remoteDevId, socket, backend_->GetLocalSessionName(),
+            peerSessionName, SessionStatus::IDLE);
+        DHLOGI("Prewarm session success, remoteDevId: %{public}s, sessionId: %{public}d",
+            GetAnonyString(remoteDevId).c_str(), socket);
+        remoteDevSessionMap_[remoteDevId] = socket;
+        channelStatusMap_[remoteDevId] = true;
+        localSessions_.insert(remoteDevId);
+        idleSessions_.insert(remoteDevId);
+        ScheduleIdleShutdownLocked(remoteDevId);
+    }
+    ScheduleDataSession(remoteDevId);
+}
+
+void DistributedInputTransportBase::ScheduleIdleShutdownLocked(const std::string &remoteDevId)
+{
+    std::string taskName = IDLE_TASK_PREFIX + remoteDevId;
+    keepHandler_->RemoveTask(taskName);
+    keepHandler_->PostTask([this, remoteDevId]() { ShutdownIdleSession(remoteDevId); }, taskName,
+        keepPolicy_.idleGraceMs);
+}
+
+bool DistributedInputTransportBase::ClaimIdleSession(const std::string &remoteDevId)
+{
+    int32_t sessionId = 0;
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        if (idleSessions_.erase(remoteDevId) == 0) {
+            return false;
+        }
+        if (keepHandler_ != nullptr) {
+            keepHandler_->RemoveTask(IDLE_TASK_PREFIX + remoteDevId);
+        }
+        sessionId = remoteDevSessionMap_[remoteDevId];
+    }
+    DHLOGI("Reuse idle session, remoteDevId: %{public}s, sessionId: %{public}d", GetAnonyString(remoteDevId).c_str(),
+        sessionId);
+    HiDumper::GetInstance().SetSessionStatus(remoteDevId, SessionStatus::OPENED);
+    sessionId_ = sessionId;
+    std::string peerSessionName = SESSION_NAME + remoteDevId.substr(0, INTERCEPT_STRING_LENGTH);
+    PeerSocketInfo peerSocketInfo = {
+        .name = const_cast<char*>(peerSessionName.c_str()),
+        .networkId = const_cast<char*>(remoteDevId.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    OnSessionOpened(sessionId, peerSocketInfo);
+    return true;
+}
+
+void DistributedInputTransportBase::ShutdownIdleSession(const std::string &remoteDevId)
+{
+    std::unique_lock<std::mutex> sessionLock(operationMutex_);
+    // the session was claimed by a prepare or closed by the peer in the meantime.
+    if (idleSessions_.count(remoteDevId) == 0 || remoteDevSessionMap_.count(remoteDevId) == 0) {
+        return;
+    }
+    int32_t sessionId = remoteDevSessionMap_[remoteDevId];
+    DHLOGI("Idle session expired, remoteDevId: %{public}s, sessionId: %{public}d",
+        GetAnonyString(remoteDevId).c_str(), sessionId);
+    CloseSessionLocked(remoteDevId, sessionId);
+}
+
 void DistributedInputTransportBase::RegisterSrcHandleSessionCallback(
     std::shared_ptr<DInputTransbaseSourceCallback> callback)
 {
@@ -401,10 +607,44 @@ int32_t DistributedInputTransportBase::OnSessionOpened(int32_t sessionId, const
         "peerPkgName: %{public}s", sessionId, info.name, GetAnonyString(peerDevId).c_str(), info.pkgName);
     FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
 
+    std::string peerSessionName = info.name == nullptr ? "" : info.name;
+    if (peerSessionName.compare(0, DATA_SESSION_NAME.size(), DATA_SESSION_NAME) == 0) {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        // the data session rides on a control session, it is of no use to a peer without one.
+        if (remoteDevSessionMap_.count(peerDevId) == 0) {
+            DHLOGE("Data session without control session, peerNetworkId: %{public}s",
+                GetAnonyString(peerDevId).c_str());
+            backend_->Shutdown(sessionId);
+            return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_DEVICE_SESSION_STATE;
+        }
+        auto iter = dataSessionMap_.find(peerDevId);
+        if (iter != dataSessionMap_.end() && iter->second != sessionId) {
+            backend_->Shutdown(iter->second);
+        }
+        dataSessionMap_[peerDevId] = sessionId;
+        DHLOGI("Data session opened, peerNetworkId: %{public}s", GetAnonyString(peerDevId).c_str());
+        return DH_SUCCESS;
+    }
+
     {
         std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        // a pre-warmed session raced with the one opened by a prepare, keep the latter.
+        if (idleSessions_.erase(peerDevId) > 0) {
+            if (keepHandler_ != nullptr) {
+                keepHandler_->RemoveTask(IDLE_TASK_PREFIX + peerDevId);
+            }
+            if (remoteDevSessionMap_[peerDevId] != sessionId) {
+                backend_->Shutdown(remoteDevSessionMap_[peerDevId]);
+            }
+        }
         remoteDevSessionMap_[peerDevId] = sessionId;
         channelStatusMap_[peerDevId] = true;
+        // a session opened by the peer may be a pre-warmed one, it goes active with its first prepare.
+        if (localSessions_.count(peerDevId) == 0) {
+            inactiveSessions_.insert(peerDevId);
+            DHLOGI("OnSessionOpened finish, inactive until the first prepare");
+            return DH_SUCCESS;
+        }
     }
     RunSessionStateCallback(peerDevId, SESSION_STATUS_OPENED);
     std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
@@ -419,17 +659,40 @@ int32_t DistributedInputTransportBase::OnSessionOpened(int32_t sessionId, const
 void DistributedInputTransportBase::OnSessionClosed(int32_t sessionId, ShutdownReason reason)
 {
     DHLOGI("OnSessionClosed, socket: %{public}d, reason: %{public}d", sessionId, (int32_t)reason);
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        for (auto iter = dataSessionMap_.begin(); iter != dataSessionMap_.end(); ++iter) {
+            if (iter->second == sessionId) {
+                // the control session goes on, the event batches fall back to it.
+                DHLOGW("Data session closed, peer deviceId: %{public}s", GetAnonyString(iter->first).c_str());
+                dataSessionMap_.erase(iter);
+                return;
+            }
+        }
+    }
     std::string deviceId = GetDevIdBySessionId(sessionId);
     DHLOGI("OnSessionClosed notify session closed, sessionId: %{public}d, peer deviceId:%{public}s",
         sessionId, GetAnonyString(deviceId).c_str());
-    RunSessionStateCallback(deviceId, SESSION_STATUS_CLOSED);
+    bool isActive = true;
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        isActive = inactiveSessions_.erase(deviceId) == 0;
+    }
+    if (isActive) {
+        RunSessionStateCallback(deviceId, SESSION_STATUS_CLOSED);
+    }
 
     {
         std::unique_lock<std::mutex> sessionLock(operationMutex_);
         if (CountSession(deviceId) > 0) {
             EraseSessionId(deviceId);
         }
+        CloseDataSessionLocked(deviceId);
         channelStatusMap_.erase(deviceId);
+        localSessions_.erase(deviceId);
+        if (idleSessions_.erase(deviceId) > 0 && keepHandler_ != nullptr) {
+            keepHandler_->RemoveTask(IDLE_TASK_PREFIX + deviceId);
+        }
 
         if (sinkCallback_ == nullptr) {
             DHLOGE("sinkCallback is nullptr.");
@@ -457,7 +720,7 @@ void DistributedInputTransportBase::OnSessionClosed(int32_t sessionId, ShutdownR
     }
 
     std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
-    if (dhFwkKit != nullptr) {
+    if (isActive && dhFwkKit != nullptr) {
         DHLOGD("Disable low Latency!");
         dhFwkKit->PublishMessage(DHTopic::TOPIC_LOW_LATENCY, DISABLE_LOW_LATENCY.dump());
     }
@@ -530,6 +793,7 @@ void DistributedInputTransportBase::HandleSession(int32_t sessionId, const std::
         return;
     }
     if (cmdType > TRANS_MSG_SRC_SINK_SPLIT) {
+        UpdateSessionActivity(sessionId, cmdType);
         if (sinkCallback_ == nullptr) {
             DHLOGE("sinkCallback is nullptr.");
             return;
@@ -538,6 +802,40 @@ void DistributedInputTransportBase::HandleSession(int32_t sessionId, const std::
     }
 }
 
+void DistributedInputTransportBase::UpdateSessionActivity(int32_t sessionId, uint32_t cmdType)
+{
+    bool isPrepare = cmdType == TRANS_SOURCE_MSG_PREPARE || cmdType == TRANS_SOURCE_MSG_PREPARE_FOR_REL ||
+        cmdType == TRANS_SOURCE_MSG_PREPARE_START_DHID;
+    bool isUnprepare = cmdType == TRANS_SOURCE_MSG_UNPREPARE || cmdType == TRANS_SOURCE_MSG_UNPREPARE_FOR_REL;
+    if (!isPrepare && !isUnprepare) {
+        return;
+    }
+    std::string deviceId = GetDevIdBySessionId(sessionId);
+    {
+        std::unique_lock<std::mutex> sessionLock(operationMutex_);
+        if (deviceId.empty() || localSessions_.count(deviceId) > 0) {
+            return;
+        }
+        // the source may keep the session idle after the unprepare, the low latency mode ends with it.
+        bool isChanged = isPrepare ? inactiveSessions_.erase(deviceId) > 0 :
+            inactiveSessions_.insert(deviceId).second;
+        if (!isChanged) {
+            return;
+        }
+    }
+    DHLOGI("Session of remoteDevId: %{public}s is %{public}s", GetAnonyString(deviceId).c_str(),
+        isPrepare ? "active" : "inactive");
+    if (isPrepare) {
+        RunSessionStateCallback(deviceId, SESSION_STATUS_OPENED);
+    }
+    std::shared_ptr<DistributedHardwareFwkKit> dhFwkKit = DInputContext::GetInstance().GetDHFwkKit();
+    if (dhFwkKit != nullptr) {
+        DHLOGD("%{public}s low Latency!", isPrepare ? "Enable" : "Disable");
+        dhFwkKit->PublishMessage(DHTopic::TOPIC_LOW_LATENCY,
+            isPrepare ? ENABLE_LOW_LATENCY.dump() : DISABLE_LOW_LATENCY.dump());
+    }
+}
+
 int32_t DistributedInputTransportBase::SendMsg(int32_t sessionId, std::string &message)
 {
     if (message.size() > MSG_MAX_SIZE) {
@@ -556,7 +854,7 @@ int32_t DistributedInputTransportBase::SendMsg(int32_t sessionId, std::string &m
         return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE;
     }
     outLen = static_cast<int32_t>(message.size());
-    int32_t ret = SendBytes(sessionId, buf, outLen);
+    int32_t ret = backend_->SendBytes(sessionId, buf, outLen);
     free(buf);
     return ret;
 }
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "softbus_permission_cache.h"
+
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    // a reconnect storm only needs a handful of peers, the bound keeps a misbehaving peer from growing the map.
+    constexpr size_t MAX_GRANT_NUM = 64;
+}
+IMPLEMENT_SINGLE_INSTANCE(SoftBusPermissionCache);
+
+void SoftBusPermissionCache::SetTtl(int64_t ttlMs)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    ttl_ = std::chrono::milliseconds(ttlMs > 0 ? ttlMs : 0);
+    epoch_++;
+    hasLocalAccountInfo_ = false;
+    grants_.clear();
+}
+
+uint64_t SoftBusPermissionCache::GetEpoch()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return epoch_;
+}
+
+bool SoftBusPermissionCache::GetLocalAccountInfo(AccountInfo &localAccountInfo)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!hasLocalAccountInfo_ || std::chrono::steady_clock::now() >= localAccountInfoExpiry_) {
+        hasLocalAccountInfo_ = false;
+        return false;
+    }
+    localAccountInfo = localAccountInfo_;
+    return true;
+}
+
+void SoftBusPermissionCache::PutLocalAccountInfo(const AccountInfo &localAccountInfo, uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (ttl_.count() == 0 || epoch != epoch_) {
+        return;
+    }
+    localAccountInfo_ = localAccountInfo;
+    localAccountInfoExpiry_ = std::chrono::steady_clock::now() + ttl_;
+    hasLocalAccountInfo_ = true;
+}
+
+bool SoftBusPermissionCache::IsGranted(const PermissionCacheKey &key)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = grants_.find(key);
+    if (iter == grants_.end()) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() >= iter->second) {
+        grants_.erase(iter);
+        return false;
+    }
+    return true;
+}
+
+void SoftBusPermissionCache::Grant(const PermissionCacheKey &key, uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (ttl_.count() == 0) {
+        return;
+    }
+    if (epoch != epoch_) {
+        DHLOGI("Permission cache invalidated during the check, skip the grant");
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (grants_.size() >= MAX_GRANT_NUM && grants_.count(key) == 0) {
+        EvictExpiredLocked(now);
+    }
+    if (grants_.size() >= MAX_GRANT_NUM && grants_.count(key) == 0) {
+        auto oldest = grants_.begin();
+        for (auto iter = grants_.begin(); iter != grants_.end(); ++iter) {
+            if (iter->second < oldest->second) {
+                oldest = iter;
+            }
+        }
+        grants_.erase(oldest);
+    }
+    grants_[key] = now + ttl_;
+}
+
+void SoftBusPermissionCache::InvalidatePeer(const std::string &networkId)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    epoch_++;
+    for (auto iter = grants_.begin(); iter != grants_.end();) {
+        if (iter->first.networkId == networkId) {
+            iter = grants_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    DHLOGI("Invalidate permission cache of networkId: %{public}s", GetAnonyString(networkId).c_str());
+}
+
+void SoftBusPermissionCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    epoch_++;
+    hasLocalAccountInfo_ = false;
+    grants_.clear();
+    DHLOGI("Invalidate all permission cache");
+}
+
+size_t SoftBusPermissionCache::GetGrantNum()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return grants_.size();
+}
+
+void SoftBusPermissionCache::EvictExpiredLocked(std::chrono::steady_clock::time_point now)
+{
+    for (auto iter = grants_.begin(); iter != grants_.end();) {
+        if (now >= iter->second) {
+            iter = grants_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "softbus_permission_check.h"
 
+#include <mutex>
+
 #include "device_manager.h"
 #include "dm_device_info.h"
 #include "dinput_errcode.h"
@@ -23,6 +25,8 @@
 #include "ipc_skeleton.h"
 #include "ohos_account_kits.h"
 #include "os_account_manager.h"
+#include "os_account_subscriber.h"
+#include "softbus_permission_cache.h"
 #include "transport/socket.h"
 
 namespace OHOS {
@@ -30,43 +34,143 @@ namespace DistributedHardware {
 namespace DistributedInput {
 constexpr const char *ACCOUNT_ID = "accountId";
 static inline const std::string SERVICE_NAME { "ohos.dhardware.dinput" };
+static inline const std::string ACCOUNT_SUBSCRIBER_NAME { "dinput_permission_cache" };
 using namespace DistributedHardware;
+namespace {
+class AccountSwitchSubscriber : public AccountSA::OsAccountSubscriber {
+public:
+    explicit AccountSwitchSubscriber(const AccountSA::OsAccountSubscribeInfo &subscribeInfo)
+        : AccountSA::OsAccountSubscriber(subscribeInfo) {}
+
+    void OnAccountsChanged(const int &id) override
+    {
+        DHLOGI("Os account switched to %{public}d", id);
+        SoftBusPermissionCache::GetInstance().InvalidateAll();
+    }
+};
+
+#ifdef SUPPORT_SAME_ACCOUNT
+class AccountLoginSubscriber : public AccountSA::DistributedAccountSubscribeCallback {
+public:
+    void OnAccountsChanged(const AccountSA::DistributedAccountEventData &eventData) override
+    {
+        DHLOGI("Distributed account changed, userId: %{public}d", eventData.id_);
+        SoftBusPermissionCache::GetInstance().InvalidateAll();
+    }
+};
+#endif
+}
+
 bool SoftBusPermissionCheck::CheckSrcPermission(const std::string &sinkNetworkId)
 {
     DHLOGI("Begin");
+    uint64_t epoch = SoftBusPermissionCache::GetInstance().GetEpoch();
     AccountInfo localAccountInfo;
     if (!GetLocalAccountInfo(localAccountInfo)) {
         DHLOGE("Get os account data failed");
         return false;
     }
+    PermissionCacheKey key { PermissionDirection::SRC, sinkNetworkId, localAccountInfo.accountId_,
+        localAccountInfo.userId_, localAccountInfo.tokenId_ };
+    if (SoftBusPermissionCache::GetInstance().IsGranted(key)) {
+        DHLOGI("Src permission granted by cache");
+        return true;
+    }
 #ifdef SUPPORT_SAME_ACCOUNT
     if (!CheckSrcIsSameAccount(sinkNetworkId, localAccountInfo)) {
         DHLOGE("Check src same account failed");
         return false;
     }
 #endif
+    SoftBusPermissionCache::GetInstance().Grant(key, epoch);
     return true;
 }
 
 bool SoftBusPermissionCheck::CheckSinkPermission(const AccountInfo &callerAccountInfo)
 {
     DHLOGI("Begin");
+    uint64_t epoch = SoftBusPermissionCache::GetInstance().GetEpoch();
     AccountInfo localAccountInfo;
     if (!GetLocalAccountInfo(localAccountInfo)) {
         DHLOGE("Get local account info failed");
         return false;
     }
+    PermissionCacheKey key { PermissionDirection::SINK, callerAccountInfo.networkId_, callerAccountInfo.accountId_,
+        callerAccountInfo.userId_, localAccountInfo.tokenId_ };
+    if (SoftBusPermissionCache::GetInstance().IsGranted(key)) {
+        DHLOGI("Sink permission granted by cache");
+        return true;
+    }
 #ifdef SUPPORT_SAME_ACCOUNT
     if (!CheckSinkIsSameAccount(callerAccountInfo, localAccountInfo)) {
         DHLOGE("Check sink same account failed");
         return false;
     }
 #endif
+    SoftBusPermissionCache::GetInstance().Grant(key, epoch);
     return true;
 }
 
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    static std::mutex subscribeMutex;
+    static bool subscribed = false;
+    static bool allSubscribed = false;
+    std::lock_guard<std::mutex> lock(subscribeMutex);
+    if (subscribed) {
+        return allSubscribed;
+    }
+    AccountSA::OsAccountSubscribeInfo subscribeInfo(AccountSA::OS_ACCOUNT_SUBSCRIBE_TYPE::SWITCHED,
+        ACCOUNT_SUBSCRIBER_NAME);
+    auto switchSubscriber = std::make_shared<AccountSwitchSubscriber>(subscribeInfo);
+    int32_t ret = AccountSA::OsAccountManager::SubscribeOsAccount(switchSubscriber);
+    if (ret != NO_ERROR) {
+        DHLOGE("Subscribe os account switch failed, ret: %{public}d", ret);
+        return false;
+    }
+    subscribed = true;
+    allSubscribed = true;
+#ifdef SUPPORT_SAME_ACCOUNT
+    auto loginSubscriber = std::make_shared<AccountLoginSubscriber>();
+    const AccountSA::DISTRIBUTED_ACCOUNT_SUBSCRIBE_TYPE loginTypes[] = {
+        AccountSA::DISTRIBUTED_ACCOUNT_SUBSCRIBE_TYPE::LOGIN,
+        AccountSA::DISTRIBUTED_ACCOUNT_SUBSCRIBE_TYPE::LOGOUT,
+        AccountSA::DISTRIBUTED_ACCOUNT_SUBSCRIBE_TYPE::LOGOFF,
+        AccountSA::DISTRIBUTED_ACCOUNT_SUBSCRIBE_TYPE::TOKEN_INVALID,
+    };
+    for (auto type : loginTypes) {
+        ret = AccountSA::OhosAccountKits::GetInstance().SubscribeDistributedAccountEvent(type, loginSubscriber);
+        if (ret != NO_ERROR) {
+            DHLOGE("Subscribe distributed account event %{public}d failed, ret: %{public}d",
+                static_cast<int32_t>(type), ret);
+            allSubscribed = false;
+        }
+    }
+#endif
+    return allSubscribed;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+    DHLOGW("Disable the permission cache");
+    SoftBusPermissionCache::GetInstance().SetTtl(0);
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    if (networkId.empty()) {
+        SoftBusPermissionCache::GetInstance().InvalidateAll();
+        return;
+    }
+    SoftBusPermissionCache::GetInstance().InvalidatePeer(networkId);
+}
+
 bool SoftBusPermissionCheck::GetLocalAccountInfo(AccountInfo &localAccountInfo)
 {
+    if (SoftBusPermissionCache::GetInstance().GetLocalAccountInfo(localAccountInfo)) {
+        return true;
+    }
+    uint64_t epoch = SoftBusPermissionCache::GetInstance().GetEpoch();
     int32_t userId = GetCurrentUserId();
     if (userId == INVALID_USER_ID) {
         DHLOGE("Get current userid failed");
@@ -91,6 +195,7 @@ bool SoftBusPermissionCheck::GetLocalAccountInfo(AccountInfo &localAccountInfo)
     DHLOGI("Get local accountinfo success, accountId %{public}s, userId %{public}s, networkId %{public}s.",
         GetAnonyString(localAccountInfo.accountId_).c_str(), std::to_string(localAccountInfo.userId_).c_str(),
         GetAnonyString(localAccountInfo.networkId_).c_str());
+    SoftBusPermissionCache::GetInstance().PutLocalAccountInfo(localAccountInfo, epoch);
     return true;
 }
 
@@ -262,7 +367,9 @@ bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
         DHLOGE("localInfo is nullptr.");
         return false;
     }
-    int32_t userId = GetCurrentUserId();
+    AccountInfo localAccountInfo;
+    int32_t userId = SoftBusPermissionCache::GetInstance().GetLocalAccountInfo(localAccountInfo) ?
+        localAccountInfo.userId_ : GetCurrentUserId();
     if (userId == INVALID_USER_ID) {
         DHLOGE("get current user id falied");
         return false;
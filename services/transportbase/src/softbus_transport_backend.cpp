@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "softbus_transport_backend.h"
+
+#include "socket.h"
+#include "softbus_bus_center.h"
+#include "softbus_common.h"
+
+#include "dinput_errcode.h"
+#include "dinput_hitrace.h"
+#include "dinput_log.h"
+#include "dinput_softbus_define.h"
+#include "dinput_utils_tool.h"
+#include "distributed_input_transport_base.h"
+#include "softbus_permission_check.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+static QosTV g_qosInfo[] = {
+    { .qos = QOS_TYPE_MIN_BW, .value = 80 * 1024 * 1024},
+    { .qos = QOS_TYPE_MAX_LATENCY, .value = 8000 },
+    { .qos = QOS_TYPE_MIN_LATENCY, .value = 2000 }
+};
+static uint32_t g_QosTV_Param_Index = static_cast<uint32_t>(sizeof(g_qosInfo) / sizeof(g_qosInfo[0]));
+// the data sessions carry small batches at a high rate, they ask for the same link with a tighter latency.
+static QosTV g_dataQosInfo[] = {
+    { .qos = QOS_TYPE_MIN_BW, .value = 80 * 1024 * 1024},
+    { .qos = QOS_TYPE_MAX_LATENCY, .value = 4000 },
+    { .qos = QOS_TYPE_MIN_LATENCY, .value = 1000 }
+};
+static uint32_t g_dataQosCount = static_cast<uint32_t>(sizeof(g_dataQosInfo) / sizeof(g_dataQosInfo[0]));
+std::shared_ptr<DInputTransportBackendListener> g_softbusListener = nullptr;
+}
+
+void OnBind(int32_t socket, PeerSocketInfo info)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener = std::atomic_load(&g_softbusListener);
+    if (listener == nullptr || info.networkId == nullptr) {
+        DHLOGE("OnBind listener or networkId is nullptr.");
+        return;
+    }
+    listener->OnSessionOpened(socket, info.networkId, info.name == nullptr ? "" : info.name);
+}
+
+void OnShutdown(int32_t socket, ShutdownReason reason)
+{
+    DHLOGI("OnShutdown, socket: %{public}d, reason: %{public}d", socket, (int32_t)reason);
+    std::shared_ptr<DInputTransportBackendListener> listener = std::atomic_load(&g_softbusListener);
+    if (listener != nullptr) {
+        listener->OnSessionClosed(socket);
+    }
+}
+
+void OnBytes(int32_t socket, const void *data, uint32_t dataLen)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener = std::atomic_load(&g_softbusListener);
+    if (listener != nullptr) {
+        listener->OnBytesReceived(socket, data, dataLen);
+    }
+}
+
+void OnMessage(int32_t socket, const void *data, uint32_t dataLen)
+{
+    (void)socket;
+    (void)data;
+    (void)dataLen;
+    DHLOGI("socket: %{public}d, dataLen:%{public}d", socket, dataLen);
+}
+
+void OnStream(int32_t socket, const StreamData *data, const StreamData *ext,
+    const StreamFrameInfo *param)
+{
+    (void)socket;
+    (void)data;
+    (void)ext;
+    (void)param;
+    DHLOGI("socket: %{public}d", socket);
+}
+
+void OnFile(int32_t socket, FileEvent *event)
+{
+    (void)event;
+    DHLOGI("socket: %{public}d", socket);
+}
+
+void OnQos(int32_t socket, QoSEvent eventId, const QosTV *qos, uint32_t qosCount)
+{
+    DHLOGI("OnQos, socket: %{public}d, QoSEvent: %{public}d, qosCount: %{public}u", socket, (int32_t)eventId, qosCount);
+    for (uint32_t idx = 0; idx < qosCount; idx++) {
+        DHLOGI("QosTV: type: %{public}d, value: %{public}d", (int32_t)qos[idx].qos, qos[idx].value);
+    }
+}
+
+static bool OnNegotiate2(int32_t socket, PeerSocketInfo info, SocketAccessInfo *peerInfo, SocketAccessInfo *localInfo)
+{
+    return DistributedInputTransportBase::GetInstance().OnNegotiate2(socket, info, peerInfo, localInfo);
+}
+
+ISocketListener iSocketListener = {
+    .OnBind = OnBind,
+    .OnShutdown = OnShutdown,
+    .OnBytes = OnBytes,
+    .OnMessage = OnMessage,
+    .OnStream = OnStream,
+    .OnFile = OnFile,
+    .OnQos = OnQos,
+    .OnNegotiate2 = OnNegotiate2
+};
+
+int32_t SoftbusTransportBackend::Init(std::shared_ptr<DInputTransportBackendListener> listener)
+{
+    std::lock_guard<std::mutex> lock(socketMutex_);
+    std::atomic_store(&g_softbusListener, listener);
+    int32_t socket = CreateServerSocket();
+    if (socket < DH_SUCCESS) {
+        DHLOGE("CreateServerSocket failed, ret: %{public}d", socket);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+
+    int32_t ret = Listen(socket, g_qosInfo, g_QosTV_Param_Index, &iSocketListener);
+    if (ret != DH_SUCCESS) {
+        DHLOGE("Socket Listen failed, error code %{public}d.", ret);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+    localServerSocket_ = socket;
+    DHLOGI("Finish Init DSoftBus Server Socket, socket: %{public}d", socket);
+
+    int32_t dataSocket = CreateDataServerSocket();
+    if (dataSocket < DH_SUCCESS) {
+        DHLOGW("CreateDataServerSocket failed, ret: %{public}d, peers send the events on one session", dataSocket);
+        return DH_SUCCESS;
+    }
+    ret = Listen(dataSocket, g_dataQosInfo, g_dataQosCount, &iSocketListener);
+    if (ret != DH_SUCCESS) {
+        DHLOGW("Data socket Listen failed, error code %{public}d, peers send the events on one session", ret);
+        ::Shutdown(dataSocket);
+        return DH_SUCCESS;
+    }
+    localDataServerSocket_ = dataSocket;
+    DHLOGI("Finish Init DSoftBus Data Server Socket, socket: %{public}d", dataSocket);
+    return DH_SUCCESS;
+}
+
+void SoftbusTransportBackend::Release()
+{
+    std::lock_guard<std::mutex> lock(socketMutex_);
+    if (localDataServerSocket_.load() >= 0) {
+        DHLOGI("Shutdown DSoftBus Data Server Socket, socket: %{public}d", localDataServerSocket_.load());
+        ::Shutdown(localDataServerSocket_.load());
+        localDataServerSocket_ = -1;
+    }
+    if (localServerSocket_.load() < 0) {
+        return;
+    }
+    DHLOGI("Shutdown DSoftBus Server Socket, socket: %{public}d", localServerSocket_.load());
+    ::Shutdown(localServerSocket_.load());
+    localServerSocket_ = -1;
+}
+
+int32_t SoftbusTransportBackend::CreateServerSocket()
+{
+    DHLOGI("CreateServerSocket start");
+    auto localNode = std::make_unique<NodeBasicInfo>();
+    int32_t retCode = GetLocalNodeDeviceInfo(DINPUT_PKG_NAME.c_str(), localNode.get());
+    if (retCode != DH_SUCCESS) {
+        DHLOGE("Init Could not get local device id.");
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+    std::string networkId = localNode->networkId;
+    localSessionName_ = SESSION_NAME + networkId.substr(0, INTERCEPT_STRING_LENGTH);
+    localDataSessionName_ = DATA_SESSION_NAME + networkId.substr(0, INTERCEPT_STRING_LENGTH);
+    DHLOGI("CreateServerSocket local networkId is %{public}s, local socketName: %{public}s",
+        GetAnonyString(networkId).c_str(), localSessionName_.c_str());
+    SocketInfo info = {
+        .name = const_cast<char*>(localSessionName_.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    int32_t socket = Socket(info);
+    DHLOGI("CreateServerSocket Finish, socket: %{public}d", socket);
+    return socket;
+}
+
+int32_t SoftbusTransportBackend::CreateDataServerSocket()
+{
+    SocketInfo info = {
+        .name = const_cast<char*>(localDataSessionName_.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    int32_t socket = Socket(info);
+    DHLOGI("CreateDataServerSocket Finish, socket: %{public}d, local socketName: %{public}s", socket,
+        localDataSessionName_.c_str());
+    return socket;
+}
+
+int32_t SoftbusTransportBackend::CreateClientSocket(const std::string &localName, const std::string &peerName,
+    const std::string &remoteDevId)
+{
+    DHLOGI("CreateClientSocket start, peerNetworkId: %{public}s", GetAnonyString(remoteDevId).c_str());
+    std::string localSesionName = localName + "_" + std::to_string(GetCurrentTimeUs());
+    std::string peerSessionName = peerName + remoteDevId.substr(0, INTERCEPT_STRING_LENGTH);
+    SocketInfo info = {
+        .name = const_cast<char*>(localSesionName.c_str()),
+        .peerName = const_cast<char*>(peerSessionName.c_str()),
+        .peerNetworkId = const_cast<char*>(remoteDevId.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    int32_t socket = Socket(info);
+    DHLOGI("Bind Socket server, socket: %{public}d, localSessionName: %{public}s, peerSessionName: %{public}s",
+        socket, localSesionName.c_str(), peerSessionName.c_str());
+    return socket;
+}
+
+int32_t SoftbusTransportBackend::BindClientSocket(const std::string &localName, const std::string &peerName,
+    const std::string &remoteDevId, const QosTV *qos, uint32_t qosCount)
+{
+    if (!SoftBusPermissionCheck::CheckSrcPermission(remoteDevId)) {
+        DHLOGE("Permission denied");
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_PERMISSION_DENIED;
+    }
+
+    int socket = CreateClientSocket(localName, peerName, remoteDevId);
+    if (socket < DH_SUCCESS) {
+        DHLOGE("StartSession failed, ret: %{public}d", socket);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    if (!SoftBusPermissionCheck::SetAccessInfoToSocket(socket)) {
+        DHLOGW("Fill and set accessInfo failed");
+        ::Shutdown(socket);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_CONTEXT;
+    }
+    StartAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
+    int32_t ret = Bind(socket, qos, qosCount, &iSocketListener);
+    if (ret < DH_SUCCESS) {
+        DHLOGE("OpenSession fail, remoteDevId: %{public}s, socket: %{public}d", GetAnonyString(remoteDevId).c_str(),
+            socket);
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
+        ::Shutdown(socket);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    return socket;
+}
+
+int32_t SoftbusTransportBackend::Connect(const std::string &remoteDevId)
+{
+    return BindClientSocket(localSessionName_, SESSION_NAME, remoteDevId, g_qosInfo, g_QosTV_Param_Index);
+}
+
+int32_t SoftbusTransportBackend::ConnectData(const std::string &remoteDevId)
+{
+    // the bind fails if the peer runs no data server, e.g. an older version.
+    int32_t socket = BindClientSocket(localDataSessionName_, DATA_SESSION_NAME, remoteDevId, g_dataQosInfo,
+        g_dataQosCount);
+    if (socket >= DH_SUCCESS) {
+        FinishAsyncTrace(DINPUT_HITRACE_LABEL, DINPUT_OPEN_SESSION_START, DINPUT_OPEN_SESSION_TASK);
+    }
+    return socket;
+}
+
+void SoftbusTransportBackend::Shutdown(int32_t sessionId)
+{
+    ::Shutdown(sessionId);
+}
+
+int32_t SoftbusTransportBackend::SendBytes(int32_t sessionId, const void *data, uint32_t dataLen)
+{
+    return ::SendBytes(sessionId, data, dataLen);
+}
+
+std::string SoftbusTransportBackend::GetLocalSessionName()
+{
+    return localSessionName_;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOOPBACK_TRANSPORT_BACKEND_H
+#define LOOPBACK_TRANSPORT_BACKEND_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "distributed_input_transport_backend.h"
+#include "transport_link_shaper.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * An in-process backend for running the sink and the source in one process. Connect opens a session pair,
+ * the local end is returned and the peer end is announced to the listener as opened by localNetworkId,
+ * so the messages of one end arrive at the other one through the same listener.
+ */
+class LoopbackTransportBackend : public DInputTransportBackend {
+public:
+    explicit LoopbackTransportBackend(const std::string &localNetworkId,
+        const TransportLinkCondition &condition = TransportLinkCondition());
+    ~LoopbackTransportBackend() override;
+
+    int32_t Init(std::shared_ptr<DInputTransportBackendListener> listener) override;
+    void Release() override;
+    int32_t Connect(const std::string &remoteDevId) override;
+    void Shutdown(int32_t sessionId) override;
+    int32_t SendBytes(int32_t sessionId, const void *data, uint32_t dataLen) override;
+    std::string GetLocalSessionName() override;
+
+    void SetLinkCondition(const TransportLinkCondition &condition);
+    uint64_t GetDroppedNum() const;
+
+private:
+    std::shared_ptr<DInputTransportBackendListener> GetListenerIfOpened(int32_t sessionId);
+    void DeliverMessage(int32_t sessionId, const std::string &message);
+    void DeliverClose(int32_t sessionId);
+
+    std::string localNetworkId_;
+    std::mutex mutex_;
+    std::shared_ptr<DInputTransportBackendListener> listener_;
+    // the map's key is a session id, the value is the session id of its other end.
+    std::map<int32_t, int32_t> peerSessions_;
+    int32_t nextSessionId_ = 1;
+    TransportLinkShaper shaper_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // LOOPBACK_TRANSPORT_BACKEND_H
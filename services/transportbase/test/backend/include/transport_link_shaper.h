@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSPORT_LINK_SHAPER_H
+#define TRANSPORT_LINK_SHAPER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "distributed_input_transport_backend.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Delivers the sent messages of a local backend on its own thread, delayed and dropped according to the
+ * link condition. The messages of all sessions share one FIFO, so the per-session order is kept.
+ */
+class TransportLinkShaper {
+public:
+    using MessageCallback = std::function<void(int32_t sessionId, const std::string &message)>;
+    using CloseCallback = std::function<void(int32_t sessionId)>;
+
+    TransportLinkShaper(MessageCallback onMessage, CloseCallback onClose);
+    ~TransportLinkShaper();
+
+    void SetCondition(const TransportLinkCondition &condition);
+    void Start();
+    void Stop();
+    /*
+     * Queue the message for the session, it is delivered after the injected latency unless it is lost.
+     */
+    void Submit(int32_t sessionId, std::string message);
+    /*
+     * Queue the close notification of the session behind its pending messages, it is never lost.
+     */
+    void SubmitClose(int32_t sessionId);
+    uint64_t GetDroppedNum() const
+    {
+        return droppedNum_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct PendingMessage {
+        std::chrono::steady_clock::time_point due;
+        int32_t sessionId = 0;
+        bool isClose = false;
+        std::string message;
+    };
+
+    void SubmitLocked(PendingMessage &&pending);
+    void DeliverLoop();
+
+    MessageCallback onMessage_;
+    CloseCallback onClose_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<PendingMessage> queue_;
+    TransportLinkCondition condition_;
+    std::mt19937 random_;
+    std::chrono::steady_clock::time_point lastDue_;
+    std::atomic<uint64_t> droppedNum_ = 0;
+    bool running_ = false;
+    std::thread deliverThread_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // TRANSPORT_LINK_SHAPER_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UNIX_SOCKET_TRANSPORT_BACKEND_H
+#define UNIX_SOCKET_TRANSPORT_BACKEND_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "distributed_input_transport_backend.h"
+#include "transport_link_shaper.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * A backend over unix domain stream sockets, for running the sink and the source in two local processes.
+ * Every process listens at socketDir/<localNetworkId>.sock and Connect dials socketDir/<remoteDevId>.sock.
+ * A message is framed as a u32 length in host byte order followed by the bytes, the first frame of a
+ * connection carries the networkId of the dialing side. The peer is trusted by that claim alone, so the
+ * backend is only built into the tests.
+ */
+class UnixSocketTransportBackend : public DInputTransportBackend {
+public:
+    UnixSocketTransportBackend(const std::string &socketDir, const std::string &localNetworkId,
+        const TransportLinkCondition &condition = TransportLinkCondition());
+    ~UnixSocketTransportBackend() override;
+
+    int32_t Init(std::shared_ptr<DInputTransportBackendListener> listener) override;
+    void Release() override;
+    int32_t Connect(const std::string &remoteDevId) override;
+    void Shutdown(int32_t sessionId) override;
+    int32_t SendBytes(int32_t sessionId, const void *data, uint32_t dataLen) override;
+    std::string GetLocalSessionName() override;
+
+    void SetLinkCondition(const TransportLinkCondition &condition);
+    uint64_t GetDroppedNum() const;
+
+private:
+    struct Session {
+        explicit Session(int32_t fd) : fd(fd) {}
+        ~Session();
+        int32_t fd = -1;
+        // the dialed sessions are opened at once, the accepted ones after the hello frame.
+        bool opened = false;
+        std::vector<uint8_t> readBuffer;
+    };
+
+    std::string GetSocketPath(const std::string &networkId) const;
+    int32_t AddSessionLocked(int32_t fd, bool opened);
+    std::shared_ptr<Session> GetSession(int32_t sessionId);
+    std::shared_ptr<Session> TakeSession(int32_t sessionId);
+    void PollLoop();
+    void AcceptSession();
+    void ReadSession(int32_t sessionId);
+    bool DispatchFrames(int32_t sessionId, Session &session,
+        const std::shared_ptr<DInputTransportBackendListener> &listener);
+    void WriteFrame(int32_t sessionId, const std::string &message);
+
+    std::string socketDir_;
+    std::string localNetworkId_;
+    std::mutex mutex_;
+    std::shared_ptr<DInputTransportBackendListener> listener_;
+    std::map<int32_t, std::shared_ptr<Session>> sessions_;
+    int32_t nextSessionId_ = 1;
+    int32_t listenFd_ = -1;
+    int32_t epollFd_ = -1;
+    int32_t wakeupFd_ = -1;
+    std::atomic<bool> polling_ = false;
+    std::thread pollThread_;
+    TransportLinkShaper shaper_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // UNIX_SOCKET_TRANSPORT_BACKEND_H
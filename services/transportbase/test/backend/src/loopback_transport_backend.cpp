@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "loopback_transport_backend.h"
+
+#include "dinput_errcode.h"
+#include "dinput_log.h"
+#include "dinput_softbus_define.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+LoopbackTransportBackend::LoopbackTransportBackend(const std::string &localNetworkId,
+    const TransportLinkCondition &condition)
+    : localNetworkId_(localNetworkId),
+      shaper_([this](int32_t sessionId, const std::string &message) { DeliverMessage(sessionId, message); },
+          [this](int32_t sessionId) { DeliverClose(sessionId); })
+{
+    shaper_.SetCondition(condition);
+}
+
+LoopbackTransportBackend::~LoopbackTransportBackend()
+{
+    Release();
+}
+
+int32_t LoopbackTransportBackend::Init(std::shared_ptr<DInputTransportBackendListener> listener)
+{
+    if (listener == nullptr) {
+        DHLOGE("Loopback backend listener is nullptr.");
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        listener_ = listener;
+    }
+    shaper_.Start();
+    DHLOGI("Loopback backend init, local networkId: %{public}s", GetAnonyString(localNetworkId_).c_str());
+    return DH_SUCCESS;
+}
+
+void LoopbackTransportBackend::Release()
+{
+    shaper_.Stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    listener_ = nullptr;
+    peerSessions_.clear();
+}
+
+int32_t LoopbackTransportBackend::Connect(const std::string &remoteDevId)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener;
+    int32_t localSessionId = 0;
+    int32_t peerSessionId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (listener_ == nullptr) {
+            DHLOGE("Loopback backend is not initialized.");
+            return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+        }
+        listener = listener_;
+        localSessionId = nextSessionId_++;
+        peerSessionId = nextSessionId_++;
+        peerSessions_[localSessionId] = peerSessionId;
+        peerSessions_[peerSessionId] = localSessionId;
+    }
+    DHLOGI("Loopback session opened, remoteDevId: %{public}s, sessionId: %{public}d, peer sessionId: %{public}d",
+        GetAnonyString(remoteDevId).c_str(), localSessionId, peerSessionId);
+    listener->OnSessionOpened(peerSessionId, localNetworkId_, GetLocalSessionName());
+    return localSessionId;
+}
+
+void LoopbackTransportBackend::Shutdown(int32_t sessionId)
+{
+    int32_t peerSessionId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = peerSessions_.find(sessionId);
+        if (iter == peerSessions_.end()) {
+            return;
+        }
+        peerSessionId = iter->second;
+        peerSessions_.erase(iter);
+        peerSessions_.erase(peerSessionId);
+    }
+    // the caller may hold its session lock, the peer learns about the close from the shaper thread.
+    shaper_.SubmitClose(peerSessionId);
+}
+
+int32_t LoopbackTransportBackend::SendBytes(int32_t sessionId, const void *data, uint32_t dataLen)
+{
+    if (data == nullptr || dataLen == 0 || dataLen > MSG_MAX_SIZE) {
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE;
+    }
+    int32_t peerSessionId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = peerSessions_.find(sessionId);
+        if (iter == peerSessions_.end()) {
+            DHLOGE("Loopback session %{public}d is not opened.", sessionId);
+            return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE;
+        }
+        peerSessionId = iter->second;
+    }
+    const char *bytes = static_cast<const char *>(data);
+    shaper_.Submit(peerSessionId, std::string(bytes, bytes + dataLen));
+    return DH_SUCCESS;
+}
+
+std::string LoopbackTransportBackend::GetLocalSessionName()
+{
+    return SESSION_NAME + localNetworkId_.substr(0, INTERCEPT_STRING_LENGTH);
+}
+
+void LoopbackTransportBackend::SetLinkCondition(const TransportLinkCondition &condition)
+{
+    shaper_.SetCondition(condition);
+}
+
+uint64_t LoopbackTransportBackend::GetDroppedNum() const
+{
+    return shaper_.GetDroppedNum();
+}
+
+std::shared_ptr<DInputTransportBackendListener> LoopbackTransportBackend::GetListenerIfOpened(int32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (peerSessions_.count(sessionId) == 0) {
+        return nullptr;
+    }
+    return listener_;
+}
+
+void LoopbackTransportBackend::DeliverMessage(int32_t sessionId, const std::string &message)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener = GetListenerIfOpened(sessionId);
+    if (listener == nullptr) {
+        return;
+    }
+    listener->OnBytesReceived(sessionId, message.data(), static_cast<uint32_t>(message.size()));
+}
+
+void LoopbackTransportBackend::DeliverClose(int32_t sessionId)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        listener = listener_;
+    }
+    if (listener != nullptr) {
+        listener->OnSessionClosed(sessionId);
+    }
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
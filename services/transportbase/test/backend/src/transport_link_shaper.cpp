@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transport_link_shaper.h"
+
+#include <algorithm>
+#include <pthread.h>
+
+#include "dinput_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr const char *LINK_SHAPER_THREAD_NAME = "linkShaper";
+}
+
+TransportLinkShaper::TransportLinkShaper(MessageCallback onMessage, CloseCallback onClose)
+    : onMessage_(std::move(onMessage)), onClose_(std::move(onClose)), random_(std::random_device()())
+{
+}
+
+TransportLinkShaper::~TransportLinkShaper()
+{
+    Stop();
+}
+
+void TransportLinkShaper::SetCondition(const TransportLinkCondition &condition)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_ = condition;
+    condition_.lossRate = std::clamp(condition.lossRate, 0.0, 1.0);
+}
+
+void TransportLinkShaper::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    deliverThread_ = std::thread([this]() { DeliverLoop(); });
+}
+
+void TransportLinkShaper::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    if (deliverThread_.joinable() && deliverThread_.get_id() != std::this_thread::get_id()) {
+        deliverThread_.join();
+    } else if (deliverThread_.joinable()) {
+        deliverThread_.detach();
+    }
+}
+
+void TransportLinkShaper::Submit(int32_t sessionId, std::string message)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return;
+    }
+    if (condition_.lossRate > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(random_) < condition_.lossRate) {
+        droppedNum_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    PendingMessage pending;
+    pending.sessionId = sessionId;
+    pending.message = std::move(message);
+    SubmitLocked(std::move(pending));
+}
+
+void TransportLinkShaper::SubmitClose(int32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return;
+    }
+    PendingMessage pending;
+    pending.sessionId = sessionId;
+    pending.isClose = true;
+    SubmitLocked(std::move(pending));
+}
+
+void TransportLinkShaper::SubmitLocked(PendingMessage &&pending)
+{
+    uint32_t delayUs = condition_.latencyUs;
+    if (condition_.jitterUs > 0) {
+        delayUs += std::uniform_int_distribution<uint32_t>(0, condition_.jitterUs)(random_);
+    }
+    // a later message never overtakes an earlier one, the jitter only stretches the gaps.
+    pending.due = std::max(std::chrono::steady_clock::now() + std::chrono::microseconds(delayUs), lastDue_);
+    lastDue_ = pending.due;
+    queue_.push_back(std::move(pending));
+    cv_.notify_one();
+}
+
+void TransportLinkShaper::DeliverLoop()
+{
+    int32_t ret = pthread_setname_np(pthread_self(), LINK_SHAPER_THREAD_NAME);
+    if (ret != 0) {
+        DHLOGE("linkShaper setname failed.");
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (queue_.empty()) {
+            cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+            continue;
+        }
+        auto due = queue_.front().due;
+        if (std::chrono::steady_clock::now() < due) {
+            cv_.wait_until(lock, due);
+            continue;
+        }
+        PendingMessage pending = std::move(queue_.front());
+        queue_.pop_front();
+        // the callbacks may send or close sessions, they run without the lock.
+        lock.unlock();
+        if (pending.isClose) {
+            onClose_(pending.sessionId);
+        } else {
+            onMessage_(pending.sessionId, pending.message);
+        }
+        lock.lock();
+    }
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
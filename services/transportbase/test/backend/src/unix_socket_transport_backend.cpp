@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "unix_socket_transport_backend.h"
+
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+#include "dinput_errcode.h"
+#include "dinput_log.h"
+#include "dinput_softbus_define.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr const char *UNIX_SOCKET_POLL_THREAD_NAME = "unixSocketPoll";
+    constexpr int32_t LISTEN_BACKLOG = 8;
+    constexpr int32_t EPOLL_MAX_EVENTS = 16;
+    constexpr size_t READ_CHUNK_SIZE = 16 * 1024;
+    // the session ids start at 1, the two ids below mark the listen socket and the wakeup eventfd.
+    constexpr uint64_t LISTEN_EPOLL_ID = 0;
+    constexpr uint64_t WAKEUP_EPOLL_ID = UINT64_MAX;
+    const std::string SOCKET_FILE_SUFFIX = ".sock";
+
+    bool SendAll(int32_t fd, const uint8_t *data, size_t len)
+    {
+        while (len > 0) {
+            ssize_t ret = send(fd, data, len, MSG_NOSIGNAL);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                return false;
+            }
+            data += ret;
+            len -= static_cast<size_t>(ret);
+        }
+        return true;
+    }
+
+    bool SendFrame(int32_t fd, const std::string &payload)
+    {
+        std::vector<uint8_t> frame(sizeof(uint32_t) + payload.size());
+        uint32_t len = static_cast<uint32_t>(payload.size());
+        if (memcpy_s(frame.data(), frame.size(), &len, sizeof(len)) != EOK ||
+            (len > 0 && memcpy_s(frame.data() + sizeof(len), len, payload.data(), len) != EOK)) {
+            return false;
+        }
+        return SendAll(fd, frame.data(), frame.size());
+    }
+
+    bool AddEpollFd(int32_t epollFd, int32_t fd, uint64_t id)
+    {
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+}
+
+UnixSocketTransportBackend::Session::~Session()
+{
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+UnixSocketTransportBackend::UnixSocketTransportBackend(const std::string &socketDir,
+    const std::string &localNetworkId, const TransportLinkCondition &condition)
+    : socketDir_(socketDir), localNetworkId_(localNetworkId),
+      shaper_([this](int32_t sessionId, const std::string &message) { WriteFrame(sessionId, message); },
+          [](int32_t sessionId) { (void)sessionId; })
+{
+    shaper_.SetCondition(condition);
+}
+
+UnixSocketTransportBackend::~UnixSocketTransportBackend()
+{
+    Release();
+}
+
+std::string UnixSocketTransportBackend::GetSocketPath(const std::string &networkId) const
+{
+    return socketDir_ + "/" + networkId + SOCKET_FILE_SUFFIX;
+}
+
+int32_t UnixSocketTransportBackend::Init(std::shared_ptr<DInputTransportBackendListener> listener)
+{
+    std::string path = GetSocketPath(localNetworkId_);
+    struct sockaddr_un addr {};
+    if (listener == nullptr || path.size() >= sizeof(addr.sun_path)) {
+        DHLOGE("Unix socket backend init param check failed.");
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+    addr.sun_family = AF_UNIX;
+    if (memcpy_s(addr.sun_path, sizeof(addr.sun_path), path.c_str(), path.size()) != EOK) {
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (polling_.load()) {
+        return DH_SUCCESS;
+    }
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeupFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    unlink(path.c_str());
+    if (listenFd_ < 0 || epollFd_ < 0 || wakeupFd_ < 0 ||
+        bind(listenFd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        listen(listenFd_, LISTEN_BACKLOG) != 0 || !AddEpollFd(epollFd_, listenFd_, LISTEN_EPOLL_ID) ||
+        !AddEpollFd(epollFd_, wakeupFd_, WAKEUP_EPOLL_ID)) {
+        DHLOGE("Unix socket backend listen at %{public}s failed, errno: %{public}d", path.c_str(), errno);
+        for (int32_t *fd : { &listenFd_, &epollFd_, &wakeupFd_ }) {
+            if (*fd >= 0) {
+                close(*fd);
+            }
+            *fd = -1;
+        }
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_INIT_FAIL;
+    }
+    listener_ = listener;
+    polling_.store(true);
+    pollThread_ = std::thread([this]() { PollLoop(); });
+    shaper_.Start();
+    DHLOGI("Unix socket backend listen at %{public}s", path.c_str());
+    return DH_SUCCESS;
+}
+
+void UnixSocketTransportBackend::Release()
+{
+    if (!polling_.exchange(false)) {
+        return;
+    }
+    shaper_.Stop();
+    uint64_t wakeup = 1;
+    if (write(wakeupFd_, &wakeup, sizeof(wakeup)) < 0) {
+        DHLOGE("Unix socket backend wakeup failed, errno: %{public}d", errno);
+    }
+    if (pollThread_.joinable()) {
+        pollThread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[sessionId, session] : sessions_) {
+        ::shutdown(session->fd, SHUT_RDWR);
+    }
+    sessions_.clear();
+    listener_ = nullptr;
+    close(listenFd_);
+    close(epollFd_);
+    close(wakeupFd_);
+    listenFd_ = -1;
+    epollFd_ = -1;
+    wakeupFd_ = -1;
+    unlink(GetSocketPath(localNetworkId_).c_str());
+}
+
+int32_t UnixSocketTransportBackend::AddSessionLocked(int32_t fd, bool opened)
+{
+    int32_t sessionId = nextSessionId_++;
+    auto session = std::make_shared<Session>(fd);
+    session->opened = opened;
+    if (!AddEpollFd(epollFd_, fd, static_cast<uint64_t>(sessionId))) {
+        DHLOGE("Unix socket backend add session to epoll failed, errno: %{public}d", errno);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    sessions_[sessionId] = session;
+    return sessionId;
+}
+
+int32_t UnixSocketTransportBackend::Connect(const std::string &remoteDevId)
+{
+    std::string path = GetSocketPath(remoteDevId);
+    struct sockaddr_un addr {};
+    if (!polling_.load() || path.size() >= sizeof(addr.sun_path)) {
+        DHLOGE("Unix socket backend connect param check failed.");
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    addr.sun_family = AF_UNIX;
+    if (memcpy_s(addr.sun_path, sizeof(addr.sun_path), path.c_str(), path.size()) != EOK) {
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    int32_t fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        !SendFrame(fd, localNetworkId_)) {
+        DHLOGE("Unix socket backend connect %{public}s failed, errno: %{public}d", path.c_str(), errno);
+        close(fd);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t sessionId = AddSessionLocked(fd, true);
+    if (sessionId < 0) {
+        close(fd);
+        return sessionId;
+    }
+    DHLOGI("Unix socket session opened, remoteDevId: %{public}s, sessionId: %{public}d",
+        GetAnonyString(remoteDevId).c_str(), sessionId);
+    return sessionId;
+}
+
+std::shared_ptr<UnixSocketTransportBackend::Session> UnixSocketTransportBackend::GetSession(int32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = sessions_.find(sessionId);
+    return iter == sessions_.end() ? nullptr : iter->second;
+}
+
+std::shared_ptr<UnixSocketTransportBackend::Session> UnixSocketTransportBackend::TakeSession(int32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = sessions_.find(sessionId);
+    if (iter == sessions_.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<Session> session = iter->second;
+    sessions_.erase(iter);
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, session->fd, nullptr);
+    return session;
+}
+
+void UnixSocketTransportBackend::Shutdown(int32_t sessionId)
+{
+    std::shared_ptr<Session> session = TakeSession(sessionId);
+    if (session != nullptr) {
+        // the peer sees EOF, the fd is closed once a pending write or read drops its reference.
+        ::shutdown(session->fd, SHUT_RDWR);
+    }
+}
+
+int32_t UnixSocketTransportBackend::SendBytes(int32_t sessionId, const void *data, uint32_t dataLen)
+{
+    if (data == nullptr || dataLen == 0 || dataLen > MSG_MAX_SIZE) {
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE;
+    }
+    if (GetSession(sessionId) == nullptr) {
+        DHLOGE("Unix socket session %{public}d is not opened.", sessionId);
+        return ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE;
+    }
+    const char *bytes = static_cast<const char *>(data);
+    shaper_.Submit(sessionId, std::string(bytes, bytes + dataLen));
+    return DH_SUCCESS;
+}
+
+std::string UnixSocketTransportBackend::GetLocalSessionName()
+{
+    return SESSION_NAME + localNetworkId_.substr(0, INTERCEPT_STRING_LENGTH);
+}
+
+void UnixSocketTransportBackend::SetLinkCondition(const TransportLinkCondition &condition)
+{
+    shaper_.SetCondition(condition);
+}
+
+uint64_t UnixSocketTransportBackend::GetDroppedNum() const
+{
+    return shaper_.GetDroppedNum();
+}
+
+void UnixSocketTransportBackend::WriteFrame(int32_t sessionId, const std::string &message)
+{
+    std::shared_ptr<Session> session = GetSession(sessionId);
+    if (session == nullptr) {
+        return;
+    }
+    if (!SendFrame(session->fd, message)) {
+        DHLOGE("Unix socket session %{public}d write failed, errno: %{public}d", sessionId, errno);
+    }
+}
+
+void UnixSocketTransportBackend::PollLoop()
+{
+    int32_t ret = pthread_setname_np(pthread_self(), UNIX_SOCKET_POLL_THREAD_NAME);
+    if (ret != 0) {
+        DHLOGE("unixSocketPoll setname failed.");
+    }
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    while (polling_.load()) {
+        int32_t count = epoll_wait(epollFd_, events, EPOLL_MAX_EVENTS, -1);
+        if (count < 0 && errno != EINTR) {
+            DHLOGE("Unix socket backend epoll_wait failed, errno: %{public}d", errno);
+            return;
+        }
+        for (int32_t i = 0; i < count && polling_.load(); i++) {
+            if (events[i].data.u64 == WAKEUP_EPOLL_ID) {
+                continue;
+            }
+            if (events[i].data.u64 == LISTEN_EPOLL_ID) {
+                AcceptSession();
+                continue;
+            }
+            ReadSession(static_cast<int32_t>(events[i].data.u64));
+        }
+    }
+}
+
+void UnixSocketTransportBackend::AcceptSession()
+{
+    int32_t fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+        DHLOGE("Unix socket backend accept failed, errno: %{public}d", errno);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (AddSessionLocked(fd, false) < 0) {
+        close(fd);
+    }
+}
+
+void UnixSocketTransportBackend::ReadSession(int32_t sessionId)
+{
+    std::shared_ptr<DInputTransportBackendListener> listener;
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = sessions_.find(sessionId);
+        if (iter == sessions_.end()) {
+            return;
+        }
+        session = iter->second;
+        listener = listener_;
+    }
+    uint8_t chunk[READ_CHUNK_SIZE];
+    ssize_t len = recv(session->fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+    if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    if (len > 0) {
+        session->readBuffer.insert(session->readBuffer.end(), chunk, chunk + len);
+        if (DispatchFrames(sessionId, *session, listener)) {
+            return;
+        }
+    }
+    // EOF, a broken link or a bad frame, the session is gone unless it was shut down locally meanwhile.
+    bool wasOpened = session->opened;
+    if (TakeSession(sessionId) != nullptr && wasOpened && listener != nullptr) {
+        DHLOGI("Unix socket session %{public}d closed by peer.", sessionId);
+        listener->OnSessionClosed(sessionId);
+    }
+}
+
+bool UnixSocketTransportBackend::DispatchFrames(int32_t sessionId, Session &session,
+    const std::shared_ptr<DInputTransportBackendListener> &listener)
+{
+    size_t offset = 0;
+    std::vector<uint8_t> &buffer = session.readBuffer;
+    while (buffer.size() - offset >= sizeof(uint32_t)) {
+        uint32_t frameLen = 0;
+        if (memcpy_s(&frameLen, sizeof(frameLen), buffer.data() + offset, sizeof(frameLen)) != EOK) {
+            return false;
+        }
+        if (frameLen > MSG_MAX_SIZE) {
+            DHLOGE("Unix socket session %{public}d frame length %{public}u is invalid.", sessionId, frameLen);
+            return false;
+        }
+        if (buffer.size() - offset - sizeof(uint32_t) < frameLen) {
+            break;
+        }
+        const uint8_t *payload = buffer.data() + offset + sizeof(uint32_t);
+        offset += sizeof(uint32_t) + frameLen;
+        if (listener == nullptr) {
+            continue;
+        }
+        if (!session.opened) {
+            session.opened = true;
+            std::string peerNetworkId(payload, payload + frameLen);
+            listener->OnSessionOpened(sessionId, peerNetworkId,
+                SESSION_NAME + peerNetworkId.substr(0, INTERCEPT_STRING_LENGTH));
+            continue;
+        }
+        if (frameLen > 0) {
+            listener->OnBytesReceived(sessionId, payload, frameLen);
+        }
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+    return true;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
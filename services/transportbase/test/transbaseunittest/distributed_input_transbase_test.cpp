@@ -16,6 +16,7 @@
 #include "distributed_input_transbase_test.h"
 
 #include <cstdlib>
+#include <cstdint>
 
 #include "dinput_errcode.h"
 #include "dinput_softbus_define.h"
@@ -64,6 +65,20 @@ bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
     return g_fillLocal;
 }
 
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    return true;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    (void)networkId;
+}
+
 void DistributedInputTransbaseTest::SetUp()
 {
     g_checkSrc = true;
@@ -155,6 +170,35 @@ HWTEST_F(DistributedInputTransbaseTest, OnSessionOpened01, testing::ext::TestSiz
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
+HWTEST_F(DistributedInputTransbaseTest, OnSessionOpened_Inactive_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    transport.localSessions_.clear();
+    transport.inactiveSessions_.clear();
+    int32_t sessionId = 3;
+    PeerSocketInfo peerSocketInfo = {
+        .name = const_cast<char*>(PEER_SESSION_NAME.c_str()),
+        .networkId = const_cast<char*>(REMOTE_DEV_ID.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME_TEST.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    // a session opened by the peer holds no low latency mode until its first prepare.
+    EXPECT_EQ(DH_SUCCESS, transport.OnSessionOpened(sessionId, peerSocketInfo));
+    EXPECT_EQ(1, transport.inactiveSessions_.count(REMOTE_DEV_ID));
+
+    transport.UpdateSessionActivity(sessionId, TRANS_SOURCE_MSG_PREPARE);
+    EXPECT_EQ(0, transport.inactiveSessions_.count(REMOTE_DEV_ID));
+    transport.UpdateSessionActivity(sessionId, TRANS_SOURCE_MSG_START_DHID);
+    EXPECT_EQ(0, transport.inactiveSessions_.count(REMOTE_DEV_ID));
+    transport.UpdateSessionActivity(sessionId, TRANS_SOURCE_MSG_UNPREPARE);
+    EXPECT_EQ(1, transport.inactiveSessions_.count(REMOTE_DEV_ID));
+
+    transport.OnSessionClosed(sessionId, ShutdownReason::SHUTDOWN_REASON_PEER);
+    EXPECT_EQ(0, transport.inactiveSessions_.count(REMOTE_DEV_ID));
+    EXPECT_EQ(0, transport.remoteDevSessionMap_.count(REMOTE_DEV_ID));
+}
+
 HWTEST_F(DistributedInputTransbaseTest, HandleSession01, testing::ext::TestSize.Level1)
 {
     DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.clear();
@@ -231,6 +275,52 @@ HWTEST_F(DistributedInputTransbaseTest, StopSession_001, testing::ext::TestSize.
     EXPECT_EQ(0, DistributedInputTransportBase::GetInstance().remoteDevSessionMap_.size());
 }
 
+HWTEST_F(DistributedInputTransbaseTest, StopSession_KeepIdle_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    SessionKeepPolicy policy;
+    policy.prewarm = true;
+    policy.idleGraceMs = 60 * 1000;
+    transport.SetSessionKeepPolicy(policy);
+    std::string remoteDevId = "remoteDevId_test";
+    int32_t sessionId = 2;
+    transport.remoteDevSessionMap_[remoteDevId] = sessionId;
+    transport.localSessions_.insert(remoteDevId);
+    transport.StopSession(remoteDevId);
+    EXPECT_EQ(1, transport.idleSessions_.count(remoteDevId));
+    EXPECT_EQ(sessionId, transport.remoteDevSessionMap_[remoteDevId]);
+
+    EXPECT_EQ(DH_SUCCESS, transport.StartSession(remoteDevId));
+    EXPECT_EQ(0, transport.idleSessions_.count(remoteDevId));
+    EXPECT_EQ(sessionId, transport.GetCurrentSessionId());
+    EXPECT_EQ(remoteDevId, transport.recentPeers_.front());
+
+    std::string unknownDevId = "unknownDevId_test";
+    transport.PrewarmSession(unknownDevId);
+    EXPECT_EQ(0, transport.remoteDevSessionMap_.count(unknownDevId));
+
+    transport.SetSessionKeepPolicy(SessionKeepPolicy());
+    transport.StopSession(remoteDevId);
+    EXPECT_EQ(0, transport.remoteDevSessionMap_.count(remoteDevId));
+}
+
+HWTEST_F(DistributedInputTransbaseTest, StopSession_KeepIdle_002, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    SessionKeepPolicy policy;
+    policy.prewarm = true;
+    policy.idleGraceMs = 60 * 1000;
+    transport.SetSessionKeepPolicy(policy);
+    std::string remoteDevId = "remoteDevId_test";
+    transport.remoteDevSessionMap_[remoteDevId] = 2;
+    transport.StopSession(remoteDevId);
+    EXPECT_EQ(0, transport.idleSessions_.count(remoteDevId));
+    EXPECT_EQ(0, transport.remoteDevSessionMap_.count(remoteDevId));
+    transport.SetSessionKeepPolicy(SessionKeepPolicy());
+}
+
 HWTEST_F(DistributedInputTransbaseTest, RunSessionStateCallback_001, testing::ext::TestSize.Level1)
 {
     std::string remoteDevId = "remoteDevId_test";
@@ -265,6 +355,73 @@ HWTEST_F(DistributedInputTransbaseTest, OnSessionClosed_001, testing::ext::TestS
     EXPECT_EQ(DH_SUCCESS, ret);
 }
 
+HWTEST_F(DistributedInputTransbaseTest, DataSession_Fallback_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    transport.dataSessionMap_.clear();
+    int32_t sessionId = 1;
+    int32_t dataSessionId = 2;
+    std::string devId = "devId_963852";
+    transport.remoteDevSessionMap_[devId] = sessionId;
+    EXPECT_EQ(sessionId, transport.GetDataSessionId(sessionId));
+
+    std::string dataSessionName = DATA_SESSION_NAME + "devId_9638";
+    PeerSocketInfo peerSocketInfo = {
+        .name = const_cast<char*>(dataSessionName.c_str()),
+        .networkId = const_cast<char*>(devId.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME_TEST.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    EXPECT_EQ(DH_SUCCESS, transport.OnSessionOpened(dataSessionId, peerSocketInfo));
+    EXPECT_EQ(sessionId, transport.remoteDevSessionMap_[devId]);
+    EXPECT_EQ(dataSessionId, transport.GetDataSessionId(sessionId));
+    EXPECT_EQ(devId, transport.GetDevIdBySessionId(dataSessionId));
+
+    transport.OnSessionClosed(dataSessionId, ShutdownReason::SHUTDOWN_REASON_PEER);
+    EXPECT_EQ(1, transport.remoteDevSessionMap_.count(devId));
+    EXPECT_EQ(0, transport.dataSessionMap_.count(devId));
+    EXPECT_EQ(sessionId, transport.GetDataSessionId(sessionId));
+    transport.remoteDevSessionMap_.clear();
+}
+
+HWTEST_F(DistributedInputTransbaseTest, DataSession_Orphan_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    transport.dataSessionMap_.clear();
+    std::string devId = "devId_852963";
+    std::string dataSessionName = DATA_SESSION_NAME + "devId_8529";
+    PeerSocketInfo peerSocketInfo = {
+        .name = const_cast<char*>(dataSessionName.c_str()),
+        .networkId = const_cast<char*>(devId.c_str()),
+        .pkgName = const_cast<char*>(DINPUT_PKG_NAME_TEST.c_str()),
+        .dataType = DATA_TYPE_BYTES
+    };
+    // a data session of a peer without a control session is refused.
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_DEVICE_SESSION_STATE, transport.OnSessionOpened(2, peerSocketInfo));
+    EXPECT_EQ(0, transport.dataSessionMap_.count(devId));
+}
+
+HWTEST_F(DistributedInputTransbaseTest, DataSession_Retry_001, testing::ext::TestSize.Level1)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.remoteDevSessionMap_.clear();
+    transport.dataSessionMap_.clear();
+    int32_t sessionId = 1;
+    std::string devId = "devId_741852";
+    transport.remoteDevSessionMap_[devId] = sessionId;
+    // a failure not older than the retry interval is not retried.
+    transport.singleSessionPeers_[devId] = INT64_MAX;
+    transport.ConnectDataSession(devId);
+    EXPECT_EQ(INT64_MAX, transport.singleSessionPeers_[devId]);
+    EXPECT_EQ(0, transport.dataSessionMap_.count(devId));
+
+    transport.OnSessionClosed(sessionId, ShutdownReason::SHUTDOWN_REASON_PEER);
+    EXPECT_EQ(0, transport.singleSessionPeers_.count(devId));
+    transport.remoteDevSessionMap_.clear();
+}
+
 HWTEST_F(DistributedInputTransbaseTest, OnNegotiate2_001, testing::ext::TestSize.Level1)
 {
     PeerSocketInfo info;
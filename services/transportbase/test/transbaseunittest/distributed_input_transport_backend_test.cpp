@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed_input_transport_backend_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "dinput_errcode.h"
+#include "loopback_transport_backend.h"
+#include "unix_socket_transport_backend.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    const std::string LOCAL_NETWORK_ID = "0b8a4a8e26e4b1c6fa3c1f5c2e77d2f1c3a9b1d2e3f4a5b6c7d8e9f0a1b2c3d4";
+    const std::string REMOTE_NETWORK_ID = "f6d4c0864707aefte7a78f09473aa122ff57fc81c00981fcf5be989e7d112591";
+    const std::string SOCKET_DIR_TEMPLATE = "/data/test/dinput_transport_XXXXXX";
+    constexpr int32_t WAIT_TIMEOUT_MS = 3000;
+    constexpr size_t MESSAGE_NUM = 100;
+    constexpr uint32_t INJECTED_LATENCY_US = 50 * 1000;
+}
+
+void DistributedInputTransportBackendTest::SetUp()
+{
+}
+
+void DistributedInputTransportBackendTest::TearDown()
+{
+}
+
+void DistributedInputTransportBackendTest::SetUpTestCase()
+{
+}
+
+void DistributedInputTransportBackendTest::TearDownTestCase()
+{
+}
+
+void DistributedInputTransportBackendTest::TestBackendListener::OnSessionOpened(int32_t sessionId,
+    const std::string &peerNetworkId, const std::string &peerSessionName)
+{
+    (void)peerSessionName;
+    std::lock_guard<std::mutex> lock(mutex_);
+    openedSessions_[sessionId] = peerNetworkId;
+    cv_.notify_all();
+}
+
+void DistributedInputTransportBackendTest::TestBackendListener::OnSessionClosed(int32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    closedSessions_.push_back(sessionId);
+    cv_.notify_all();
+}
+
+void DistributedInputTransportBackendTest::TestBackendListener::OnBytesReceived(int32_t sessionId,
+    const void *data, uint32_t dataLen)
+{
+    const char *bytes = static_cast<const char *>(data);
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.emplace_back(sessionId, std::string(bytes, bytes + dataLen));
+    cv_.notify_all();
+}
+
+bool DistributedInputTransportBackendTest::TestBackendListener::WaitMessages(size_t count, int32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, count]() {
+        return messages_.size() >= count;
+    });
+}
+
+bool DistributedInputTransportBackendTest::TestBackendListener::WaitClosed(int32_t sessionId, int32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, sessionId]() {
+        return std::find(closedSessions_.begin(), closedSessions_.end(), sessionId) != closedSessions_.end();
+    });
+}
+
+bool DistributedInputTransportBackendTest::TestBackendListener::WaitOpened(int32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() {
+        return !openedSessions_.empty();
+    });
+}
+
+HWTEST_F(DistributedInputTransportBackendTest, Loopback_SendInOrder_001, testing::ext::TestSize.Level1)
+{
+    auto listener = std::make_shared<TestBackendListener>();
+    LoopbackTransportBackend backend(LOCAL_NETWORK_ID);
+    EXPECT_EQ(DH_SUCCESS, backend.Init(listener));
+    int32_t sessionId = backend.Connect(REMOTE_NETWORK_ID);
+    ASSERT_GT(sessionId, 0);
+    ASSERT_EQ(1u, listener->openedSessions_.size());
+    int32_t peerSessionId = listener->openedSessions_.begin()->first;
+    EXPECT_EQ(LOCAL_NETWORK_ID, listener->openedSessions_.begin()->second);
+
+    for (size_t i = 0; i < MESSAGE_NUM; i++) {
+        std::string message = "message" + std::to_string(i);
+        EXPECT_EQ(DH_SUCCESS, backend.SendBytes(sessionId, message.data(), message.size()));
+    }
+    std::string reply = "reply";
+    EXPECT_EQ(DH_SUCCESS, backend.SendBytes(peerSessionId, reply.data(), reply.size()));
+    ASSERT_TRUE(listener->WaitMessages(MESSAGE_NUM + 1, WAIT_TIMEOUT_MS));
+    std::lock_guard<std::mutex> lock(listener->mutex_);
+    for (size_t i = 0; i < MESSAGE_NUM; i++) {
+        EXPECT_EQ(peerSessionId, listener->messages_[i].first);
+        EXPECT_EQ("message" + std::to_string(i), listener->messages_[i].second);
+    }
+    EXPECT_EQ(sessionId, listener->messages_[MESSAGE_NUM].first);
+    EXPECT_EQ(reply, listener->messages_[MESSAGE_NUM].second);
+}
+
+HWTEST_F(DistributedInputTransportBackendTest, Loopback_Shutdown_001, testing::ext::TestSize.Level1)
+{
+    auto listener = std::make_shared<TestBackendListener>();
+    LoopbackTransportBackend backend(LOCAL_NETWORK_ID);
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL, backend.Connect(REMOTE_NETWORK_ID));
+    EXPECT_EQ(DH_SUCCESS, backend.Init(listener));
+    int32_t sessionId = backend.Connect(REMOTE_NETWORK_ID);
+    ASSERT_GT(sessionId, 0);
+    int32_t peerSessionId = listener->openedSessions_.begin()->first;
+    backend.Shutdown(sessionId);
+    EXPECT_TRUE(listener->WaitClosed(peerSessionId, WAIT_TIMEOUT_MS));
+    std::string message = "message";
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE,
+        backend.SendBytes(sessionId, message.data(), message.size()));
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_SENDMESSSAGE,
+        backend.SendBytes(peerSessionId, message.data(), message.size()));
+}
+
+HWTEST_F(DistributedInputTransportBackendTest, Loopback_LinkCondition_001, testing::ext::TestSize.Level1)
+{
+    auto listener = std::make_shared<TestBackendListener>();
+    TransportLinkCondition condition;
+    condition.lossRate = 1.0;
+    LoopbackTransportBackend backend(LOCAL_NETWORK_ID, condition);
+    EXPECT_EQ(DH_SUCCESS, backend.Init(listener));
+    int32_t sessionId = backend.Connect(REMOTE_NETWORK_ID);
+    ASSERT_GT(sessionId, 0);
+    std::string message = "message";
+    for (size_t i = 0; i < MESSAGE_NUM; i++) {
+        EXPECT_EQ(DH_SUCCESS, backend.SendBytes(sessionId, message.data(), message.size()));
+    }
+    EXPECT_EQ(MESSAGE_NUM, backend.GetDroppedNum());
+
+    condition.lossRate = 0;
+    condition.latencyUs = INJECTED_LATENCY_US;
+    backend.SetLinkCondition(condition);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(DH_SUCCESS, backend.SendBytes(sessionId, message.data(), message.size()));
+    ASSERT_TRUE(listener->WaitMessages(1, WAIT_TIMEOUT_MS));
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_GE(elapsed.count(), static_cast<int64_t>(INJECTED_LATENCY_US));
+}
+
+HWTEST_F(DistributedInputTransportBackendTest, UnixSocket_SendAndClose_001, testing::ext::TestSize.Level1)
+{
+    std::string socketDir = SOCKET_DIR_TEMPLATE;
+    ASSERT_NE(nullptr, mkdtemp(socketDir.data()));
+    auto localListener = std::make_shared<TestBackendListener>();
+    auto remoteListener = std::make_shared<TestBackendListener>();
+    UnixSocketTransportBackend localBackend(socketDir, LOCAL_NETWORK_ID);
+    UnixSocketTransportBackend remoteBackend(socketDir, REMOTE_NETWORK_ID);
+    EXPECT_EQ(DH_SUCCESS, localBackend.Init(localListener));
+    EXPECT_EQ(DH_SUCCESS, remoteBackend.Init(remoteListener));
+    EXPECT_EQ(ERR_DH_INPUT_SERVER_SOURCE_TRANSPORT_OPEN_SESSION_FAIL, localBackend.Connect("unknown"));
+
+    int32_t sessionId = localBackend.Connect(REMOTE_NETWORK_ID);
+    ASSERT_GT(sessionId, 0);
+    ASSERT_TRUE(remoteListener->WaitOpened(WAIT_TIMEOUT_MS));
+    int32_t peerSessionId = 0;
+    {
+        std::lock_guard<std::mutex> lock(remoteListener->mutex_);
+        peerSessionId = remoteListener->openedSessions_.begin()->first;
+        EXPECT_EQ(LOCAL_NETWORK_ID, remoteListener->openedSessions_.begin()->second);
+    }
+    for (size_t i = 0; i < MESSAGE_NUM; i++) {
+        std::string message = "message" + std::to_string(i);
+        EXPECT_EQ(DH_SUCCESS, localBackend.SendBytes(sessionId, message.data(), message.size()));
+    }
+    ASSERT_TRUE(remoteListener->WaitMessages(MESSAGE_NUM, WAIT_TIMEOUT_MS));
+    {
+        std::lock_guard<std::mutex> lock(remoteListener->mutex_);
+        for (size_t i = 0; i < MESSAGE_NUM; i++) {
+            EXPECT_EQ(peerSessionId, remoteListener->messages_[i].first);
+            EXPECT_EQ("message" + std::to_string(i), remoteListener->messages_[i].second);
+        }
+    }
+    std::string reply = "reply";
+    EXPECT_EQ(DH_SUCCESS, remoteBackend.SendBytes(peerSessionId, reply.data(), reply.size()));
+    ASSERT_TRUE(localListener->WaitMessages(1, WAIT_TIMEOUT_MS));
+    EXPECT_EQ(reply, localListener->messages_[0].second);
+
+    remoteBackend.Shutdown(peerSessionId);
+    EXPECT_TRUE(localListener->WaitClosed(sessionId, WAIT_TIMEOUT_MS));
+    localBackend.Release();
+    remoteBackend.Release();
+    rmdir(socketDir.c_str());
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
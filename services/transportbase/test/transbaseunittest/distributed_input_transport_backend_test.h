@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_INPUT_TRANSPORT_BACKEND_TEST_H
+#define DISTRIBUTED_INPUT_TRANSPORT_BACKEND_TEST_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "distributed_input_transport_backend.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+class DistributedInputTransportBackendTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    class TestBackendListener : public DInputTransportBackendListener {
+    public:
+        void OnSessionOpened(int32_t sessionId, const std::string &peerNetworkId,
+            const std::string &peerSessionName) override;
+        void OnSessionClosed(int32_t sessionId) override;
+        void OnBytesReceived(int32_t sessionId, const void *data, uint32_t dataLen) override;
+
+        bool WaitMessages(size_t count, int32_t timeoutMs);
+        bool WaitClosed(int32_t sessionId, int32_t timeoutMs);
+        bool WaitOpened(int32_t timeoutMs);
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        // the map's key is the opened session id, the value is its peer networkId.
+        std::map<int32_t, std::string> openedSessions_;
+        std::vector<int32_t> closedSessions_;
+        std::vector<std::pair<int32_t, std::string>> messages_;
+    };
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DISTRIBUTED_INPUT_TRANSPORT_BACKEND_TEST_H
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed_input_transport_two_process_test.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nlohmann/json.hpp"
+
+#include "dinput_errcode.h"
+#include "dinput_softbus_define.h"
+#include "distributed_input_transport_base.h"
+#include "softbus_permission_check.h"
+#include "unix_socket_transport_backend.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    const std::string SOURCE_NETWORK_ID = "0b8a4a8e26e4b1c6fa3c1f5c2e77d2f1c3a9b1d2e3f4a5b6c7d8e9f0a1b2c3d4";
+    const std::string SINK_NETWORK_ID = "f6d4c0864707aefte7a78f09473aa122ff57fc81c00981fcf5be989e7d112591";
+    const std::string SOCKET_DIR_TEMPLATE = "/data/test/dinput_transport_XXXXXX";
+    constexpr int32_t WAIT_TIMEOUT_MS = 3000;
+    constexpr size_t EVENT_NUM = 100;
+    constexpr char SINK_READY = 'r';
+    constexpr int32_t SINK_EXIT_SUCCESS = 0;
+    constexpr int32_t SINK_EXIT_INIT_FAIL = 1;
+    constexpr int32_t SINK_EXIT_NOT_CLOSED = 2;
+    constexpr int32_t SINK_EXIT_BAD_PREPARE = 3;
+}
+
+bool SoftBusPermissionCheck::CheckSrcPermission(const std::string &sinkNetworkId)
+{
+    (void)sinkNetworkId;
+    return true;
+}
+
+bool SoftBusPermissionCheck::CheckSinkPermission(const AccountInfo &callerAccountInfo)
+{
+    (void)callerAccountInfo;
+    return true;
+}
+
+bool SoftBusPermissionCheck::SetAccessInfoToSocket(const int32_t sessionId)
+{
+    (void)sessionId;
+    return true;
+}
+
+bool SoftBusPermissionCheck::TransCallerInfo(SocketAccessInfo *callerInfo,
+    AccountInfo &callerAccountInfo, const std::string &networkId)
+{
+    (void)callerInfo;
+    (void)callerAccountInfo;
+    (void)networkId;
+    return true;
+}
+
+bool SoftBusPermissionCheck::FillLocalInfo(SocketAccessInfo *localInfo)
+{
+    (void)localInfo;
+    return true;
+}
+
+bool SoftBusPermissionCheck::SubscribeAccountEvents()
+{
+    return true;
+}
+
+void SoftBusPermissionCheck::DisablePermissionCache()
+{
+}
+
+void SoftBusPermissionCheck::InvalidateCachedPermission(const std::string &networkId)
+{
+    (void)networkId;
+}
+
+void DistributedInputTransportTwoProcessTest::SetUp()
+{
+}
+
+void DistributedInputTransportTwoProcessTest::TearDown()
+{
+}
+
+void DistributedInputTransportTwoProcessTest::SetUpTestCase()
+{
+}
+
+void DistributedInputTransportTwoProcessTest::TearDownTestCase()
+{
+}
+
+void DistributedInputTransportTwoProcessTest::SinkProcessCallback::HandleSessionData(int32_t sessionId,
+    const std::string &messageData)
+{
+    nlohmann::json recMsg = nlohmann::json::parse(messageData, nullptr, false);
+    if (recMsg.is_discarded() || recMsg[DINPUT_SOFTBUS_KEY_CMD_TYPE] != TRANS_SOURCE_MSG_PREPARE) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prepareNum_++;
+    }
+    nlohmann::json response;
+    response[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_ONPREPARE;
+    response[DINPUT_SOFTBUS_KEY_RESP_VALUE] = true;
+    std::string smsg = response.dump();
+    DistributedInputTransportBase::GetInstance().SendMsg(sessionId, smsg);
+    for (size_t i = 0; i < EVENT_NUM; i++) {
+        nlohmann::json event;
+        event[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SINK_MSG_BODY_DATA;
+        event[DINPUT_SOFTBUS_KEY_INPUT_DATA] = "event" + std::to_string(i);
+        smsg = event.dump();
+        DistributedInputTransportBase::GetInstance().SendMsg(sessionId, smsg);
+    }
+}
+
+void DistributedInputTransportTwoProcessTest::SinkProcessCallback::NotifySessionClosed(int32_t sessionId)
+{
+    (void)sessionId;
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+}
+
+bool DistributedInputTransportTwoProcessTest::SinkProcessCallback::WaitClosed(int32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return closed_; });
+}
+
+void DistributedInputTransportTwoProcessTest::SourceProcessCallback::HandleSessionData(int32_t sessionId,
+    const std::string &messageData)
+{
+    (void)sessionId;
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.push_back(messageData);
+    cv_.notify_all();
+}
+
+void DistributedInputTransportTwoProcessTest::SourceProcessCallback::NotifySessionClosed()
+{
+}
+
+bool DistributedInputTransportTwoProcessTest::SourceProcessCallback::WaitMessages(size_t count, int32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, count]() {
+        return messages_.size() >= count;
+    });
+}
+
+int32_t DistributedInputTransportTwoProcessTest::RunSinkProcess(const std::string &socketDir, int32_t readyFd)
+{
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.SetTransportBackend(std::make_shared<UnixSocketTransportBackend>(socketDir, SINK_NETWORK_ID));
+    auto callback = std::make_shared<SinkProcessCallback>();
+    transport.RegisterSinkHandleSessionCallback(callback);
+    if (transport.Init() != DH_SUCCESS) {
+        return SINK_EXIT_INIT_FAIL;
+    }
+    if (write(readyFd, &SINK_READY, sizeof(SINK_READY)) != sizeof(SINK_READY)) {
+        transport.Release();
+        return SINK_EXIT_INIT_FAIL;
+    }
+    bool closed = callback->WaitClosed(WAIT_TIMEOUT_MS);
+    transport.Release();
+    if (!closed) {
+        return SINK_EXIT_NOT_CLOSED;
+    }
+    std::lock_guard<std::mutex> lock(callback->mutex_);
+    return callback->prepareNum_ == 1 ? SINK_EXIT_SUCCESS : SINK_EXIT_BAD_PREPARE;
+}
+
+HWTEST_F(DistributedInputTransportTwoProcessTest, PrepareAndEvents_001, testing::ext::TestSize.Level1)
+{
+    std::string socketDir = SOCKET_DIR_TEMPLATE;
+    ASSERT_NE(nullptr, mkdtemp(socketDir.data()));
+    int32_t readyPipe[2] = { -1, -1 };
+    ASSERT_EQ(0, pipe(readyPipe));
+    // fork before the transport starts any thread, the child only runs the sink and exits.
+    pid_t sinkPid = fork();
+    ASSERT_GE(sinkPid, 0);
+    if (sinkPid == 0) {
+        close(readyPipe[0]);
+        _exit(RunSinkProcess(socketDir, readyPipe[1]));
+    }
+    close(readyPipe[1]);
+    char ready = 0;
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(ready)), read(readyPipe[0], &ready, sizeof(ready)));
+    close(readyPipe[0]);
+    EXPECT_EQ(SINK_READY, ready);
+
+    DistributedInputTransportBase &transport = DistributedInputTransportBase::GetInstance();
+    transport.SetTransportBackend(std::make_shared<UnixSocketTransportBackend>(socketDir, SOURCE_NETWORK_ID));
+    auto callback = std::make_shared<SourceProcessCallback>();
+    transport.RegisterSrcHandleSessionCallback(callback);
+    EXPECT_EQ(DH_SUCCESS, transport.Init());
+    EXPECT_EQ(DH_SUCCESS, transport.StartSession(SINK_NETWORK_ID));
+    int32_t sessionId = transport.GetSessionIdByDevId(SINK_NETWORK_ID);
+    EXPECT_GT(sessionId, 0);
+
+    nlohmann::json prepare;
+    prepare[DINPUT_SOFTBUS_KEY_CMD_TYPE] = TRANS_SOURCE_MSG_PREPARE;
+    prepare[DINPUT_SOFTBUS_KEY_DEVICE_ID] = SINK_NETWORK_ID;
+    std::string smsg = prepare.dump();
+    EXPECT_EQ(DH_SUCCESS, transport.SendMsg(sessionId, smsg));
+    EXPECT_TRUE(callback->WaitMessages(EVENT_NUM + 1, WAIT_TIMEOUT_MS));
+    {
+        std::lock_guard<std::mutex> lock(callback->mutex_);
+        ASSERT_EQ(EVENT_NUM + 1, callback->messages_.size());
+        nlohmann::json response = nlohmann::json::parse(callback->messages_[0], nullptr, false);
+        EXPECT_EQ(TRANS_SINK_MSG_ONPREPARE, response[DINPUT_SOFTBUS_KEY_CMD_TYPE]);
+        for (size_t i = 0; i < EVENT_NUM; i++) {
+            nlohmann::json event = nlohmann::json::parse(callback->messages_[i + 1], nullptr, false);
+            EXPECT_EQ(TRANS_SINK_MSG_BODY_DATA, event[DINPUT_SOFTBUS_KEY_CMD_TYPE]);
+            EXPECT_EQ("event" + std::to_string(i), event[DINPUT_SOFTBUS_KEY_INPUT_DATA]);
+        }
+    }
+
+    transport.StopSession(SINK_NETWORK_ID);
+    int32_t status = -1;
+    EXPECT_EQ(sinkPid, waitpid(sinkPid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(SINK_EXIT_SUCCESS, WEXITSTATUS(status));
+    transport.Release();
+    rmdir(socketDir.c_str());
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_INPUT_TRANSPORT_TWO_PROCESS_TEST_H
+#define DISTRIBUTED_INPUT_TRANSPORT_TWO_PROCESS_TEST_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dinput_transbase_sink_callback.h"
+#include "dinput_transbase_source_callback.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Runs the transport base of the sink and of the source in two processes linked by the unix socket backend.
+ * The transport base is a singleton, so a single process can only loop the backends back to each other.
+ */
+class DistributedInputTransportTwoProcessTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // the sink process answers a prepare and then sends its input events.
+    class SinkProcessCallback : public DInputTransbaseSinkCallback {
+    public:
+        void HandleSessionData(int32_t sessionId, const std::string &messageData) override;
+        void NotifySessionClosed(int32_t sessionId) override;
+        bool WaitClosed(int32_t timeoutMs);
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        int32_t prepareNum_ = 0;
+        bool closed_ = false;
+    };
+
+    class SourceProcessCallback : public DInputTransbaseSourceCallback {
+    public:
+        void HandleSessionData(int32_t sessionId, const std::string &messageData) override;
+        void NotifySessionClosed() override;
+        bool WaitMessages(size_t count, int32_t timeoutMs);
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<std::string> messages_;
+    };
+
+    static int32_t RunSinkProcess(const std::string &socketDir, int32_t readyFd);
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DISTRIBUTED_INPUT_TRANSPORT_TWO_PROCESS_TEST_H
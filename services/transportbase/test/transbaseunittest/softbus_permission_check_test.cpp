@@ -23,6 +23,7 @@
 #include "dinput_utils_tool.h"
 #include "mock_other_method.h"
 #include "socket_mock.h"
+#include "softbus_permission_cache.h"
 #include "softbus_permission_check.h"
 
 namespace OHOS {
@@ -31,12 +32,19 @@ namespace DistributedInput {
 using namespace testing;
 using namespace testing::ext;
 using namespace std;
+namespace {
+    constexpr int64_t PERMISSION_CACHE_TTL_MS = 60 * 1000;
+}
 
 class SoftbusPermissionCheckTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
     static void TearDownTestCase(void);
-    void SetUp() {};
+    // the checks below count the queries, so they run without the permission cache.
+    void SetUp()
+    {
+        SoftBusPermissionCache::GetInstance().SetTtl(0);
+    }
     void TearDown() {};
 public:
     static inline shared_ptr<DeviceOtherMethodMock> otherMethodMock_ = nullptr;
@@ -416,6 +424,70 @@ HWTEST_F(SoftbusPermissionCheckTest, SoftbusPermissionCheckTest_CheckSinkPermiss
 #endif
     GTEST_LOG_(INFO) << "SoftbusPermissionCheckTest_CheckSinkPermission_001 end";
 }
+
+/**
+ * @tc.name: SoftbusPermissionCheckTest_PermissionCache_001
+ * @tc.desc: Verify a granted permission is answered by the cache until it is invalidated.
+ * @tc.type: FUNC
+ * @tc.require: ICCZFE
+ */
+HWTEST_F(SoftbusPermissionCheckTest, SoftbusPermissionCheckTest_PermissionCache_001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "SoftbusPermissionCheckTest_PermissionCache_001 start";
+    SoftBusPermissionCache::GetInstance().SetTtl(PERMISSION_CACHE_TTL_MS);
+    std::string networkId = "networkId";
+    std::vector<int32_t> userIds{100, 101};
+    // every query is expected once, the second check must not reach them.
+    EXPECT_CALL(*otherMethodMock_, QueryActiveOsAccountIds(_))
+        .WillOnce(DoAll(SetArgReferee<0>(userIds), Return(DH_SUCCESS)));
+    EXPECT_CALL(*deviceManagerMock_, GetLocalDeviceInfo(_, _)).WillOnce(Return(0));
+#ifdef SUPPORT_SAME_ACCOUNT
+    AccountSA::OhosAccountInfo osAccountInfo;
+    osAccountInfo.uid_ = "test";
+    EXPECT_CALL(*otherMethodMock_, GetOhosAccountInfo(_))
+        .WillOnce(DoAll(SetArgReferee<0>(osAccountInfo), Return(DH_SUCCESS)));
+    EXPECT_CALL(*deviceManagerMock_, CheckSrcIsSameAccount(_, _)).WillOnce(Return(true));
+#endif
+    EXPECT_TRUE(SoftBusPermissionCheck::CheckSrcPermission(networkId));
+    EXPECT_TRUE(SoftBusPermissionCheck::CheckSrcPermission(networkId));
+    EXPECT_EQ(1u, SoftBusPermissionCache::GetInstance().GetGrantNum());
+
+    SoftBusPermissionCheck::InvalidateCachedPermission("otherNetworkId");
+    EXPECT_EQ(1u, SoftBusPermissionCache::GetInstance().GetGrantNum());
+    SoftBusPermissionCheck::InvalidateCachedPermission(networkId);
+    EXPECT_EQ(0u, SoftBusPermissionCache::GetInstance().GetGrantNum());
+    SoftBusPermissionCheck::InvalidateCachedPermission("");
+    AccountInfo localAccountInfo;
+    EXPECT_FALSE(SoftBusPermissionCache::GetInstance().GetLocalAccountInfo(localAccountInfo));
+    SoftBusPermissionCache::GetInstance().SetTtl(0);
+    GTEST_LOG_(INFO) << "SoftbusPermissionCheckTest_PermissionCache_001 end";
+}
+
+/**
+ * @tc.name: SoftbusPermissionCheckTest_PermissionCache_002
+ * @tc.desc: Verify a grant checked before an invalidation is not cached.
+ * @tc.type: FUNC
+ * @tc.require: ICCZFE
+ */
+HWTEST_F(SoftbusPermissionCheckTest, SoftbusPermissionCheckTest_PermissionCache_002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "SoftbusPermissionCheckTest_PermissionCache_002 start";
+    SoftBusPermissionCache::GetInstance().SetTtl(PERMISSION_CACHE_TTL_MS);
+    PermissionCacheKey key { PermissionDirection::SINK, "networkId", "accountId", 100, 0 };
+    AccountInfo localAccountInfo;
+    uint64_t epoch = SoftBusPermissionCache::GetInstance().GetEpoch();
+    SoftBusPermissionCheck::InvalidateCachedPermission("networkId");
+    SoftBusPermissionCache::GetInstance().PutLocalAccountInfo(localAccountInfo, epoch);
+    SoftBusPermissionCache::GetInstance().Grant(key, epoch);
+    EXPECT_FALSE(SoftBusPermissionCache::GetInstance().GetLocalAccountInfo(localAccountInfo));
+    EXPECT_FALSE(SoftBusPermissionCache::GetInstance().IsGranted(key));
+
+    epoch = SoftBusPermissionCache::GetInstance().GetEpoch();
+    SoftBusPermissionCache::GetInstance().Grant(key, epoch);
+    EXPECT_TRUE(SoftBusPermissionCache::GetInstance().IsGranted(key));
+    SoftBusPermissionCache::GetInstance().SetTtl(0);
+    GTEST_LOG_(INFO) << "SoftbusPermissionCheckTest_PermissionCache_002 end";
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -27,6 +27,7 @@
 
 #include "constants_dinput.h"
 #include "distributed_input_transport_base.h"
+#include "softbus_transport_backend.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -126,9 +127,10 @@ void CreateClientSocketFuzzTest(const uint8_t *data, size_t size)
     }
     FuzzedDataProvider fdp(data, size);
     std::string remoteDevId = fdp.ConsumeRandomLengthString();
-    DistributedInput::DistributedInputTransportBase::GetInstance().CreateClientSocket(remoteDevId);
-    if (DistributedInput::DistributedInputTransportBase::GetInstance().sessionId_ > 0) {
-        Shutdown(DistributedInput::DistributedInputTransportBase::GetInstance().sessionId_);
+    DistributedInput::SoftbusTransportBackend backend;
+    int32_t socket = backend.CreateClientSocket(remoteDevId);
+    if (socket > 0) {
+        backend.Shutdown(socket);
     }
 }
 } // namespace DistributedHardware
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_CAPABILITY_CODEC_H
+#define DINPUT_CAPABILITY_CODEC_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "constants_dinput.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Compact capability descriptor, all integers are little endian:
+ *   header:  magic u32, version u8, reserved u8
+ *   strings: name, physicalPath, uniqueId, descriptor, each a u16 length followed by the bytes
+ *   ids:     bus u16, vendor u16, product u16, version u16, classes u32
+ *   bitmaps: eventTypes, eventKeys, relTypes, absTypes, properties, miscellaneous, leds, switchs, repeats,
+ *            each a u16 byte length followed by the bytes, bit n is set for code n, trailing zero bytes are cut,
+ *            so the codes decode in ascending order without duplicates
+ *   abs:     count u16, count * (code u16, value num u8, value num * i32)
+ * Later versions only append fields, a decoder reads the fields it knows and ignores the rest.
+ * The descriptor travels as CAPABILITY_DESCRIPTOR_PREFIX followed by the base64 of the binary form, so it
+ * fits everywhere the capability json does.
+ */
+constexpr uint32_t CAPABILITY_DESCRIPTOR_MAGIC = 0x42434944;
+constexpr uint8_t CAPABILITY_DESCRIPTOR_VERSION = 1;
+const std::string CAPABILITY_DESCRIPTOR_PREFIX = "dicb:";
+
+std::string InputDeviceToDescriptor(const InputDevice &device);
+bool IsCapabilityDescriptor(const std::string &capability);
+bool DescriptorToInputDevice(const std::string &capability, InputDevice &device);
+
+/*
+ * The parsed capabilities of the registered devices keyed by the sha256 of the capability string, so
+ * registering an identical peripheral again skips the parsing. Both the descriptor and the json are accepted.
+ */
+class CapabilityParseCache {
+public:
+    explicit CapabilityParseCache(size_t capacity);
+    /*
+     * Return false if the capability can not be parsed, the device is left untouched then.
+     */
+    bool Parse(const std::string &capability, InputDevice &device);
+    size_t GetHitNum();
+    void Clear();
+
+    static bool ParseUncached(const std::string &capability, InputDevice &device);
+
+private:
+    size_t capacity_;
+    std::mutex cacheMutex_;
+    // the most recently used hash first.
+    std::list<std::string> lru_;
+    std::map<std::string, InputDevice> devices_;
+    size_t hitNum_ = 0;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_CAPABILITY_CODEC_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_CLOCK_SYNC_H
+#define DINPUT_CLOCK_SYNC_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * One latency probe exchange in wall clock microseconds: the source sends at t1, the sink receives at t2
+ * and answers at t3, the source receives the answer at t4.
+ */
+struct ClockSample {
+    uint64_t t1 = 0;
+    uint64_t t2 = 0;
+    uint64_t t3 = 0;
+    uint64_t t4 = 0;
+};
+
+struct ClockEstimate {
+    // the remote clock minus the local clock.
+    int64_t offsetUs = 0;
+    double driftPpm = 0;
+    // the lowest round trip delay in the window, it bounds the error of the offset by its half.
+    uint64_t minDelayUs = 0;
+};
+
+/*
+ * NTP style estimate of a remote clock. Every sample gives the offset ((t2 - t1) + (t3 - t4)) / 2 and the
+ * delay (t4 - t1) - (t3 - t2). Of the last SAMPLE_WINDOW samples only the ones with a delay close to the
+ * minimum are trusted, the offset is their least squares line over the local time and the drift its slope.
+ * Not thread safe, the owner is responsible for locking.
+ */
+class ClockOffsetEstimator {
+public:
+    static constexpr size_t SAMPLE_WINDOW = 64;
+
+    /*
+     * Return false if the stamps are not ordered, the sample is dropped then.
+     */
+    bool AddSample(const ClockSample &sample);
+    bool HasEstimate() const;
+    /*
+     * The remote clock minus the local clock at the given local time.
+     */
+    int64_t GetOffsetUs(uint64_t localUs) const;
+    ClockEstimate GetEstimate(uint64_t localUs) const;
+    uint64_t RemoteToLocalUs(uint64_t remoteUs) const;
+    void Reset();
+
+private:
+    struct OffsetSample {
+        uint64_t localUs = 0;
+        int64_t offsetUs = 0;
+        uint64_t delayUs = 0;
+    };
+    void Update();
+
+    std::deque<OffsetSample> samples_;
+    bool hasEstimate_ = false;
+    uint64_t refLocalUs_ = 0;
+    double refOffsetUs_ = 0;
+    // the change of the offset per local microsecond.
+    double drift_ = 0;
+    uint64_t minDelayUs_ = 0;
+};
+
+/*
+ * The clock estimates of the sink devices, keyed by the device id. Fed by the latency probe and read by
+ * the inject thread to translate the sink event time into the local clock.
+ */
+class DInputClockSync {
+DECLARE_SINGLE_INSTANCE_BASE(DInputClockSync);
+public:
+    void AddSample(const std::string &devId, const ClockSample &sample);
+    bool GetEstimate(const std::string &devId, ClockEstimate &estimate);
+    bool RemoteToLocalUs(const std::string &devId, uint64_t remoteUs, uint64_t &localUs);
+    void RemoveDevice(const std::string &devId);
+    void Clear();
+
+private:
+    DInputClockSync() = default;
+    ~DInputClockSync() = default;
+
+    std::mutex estimatorMutex_;
+    std::map<std::string, ClockOffsetEstimator> estimators_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_CLOCK_SYNC_H
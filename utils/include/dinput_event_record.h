@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_EVENT_RECORD_H
+#define DINPUT_EVENT_RECORD_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "single_instance.h"
+
+#include "constants_dinput.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Record file layout, all fields are in host byte order:
+ *   header: magic u32, version u16, reserved u16
+ *   chunks: tag u8, followed by
+ *     DEVICE:      index u16, dhId str, path str, capability str
+ *     EVENT_BATCH: count u32, count * (when i64, index u16, type u16, code u16, value i32)
+ *   str is a u32 length followed by the bytes, index refers to a DEVICE chunk written before.
+ * The capability is the same json the sink reports for the device in Query. Key events and scan codes are
+ * never recorded, so a record holds no typed text.
+ * Record and replay are debug tools, they are only built with the dinput_event_record gn arg.
+ */
+constexpr uint32_t EVENT_RECORD_MAGIC = 0x43524944;
+constexpr uint16_t EVENT_RECORD_VERSION = 1;
+// the records only live in this directory of the SA, the dump commands take a bare file name.
+const std::string EVENT_RECORD_DIR = "/data/service/el1/public/dinput/record/";
+const std::string EVENT_RECORD_DEFAULT_FILE = "dinput_event_record.bin";
+
+/*
+ * Resolve a record file name inside EVENT_RECORD_DIR, a name holding a path separator or dots only is rejected.
+ */
+int32_t GetEventRecordPath(const std::string &fileName, std::string &filePath);
+
+struct RecordedDevice {
+    std::string dhId;
+    std::string path;
+    std::string capability;
+};
+
+struct EventRecording {
+    std::vector<RecordedDevice> devices;
+    // the events keep the batching of the collector they were recorded from.
+    std::vector<std::vector<RawEvent>> batches;
+    size_t eventNum = 0;
+};
+
+/*
+ * Load a record file, a truncated tail left by an interrupted recording is dropped.
+ */
+int32_t LoadEventRecording(const std::string &filePath, EventRecording &recording);
+
+class DInputEventRecorder {
+DECLARE_SINGLE_INSTANCE_BASE(DInputEventRecorder);
+public:
+    int32_t Start(const std::string &fileName);
+    void Stop();
+    bool IsRecording() const
+    {
+        return recording_.load(std::memory_order_relaxed);
+    }
+    bool HasDevice(const std::string &dhId);
+    void RecordDevice(const std::string &dhId, const std::string &path, const std::string &capability);
+    /*
+     * Record one collected batch, the events of devices not recorded yet are dropped.
+     */
+    void RecordEvents(const RawEvent *events, size_t count);
+    size_t GetRecordedEventNum();
+
+private:
+    DInputEventRecorder() = default;
+    ~DInputEventRecorder();
+    void CloseFileLocked();
+    bool WriteLocked(const std::string &buffer);
+
+    std::atomic<bool> recording_ = false;
+    std::mutex recordMutex_;
+    FILE *file_ = nullptr;
+    // the map's key is dhId, the value is the device index in the record file.
+    std::map<std::string, uint16_t> deviceIndexes_;
+    size_t eventNum_ = 0;
+};
+
+using ReplayBatchCallback = std::function<void(std::vector<RawEvent> &events)>;
+
+/*
+ * Lets a stop wake the replay up in the middle of a pacing gap.
+ */
+class ReplayControl {
+public:
+    /*
+     * Return false if the replay was stopped before the deadline.
+     */
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+    void Stop();
+    bool IsStopped();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable stopCondition_;
+    bool isStopped_ = false;
+};
+
+class DInputEventReplayer {
+DECLARE_SINGLE_INSTANCE_BASE(DInputEventReplayer);
+public:
+    /*
+     * The callback feeds one replayed batch into the pipeline, it is registered by the collector.
+     */
+    void RegisterBatchCallback(ReplayBatchCallback callback);
+    /*
+     * Replay the record file asynchronously. speed 1 keeps the recorded timing, N replays N times
+     * faster and 0 replays the batches back to back without pacing.
+     */
+    int32_t StartReplay(const std::string &fileName, double speed, EventRecording &recording);
+    void StopReplay();
+    bool IsReplaying() const
+    {
+        return replaying_.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Hand the batches to the callback paced by their recorded timestamps, which are rebased to the
+     * current wall clock. Return the replayed event number.
+     */
+    static size_t Replay(const EventRecording &recording, double speed, const ReplayBatchCallback &callback,
+        ReplayControl &control);
+
+private:
+    DInputEventReplayer() = default;
+    ~DInputEventReplayer();
+
+    std::atomic<bool> replaying_ = false;
+    std::mutex replayMutex_;
+    std::thread replayThread_;
+    std::shared_ptr<ReplayControl> replayControl_;
+    ReplayBatchCallback callback_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_EVENT_RECORD_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_LATENCY_HISTOGRAM_H
+#define DINPUT_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * Summary of a latency histogram, all values are in microseconds.
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    uint64_t mean = 0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+};
+
+/*
+ * Fixed-memory log-linear latency histogram, in the spirit of HdrHistogram.
+ * Values below 2^SUB_BUCKET_BITS are counted exactly, larger values fall into one of
+ * SUB_BUCKET_COUNT linear sub buckets per power of two, so the relative error of any
+ * reported percentile is bounded by 1 / SUB_BUCKET_COUNT. Values above 2^MAX_MSB are
+ * clamped into the last bucket. Not thread safe, the owner is responsible for locking.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_MSB = 30;
+    static constexpr uint32_t BUCKET_COUNT = SUB_BUCKET_COUNT + (MAX_MSB - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    void Record(uint64_t value);
+    void Merge(const LatencyHistogram &other);
+    void Reset();
+
+    uint64_t GetCount() const;
+    uint64_t GetMin() const;
+    uint64_t GetMax() const;
+    uint64_t GetMean() const;
+    /*
+     * Return the highest value equivalent to the given percentile, percentile is in [0, 100].
+     */
+    uint64_t GetPercentile(double percentile) const;
+    LatencySummary GetSummary() const;
+
+private:
+    static uint32_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketHighestValue(uint32_t index);
+
+    std::array<uint32_t, BUCKET_COUNT> buckets_ {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_LATENCY_HISTOGRAM_H
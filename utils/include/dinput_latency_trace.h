@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_LATENCY_TRACE_H
+#define DINPUT_LATENCY_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "single_instance.h"
+
+#include "dinput_latency_histogram.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+/*
+ * The stages an event batch passes through from the sink kernel to the source uinput node,
+ * the first five stamps are taken on the sink, the others on the source.
+ */
+enum class TraceStage : uint32_t {
+    KERNEL_EVENT = 0,
+    HUB_READ,
+    COLLECTOR_ENCODE,
+    RUNNER_DEQUEUE,
+    SEND_BYTES,
+    BYTES_RECEIVED,
+    EVENT_PARSED,
+    INJECT_DEQUEUE,
+    UINPUT_WRITTEN,
+    STAGE_NUM,
+};
+
+constexpr size_t TRACE_STAGE_NUM = static_cast<size_t>(TraceStage::STAGE_NUM);
+
+/*
+ * Wall clock timestamps in microseconds indexed by TraceStage, 0 means the stage was not stamped.
+ */
+using TraceStamps = std::array<uint64_t, TRACE_STAGE_NUM>;
+
+/*
+ * A collected event batch together with its sink side stamps, posted to the sink event runner
+ * instead of the bare event array when tracing is enabled.
+ */
+struct TracedEventBatch {
+    std::shared_ptr<nlohmann::json> events;
+    TraceStamps stamps {};
+};
+
+struct TraceStageSummary {
+    std::string name;
+    LatencySummary summary;
+};
+
+class DInputLatencyTrace {
+DECLARE_SINGLE_INSTANCE_BASE(DInputLatencyTrace);
+public:
+    bool IsEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+    void SetEnabled(bool enabled);
+    void Reset();
+
+    static void Stamp(TraceStamps &stamps, TraceStage stage);
+    static nlohmann::json StampsToJson(const TraceStamps &stamps);
+    static bool StampsFromJson(const nlohmann::json &stampsJson, TraceStamps &stamps);
+
+    /*
+     * Record the delta of every pair of adjacent stamped stages and the end to end latency of a batch
+     * from the sink devId. The sink stamps are translated by the clock estimate of the sink, without one
+     * the stages crossing devices are not recorded.
+     */
+    void RecordBatch(const std::string &devId, const TraceStamps &stamps);
+    std::vector<TraceStageSummary> GetStageSummaries();
+
+private:
+    DInputLatencyTrace() = default;
+    ~DInputLatencyTrace() = default;
+
+    std::atomic<bool> enabled_ = false;
+    std::mutex histogramMutex_;
+    // index 0 holds the end to end latency, index i holds the delta between stage i - 1 and stage i.
+    std::array<LatencyHistogram, TRACE_STAGE_NUM> stageHistograms_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_LATENCY_TRACE_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINPUT_METRICS_H
+#define DINPUT_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "single_instance.h"
+
+#include "dinput_latency_histogram.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+enum class MetricCounter : uint32_t {
+    EVENTS_READ = 0,
+    EVENTS_FILTERED,
+    BATCHES_SENT,
+    BYTES_SENT,
+    SEND_FAILURES,
+    PARSE_FAILURES,
+    EVENTS_INJECTED,
+    INJECT_WRITE_ERRORS,
+    CAPABILITY_CACHE_HITS,
+    CAPABILITY_CACHE_MISSES,
+    VIRTUAL_DEVICE_POOL_HITS,
+    VIRTUAL_DEVICE_POOL_MISSES,
+    VIRTUAL_DEVICE_POOL_EVICTIONS,
+    // events merged away by the sink while the link is congested.
+    SINK_EVENTS_COALESCED,
+    COUNTER_NUM,
+};
+
+enum class MetricGauge : uint32_t {
+    SINK_SEND_QUEUE_DEPTH = 0,
+    INJECT_QUEUE_DEPTH,
+    // the CongestionMode of the sink: 0 normal, 1 congested, 2 severe.
+    SINK_CONGESTION_MODE,
+    GAUGE_NUM,
+};
+
+enum class MetricHistogram : uint32_t {
+    EVENTS_PER_BATCH = 0,
+    INJECT_BATCH_COST_US,
+    DEVICE_PROBE_COST_US,
+    // the sink kernel event time translated by the estimated clock offset, to the uinput write on the source.
+    SINK_KERNEL_TO_INJECT_US,
+    HISTOGRAM_NUM,
+};
+
+constexpr size_t METRIC_COUNTER_NUM = static_cast<size_t>(MetricCounter::COUNTER_NUM);
+constexpr size_t METRIC_GAUGE_NUM = static_cast<size_t>(MetricGauge::GAUGE_NUM);
+constexpr size_t METRIC_HISTOGRAM_NUM = static_cast<size_t>(MetricHistogram::HISTOGRAM_NUM);
+
+struct DeviceEventMetric {
+    uint64_t events = 0;
+    // events per second since the previous snapshot.
+    uint64_t rate = 0;
+};
+
+struct MetricsSnapshot {
+    std::array<uint64_t, METRIC_COUNTER_NUM> counters {};
+    std::array<int64_t, METRIC_GAUGE_NUM> gauges {};
+    std::array<LatencySummary, METRIC_HISTOGRAM_NUM> histograms {};
+    // the map's key is dhId.
+    std::map<std::string, DeviceEventMetric> devices;
+};
+
+/*
+ * Process wide input metrics. Every writing thread owns a shard, counters are relaxed atomics
+ * only written by the owner, histograms and device counts are guarded by a per shard mutex that
+ * is only contended while a snapshot is taken. Shards are aggregated on read and recycled by
+ * new threads once their owner exits, so totals survive thread restarts.
+ */
+class DInputMetrics {
+DECLARE_SINGLE_INSTANCE_BASE(DInputMetrics);
+public:
+    void AddCounter(MetricCounter counter, uint64_t value = 1);
+    void SetGauge(MetricGauge gauge, int64_t value);
+    void AddGauge(MetricGauge gauge, int64_t delta);
+    void RecordHistogram(MetricHistogram histogram, uint64_t value);
+    void AddDeviceEvents(const std::string &dhId, uint64_t count);
+
+    /*
+     * The rates are taken over the time since the previous snapshot of the same reader, so readers
+     * polling at their own pace do not shorten each other's window.
+     */
+    MetricsSnapshot GetSnapshot(const std::string &reader = "");
+    void Reset();
+
+    static const char *GetCounterName(MetricCounter counter);
+    static const char *GetGaugeName(MetricGauge gauge);
+    static const char *GetHistogramName(MetricHistogram histogram);
+
+private:
+    DInputMetrics() = default;
+    ~DInputMetrics() = default;
+
+    struct MetricsShard {
+        std::atomic<bool> inUse = true;
+        std::array<std::atomic<uint64_t>, METRIC_COUNTER_NUM> counters {};
+        std::mutex mutex;
+        std::array<LatencyHistogram, METRIC_HISTOGRAM_NUM> histograms;
+        std::unordered_map<std::string, uint64_t> deviceEvents;
+    };
+    struct ShardHolder {
+        std::shared_ptr<MetricsShard> shard;
+        ~ShardHolder();
+    };
+    MetricsShard &GetLocalShard();
+
+    std::mutex shardsMutex_;
+    std::vector<std::shared_ptr<MetricsShard>> shards_;
+    std::array<std::atomic<int64_t>, METRIC_GAUGE_NUM> gauges_ {};
+
+    struct RateBaseline {
+        uint64_t snapshotTime = 0;
+        std::unordered_map<std::string, uint64_t> deviceEvents;
+    };
+    std::mutex rateMutex_;
+    // the map's key is the reader.
+    std::unordered_map<std::string, RateBaseline> rateBaselines_;
+};
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
+
+#endif // DINPUT_METRICS_H
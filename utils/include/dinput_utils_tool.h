@@ -27,6 +27,8 @@
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
+struct InputDevice;
+
 struct DevInfo {
     std::string networkId;
     std::string deviceName;
@@ -55,19 +57,27 @@ void CloseFd(int &fd);
 int BitIsSet(const unsigned long *array, int bit);
 void SplitStringToVector(const std::string &str, const char split, std::vector<std::string> &vecStr);
 int OpenInputDeviceFdByPath(const std::string &devicePath);
+/*
+ * Open the input node for read and write once it is usable. A node that does not exist yet or is not
+ * accessible yet is waited for with inotify, until the node is created or its attributes change, up to
+ * timeoutMs. Return the fd, or -1 if the node is not usable by then.
+ */
+int OpenInputDeviceFdWhenReady(const std::string &devicePath, uint32_t timeoutMs);
 std::string ConvertErrNo();
 void ScanInputDevicesPath(const std::string &dirName, std::vector<std::string> &vecInputDevPath);
 
-/**
- * If we pressed the sink keyboard while mouse pass throuth from source to sink, we need reset the virtual keyboard
- * key states at the source side.
- */
-void ResetVirtualDevicePressedKeys(const std::vector<std::string> &nodePaths);
-
 std::string GetString(const std::vector<std::string> &vec);
 int32_t GetRandomInt32(int32_t randMin, int32_t randMax);
 std::string JointDhIds(const std::vector<std::string> &dhids);
 std::vector<std::string> SplitDhIdString(const std::string &dhIdsString);
+/*
+ * The capability json of the device, as reported by the sink in Query.
+ */
+std::string InputDeviceToJson(const InputDevice &device);
+/*
+ * The reverse of InputDeviceToJson, the keys missing from the json are left untouched.
+ */
+bool JsonToInputDevice(const std::string &capability, InputDevice &device);
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
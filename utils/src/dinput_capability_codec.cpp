@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_capability_codec.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint32_t BITS_PER_BYTE = 8;
+    // KEY_CNT is the largest code space of the bitmaps.
+    constexpr uint32_t MAX_BITMAP_BYTES = 0x300 / BITS_PER_BYTE;
+    constexpr size_t MAX_ABS_VALUE_NUM = 0xff;
+    constexpr uint32_t BASE64_GROUP_BYTES = 3;
+    constexpr uint32_t BASE64_GROUP_CHARS = 4;
+    constexpr uint32_t BASE64_BITS_PER_CHAR = 6;
+    constexpr uint32_t BASE64_CHAR_MASK = 0x3f;
+    constexpr uint32_t BYTE_MASK = 0xff;
+    const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char BASE64_PAD = '=';
+
+    class DescriptorWriter {
+    public:
+        void PutU8(uint8_t value)
+        {
+            buffer_.push_back(static_cast<char>(value));
+        }
+        void PutU16(uint16_t value)
+        {
+            PutU8(static_cast<uint8_t>(value & BYTE_MASK));
+            PutU8(static_cast<uint8_t>(value >> BITS_PER_BYTE));
+        }
+        void PutU32(uint32_t value)
+        {
+            PutU16(static_cast<uint16_t>(value & 0xffff));
+            PutU16(static_cast<uint16_t>(value >> (BITS_PER_BYTE * 2)));
+        }
+        void PutString(const std::string &value)
+        {
+            size_t len = std::min<size_t>(value.size(), UINT16_MAX);
+            PutU16(static_cast<uint16_t>(len));
+            buffer_.append(value, 0, len);
+        }
+        void PutBitmap(const std::vector<uint32_t> &codes)
+        {
+            std::string bitmap;
+            for (uint32_t code : codes) {
+                if (code / BITS_PER_BYTE >= MAX_BITMAP_BYTES) {
+                    DHLOGE("Code %{public}u is out of the bitmap range", code);
+                    continue;
+                }
+                if (bitmap.size() <= code / BITS_PER_BYTE) {
+                    bitmap.resize(code / BITS_PER_BYTE + 1, '\0');
+                }
+                bitmap[code / BITS_PER_BYTE] = static_cast<char>(
+                    static_cast<uint8_t>(bitmap[code / BITS_PER_BYTE]) | (1u << (code % BITS_PER_BYTE)));
+            }
+            PutU16(static_cast<uint16_t>(bitmap.size()));
+            buffer_.append(bitmap);
+        }
+        const std::string &GetBuffer() const
+        {
+            return buffer_;
+        }
+
+    private:
+        std::string buffer_;
+    };
+
+    class DescriptorReader {
+    public:
+        explicit DescriptorReader(const std::string &buffer) : buffer_(buffer) {}
+
+        bool GetU8(uint8_t &value)
+        {
+            if (pos_ + 1 > buffer_.size()) {
+                return false;
+            }
+            value = static_cast<uint8_t>(buffer_[pos_++]);
+            return true;
+        }
+        bool GetU16(uint16_t &value)
+        {
+            uint8_t low = 0;
+            uint8_t high = 0;
+            if (!GetU8(low) || !GetU8(high)) {
+                return false;
+            }
+            value = static_cast<uint16_t>(low | (high << BITS_PER_BYTE));
+            return true;
+        }
+        bool GetU32(uint32_t &value)
+        {
+            uint16_t low = 0;
+            uint16_t high = 0;
+            if (!GetU16(low) || !GetU16(high)) {
+                return false;
+            }
+            value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << (BITS_PER_BYTE * 2));
+            return true;
+        }
+        bool GetString(std::string &value)
+        {
+            uint16_t len = 0;
+            if (!GetU16(len) || pos_ + len > buffer_.size()) {
+                return false;
+            }
+            value.assign(buffer_, pos_, len);
+            pos_ += len;
+            return true;
+        }
+        bool GetBitmap(std::vector<uint32_t> &codes)
+        {
+            uint16_t len = 0;
+            if (!GetU16(len) || len > MAX_BITMAP_BYTES || pos_ + len > buffer_.size()) {
+                return false;
+            }
+            codes.clear();
+            for (uint32_t byte = 0; byte < len; byte++) {
+                uint8_t bits = static_cast<uint8_t>(buffer_[pos_ + byte]);
+                for (uint32_t bit = 0; bit < BITS_PER_BYTE; bit++) {
+                    if ((bits & (1u << bit)) != 0) {
+                        codes.push_back(byte * BITS_PER_BYTE + bit);
+                    }
+                }
+            }
+            pos_ += len;
+            return true;
+        }
+
+    private:
+        const std::string &buffer_;
+        size_t pos_ = 0;
+    };
+
+    std::string Base64Encode(const std::string &data)
+    {
+        std::string out;
+        out.reserve((data.size() + BASE64_GROUP_BYTES - 1) / BASE64_GROUP_BYTES * BASE64_GROUP_CHARS);
+        for (size_t i = 0; i < data.size(); i += BASE64_GROUP_BYTES) {
+            size_t remain = std::min<size_t>(BASE64_GROUP_BYTES, data.size() - i);
+            uint32_t group = 0;
+            for (size_t j = 0; j < BASE64_GROUP_BYTES; j++) {
+                uint32_t byte = (j < remain) ? static_cast<uint8_t>(data[i + j]) : 0;
+                group = (group << BITS_PER_BYTE) | byte;
+            }
+            for (size_t j = 0; j < BASE64_GROUP_CHARS; j++) {
+                if (j > remain) {
+                    out.push_back(BASE64_PAD);
+                    continue;
+                }
+                uint32_t shift = (BASE64_GROUP_CHARS - 1 - j) * BASE64_BITS_PER_CHAR;
+                out.push_back(BASE64_CHARS[(group >> shift) & BASE64_CHAR_MASK]);
+            }
+        }
+        return out;
+    }
+
+    bool Base64Decode(const std::string &text, size_t offset, std::string &data)
+    {
+        if ((text.size() - offset) % BASE64_GROUP_CHARS != 0) {
+            return false;
+        }
+        data.clear();
+        for (size_t i = offset; i < text.size(); i += BASE64_GROUP_CHARS) {
+            uint32_t group = 0;
+            size_t padNum = 0;
+            for (size_t j = 0; j < BASE64_GROUP_CHARS; j++) {
+                char ch = text[i + j];
+                uint32_t value = 0;
+                if (ch == BASE64_PAD && i + BASE64_GROUP_CHARS == text.size() && j >= BASE64_GROUP_CHARS - 2) {
+                    padNum++;
+                } else if (padNum > 0) {
+                    return false;
+                } else {
+                    const char *pos = std::find(std::begin(BASE64_CHARS), std::end(BASE64_CHARS) - 1, ch);
+                    if (pos == std::end(BASE64_CHARS) - 1) {
+                        return false;
+                    }
+                    value = static_cast<uint32_t>(pos - BASE64_CHARS);
+                }
+                group = (group << BASE64_BITS_PER_CHAR) | value;
+            }
+            for (size_t j = 0; j < BASE64_GROUP_BYTES - padNum; j++) {
+                uint32_t shift = (BASE64_GROUP_BYTES - 1 - j) * BITS_PER_BYTE;
+                data.push_back(static_cast<char>((group >> shift) & BYTE_MASK));
+            }
+        }
+        return true;
+    }
+
+    bool ReadAbsInfos(DescriptorReader &reader, std::map<uint32_t, std::vector<int32_t>> &absInfos)
+    {
+        uint16_t count = 0;
+        if (!reader.GetU16(count)) {
+            return false;
+        }
+        absInfos.clear();
+        for (uint16_t i = 0; i < count; i++) {
+            uint16_t code = 0;
+            uint8_t valueNum = 0;
+            if (!reader.GetU16(code) || !reader.GetU8(valueNum)) {
+                return false;
+            }
+            std::vector<int32_t> &values = absInfos[code];
+            for (uint8_t j = 0; j < valueNum; j++) {
+                uint32_t value = 0;
+                if (!reader.GetU32(value)) {
+                    return false;
+                }
+                values.push_back(static_cast<int32_t>(value));
+            }
+        }
+        return true;
+    }
+}
+
+std::string InputDeviceToDescriptor(const InputDevice &device)
+{
+    DescriptorWriter writer;
+    writer.PutU32(CAPABILITY_DESCRIPTOR_MAGIC);
+    writer.PutU8(CAPABILITY_DESCRIPTOR_VERSION);
+    writer.PutU8(0);
+    writer.PutString(device.name);
+    writer.PutString(device.physicalPath);
+    writer.PutString(device.uniqueId);
+    writer.PutString(device.descriptor);
+    writer.PutU16(device.bus);
+    writer.PutU16(device.vendor);
+    writer.PutU16(device.product);
+    writer.PutU16(device.version);
+    writer.PutU32(device.classes);
+    for (const auto *codes : { &device.eventTypes, &device.eventKeys, &device.relTypes, &device.absTypes,
+        &device.properties, &device.miscellaneous, &device.leds, &device.switchs, &device.repeats }) {
+        writer.PutBitmap(*codes);
+    }
+    writer.PutU16(static_cast<uint16_t>(device.absInfos.size()));
+    for (const auto &[code, values] : device.absInfos) {
+        size_t valueNum = std::min(values.size(), MAX_ABS_VALUE_NUM);
+        writer.PutU16(static_cast<uint16_t>(code));
+        writer.PutU8(static_cast<uint8_t>(valueNum));
+        for (size_t i = 0; i < valueNum; i++) {
+            writer.PutU32(static_cast<uint32_t>(values[i]));
+        }
+    }
+    return CAPABILITY_DESCRIPTOR_PREFIX + Base64Encode(writer.GetBuffer());
+}
+
+bool IsCapabilityDescriptor(const std::string &capability)
+{
+    return capability.compare(0, CAPABILITY_DESCRIPTOR_PREFIX.size(), CAPABILITY_DESCRIPTOR_PREFIX) == 0;
+}
+
+bool DescriptorToInputDevice(const std::string &capability, InputDevice &device)
+{
+    std::string buffer;
+    if (!IsCapabilityDescriptor(capability) ||
+        !Base64Decode(capability, CAPABILITY_DESCRIPTOR_PREFIX.size(), buffer)) {
+        DHLOGE("The capability is not a descriptor");
+        return false;
+    }
+    DescriptorReader reader(buffer);
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint8_t reserved = 0;
+    if (!reader.GetU32(magic) || magic != CAPABILITY_DESCRIPTOR_MAGIC || !reader.GetU8(version) ||
+        version < CAPABILITY_DESCRIPTOR_VERSION || !reader.GetU8(reserved)) {
+        DHLOGE("The descriptor header is invalid");
+        return false;
+    }
+    InputDevice parsed;
+    bool ret = reader.GetString(parsed.name) && reader.GetString(parsed.physicalPath) &&
+        reader.GetString(parsed.uniqueId) && reader.GetString(parsed.descriptor) && reader.GetU16(parsed.bus) &&
+        reader.GetU16(parsed.vendor) && reader.GetU16(parsed.product) && reader.GetU16(parsed.version) &&
+        reader.GetU32(parsed.classes);
+    for (auto *codes : { &parsed.eventTypes, &parsed.eventKeys, &parsed.relTypes, &parsed.absTypes,
+        &parsed.properties, &parsed.miscellaneous, &parsed.leds, &parsed.switchs, &parsed.repeats }) {
+        ret = ret && reader.GetBitmap(*codes);
+    }
+    if (!ret || !ReadAbsInfos(reader, parsed.absInfos)) {
+        DHLOGE("The descriptor is truncated");
+        return false;
+    }
+    device = std::move(parsed);
+    return true;
+}
+
+CapabilityParseCache::CapabilityParseCache(size_t capacity) : capacity_(capacity)
+{
+}
+
+bool CapabilityParseCache::ParseUncached(const std::string &capability, InputDevice &device)
+{
+    if (IsCapabilityDescriptor(capability)) {
+        return DescriptorToInputDevice(capability, device);
+    }
+    return JsonToInputDevice(capability, device);
+}
+
+bool CapabilityParseCache::Parse(const std::string &capability, InputDevice &device)
+{
+    std::string hash = Sha256(capability);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = devices_.find(hash);
+        if (iter != devices_.end()) {
+            device = iter->second;
+            lru_.remove(hash);
+            lru_.push_front(hash);
+            hitNum_++;
+            return true;
+        }
+    }
+    InputDevice parsed;
+    if (!ParseUncached(capability, parsed)) {
+        return false;
+    }
+    device = parsed;
+    if (capacity_ == 0) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (devices_.count(hash) == 0) {
+        if (devices_.size() >= capacity_ && !lru_.empty()) {
+            devices_.erase(lru_.back());
+            lru_.pop_back();
+        }
+        lru_.push_front(hash);
+    }
+    devices_[hash] = std::move(parsed);
+    return true;
+}
+
+size_t CapabilityParseCache::GetHitNum()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return hitNum_;
+}
+
+void CapabilityParseCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    lru_.clear();
+    devices_.clear();
+    hitNum_ = 0;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_clock_sync.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    // samples up to this much slower than the fastest one are still trusted.
+    constexpr uint64_t DELAY_SLACK_US = 200;
+    // the drift is only fitted once the trusted samples span this long, shorter spans are dominated by jitter.
+    constexpr uint64_t MIN_DRIFT_SPAN_US = 2 * 1000 * 1000;
+    // crystal oscillators stay well within this, a steeper slope is a clock step rather than a drift.
+    constexpr double MAX_DRIFT = 500.0 / 1000000.0;
+    constexpr double PPM = 1000000.0;
+}
+IMPLEMENT_SINGLE_INSTANCE(DInputClockSync);
+
+bool ClockOffsetEstimator::AddSample(const ClockSample &sample)
+{
+    if (sample.t4 < sample.t1 || sample.t3 < sample.t2) {
+        return false;
+    }
+    uint64_t roundTripUs = sample.t4 - sample.t1;
+    uint64_t remoteHoldUs = sample.t3 - sample.t2;
+    OffsetSample offsetSample;
+    offsetSample.localUs = sample.t1 + roundTripUs / 2;
+    offsetSample.offsetUs = ((static_cast<int64_t>(sample.t2) - static_cast<int64_t>(sample.t1)) +
+        (static_cast<int64_t>(sample.t3) - static_cast<int64_t>(sample.t4))) / 2;
+    offsetSample.delayUs = roundTripUs > remoteHoldUs ? roundTripUs - remoteHoldUs : 0;
+    // a wall clock stepped back invalidates the line fitted so far.
+    if (!samples_.empty() && offsetSample.localUs < samples_.back().localUs) {
+        samples_.clear();
+    }
+    samples_.push_back(offsetSample);
+    if (samples_.size() > SAMPLE_WINDOW) {
+        samples_.pop_front();
+    }
+    Update();
+    return true;
+}
+
+void ClockOffsetEstimator::Update()
+{
+    minDelayUs_ = UINT64_MAX;
+    for (const auto &sample : samples_) {
+        minDelayUs_ = std::min(minDelayUs_, sample.delayUs);
+    }
+    uint64_t threshold = minDelayUs_ + std::max(minDelayUs_, DELAY_SLACK_US);
+    refLocalUs_ = samples_.back().localUs;
+
+    double sumX = 0;
+    double sumY = 0;
+    size_t count = 0;
+    uint64_t firstLocalUs = refLocalUs_;
+    for (const auto &sample : samples_) {
+        if (sample.delayUs > threshold) {
+            continue;
+        }
+        sumX += -static_cast<double>(refLocalUs_ - sample.localUs);
+        sumY += static_cast<double>(sample.offsetUs);
+        firstLocalUs = std::min(firstLocalUs, sample.localUs);
+        count++;
+    }
+    double meanX = sumX / count;
+    double meanY = sumY / count;
+
+    drift_ = 0;
+    if (count >= 2 && refLocalUs_ - firstLocalUs >= MIN_DRIFT_SPAN_US) {
+        double varX = 0;
+        double covXY = 0;
+        for (const auto &sample : samples_) {
+            if (sample.delayUs > threshold) {
+                continue;
+            }
+            double dx = -static_cast<double>(refLocalUs_ - sample.localUs) - meanX;
+            varX += dx * dx;
+            covXY += dx * (static_cast<double>(sample.offsetUs) - meanY);
+        }
+        if (varX > 0) {
+            drift_ = std::clamp(covXY / varX, -MAX_DRIFT, MAX_DRIFT);
+        }
+    }
+    refOffsetUs_ = meanY - drift_ * meanX;
+    hasEstimate_ = true;
+}
+
+bool ClockOffsetEstimator::HasEstimate() const
+{
+    return hasEstimate_;
+}
+
+int64_t ClockOffsetEstimator::GetOffsetUs(uint64_t localUs) const
+{
+    double elapsedUs = localUs >= refLocalUs_ ? static_cast<double>(localUs - refLocalUs_) :
+        -static_cast<double>(refLocalUs_ - localUs);
+    return static_cast<int64_t>(std::llround(refOffsetUs_ + drift_ * elapsedUs));
+}
+
+ClockEstimate ClockOffsetEstimator::GetEstimate(uint64_t localUs) const
+{
+    ClockEstimate estimate;
+    if (!hasEstimate_) {
+        return estimate;
+    }
+    estimate.offsetUs = GetOffsetUs(localUs);
+    estimate.driftPpm = drift_ * PPM;
+    estimate.minDelayUs = minDelayUs_;
+    return estimate;
+}
+
+uint64_t ClockOffsetEstimator::RemoteToLocalUs(uint64_t remoteUs) const
+{
+    // the offset changes by the drift times the offset itself between the two readings, far below a microsecond.
+    int64_t localUs = static_cast<int64_t>(remoteUs) - GetOffsetUs(remoteUs);
+    return localUs > 0 ? static_cast<uint64_t>(localUs) : 0;
+}
+
+void ClockOffsetEstimator::Reset()
+{
+    samples_.clear();
+    hasEstimate_ = false;
+    refLocalUs_ = 0;
+    refOffsetUs_ = 0;
+    drift_ = 0;
+    minDelayUs_ = 0;
+}
+
+void DInputClockSync::AddSample(const std::string &devId, const ClockSample &sample)
+{
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    if (!estimators_[devId].AddSample(sample)) {
+        DHLOGW("Drop unordered clock sample of devId: %{public}s", GetAnonyString(devId).c_str());
+    }
+}
+
+bool DInputClockSync::GetEstimate(const std::string &devId, ClockEstimate &estimate)
+{
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    auto iter = estimators_.find(devId);
+    if (iter == estimators_.end() || !iter->second.HasEstimate()) {
+        return false;
+    }
+    estimate = iter->second.GetEstimate(GetCurrentTimeUs());
+    return true;
+}
+
+bool DInputClockSync::RemoteToLocalUs(const std::string &devId, uint64_t remoteUs, uint64_t &localUs)
+{
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    auto iter = estimators_.find(devId);
+    if (iter == estimators_.end() || !iter->second.HasEstimate()) {
+        return false;
+    }
+    localUs = iter->second.RemoteToLocalUs(remoteUs);
+    return true;
+}
+
+void DInputClockSync::RemoveDevice(const std::string &devId)
+{
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    estimators_.erase(devId);
+}
+
+void DInputClockSync::Clear()
+{
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    estimators_.clear();
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
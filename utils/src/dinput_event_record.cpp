@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_event_record.h"
+
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+#include <fcntl.h>
+#include <linux/input.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+#include "dinput_errcode.h"
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+IMPLEMENT_SINGLE_INSTANCE(DInputEventRecorder);
+IMPLEMENT_SINGLE_INSTANCE(DInputEventReplayer);
+namespace {
+    constexpr uint8_t CHUNK_DEVICE = 1;
+    constexpr uint8_t CHUNK_EVENT_BATCH = 2;
+    constexpr uint32_t MAX_RECORD_STRING_LEN = 64 * 1024;
+    constexpr uint32_t MAX_RECORD_BATCH_SIZE = 64 * 1024;
+    constexpr int64_t NS_PER_US = 1000;
+    constexpr const char *EVENT_REPLAY_THREAD_NAME = "eventReplay";
+    constexpr size_t MAX_RECORD_FILE_NAME_LEN = 64;
+    constexpr mode_t RECORD_DIR_MODE = 0700;
+    constexpr mode_t RECORD_FILE_MODE = 0600;
+
+    bool IsValidRecordFileName(const std::string &fileName)
+    {
+        if (fileName.empty() || fileName.size() > MAX_RECORD_FILE_NAME_LEN || fileName.find("..") != std::string::npos) {
+            return false;
+        }
+        for (char ch : fileName) {
+            if (!isalnum(static_cast<unsigned char>(ch)) && ch != '_' && ch != '-' && ch != '.') {
+                return false;
+            }
+        }
+        return fileName.front() != '.';
+    }
+
+    // key events and scan codes tell what was typed.
+    bool IsPrivateEvent(const RawEvent &event)
+    {
+        return event.type == EV_KEY || (event.type == EV_MSC && event.code == MSC_SCAN);
+    }
+
+    template<typename T>
+    void AppendValue(std::string &buffer, T value)
+    {
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void AppendString(std::string &buffer, const std::string &value)
+    {
+        AppendValue<uint32_t>(buffer, static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    class RecordReader {
+    public:
+        explicit RecordReader(const std::string &buffer) : buffer_(buffer) {}
+
+        template<typename T>
+        bool Read(T &value)
+        {
+            if (buffer_.size() - offset_ < sizeof(T)) {
+                return false;
+            }
+            if (memcpy_s(&value, sizeof(T), buffer_.data() + offset_, sizeof(T)) != EOK) {
+                return false;
+            }
+            offset_ += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(std::string &value)
+        {
+            uint32_t len = 0;
+            if (!Read(len) || len > MAX_RECORD_STRING_LEN || buffer_.size() - offset_ < len) {
+                return false;
+            }
+            value.assign(buffer_, offset_, len);
+            offset_ += len;
+            return true;
+        }
+
+        bool IsEnd() const
+        {
+            return offset_ >= buffer_.size();
+        }
+
+    private:
+        const std::string &buffer_;
+        size_t offset_ = 0;
+    };
+
+    bool ReadDeviceChunk(RecordReader &reader, EventRecording &recording)
+    {
+        uint16_t index = 0;
+        RecordedDevice device;
+        if (!reader.Read(index) || !reader.ReadString(device.dhId) || !reader.ReadString(device.path) ||
+            !reader.ReadString(device.capability)) {
+            return false;
+        }
+        if (index != recording.devices.size()) {
+            DHLOGE("Record device index %{public}d is out of order.", index);
+            return false;
+        }
+        recording.devices.push_back(device);
+        return true;
+    }
+
+    bool ReadEventBatchChunk(RecordReader &reader, EventRecording &recording)
+    {
+        uint32_t count = 0;
+        if (!reader.Read(count) || count == 0 || count > MAX_RECORD_BATCH_SIZE) {
+            return false;
+        }
+        std::vector<RawEvent> batch;
+        batch.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            int64_t when = 0;
+            uint16_t index = 0;
+            uint16_t type = 0;
+            uint16_t code = 0;
+            int32_t value = 0;
+            if (!reader.Read(when) || !reader.Read(index) || !reader.Read(type) || !reader.Read(code) ||
+                !reader.Read(value) || index >= recording.devices.size()) {
+                return false;
+            }
+            const RecordedDevice &device = recording.devices[index];
+            batch.push_back({ when, type, code, value, device.dhId, device.path });
+        }
+        recording.eventNum += count;
+        recording.batches.push_back(std::move(batch));
+        return true;
+    }
+}
+
+int32_t GetEventRecordPath(const std::string &fileName, std::string &filePath)
+{
+    if (!IsValidRecordFileName(fileName)) {
+        DHLOGE("Record file name is invalid.");
+        return ERR_DH_INPUT_RECORD_FILE_INVALID;
+    }
+    filePath = EVENT_RECORD_DIR + fileName;
+    return DH_SUCCESS;
+}
+
+int32_t LoadEventRecording(const std::string &filePath, EventRecording &recording)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        DHLOGE("Open record file failed.");
+        return ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL;
+    }
+    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    RecordReader reader(buffer);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(reserved) ||
+        magic != EVENT_RECORD_MAGIC || version != EVENT_RECORD_VERSION) {
+        DHLOGE("Record file header is invalid.");
+        return ERR_DH_INPUT_RECORD_FILE_INVALID;
+    }
+    recording = {};
+    while (!reader.IsEnd()) {
+        uint8_t tag = 0;
+        bool ret = reader.Read(tag);
+        if (ret && tag == CHUNK_DEVICE) {
+            ret = ReadDeviceChunk(reader, recording);
+        } else if (ret && tag == CHUNK_EVENT_BATCH) {
+            ret = ReadEventBatchChunk(reader, recording);
+        } else {
+            ret = false;
+        }
+        if (!ret) {
+            DHLOGW("Record file is truncated, drop the tail.");
+            break;
+        }
+    }
+    DHLOGI("Load record file, devices: %{public}zu, batches: %{public}zu, events: %{public}zu.",
+        recording.devices.size(), recording.batches.size(), recording.eventNum);
+    return DH_SUCCESS;
+}
+
+DInputEventRecorder::~DInputEventRecorder()
+{
+    Stop();
+}
+
+int32_t DInputEventRecorder::Start(const std::string &fileName)
+{
+    std::string filePath;
+    int32_t ret = GetEventRecordPath(fileName, filePath);
+    if (ret != DH_SUCCESS) {
+        return ret;
+    }
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    if (file_ != nullptr) {
+        DHLOGE("Event recording is already started.");
+        return ERR_DH_INPUT_RECORD_IS_BUSY;
+    }
+    if (mkdir(EVENT_RECORD_DIR.c_str(), RECORD_DIR_MODE) != 0 && errno != EEXIST) {
+        DHLOGE("Create record dir failed, %{public}s.", ConvertErrNo().c_str());
+        return ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL;
+    }
+    int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, RECORD_FILE_MODE);
+    if (fd < 0) {
+        DHLOGE("Open record file failed, %{public}s.", ConvertErrNo().c_str());
+        return ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL;
+    }
+    file_ = fdopen(fd, "wb");
+    if (file_ == nullptr) {
+        DHLOGE("Open record file failed, %{public}s.", ConvertErrNo().c_str());
+        (void)close(fd);
+        return ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL;
+    }
+    std::string header;
+    AppendValue<uint32_t>(header, EVENT_RECORD_MAGIC);
+    AppendValue<uint16_t>(header, EVENT_RECORD_VERSION);
+    AppendValue<uint16_t>(header, 0);
+    if (!WriteLocked(header)) {
+        CloseFileLocked();
+        return ERR_DH_INPUT_RECORD_WRITE_FAIL;
+    }
+    deviceIndexes_.clear();
+    eventNum_ = 0;
+    recording_.store(true);
+    DHLOGI("Event recording started.");
+    return DH_SUCCESS;
+}
+
+void DInputEventRecorder::Stop()
+{
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    if (file_ == nullptr) {
+        return;
+    }
+    CloseFileLocked();
+    DHLOGI("Event recording stopped, devices: %{public}zu, events: %{public}zu.", deviceIndexes_.size(), eventNum_);
+}
+
+bool DInputEventRecorder::HasDevice(const std::string &dhId)
+{
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return deviceIndexes_.find(dhId) != deviceIndexes_.end();
+}
+
+void DInputEventRecorder::RecordDevice(const std::string &dhId, const std::string &path,
+    const std::string &capability)
+{
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    if (file_ == nullptr || deviceIndexes_.find(dhId) != deviceIndexes_.end() ||
+        deviceIndexes_.size() >= std::numeric_limits<uint16_t>::max()) {
+        return;
+    }
+    uint16_t index = static_cast<uint16_t>(deviceIndexes_.size());
+    std::string chunk;
+    AppendValue<uint8_t>(chunk, CHUNK_DEVICE);
+    AppendValue<uint16_t>(chunk, index);
+    AppendString(chunk, dhId);
+    AppendString(chunk, path);
+    AppendString(chunk, capability);
+    if (WriteLocked(chunk)) {
+        deviceIndexes_[dhId] = index;
+    }
+}
+
+void DInputEventRecorder::RecordEvents(const RawEvent *events, size_t count)
+{
+    if (events == nullptr || count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    if (file_ == nullptr) {
+        return;
+    }
+    std::string body;
+    uint32_t recordedNum = 0;
+    for (size_t i = 0; i < count; i++) {
+        auto iter = deviceIndexes_.find(events[i].descriptor);
+        if (iter == deviceIndexes_.end() || IsPrivateEvent(events[i])) {
+            continue;
+        }
+        AppendValue<int64_t>(body, events[i].when);
+        AppendValue<uint16_t>(body, iter->second);
+        AppendValue<uint16_t>(body, static_cast<uint16_t>(events[i].type));
+        AppendValue<uint16_t>(body, static_cast<uint16_t>(events[i].code));
+        AppendValue<int32_t>(body, events[i].value);
+        recordedNum++;
+    }
+    if (recordedNum == 0) {
+        return;
+    }
+    std::string chunk;
+    AppendValue<uint8_t>(chunk, CHUNK_EVENT_BATCH);
+    AppendValue<uint32_t>(chunk, recordedNum);
+    chunk.append(body);
+    if (WriteLocked(chunk)) {
+        eventNum_ += recordedNum;
+    }
+}
+
+size_t DInputEventRecorder::GetRecordedEventNum()
+{
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return eventNum_;
+}
+
+void DInputEventRecorder::CloseFileLocked()
+{
+    recording_.store(false);
+    if (file_ != nullptr) {
+        (void)fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool DInputEventRecorder::WriteLocked(const std::string &buffer)
+{
+    if (fwrite(buffer.data(), 1, buffer.size(), file_) != buffer.size()) {
+        DHLOGE("Write record file failed, stop recording.");
+        CloseFileLocked();
+        return false;
+    }
+    return true;
+}
+
+DInputEventReplayer::~DInputEventReplayer()
+{
+    StopReplay();
+}
+
+void DInputEventReplayer::RegisterBatchCallback(ReplayBatchCallback callback)
+{
+    std::lock_guard<std::mutex> lock(replayMutex_);
+    callback_ = callback;
+}
+
+bool ReplayControl::WaitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !stopCondition_.wait_until(lock, deadline, [this]() { return isStopped_; });
+}
+
+void ReplayControl::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+    }
+    stopCondition_.notify_all();
+}
+
+bool ReplayControl::IsStopped()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isStopped_;
+}
+
+int32_t DInputEventReplayer::StartReplay(const std::string &fileName, double speed, EventRecording &recording)
+{
+    std::string filePath;
+    int32_t ret = GetEventRecordPath(fileName, filePath);
+    if (ret != DH_SUCCESS) {
+        return ret;
+    }
+    std::lock_guard<std::mutex> lock(replayMutex_);
+    if (replaying_.load()) {
+        DHLOGE("Event replay is already running.");
+        return ERR_DH_INPUT_REPLAY_IS_BUSY;
+    }
+    if (callback_ == nullptr) {
+        DHLOGE("No pipeline registered for replay.");
+        return ERR_DH_INPUT_POINTER_NULL;
+    }
+    ret = LoadEventRecording(filePath, recording);
+    if (ret != DH_SUCCESS) {
+        return ret;
+    }
+    // the previous replay has finished, it only waits to be joined.
+    if (replayThread_.joinable()) {
+        replayThread_.join();
+    }
+    replaying_.store(true);
+    replayControl_ = std::make_shared<ReplayControl>();
+    replayThread_ = std::thread([this, recording, speed, callback = callback_, control = replayControl_]() {
+        int32_t ret = pthread_setname_np(pthread_self(), EVENT_REPLAY_THREAD_NAME);
+        if (ret != 0) {
+            DHLOGE("eventReplay setname failed.");
+        }
+        uint64_t startUs = GetCurrentTimeUs();
+        size_t eventNum = Replay(recording, speed, callback, *control);
+        DHLOGI("Event replay finished, events: %{public}zu, cost: %{public}" PRIu64 "us.", eventNum,
+            GetCurrentTimeUs() - startUs);
+        replaying_.store(false);
+    });
+    return DH_SUCCESS;
+}
+
+void DInputEventReplayer::StopReplay()
+{
+    std::thread replayThread;
+    {
+        std::lock_guard<std::mutex> lock(replayMutex_);
+        if (replayControl_ != nullptr) {
+            replayControl_->Stop();
+        }
+        replayThread = std::move(replayThread_);
+    }
+    // the replay wakes up at once, joining outside the lock keeps StartReplay and the callback free.
+    if (replayThread.joinable()) {
+        replayThread.join();
+    }
+}
+
+size_t DInputEventReplayer::Replay(const EventRecording &recording, double speed,
+    const ReplayBatchCallback &callback, ReplayControl &control)
+{
+    if (callback == nullptr || recording.batches.empty()) {
+        return 0;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    int64_t firstWhen = recording.batches.front().front().when;
+    // rebase the kernel timestamps to the replay wall clock, so the traced latencies stay meaningful.
+    int64_t whenShift = static_cast<int64_t>(GetCurrentTimeUs()) * NS_PER_US - firstWhen;
+    size_t eventNum = 0;
+    for (const auto &batch : recording.batches) {
+        if (control.IsStopped()) {
+            break;
+        }
+        if (speed > 0) {
+            auto offset = std::chrono::nanoseconds(static_cast<int64_t>((batch.front().when - firstWhen) / speed));
+            if (!control.WaitUntil(startTime + offset)) {
+                break;
+            }
+        }
+        std::vector<RawEvent> events = batch;
+        for (auto &event : events) {
+            event.when += whenShift;
+        }
+        callback(events);
+        eventNum += batch.size();
+    }
+    return eventNum;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
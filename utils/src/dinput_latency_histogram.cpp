@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint32_t UINT64_BITS = 64;
+    constexpr double PERCENTILE_MAX = 100.0;
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    uint32_t index = GetBucketIndex(value);
+    if (buckets_[index] < UINT32_MAX) {
+        buckets_[index]++;
+    }
+    count_++;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        uint64_t merged = static_cast<uint64_t>(buckets_[i]) + other.buckets_[i];
+        buckets_[i] = static_cast<uint32_t>(std::min<uint64_t>(merged, UINT32_MAX));
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::Reset()
+{
+    buckets_.fill(0);
+    count_ = 0;
+    sum_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    return count_;
+}
+
+uint64_t LatencyHistogram::GetMin() const
+{
+    return count_ == 0 ? 0 : min_;
+}
+
+uint64_t LatencyHistogram::GetMax() const
+{
+    return max_;
+}
+
+uint64_t LatencyHistogram::GetMean() const
+{
+    return count_ == 0 ? 0 : sum_ / count_;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    if (percentile >= PERCENTILE_MAX) {
+        return max_;
+    }
+    percentile = std::max(percentile, 0.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / PERCENTILE_MAX * static_cast<double>(count_)));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t cumulative = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        cumulative += buckets_[i];
+        if (cumulative >= target) {
+            return std::min(GetBucketHighestValue(i), max_);
+        }
+    }
+    return max_;
+}
+
+LatencySummary LatencyHistogram::GetSummary() const
+{
+    LatencySummary summary;
+    summary.count = count_;
+    summary.min = GetMin();
+    summary.max = GetMax();
+    summary.mean = GetMean();
+    summary.p50 = GetPercentile(50.0);
+    summary.p90 = GetPercentile(90.0);
+    summary.p99 = GetPercentile(99.0);
+    return summary;
+}
+
+uint32_t LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+    uint32_t msb = UINT64_BITS - 1 - static_cast<uint32_t>(__builtin_clzll(value));
+    if (msb > MAX_MSB) {
+        return BUCKET_COUNT - 1;
+    }
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t subIndex = static_cast<uint32_t>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+    return SUB_BUCKET_COUNT + (msb - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT + subIndex;
+}
+
+uint64_t LatencyHistogram::GetBucketHighestValue(uint32_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    uint32_t msb = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT + SUB_BUCKET_BITS;
+    uint32_t subIndex = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint64_t lowest = (1ULL << msb) + (static_cast<uint64_t>(subIndex) << shift);
+    return lowest + (1ULL << shift) - 1;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_latency_trace.h"
+
+#include "dinput_clock_sync.h"
+#include "dinput_log.h"
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+IMPLEMENT_SINGLE_INSTANCE(DInputLatencyTrace);
+namespace {
+    // KERNEL_EVENT to SEND_BYTES are stamped with the sink clock.
+    constexpr size_t SINK_STAGE_NUM = static_cast<size_t>(TraceStage::BYTES_RECEIVED);
+    const std::array<std::string, TRACE_STAGE_NUM> STAGE_DELTA_NAMES = {
+        "kernel->uinput",
+        "kernel->read",
+        "read->encode",
+        "encode->runner",
+        "runner->send",
+        "send->recv",
+        "recv->parse",
+        "parse->inject",
+        "inject->write",
+    };
+}
+
+void DInputLatencyTrace::SetEnabled(bool enabled)
+{
+    bool prev = enabled_.exchange(enabled);
+    if (prev != enabled) {
+        DHLOGI("Latency trace %{public}s.", enabled ? "enabled" : "disabled");
+    }
+}
+
+void DInputLatencyTrace::Reset()
+{
+    std::lock_guard<std::mutex> lock(histogramMutex_);
+    for (auto &histogram : stageHistograms_) {
+        histogram.Reset();
+    }
+}
+
+void DInputLatencyTrace::Stamp(TraceStamps &stamps, TraceStage stage)
+{
+    stamps[static_cast<size_t>(stage)] = GetCurrentTimeUs();
+}
+
+nlohmann::json DInputLatencyTrace::StampsToJson(const TraceStamps &stamps)
+{
+    nlohmann::json stampsJson = nlohmann::json::array();
+    for (const auto &stamp : stamps) {
+        stampsJson.push_back(stamp);
+    }
+    return stampsJson;
+}
+
+bool DInputLatencyTrace::StampsFromJson(const nlohmann::json &stampsJson, TraceStamps &stamps)
+{
+    if (!stampsJson.is_array() || stampsJson.size() != TRACE_STAGE_NUM) {
+        return false;
+    }
+    for (size_t i = 0; i < TRACE_STAGE_NUM; i++) {
+        if (!stampsJson[i].is_number_unsigned()) {
+            return false;
+        }
+        stamps[i] = stampsJson[i].get<uint64_t>();
+    }
+    return true;
+}
+
+void DInputLatencyTrace::RecordBatch(const std::string &devId, const TraceStamps &stamps)
+{
+    TraceStamps localStamps = stamps;
+    bool isTranslated = true;
+    for (size_t i = 0; i < SINK_STAGE_NUM; i++) {
+        if (localStamps[i] == 0) {
+            continue;
+        }
+        if (!DInputClockSync::GetInstance().RemoteToLocalUs(devId, stamps[i], localStamps[i])) {
+            isTranslated = false;
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(histogramMutex_);
+    for (size_t i = 1; i < TRACE_STAGE_NUM; i++) {
+        if (!isTranslated && i == SINK_STAGE_NUM) {
+            continue;
+        }
+        // the deltas between two sink stages are taken on the sink clock as they are.
+        const TraceStamps &deltaStamps = (i < SINK_STAGE_NUM) ? stamps : localStamps;
+        if (deltaStamps[i - 1] == 0 || deltaStamps[i] == 0 || deltaStamps[i] < deltaStamps[i - 1]) {
+            continue;
+        }
+        stageHistograms_[i].Record(deltaStamps[i] - deltaStamps[i - 1]);
+    }
+    uint64_t first = localStamps[static_cast<size_t>(TraceStage::KERNEL_EVENT)];
+    uint64_t last = localStamps[static_cast<size_t>(TraceStage::UINPUT_WRITTEN)];
+    if (isTranslated && first != 0 && last >= first) {
+        stageHistograms_[0].Record(last - first);
+    }
+}
+
+std::vector<TraceStageSummary> DInputLatencyTrace::GetStageSummaries()
+{
+    std::vector<TraceStageSummary> summaries;
+    std::lock_guard<std::mutex> lock(histogramMutex_);
+    for (size_t i = 0; i < TRACE_STAGE_NUM; i++) {
+        summaries.push_back({STAGE_DELTA_NAMES[i], stageHistograms_[i].GetSummary()});
+    }
+    return summaries;
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
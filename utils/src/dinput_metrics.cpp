@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_metrics.h"
+
+#include "dinput_utils_tool.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+IMPLEMENT_SINGLE_INSTANCE(DInputMetrics);
+namespace {
+    constexpr uint64_t US_PER_SECOND = 1000000;
+
+    const std::array<const char *, METRIC_COUNTER_NUM> COUNTER_NAMES = {
+        "events_read",
+        "events_filtered",
+        "batches_sent",
+        "bytes_sent",
+        "send_failures",
+        "parse_failures",
+        "events_injected",
+        "inject_write_errors",
+        "capability_cache_hits",
+        "capability_cache_misses",
+        "virtual_device_pool_hits",
+        "virtual_device_pool_misses",
+        "virtual_device_pool_evictions",
+        "sink_events_coalesced",
+    };
+
+    const std::array<const char *, METRIC_GAUGE_NUM> GAUGE_NAMES = {
+        "sink_send_queue_depth",
+        "inject_queue_depth",
+        "sink_congestion_mode",
+    };
+
+    const std::array<const char *, METRIC_HISTOGRAM_NUM> HISTOGRAM_NAMES = {
+        "events_per_batch",
+        "inject_batch_cost_us",
+        "device_probe_cost_us",
+        "sink_kernel_to_inject_us",
+    };
+}
+
+DInputMetrics::ShardHolder::~ShardHolder()
+{
+    if (shard != nullptr) {
+        shard->inUse.store(false, std::memory_order_release);
+    }
+}
+
+DInputMetrics::MetricsShard &DInputMetrics::GetLocalShard()
+{
+    static thread_local ShardHolder holder;
+    if (holder.shard != nullptr) {
+        return *holder.shard;
+    }
+    std::lock_guard<std::mutex> lock(shardsMutex_);
+    for (const auto &shard : shards_) {
+        bool inUse = false;
+        if (shard->inUse.compare_exchange_strong(inUse, true, std::memory_order_acq_rel)) {
+            holder.shard = shard;
+            return *shard;
+        }
+    }
+    holder.shard = std::make_shared<MetricsShard>();
+    shards_.push_back(holder.shard);
+    return *holder.shard;
+}
+
+void DInputMetrics::AddCounter(MetricCounter counter, uint64_t value)
+{
+    GetLocalShard().counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void DInputMetrics::SetGauge(MetricGauge gauge, int64_t value)
+{
+    gauges_[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+void DInputMetrics::AddGauge(MetricGauge gauge, int64_t delta)
+{
+    gauges_[static_cast<size_t>(gauge)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void DInputMetrics::RecordHistogram(MetricHistogram histogram, uint64_t value)
+{
+    MetricsShard &shard = GetLocalShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.histograms[static_cast<size_t>(histogram)].Record(value);
+}
+
+void DInputMetrics::AddDeviceEvents(const std::string &dhId, uint64_t count)
+{
+    MetricsShard &shard = GetLocalShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.deviceEvents[dhId] += count;
+}
+
+MetricsSnapshot DInputMetrics::GetSnapshot(const std::string &reader)
+{
+    MetricsSnapshot snapshot;
+    std::array<LatencyHistogram, METRIC_HISTOGRAM_NUM> histograms;
+    std::unordered_map<std::string, uint64_t> deviceEvents;
+    {
+        std::lock_guard<std::mutex> lock(shardsMutex_);
+        for (const auto &shard : shards_) {
+            for (size_t i = 0; i < METRIC_COUNTER_NUM; i++) {
+                snapshot.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+            }
+            std::lock_guard<std::mutex> shardLock(shard->mutex);
+            for (size_t i = 0; i < METRIC_HISTOGRAM_NUM; i++) {
+                histograms[i].Merge(shard->histograms[i]);
+            }
+            for (const auto &device : shard->deviceEvents) {
+                deviceEvents[device.first] += device.second;
+            }
+        }
+    }
+    for (size_t i = 0; i < METRIC_GAUGE_NUM; i++) {
+        snapshot.gauges[i] = gauges_[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < METRIC_HISTOGRAM_NUM; i++) {
+        snapshot.histograms[i] = histograms[i].GetSummary();
+    }
+
+    std::lock_guard<std::mutex> lock(rateMutex_);
+    RateBaseline &baseline = rateBaselines_[reader];
+    uint64_t now = GetCurrentTimeUs();
+    uint64_t elapsed = (baseline.snapshotTime == 0 || now <= baseline.snapshotTime) ? 0 :
+        now - baseline.snapshotTime;
+    for (const auto &device : deviceEvents) {
+        DeviceEventMetric &metric = snapshot.devices[device.first];
+        metric.events = device.second;
+        auto last = baseline.deviceEvents.find(device.first);
+        uint64_t lastEvents = (last == baseline.deviceEvents.end()) ? 0 : last->second;
+        if (elapsed != 0 && device.second >= lastEvents) {
+            metric.rate = (device.second - lastEvents) * US_PER_SECOND / elapsed;
+        }
+    }
+    baseline.deviceEvents = std::move(deviceEvents);
+    baseline.snapshotTime = now;
+    return snapshot;
+}
+
+void DInputMetrics::Reset()
+{
+    {
+        std::lock_guard<std::mutex> lock(shardsMutex_);
+        for (const auto &shard : shards_) {
+            for (auto &counter : shard->counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            std::lock_guard<std::mutex> shardLock(shard->mutex);
+            for (auto &histogram : shard->histograms) {
+                histogram.Reset();
+            }
+            shard->deviceEvents.clear();
+        }
+    }
+    std::lock_guard<std::mutex> lock(rateMutex_);
+    rateBaselines_.clear();
+}
+
+const char *DInputMetrics::GetCounterName(MetricCounter counter)
+{
+    size_t index = static_cast<size_t>(counter);
+    return index < METRIC_COUNTER_NUM ? COUNTER_NAMES[index] : "unknown";
+}
+
+const char *DInputMetrics::GetGaugeName(MetricGauge gauge)
+{
+    size_t index = static_cast<size_t>(gauge);
+    return index < METRIC_GAUGE_NUM ? GAUGE_NAMES[index] : "unknown";
+}
+
+const char *DInputMetrics::GetHistogramName(MetricHistogram histogram)
+{
+    size_t index = static_cast<size_t>(histogram);
+    return index < METRIC_HISTOGRAM_NUM ? HISTOGRAM_NAMES[index] : "unknown";
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #include "dinput_utils_tool.h"
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #include <cstdarg>
 #include <cstdio>
@@ -23,6 +24,8 @@
 
 #include <dirent.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -35,6 +38,7 @@
 #include "softbus_bus_center.h"
 
 #include "constants_dinput.h"
+#include "dinput_capability_codec.h"
 #include "dinput_errcode.h"
 #include "dinput_softbus_define.h"
 
@@ -51,8 +55,11 @@ namespace {
     constexpr int32_t DOUBLE_TIMES = 2;
     constexpr int32_t INT32_STRING_LENGTH = 40;
     constexpr uint32_t ERROR_MSG_MAX_LEN = 256;
-    constexpr int32_t MAX_RETRY_COUNT = 3;
-    constexpr uint32_t SLEEP_TIME_US = 10 * 1000;
+    // the old open retries waited up to 3 * 10ms, keep the same budget for a node that never gets ready.
+    constexpr uint32_t OPEN_READY_TIMEOUT_MS = 30;
+    // readiness that inotify does not report, such as a driver still binding, is rechecked at this interval.
+    constexpr int32_t OPEN_READY_RECHECK_MS = 5;
+    constexpr uint64_t US_PER_MS = 1000;
     constexpr char DHID_SPLIT = '.';
 }
 DevInfo GetLocalDeviceInfo()
@@ -184,19 +191,30 @@ bool IsArray(const nlohmann::json &jsonObj, const std::string &key)
 
 std::string GetNodeDesc(std::string parameters)
 {
-    nlohmann::json parObj = nlohmann::json::parse(parameters, nullptr, false);
-    if (parObj.is_discarded()) {
-        DHLOGE("parObj parse failed!");
-        return "";
-    }
     std::string nodeName = "N/A";
     std::string physicalPath = "N/A";
     int32_t classes = -1;
 
-    if (IsString(parObj, DEVICE_NAME) && IsString(parObj, PHYSICAL_PATH) && IsInt32(parObj, CLASSES)) {
-        nodeName = parObj.at(DEVICE_NAME).get<std::string>();
-        physicalPath = parObj.at(PHYSICAL_PATH).get<std::string>();
-        classes = parObj.at(CLASSES).get<int32_t>();
+    if (IsCapabilityDescriptor(parameters)) {
+        InputDevice device;
+        if (!DescriptorToInputDevice(parameters, device)) {
+            DHLOGE("descriptor decode failed!");
+            return "";
+        }
+        nodeName = device.name;
+        physicalPath = device.physicalPath;
+        classes = static_cast<int32_t>(device.classes);
+    } else {
+        nlohmann::json parObj = nlohmann::json::parse(parameters, nullptr, false);
+        if (parObj.is_discarded()) {
+            DHLOGE("parObj parse failed!");
+            return "";
+        }
+        if (IsString(parObj, DEVICE_NAME) && IsString(parObj, PHYSICAL_PATH) && IsInt32(parObj, CLASSES)) {
+            nodeName = parObj.at(DEVICE_NAME).get<std::string>();
+            physicalPath = parObj.at(PHYSICAL_PATH).get<std::string>();
+            classes = parObj.at(CLASSES).get<int32_t>();
+        }
     }
 
     return "{ nodeName: " + nodeName + ", physicalPath: " + physicalPath + ", classes: " +
@@ -300,34 +318,118 @@ void SplitStringToVector(const std::string &str, const char split, std::vector<s
 }
 
 int OpenInputDeviceFdByPath(const std::string &devicePath)
+{
+    return OpenInputDeviceFdWhenReady(devicePath, OPEN_READY_TIMEOUT_MS);
+}
+
+namespace {
+// the wait must not stretch or end early when the wall clock is set.
+uint64_t GetSteadyTimeUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+enum class OpenResult {
+    OPENED = 0,
+    NOT_READY,
+    FAILED,
+};
+
+OpenResult TryOpenInputDeviceFd(const std::string &devicePath, int &fd)
 {
     chmod(devicePath.c_str(), S_IWRITE | S_IREAD);
     char canonicalDevicePath[PATH_MAX] = {0x00};
-    if (devicePath.length() == 0 || devicePath.length() >= PATH_MAX ||
-        realpath(devicePath.c_str(), canonicalDevicePath) == nullptr) {
+    if (realpath(devicePath.c_str(), canonicalDevicePath) == nullptr) {
+        if (errno == ENOENT) {
+            return OpenResult::NOT_READY;
+        }
         DHLOGE("path check fail, error path: %{public}s", devicePath.c_str());
-        return -1;
+        return OpenResult::FAILED;
     }
     struct stat s;
     if ((stat(canonicalDevicePath, &s) == 0) && (s.st_mode & S_IFDIR)) {
         DHLOGI("path: %{public}s is a dir.", devicePath.c_str());
+        return OpenResult::FAILED;
+    }
+    fd = open(canonicalDevicePath, O_RDWR | O_CLOEXEC);
+    if (fd >= 0) {
+        return OpenResult::OPENED;
+    }
+    // a new node shows up before udev applied its permissions, or before its driver is bound.
+    if (errno == ENOENT || errno == EACCES || errno == EPERM || errno == ENXIO || errno == ENODEV) {
+        return OpenResult::NOT_READY;
+    }
+    return OpenResult::FAILED;
+}
+
+int32_t CreateReadyWatch(const std::string &devicePath)
+{
+    size_t pos = devicePath.find_last_of('/');
+    std::string dirPath = (pos == std::string::npos) ? "." : devicePath.substr(0, (pos == 0) ? 1 : pos);
+    int32_t watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) {
+        DHLOGE("inotify init failed: %{public}s", ConvertErrNo().c_str());
         return -1;
     }
-    int fd = open(canonicalDevicePath, O_RDWR | O_CLOEXEC);
-    int32_t count = 0;
-    while ((fd < 0) && (count < MAX_RETRY_COUNT)) {
-        ++count;
-        usleep(SLEEP_TIME_US);
-        fd = open(canonicalDevicePath, O_RDWR | O_CLOEXEC);
-        DHLOGE("could not open the path: %{public}s, errno: %{public}s; retry: %{public}d", devicePath.c_str(),
-            ConvertErrNo().c_str(), count);
-    }
-    if (count >= MAX_RETRY_COUNT) {
-        DHLOGE("could not open the path: %{public}s, errno: %{public}s.", devicePath.c_str(), ConvertErrNo().c_str());
-        CloseFd(fd);
+    // a directory watch also reports IN_ATTRIB of its entries, so one watch covers creation and chmod.
+    if (inotify_add_watch(watchFd, dirPath.c_str(), IN_CREATE | IN_ATTRIB) < 0) {
+        DHLOGE("inotify watch %{public}s failed: %{public}s", dirPath.c_str(), ConvertErrNo().c_str());
+        close(watchFd);
         return -1;
     }
-    return fd;
+    return watchFd;
+}
+
+void WaitReadyEvent(int32_t watchFd, int32_t timeoutMs)
+{
+    if (watchFd < 0) {
+        usleep(static_cast<uint32_t>(timeoutMs) * US_PER_MS);
+        return;
+    }
+    struct pollfd pfd = { watchFd, POLLIN, 0 };
+    if (poll(&pfd, 1, timeoutMs) <= 0) {
+        return;
+    }
+    char buffer[sizeof(struct inotify_event) + NAME_MAX + 1];
+    while (read(watchFd, buffer, sizeof(buffer)) > 0) {
+    }
+}
+}
+
+int OpenInputDeviceFdWhenReady(const std::string &devicePath, uint32_t timeoutMs)
+{
+    if (devicePath.length() == 0 || devicePath.length() >= PATH_MAX) {
+        DHLOGE("path check fail, error path: %{public}s", devicePath.c_str());
+        return -1;
+    }
+    int fd = -1;
+    OpenResult result = TryOpenInputDeviceFd(devicePath, fd);
+    if (result != OpenResult::NOT_READY) {
+        return fd;
+    }
+    // watch first and try again, so a change that lands between the two is not missed.
+    int32_t watchFd = CreateReadyWatch(devicePath);
+    uint64_t deadline = GetSteadyTimeUs() + timeoutMs * US_PER_MS;
+    result = TryOpenInputDeviceFd(devicePath, fd);
+    while (result == OpenResult::NOT_READY) {
+        uint64_t now = GetSteadyTimeUs();
+        if (now >= deadline) {
+            break;
+        }
+        int32_t waitMs = static_cast<int32_t>(std::min<uint64_t>((deadline - now + US_PER_MS - 1) / US_PER_MS,
+            OPEN_READY_RECHECK_MS));
+        WaitReadyEvent(watchFd, waitMs);
+        result = TryOpenInputDeviceFd(devicePath, fd);
+    }
+    if (result == OpenResult::NOT_READY) {
+        DHLOGE("could not open the path: %{public}s in %{public}u ms, errno: %{public}s.", devicePath.c_str(),
+            timeoutMs, ConvertErrNo().c_str());
+    }
+    if (watchFd >= 0) {
+        close(watchFd);
+    }
+    return (result == OpenResult::OPENED) ? fd : -1;
 }
 
 std::string ConvertErrNo()
@@ -388,54 +490,6 @@ void WriteEventToDevice(const int fd, const input_event &event)
     RecordEventLog(event);
 }
 
-void ResetVirtualDevicePressedKeys(const std::vector<std::string> &nodePaths)
-{
-    unsigned long keyState[NLONGS(KEY_CNT)] = { 0 };
-    for (const auto &path : nodePaths) {
-        DHLOGI("Check and reset key state, path: %{public}s", path.c_str());
-        std::vector<uint32_t> pressedKeys;
-        int fd = OpenInputDeviceFdByPath(path);
-        if (fd == -1) {
-            DHLOGE("Open virtual keyboard node failed, path: %{public}s", path.c_str());
-            continue;
-        }
-
-        int rc = ioctl(fd, EVIOCGKEY(sizeof(keyState)), keyState);
-        if (rc < 0) {
-            DHLOGE("Read all key state failed, rc: %{public}d, path: %{public}s", rc, path.c_str());
-            CloseFd(fd);
-            continue;
-        }
-
-        for (int32_t keyIndex = 0; keyIndex < KEY_MAX; keyIndex++) {
-            if (BitIsSet(keyState, keyIndex)) {
-                DHLOGI("key index: %{public}d pressed.", keyIndex);
-                pressedKeys.push_back(keyIndex);
-            }
-        }
-
-        if (pressedKeys.empty()) {
-            CloseFd(fd);
-            continue;
-        }
-
-        struct input_event event = {
-            .type = EV_KEY,
-            .code = 0,
-            .value = KEY_UP_STATE
-        };
-        for (auto &code : pressedKeys) {
-            event.type = EV_KEY;
-            event.code = code;
-            WriteEventToDevice(fd, event);
-            event.type = EV_SYN;
-            event.code = 0;
-            WriteEventToDevice(fd, event);
-        }
-        CloseFd(fd);
-    }
-}
-
 std::string GetString(const std::vector<std::string> &vec)
 {
     std::string retStr = "[";
@@ -477,6 +531,99 @@ std::vector<std::string> SplitDhIdString(const std::string &dhIdsString)
     SplitStringToVector(dhIdsString, DHID_SPLIT, dhIdsVec);
     return dhIdsVec;
 }
+
+std::string InputDeviceToJson(const InputDevice &device)
+{
+    nlohmann::json tmpJson;
+    tmpJson[DEVICE_NAME] = device.name;
+    tmpJson[PHYSICAL_PATH] = device.physicalPath;
+    tmpJson[UNIQUE_ID] = device.uniqueId;
+    tmpJson[BUS] = device.bus;
+    tmpJson[VENDOR] = device.vendor;
+    tmpJson[PRODUCT] = device.product;
+    tmpJson[VERSION] = device.version;
+    tmpJson[DESCRIPTOR] = device.descriptor;
+    tmpJson[CLASSES] = device.classes;
+    tmpJson[EVENT_TYPES] = device.eventTypes;
+    tmpJson[EVENT_KEYS] = device.eventKeys;
+    tmpJson[ABS_TYPES] = device.absTypes;
+    tmpJson[ABS_INFOS] = device.absInfos;
+    tmpJson[REL_TYPES] = device.relTypes;
+    tmpJson[PROPERTIES] = device.properties;
+
+    tmpJson[MISCELLANEOUS] = device.miscellaneous;
+    tmpJson[LEDS] = device.leds;
+    tmpJson[REPEATS] = device.repeats;
+    tmpJson[SWITCHS] = device.switchs;
+    return tmpJson.dump();
+}
+
+bool JsonToInputDevice(const std::string &capability, InputDevice &device)
+{
+    nlohmann::json inputDeviceJson = nlohmann::json::parse(capability, nullptr, false);
+    if (inputDeviceJson.is_discarded()) {
+        DHLOGE("recMsg parse failed!");
+        return false;
+    }
+    if (IsString(inputDeviceJson, DEVICE_NAME)) {
+        device.name = inputDeviceJson[DEVICE_NAME].get<std::string>();
+    }
+    if (IsString(inputDeviceJson, PHYSICAL_PATH)) {
+        device.physicalPath = inputDeviceJson[PHYSICAL_PATH].get<std::string>();
+    }
+    if (IsString(inputDeviceJson, UNIQUE_ID)) {
+        device.uniqueId = inputDeviceJson[UNIQUE_ID].get<std::string>();
+    }
+    if (IsUInt16(inputDeviceJson, BUS)) {
+        device.bus = inputDeviceJson[BUS].get<uint16_t>();
+    }
+    if (IsUInt16(inputDeviceJson, VENDOR)) {
+        device.vendor = inputDeviceJson[VENDOR].get<uint16_t>();
+    }
+    if (IsUInt16(inputDeviceJson, PRODUCT)) {
+        device.product = inputDeviceJson[PRODUCT].get<uint16_t>();
+    }
+    if (IsUInt16(inputDeviceJson, VERSION)) {
+        device.version = inputDeviceJson[VERSION].get<uint16_t>();
+    }
+    if (IsString(inputDeviceJson, DESCRIPTOR)) {
+        device.descriptor = inputDeviceJson[DESCRIPTOR].get<std::string>();
+    }
+    if (IsUInt32(inputDeviceJson, CLASSES)) {
+        device.classes = inputDeviceJson[CLASSES].get<uint32_t>();
+    }
+    if (IsArray(inputDeviceJson, EVENT_TYPES)) {
+        device.eventTypes = inputDeviceJson[EVENT_TYPES].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, EVENT_KEYS)) {
+        device.eventKeys = inputDeviceJson[EVENT_KEYS].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, ABS_TYPES)) {
+        device.absTypes = inputDeviceJson[ABS_TYPES].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, ABS_INFOS)) {
+        device.absInfos = inputDeviceJson[ABS_INFOS].get<std::map<uint32_t, std::vector<int32_t>>>();
+    }
+    if (IsArray(inputDeviceJson, REL_TYPES)) {
+        device.relTypes = inputDeviceJson[REL_TYPES].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, PROPERTIES)) {
+        device.properties = inputDeviceJson[PROPERTIES].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, MISCELLANEOUS)) {
+        device.miscellaneous = inputDeviceJson[MISCELLANEOUS].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, LEDS)) {
+        device.leds = inputDeviceJson[LEDS].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, REPEATS)) {
+        device.repeats = inputDeviceJson[REPEATS].get<std::vector<uint32_t>>();
+    }
+    if (IsArray(inputDeviceJson, SWITCHS)) {
+        device.switchs = inputDeviceJson[SWITCHS].get<std::vector<uint32_t>>();
+    }
+    return true;
+}
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
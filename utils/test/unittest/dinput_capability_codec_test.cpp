@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_capability_codec_test.h"
+
+#include <linux/input.h>
+
+#include "dinput_capability_codec.h"
+#include "dinput_utils_tool.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr size_t CACHE_CAPACITY = 2;
+
+    InputDevice MakeTouchpad()
+    {
+        InputDevice device;
+        device.name = "touchpad";
+        device.physicalPath = "usb-0000:00:14.0-1/input0";
+        device.uniqueId = "uniqueId";
+        device.descriptor = "descriptor";
+        device.bus = BUS_USB;
+        device.vendor = 0x1234;
+        device.product = 0x5678;
+        device.version = 1;
+        device.classes = 0x14;
+        device.eventTypes = { EV_SYN, EV_KEY, EV_ABS };
+        device.eventKeys = { BTN_LEFT, BTN_TOOL_FINGER, BTN_TOUCH, KEY_MAX };
+        device.absTypes = { ABS_X, ABS_Y, ABS_MT_POSITION_X, ABS_MT_POSITION_Y };
+        device.absInfos[ABS_X] = { 0, -100, 4096, 0, 0, 40 };
+        device.absInfos[ABS_MT_POSITION_X] = { 0, 0, 4096, 0, 0, 40 };
+        device.properties = { INPUT_PROP_POINTER, INPUT_PROP_BUTTONPAD };
+        return device;
+    }
+
+    void ExpectSameDevice(const InputDevice &expected, const InputDevice &actual)
+    {
+        EXPECT_EQ(expected.name, actual.name);
+        EXPECT_EQ(expected.physicalPath, actual.physicalPath);
+        EXPECT_EQ(expected.uniqueId, actual.uniqueId);
+        EXPECT_EQ(expected.descriptor, actual.descriptor);
+        EXPECT_EQ(expected.bus, actual.bus);
+        EXPECT_EQ(expected.vendor, actual.vendor);
+        EXPECT_EQ(expected.product, actual.product);
+        EXPECT_EQ(expected.version, actual.version);
+        EXPECT_EQ(expected.classes, actual.classes);
+        EXPECT_EQ(expected.eventTypes, actual.eventTypes);
+        EXPECT_EQ(expected.eventKeys, actual.eventKeys);
+        EXPECT_EQ(expected.absTypes, actual.absTypes);
+        EXPECT_EQ(expected.absInfos, actual.absInfos);
+        EXPECT_EQ(expected.relTypes, actual.relTypes);
+        EXPECT_EQ(expected.properties, actual.properties);
+    }
+}
+
+void DInputCapabilityCodecTest::SetUp()
+{
+}
+
+void DInputCapabilityCodecTest::TearDown()
+{
+}
+
+void DInputCapabilityCodecTest::SetUpTestCase()
+{
+}
+
+void DInputCapabilityCodecTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputCapabilityCodecTest, RoundTrip001, testing::ext::TestSize.Level1)
+{
+    InputDevice device = MakeTouchpad();
+    std::string descriptor = InputDeviceToDescriptor(device);
+    EXPECT_TRUE(IsCapabilityDescriptor(descriptor));
+    EXPECT_LT(descriptor.size(), InputDeviceToJson(device).size());
+
+    InputDevice parsed;
+    EXPECT_TRUE(DescriptorToInputDevice(descriptor, parsed));
+    ExpectSameDevice(device, parsed);
+}
+
+HWTEST_F(DInputCapabilityCodecTest, DescriptorToInputDevice001, testing::ext::TestSize.Level1)
+{
+    std::string descriptor = InputDeviceToDescriptor(MakeTouchpad());
+    InputDevice parsed;
+    EXPECT_FALSE(DescriptorToInputDevice("", parsed));
+    EXPECT_FALSE(DescriptorToInputDevice(CAPABILITY_DESCRIPTOR_PREFIX + "###", parsed));
+    EXPECT_FALSE(DescriptorToInputDevice(descriptor.substr(0, descriptor.size() - 8), parsed));
+    EXPECT_TRUE(parsed.name.empty());
+}
+
+HWTEST_F(DInputCapabilityCodecTest, GetNodeDesc001, testing::ext::TestSize.Level1)
+{
+    InputDevice device = MakeTouchpad();
+    std::string desc = GetNodeDesc(InputDeviceToDescriptor(device));
+    EXPECT_EQ(GetNodeDesc(InputDeviceToJson(device)), desc);
+    EXPECT_NE(std::string::npos, desc.find(device.name));
+    EXPECT_EQ("", GetNodeDesc(CAPABILITY_DESCRIPTOR_PREFIX + "###"));
+}
+
+HWTEST_F(DInputCapabilityCodecTest, Parse001, testing::ext::TestSize.Level1)
+{
+    InputDevice device = MakeTouchpad();
+    CapabilityParseCache cache(CACHE_CAPACITY);
+    InputDevice fromJson;
+    EXPECT_TRUE(cache.Parse(InputDeviceToJson(device), fromJson));
+    ExpectSameDevice(device, fromJson);
+    InputDevice fromDescriptor;
+    EXPECT_TRUE(cache.Parse(InputDeviceToDescriptor(device), fromDescriptor));
+    ExpectSameDevice(device, fromDescriptor);
+    EXPECT_EQ(cache.GetHitNum(), 0u);
+
+    InputDevice cached;
+    EXPECT_TRUE(cache.Parse(InputDeviceToDescriptor(device), cached));
+    ExpectSameDevice(device, cached);
+    EXPECT_EQ(cache.GetHitNum(), 1u);
+
+    InputDevice invalid;
+    EXPECT_FALSE(cache.Parse("not a capability", invalid));
+}
+
+HWTEST_F(DInputCapabilityCodecTest, Parse002, testing::ext::TestSize.Level1)
+{
+    CapabilityParseCache cache(CACHE_CAPACITY);
+    InputDevice device = MakeTouchpad();
+    InputDevice parsed;
+    std::string first = InputDeviceToDescriptor(device);
+    device.name = "mouse";
+    std::string second = InputDeviceToDescriptor(device);
+    device.name = "keyboard";
+    std::string third = InputDeviceToDescriptor(device);
+    EXPECT_TRUE(cache.Parse(first, parsed));
+    EXPECT_TRUE(cache.Parse(second, parsed));
+    EXPECT_TRUE(cache.Parse(third, parsed));
+    EXPECT_EQ(cache.devices_.size(), CACHE_CAPACITY);
+
+    // the first one is evicted as the least recently used.
+    EXPECT_TRUE(cache.Parse(first, parsed));
+    EXPECT_EQ(cache.GetHitNum(), 0u);
+    EXPECT_TRUE(cache.Parse(third, parsed));
+    EXPECT_EQ(cache.GetHitNum(), 1u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.devices_.size(), 0u);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
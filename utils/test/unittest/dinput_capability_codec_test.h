@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -13,30 +13,23 @@
  * limitations under the License.
  */
 
-#ifndef DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_H
-#define DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_H
+#ifndef DINPUT_CAPABILITY_CODEC_TEST_H
+#define DINPUT_CAPABILITY_CODEC_TEST_H
 
-#include <vector>
-#include <string>
-
-#include "constants_dinput.h"
+#include <gtest/gtest.h>
 
 namespace OHOS {
 namespace DistributedHardware {
 namespace DistributedInput {
-class TouchPadEventFragment {
+class DInputCapabilityCodecTest : public testing::Test {
 public:
-    TouchPadEventFragment() : events({}) {};
-
-    bool IsShouldDrop();
-    bool IsTouchPadOptFinish() const;
-    bool IsTouchPadOptStart() const;
-    void PushEvent(const RawEvent &event);
-    std::vector<RawEvent> GetEvents();
-private:
-    std::vector<RawEvent> events;
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
 };
 } // namespace DistributedInput
 } // namespace DistributedHardware
 } // namespace OHOS
-#endif // DISTRIBUTED_INPUT_TOUCHPAD_EVENT_FRAGMENT_H
\ No newline at end of file
+
+#endif // DINPUT_CAPABILITY_CODEC_TEST_H
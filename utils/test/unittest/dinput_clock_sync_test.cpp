@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_clock_sync_test.h"
+
+#include "dinput_clock_sync.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint64_t BASE_US = 1000 * 1000 * 1000;
+    constexpr int64_t OFFSET_US = 5000;
+    constexpr uint64_t PROBE_INTERVAL_US = 50 * 1000;
+    const std::string DEV_ID = "clock_sync_test_dev";
+
+    /*
+     * A probe sent at t1 over a link with the given one way delays, the remote clock reads
+     * local + offset + drift * (local - BASE_US).
+     */
+    ClockSample MakeSample(uint64_t t1, uint64_t upUs, uint64_t downUs, double drift = 0)
+    {
+        auto toRemote = [drift](uint64_t localUs) {
+            return static_cast<uint64_t>(static_cast<int64_t>(localUs) + OFFSET_US +
+                static_cast<int64_t>(drift * static_cast<double>(localUs - BASE_US)));
+        };
+        constexpr uint64_t holdUs = 100;
+        ClockSample sample;
+        sample.t1 = t1;
+        sample.t2 = toRemote(t1 + upUs);
+        sample.t3 = toRemote(t1 + upUs + holdUs);
+        sample.t4 = t1 + upUs + holdUs + downUs;
+        return sample;
+    }
+}
+
+void DInputClockSyncTest::SetUp()
+{
+}
+
+void DInputClockSyncTest::TearDown()
+{
+    DInputClockSync::GetInstance().Clear();
+}
+
+void DInputClockSyncTest::SetUpTestCase()
+{
+}
+
+void DInputClockSyncTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputClockSyncTest, AddSample001, testing::ext::TestSize.Level1)
+{
+    ClockOffsetEstimator estimator;
+    EXPECT_FALSE(estimator.HasEstimate());
+    EXPECT_TRUE(estimator.AddSample(MakeSample(BASE_US, 500, 500)));
+    EXPECT_TRUE(estimator.HasEstimate());
+    EXPECT_EQ(OFFSET_US, estimator.GetOffsetUs(BASE_US));
+    EXPECT_EQ(BASE_US, estimator.RemoteToLocalUs(BASE_US + OFFSET_US));
+
+    ClockSample unordered = MakeSample(BASE_US, 500, 500);
+    unordered.t4 = unordered.t1 - 1;
+    EXPECT_FALSE(estimator.AddSample(unordered));
+}
+
+HWTEST_F(DInputClockSyncTest, AddSample002, testing::ext::TestSize.Level1)
+{
+    ClockOffsetEstimator estimator;
+    uint64_t t1 = BASE_US;
+    for (int32_t i = 0; i < 8; i++) {
+        estimator.AddSample(MakeSample(t1, 400, 400));
+        t1 += PROBE_INTERVAL_US;
+    }
+    // a probe queued behind a burst on the way up is far from symmetric, it must not move the estimate.
+    estimator.AddSample(MakeSample(t1, 20000, 400));
+    ClockEstimate estimate = estimator.GetEstimate(t1);
+    EXPECT_EQ(OFFSET_US, estimate.offsetUs);
+    EXPECT_EQ(800, estimate.minDelayUs);
+}
+
+HWTEST_F(DInputClockSyncTest, AddSample003, testing::ext::TestSize.Level1)
+{
+    constexpr double drift = 100.0 / 1000000.0;
+    ClockOffsetEstimator estimator;
+    uint64_t t1 = BASE_US;
+    for (size_t i = 0; i < ClockOffsetEstimator::SAMPLE_WINDOW; i++) {
+        estimator.AddSample(MakeSample(t1, 300 + (i % 3) * 50, 300, drift));
+        t1 += PROBE_INTERVAL_US;
+    }
+    ClockEstimate estimate = estimator.GetEstimate(t1);
+    EXPECT_NEAR(100.0, estimate.driftPpm, 20.0);
+    int64_t expectedOffsetUs = OFFSET_US + static_cast<int64_t>(drift * static_cast<double>(t1 - BASE_US));
+    EXPECT_NEAR(expectedOffsetUs, estimate.offsetUs, 50);
+}
+
+HWTEST_F(DInputClockSyncTest, RemoteToLocalUs001, testing::ext::TestSize.Level1)
+{
+    uint64_t localUs = 0;
+    EXPECT_FALSE(DInputClockSync::GetInstance().RemoteToLocalUs(DEV_ID, BASE_US, localUs));
+    DInputClockSync::GetInstance().AddSample(DEV_ID, MakeSample(BASE_US, 500, 500));
+    EXPECT_TRUE(DInputClockSync::GetInstance().RemoteToLocalUs(DEV_ID, BASE_US + OFFSET_US, localUs));
+    EXPECT_EQ(BASE_US, localUs);
+    DInputClockSync::GetInstance().RemoveDevice(DEV_ID);
+    ClockEstimate estimate;
+    EXPECT_FALSE(DInputClockSync::GetInstance().GetEstimate(DEV_ID, estimate));
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
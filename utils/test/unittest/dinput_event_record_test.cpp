@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_event_record_test.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include <linux/input.h>
+
+#include "dinput_errcode.h"
+#include "dinput_event_record.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    const std::string RECORD_FILE_TEST = "dinput_event_record_test.bin";
+    const std::string RECORD_PATH_TEST = EVENT_RECORD_DIR + RECORD_FILE_TEST;
+    const std::string DH_ID_MOUSE = "Input_1ds56v18e1v21v8v1erv15r1v8r1j1ty8";
+    const std::string DH_ID_KEYBOARD = "Input_2fe64a18e1v21v8v1erv15r1v8r1j1ty8";
+    const std::string PATH_MOUSE = "/dev/input/event1";
+    const std::string PATH_KEYBOARD = "/dev/input/event2";
+    const std::string CAPABILITY_TEST = "{\"name\":\"test\"}";
+    constexpr int64_t NS_PER_MS = 1000000;
+    constexpr int64_t BATCH_INTERVAL_MS = 20;
+    constexpr double REPLAY_SPEED_FAST = 10.0;
+    constexpr double REPLAY_SPEED_SLOW = 0.01;
+    constexpr int64_t STOP_DELAY_MS = 10;
+}
+
+void DInputEventRecordTest::SetUp()
+{
+}
+
+void DInputEventRecordTest::TearDown()
+{
+    DInputEventRecorder::GetInstance().Stop();
+    (void)remove(RECORD_PATH_TEST.c_str());
+}
+
+void DInputEventRecordTest::SetUpTestCase()
+{
+}
+
+void DInputEventRecordTest::TearDownTestCase()
+{
+}
+
+static void RecordTwoBatches()
+{
+    DInputEventRecorder &recorder = DInputEventRecorder::GetInstance();
+    ASSERT_EQ(DH_SUCCESS, recorder.Start(RECORD_FILE_TEST));
+    recorder.RecordDevice(DH_ID_MOUSE, PATH_MOUSE, CAPABILITY_TEST);
+    RawEvent mouseBatch[] = {
+        { 0, EV_REL, REL_X, 5, DH_ID_MOUSE, PATH_MOUSE },
+        { 0, EV_REL, REL_Y, -3, DH_ID_MOUSE, PATH_MOUSE },
+        { 0, EV_SYN, SYN_REPORT, 0, DH_ID_MOUSE, PATH_MOUSE },
+    };
+    recorder.RecordEvents(mouseBatch, sizeof(mouseBatch) / sizeof(mouseBatch[0]));
+
+    recorder.RecordDevice(DH_ID_KEYBOARD, PATH_KEYBOARD, CAPABILITY_TEST);
+    int64_t when = BATCH_INTERVAL_MS * NS_PER_MS;
+    RawEvent keyBatch[] = {
+        { when, EV_MSC, MSC_SCAN, KEY_A, DH_ID_KEYBOARD, PATH_KEYBOARD },
+        { when, EV_KEY, KEY_A, 1, DH_ID_KEYBOARD, PATH_KEYBOARD },
+        { when, EV_SYN, SYN_REPORT, 0, DH_ID_KEYBOARD, PATH_KEYBOARD },
+        { when, EV_KEY, KEY_B, 1, "unknown_dhid", PATH_KEYBOARD },
+    };
+    recorder.RecordEvents(keyBatch, sizeof(keyBatch) / sizeof(keyBatch[0]));
+    recorder.Stop();
+}
+
+HWTEST_F(DInputEventRecordTest, RecordAndLoad001, testing::ext::TestSize.Level1)
+{
+    RecordTwoBatches();
+    EXPECT_EQ(4, DInputEventRecorder::GetInstance().GetRecordedEventNum());
+
+    EventRecording recording;
+    ASSERT_EQ(DH_SUCCESS, LoadEventRecording(RECORD_PATH_TEST, recording));
+    ASSERT_EQ(2, recording.devices.size());
+    EXPECT_EQ(DH_ID_KEYBOARD, recording.devices[1].dhId);
+    EXPECT_EQ(CAPABILITY_TEST, recording.devices[1].capability);
+    ASSERT_EQ(2, recording.batches.size());
+    EXPECT_EQ(4, recording.eventNum);
+    EXPECT_EQ(3, recording.batches[0].size());
+    EXPECT_EQ(-3, recording.batches[0][1].value);
+    EXPECT_EQ(PATH_MOUSE, recording.batches[0][1].path);
+    ASSERT_EQ(1, recording.batches[1].size());
+    EXPECT_EQ(SYN_REPORT, recording.batches[1][0].code);
+    EXPECT_EQ(DH_ID_KEYBOARD, recording.batches[1][0].descriptor);
+}
+
+HWTEST_F(DInputEventRecordTest, GetEventRecordPath001, testing::ext::TestSize.Level1)
+{
+    std::string filePath;
+    EXPECT_EQ(DH_SUCCESS, GetEventRecordPath(RECORD_FILE_TEST, filePath));
+    EXPECT_EQ(RECORD_PATH_TEST, filePath);
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath("", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath("/data/test/record.bin", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath("../record.bin", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath("..", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath(".record", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, GetEventRecordPath("record bin", filePath));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, DInputEventRecorder::GetInstance().Start("../record.bin"));
+    EventRecording recording;
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID,
+        DInputEventReplayer::GetInstance().StartReplay("/data/test/record.bin", 0, recording));
+}
+
+HWTEST_F(DInputEventRecordTest, RecordAndLoad002, testing::ext::TestSize.Level1)
+{
+    RecordTwoBatches();
+    std::string content;
+    {
+        std::ifstream file(RECORD_PATH_TEST, std::ios::binary);
+        content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(RECORD_PATH_TEST, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size() - 1);
+    }
+    EventRecording recording;
+    ASSERT_EQ(DH_SUCCESS, LoadEventRecording(RECORD_PATH_TEST, recording));
+    EXPECT_EQ(1, recording.batches.size());
+
+    {
+        std::ofstream file(RECORD_PATH_TEST, std::ios::binary | std::ios::trunc);
+        file.write("test", 4);
+    }
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_FILE_INVALID, LoadEventRecording(RECORD_PATH_TEST, recording));
+    EXPECT_EQ(ERR_DH_INPUT_RECORD_OPEN_FILE_FAIL, LoadEventRecording("/data/test/not_exist.bin", recording));
+}
+
+HWTEST_F(DInputEventRecordTest, Replay001, testing::ext::TestSize.Level1)
+{
+    RecordTwoBatches();
+    EventRecording recording;
+    ASSERT_EQ(DH_SUCCESS, LoadEventRecording(RECORD_PATH_TEST, recording));
+
+    ReplayControl control;
+    std::vector<int64_t> whens;
+    auto start = std::chrono::steady_clock::now();
+    size_t eventNum = DInputEventReplayer::Replay(recording, 1.0, [&whens](std::vector<RawEvent> &events) {
+        whens.push_back(events.front().when);
+    }, control);
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(4, eventNum);
+    ASSERT_EQ(2, whens.size());
+    EXPECT_EQ(BATCH_INTERVAL_MS * NS_PER_MS, whens[1] - whens[0]);
+    EXPECT_GE(costMs.count(), BATCH_INTERVAL_MS);
+
+    eventNum = DInputEventReplayer::Replay(recording, REPLAY_SPEED_FAST, [](std::vector<RawEvent> &events) {}, control);
+    EXPECT_EQ(4, eventNum);
+
+    control.Stop();
+    eventNum = DInputEventReplayer::Replay(recording, 0, [](std::vector<RawEvent> &events) {}, control);
+    EXPECT_EQ(0, eventNum);
+}
+
+HWTEST_F(DInputEventRecordTest, Replay002, testing::ext::TestSize.Level1)
+{
+    RecordTwoBatches();
+    EventRecording recording;
+    ASSERT_EQ(DH_SUCCESS, LoadEventRecording(RECORD_PATH_TEST, recording));
+
+    // the second batch is two seconds away at this speed, the stop must not wait for it.
+    ReplayControl control;
+    std::thread stopThread([&control]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(STOP_DELAY_MS));
+        control.Stop();
+    });
+    auto start = std::chrono::steady_clock::now();
+    size_t eventNum = DInputEventReplayer::Replay(recording, REPLAY_SPEED_SLOW,
+        [](std::vector<RawEvent> &events) {}, control);
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    stopThread.join();
+    EXPECT_EQ(3, eventNum);
+    EXPECT_LT(costMs.count(), BATCH_INTERVAL_MS / REPLAY_SPEED_SLOW);
+}
+
+HWTEST_F(DInputEventRecordTest, StartReplay001, testing::ext::TestSize.Level1)
+{
+    RecordTwoBatches();
+    EventRecording recording;
+    DInputEventReplayer::GetInstance().RegisterBatchCallback(nullptr);
+    EXPECT_EQ(ERR_DH_INPUT_POINTER_NULL,
+        DInputEventReplayer::GetInstance().StartReplay(RECORD_FILE_TEST, 0, recording));
+
+    std::atomic<size_t> replayedNum = 0;
+    DInputEventReplayer::GetInstance().RegisterBatchCallback([&replayedNum](std::vector<RawEvent> &events) {
+        replayedNum += events.size();
+    });
+    EXPECT_EQ(DH_SUCCESS, DInputEventReplayer::GetInstance().StartReplay(RECORD_FILE_TEST, 0, recording));
+    EXPECT_EQ(4, recording.eventNum);
+    DInputEventReplayer::GetInstance().StopReplay();
+    EXPECT_FALSE(DInputEventReplayer::GetInstance().IsReplaying());
+    DInputEventReplayer::GetInstance().RegisterBatchCallback(nullptr);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_latency_histogram_test.h"
+
+#include "dinput_latency_histogram.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint64_t SAMPLE_COUNT = 10000;
+    constexpr uint64_t HUGE_VALUE = 1ULL << 40;
+}
+
+void DInputLatencyHistogramTest::SetUp()
+{
+}
+
+void DInputLatencyHistogramTest::TearDown()
+{
+}
+
+void DInputLatencyHistogramTest::SetUpTestCase()
+{
+}
+
+void DInputLatencyHistogramTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputLatencyHistogramTest, GetSummary001, testing::ext::TestSize.Level1)
+{
+    LatencyHistogram histogram;
+    LatencySummary summary = histogram.GetSummary();
+    EXPECT_EQ(0, summary.count);
+    EXPECT_EQ(0, summary.min);
+    EXPECT_EQ(0, summary.p99);
+    EXPECT_EQ(0, summary.max);
+}
+
+HWTEST_F(DInputLatencyHistogramTest, GetSummary002, testing::ext::TestSize.Level1)
+{
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= SAMPLE_COUNT; i++) {
+        histogram.Record(i);
+    }
+    LatencySummary summary = histogram.GetSummary();
+    EXPECT_EQ(SAMPLE_COUNT, summary.count);
+    EXPECT_EQ(1, summary.min);
+    EXPECT_EQ(SAMPLE_COUNT, summary.max);
+    // the relative error of each percentile is bounded by 1 / SUB_BUCKET_COUNT
+    EXPECT_GE(summary.p50, SAMPLE_COUNT / 2);
+    EXPECT_LE(summary.p50, SAMPLE_COUNT / 2 + SAMPLE_COUNT / 2 / LatencyHistogram::SUB_BUCKET_COUNT);
+    EXPECT_GE(summary.p90, SAMPLE_COUNT * 9 / 10);
+    EXPECT_LE(summary.p99, SAMPLE_COUNT);
+}
+
+HWTEST_F(DInputLatencyHistogramTest, Record001, testing::ext::TestSize.Level1)
+{
+    LatencyHistogram histogram;
+    histogram.Record(HUGE_VALUE);
+    EXPECT_EQ(HUGE_VALUE, histogram.GetMax());
+    EXPECT_EQ(HUGE_VALUE, histogram.GetPercentile(100.0));
+    histogram.Reset();
+    EXPECT_EQ(0, histogram.GetCount());
+    EXPECT_EQ(0, histogram.GetMax());
+}
+
+HWTEST_F(DInputLatencyHistogramTest, Merge001, testing::ext::TestSize.Level1)
+{
+    LatencyHistogram first;
+    LatencyHistogram second;
+    first.Record(10);
+    second.Record(1000);
+    first.Merge(second);
+    EXPECT_EQ(2, first.GetCount());
+    EXPECT_EQ(10, first.GetMin());
+    EXPECT_EQ(1000, first.GetMax());
+    EXPECT_EQ(505, first.GetMean());
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
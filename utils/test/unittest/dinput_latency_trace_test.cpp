@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_latency_trace_test.h"
+
+#include "dinput_clock_sync.h"
+#include "dinput_latency_trace.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint64_t BASE_TIME_US = 1000000;
+    constexpr uint64_t STAGE_STEP_US = 100;
+    constexpr uint64_t SINK_AHEAD_US = 5000;
+    const std::string DEV_ID = "latency_trace_test_dev";
+
+    // the sink clock reads offsetUs ahead of the local one.
+    void SyncClock(int64_t offsetUs)
+    {
+        ClockSample sample;
+        sample.t1 = BASE_TIME_US;
+        sample.t2 = static_cast<uint64_t>(static_cast<int64_t>(BASE_TIME_US + 500) + offsetUs);
+        sample.t3 = sample.t2 + 100;
+        sample.t4 = BASE_TIME_US + 1100;
+        DInputClockSync::GetInstance().AddSample(DEV_ID, sample);
+    }
+}
+
+void DInputLatencyTraceTest::SetUp()
+{
+    DInputLatencyTrace::GetInstance().Reset();
+}
+
+void DInputLatencyTraceTest::TearDown()
+{
+    DInputLatencyTrace::GetInstance().SetEnabled(false);
+    DInputLatencyTrace::GetInstance().Reset();
+    DInputClockSync::GetInstance().Clear();
+}
+
+void DInputLatencyTraceTest::SetUpTestCase()
+{
+}
+
+void DInputLatencyTraceTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputLatencyTraceTest, SetEnabled001, testing::ext::TestSize.Level1)
+{
+    EXPECT_FALSE(DInputLatencyTrace::GetInstance().IsEnabled());
+    DInputLatencyTrace::GetInstance().SetEnabled(true);
+    EXPECT_TRUE(DInputLatencyTrace::GetInstance().IsEnabled());
+}
+
+HWTEST_F(DInputLatencyTraceTest, StampsJson001, testing::ext::TestSize.Level1)
+{
+    TraceStamps stamps {};
+    DInputLatencyTrace::Stamp(stamps, TraceStage::HUB_READ);
+    EXPECT_NE(0, stamps[static_cast<size_t>(TraceStage::HUB_READ)]);
+
+    TraceStamps parsed {};
+    EXPECT_TRUE(DInputLatencyTrace::StampsFromJson(DInputLatencyTrace::StampsToJson(stamps), parsed));
+    EXPECT_EQ(stamps, parsed);
+
+    nlohmann::json invalidJson = nlohmann::json::array();
+    invalidJson.push_back("stamp");
+    EXPECT_FALSE(DInputLatencyTrace::StampsFromJson(invalidJson, parsed));
+}
+
+HWTEST_F(DInputLatencyTraceTest, RecordBatch001, testing::ext::TestSize.Level1)
+{
+    TraceStamps stamps {};
+    for (size_t i = 0; i < TRACE_STAGE_NUM; i++) {
+        stamps[i] = BASE_TIME_US + i * STAGE_STEP_US;
+    }
+    SyncClock(0);
+    DInputLatencyTrace::GetInstance().RecordBatch(DEV_ID, stamps);
+    std::vector<TraceStageSummary> summaries = DInputLatencyTrace::GetInstance().GetStageSummaries();
+    ASSERT_EQ(TRACE_STAGE_NUM, summaries.size());
+    EXPECT_EQ((TRACE_STAGE_NUM - 1) * STAGE_STEP_US, summaries[0].summary.max);
+    for (size_t i = 1; i < TRACE_STAGE_NUM; i++) {
+        EXPECT_EQ(1, summaries[i].summary.count);
+        EXPECT_EQ(STAGE_STEP_US, summaries[i].summary.max);
+    }
+}
+
+HWTEST_F(DInputLatencyTraceTest, RecordBatch002, testing::ext::TestSize.Level1)
+{
+    TraceStamps stamps {};
+    stamps[static_cast<size_t>(TraceStage::INJECT_DEQUEUE)] = BASE_TIME_US;
+    stamps[static_cast<size_t>(TraceStage::UINPUT_WRITTEN)] = BASE_TIME_US + STAGE_STEP_US;
+    DInputLatencyTrace::GetInstance().RecordBatch(DEV_ID, stamps);
+    std::vector<TraceStageSummary> summaries = DInputLatencyTrace::GetInstance().GetStageSummaries();
+    ASSERT_EQ(TRACE_STAGE_NUM, summaries.size());
+    EXPECT_EQ(0, summaries[0].summary.count);
+    EXPECT_EQ(1, summaries[static_cast<size_t>(TraceStage::UINPUT_WRITTEN)].summary.count);
+    EXPECT_EQ(0, summaries[static_cast<size_t>(TraceStage::HUB_READ)].summary.count);
+}
+
+HWTEST_F(DInputLatencyTraceTest, RecordBatch003, testing::ext::TestSize.Level1)
+{
+    // the sink clock runs ahead, its stamps are later than the source ones taken after them.
+    TraceStamps stamps {};
+    for (size_t i = 0; i < TRACE_STAGE_NUM; i++) {
+        stamps[i] = BASE_TIME_US + i * STAGE_STEP_US;
+        if (i < static_cast<size_t>(TraceStage::BYTES_RECEIVED)) {
+            stamps[i] += SINK_AHEAD_US;
+        }
+    }
+    size_t sendIndex = static_cast<size_t>(TraceStage::BYTES_RECEIVED);
+    DInputLatencyTrace::GetInstance().RecordBatch(DEV_ID, stamps);
+    std::vector<TraceStageSummary> summaries = DInputLatencyTrace::GetInstance().GetStageSummaries();
+    ASSERT_EQ(TRACE_STAGE_NUM, summaries.size());
+    // without a clock estimate only the stages of one device are recorded.
+    EXPECT_EQ(0, summaries[0].summary.count);
+    EXPECT_EQ(0, summaries[sendIndex].summary.count);
+    EXPECT_EQ(1, summaries[static_cast<size_t>(TraceStage::HUB_READ)].summary.count);
+
+    SyncClock(static_cast<int64_t>(SINK_AHEAD_US));
+    DInputLatencyTrace::GetInstance().RecordBatch(DEV_ID, stamps);
+    summaries = DInputLatencyTrace::GetInstance().GetStageSummaries();
+    EXPECT_EQ(1, summaries[0].summary.count);
+    EXPECT_EQ((TRACE_STAGE_NUM - 1) * STAGE_STEP_US, summaries[0].summary.max);
+    EXPECT_EQ(1, summaries[sendIndex].summary.count);
+    EXPECT_EQ(STAGE_STEP_US, summaries[sendIndex].summary.max);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
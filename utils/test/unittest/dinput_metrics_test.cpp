@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_metrics_test.h"
+
+#include <chrono>
+#include <thread>
+
+#include "dinput_metrics.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    constexpr uint32_t THREAD_NUM = 4;
+    constexpr uint64_t EVENT_NUM_PER_THREAD = 1000;
+    const std::string DH_ID_TEST = "Input_1ds56v18e1v21v8v1erv15r1v8r1j1ty8";
+}
+
+void DInputMetricsTest::SetUp()
+{
+    DInputMetrics::GetInstance().Reset();
+}
+
+void DInputMetricsTest::TearDown()
+{
+    DInputMetrics::GetInstance().Reset();
+}
+
+void DInputMetricsTest::SetUpTestCase()
+{
+}
+
+void DInputMetricsTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputMetricsTest, AddCounter001, testing::ext::TestSize.Level1)
+{
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([]() {
+            for (uint64_t j = 0; j < EVENT_NUM_PER_THREAD; j++) {
+                DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_READ);
+            }
+            DInputMetrics::GetInstance().RecordHistogram(MetricHistogram::EVENTS_PER_BATCH, EVENT_NUM_PER_THREAD);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    MetricsSnapshot snapshot = DInputMetrics::GetInstance().GetSnapshot();
+    EXPECT_EQ(THREAD_NUM * EVENT_NUM_PER_THREAD, snapshot.counters[static_cast<size_t>(MetricCounter::EVENTS_READ)]);
+    EXPECT_EQ(THREAD_NUM, snapshot.histograms[static_cast<size_t>(MetricHistogram::EVENTS_PER_BATCH)].count);
+
+    // exited threads hand their shard over, totals survive a new thread.
+    std::thread([]() { DInputMetrics::GetInstance().AddCounter(MetricCounter::EVENTS_READ); }).join();
+    snapshot = DInputMetrics::GetInstance().GetSnapshot();
+    EXPECT_EQ(THREAD_NUM * EVENT_NUM_PER_THREAD + 1,
+        snapshot.counters[static_cast<size_t>(MetricCounter::EVENTS_READ)]);
+    EXPECT_GE(THREAD_NUM + 1, DInputMetrics::GetInstance().shards_.size());
+}
+
+HWTEST_F(DInputMetricsTest, SetGauge001, testing::ext::TestSize.Level1)
+{
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::INJECT_QUEUE_DEPTH, 5);
+    DInputMetrics::GetInstance().AddGauge(MetricGauge::INJECT_QUEUE_DEPTH, -2);
+    MetricsSnapshot snapshot = DInputMetrics::GetInstance().GetSnapshot();
+    EXPECT_EQ(3, snapshot.gauges[static_cast<size_t>(MetricGauge::INJECT_QUEUE_DEPTH)]);
+    DInputMetrics::GetInstance().SetGauge(MetricGauge::INJECT_QUEUE_DEPTH, 0);
+}
+
+HWTEST_F(DInputMetricsTest, AddDeviceEvents001, testing::ext::TestSize.Level1)
+{
+    DInputMetrics::GetInstance().AddDeviceEvents(DH_ID_TEST, 10);
+    MetricsSnapshot snapshot = DInputMetrics::GetInstance().GetSnapshot();
+    ASSERT_EQ(1, snapshot.devices.size());
+    EXPECT_EQ(10, snapshot.devices[DH_ID_TEST].events);
+    // the first snapshot has no previous window, so no rate yet.
+    EXPECT_EQ(0, snapshot.devices[DH_ID_TEST].rate);
+
+    DInputMetrics::GetInstance().Reset();
+    snapshot = DInputMetrics::GetInstance().GetSnapshot();
+    EXPECT_EQ(0, snapshot.devices.size());
+}
+
+HWTEST_F(DInputMetricsTest, GetSnapshot001, testing::ext::TestSize.Level1)
+{
+    DInputMetrics::GetInstance().AddDeviceEvents(DH_ID_TEST, 10);
+    DInputMetrics::GetInstance().GetSnapshot("reader_a");
+    DInputMetrics::GetInstance().GetSnapshot("reader_b");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    DInputMetrics::GetInstance().AddDeviceEvents(DH_ID_TEST, 10);
+    // a snapshot of one reader does not move the window of the other.
+    MetricsSnapshot snapshotA = DInputMetrics::GetInstance().GetSnapshot("reader_a");
+    MetricsSnapshot snapshotB = DInputMetrics::GetInstance().GetSnapshot("reader_b");
+    EXPECT_GT(snapshotA.devices[DH_ID_TEST].rate, 0);
+    EXPECT_GT(snapshotB.devices[DH_ID_TEST].rate, 0);
+    DInputMetrics::GetInstance().Reset();
+}
+
+HWTEST_F(DInputMetricsTest, GetName001, testing::ext::TestSize.Level1)
+{
+    EXPECT_STREQ("bytes_sent", DInputMetrics::GetCounterName(MetricCounter::BYTES_SENT));
+    EXPECT_STREQ("unknown", DInputMetrics::GetCounterName(MetricCounter::COUNTER_NUM));
+    EXPECT_STREQ("inject_queue_depth", DInputMetrics::GetGaugeName(MetricGauge::INJECT_QUEUE_DEPTH));
+    EXPECT_STREQ("events_per_batch", DInputMetrics::GetHistogramName(MetricHistogram::EVENTS_PER_BATCH));
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dinput_utils_tool_test.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dinput_utils_tool.h"
+
+using namespace testing::ext;
+using namespace OHOS::DistributedHardware::DistributedInput;
+using namespace std;
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace DistributedInput {
+namespace {
+    const std::string NODE_DIR_TEST = "/data/test/dinput_open_ready";
+    const std::string NODE_PATH_TEST = NODE_DIR_TEST + "/event0";
+    constexpr uint32_t CREATE_DELAY_MS = 50;
+    constexpr uint32_t OPEN_TIMEOUT_MS = 2000;
+    constexpr uint32_t SHORT_TIMEOUT_MS = 20;
+}
+
+void DInputUtilsToolTest::SetUp()
+{
+    (void)mkdir(NODE_DIR_TEST.c_str(), S_IRWXU);
+    (void)remove(NODE_PATH_TEST.c_str());
+}
+
+void DInputUtilsToolTest::TearDown()
+{
+    (void)remove(NODE_PATH_TEST.c_str());
+    (void)rmdir(NODE_DIR_TEST.c_str());
+}
+
+void DInputUtilsToolTest::SetUpTestCase()
+{
+}
+
+void DInputUtilsToolTest::TearDownTestCase()
+{
+}
+
+HWTEST_F(DInputUtilsToolTest, OpenInputDeviceFdWhenReady_001, TestSize.Level1)
+{
+    std::thread creator([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(CREATE_DELAY_MS));
+        int fd = open(NODE_PATH_TEST.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (fd >= 0) {
+            close(fd);
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    int fd = OpenInputDeviceFdWhenReady(NODE_PATH_TEST, OPEN_TIMEOUT_MS);
+    auto cost = std::chrono::steady_clock::now() - start;
+    creator.join();
+    EXPECT_GE(fd, 0);
+    // the node is opened once it is created, not when the deadline expires.
+    EXPECT_LT(cost, std::chrono::milliseconds(OPEN_TIMEOUT_MS / 2));
+    CloseFd(fd);
+}
+
+HWTEST_F(DInputUtilsToolTest, OpenInputDeviceFdWhenReady_002, TestSize.Level1)
+{
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(-1, OpenInputDeviceFdWhenReady(NODE_PATH_TEST, SHORT_TIMEOUT_MS));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(SHORT_TIMEOUT_MS));
+
+    EXPECT_EQ(-1, OpenInputDeviceFdWhenReady(NODE_DIR_TEST, OPEN_TIMEOUT_MS));
+    EXPECT_EQ(-1, OpenInputDeviceFdWhenReady("", OPEN_TIMEOUT_MS));
+}
+
+HWTEST_F(DInputUtilsToolTest, OpenInputDeviceFdByPath_001, TestSize.Level1)
+{
+    int fd = open(NODE_PATH_TEST.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    fd = OpenInputDeviceFdByPath(NODE_PATH_TEST);
+    EXPECT_GE(fd, 0);
+    CloseFd(fd);
+}
+} // namespace DistributedInput
+} // namespace DistributedHardware
+} // namespace OHOS